@@ -0,0 +1,205 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/mem_algo/simple_seq_fit.hpp>
+#include <boost/interprocess/indexes/iset_index.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/interprocess/sync/mutex_family.hpp>
+#include <vector>
+#include "bench_utils.hpp"
+#include "../test/get_process_id_name.hpp"
+
+//Measures allocation/deallocation mixes on the two memory algorithms
+//shipped with the library, from one thread, several threads and several
+//processes sharing the same segment.
+
+using namespace boost::interprocess;
+
+typedef basic_managed_shared_memory
+   <char, rbtree_best_fit<mutex_family>, iset_index>  rbtree_segment_t;
+typedef basic_managed_shared_memory
+   <char, simple_seq_fit<mutex_family>, iset_index>   seqfit_segment_t;
+
+static const std::size_t SegmentSize   = 32u*1024u*1024u;
+static const std::size_t Slots         = 256u;
+static const std::size_t MinBlockSize  = 8u;
+static const std::size_t MaxBlockSize  = 1024u;
+static const std::size_t FixedSize     = 64u;
+static const unsigned    MaxWorkers    = 4u;
+
+//Process start gate placed in the segment so that the parent times only
+//the allocation work, not process creation
+struct start_gate
+{
+   start_gate()
+      : ready(0u), go(0u)
+   {}
+
+   interprocess_semaphore ready;
+   interprocess_semaphore go;
+};
+
+//Allocates batches of fixed size blocks and deallocates them in reverse order.
+//Each batch performs Slots*2 operations.
+template<class Segment>
+bench::nanoseconds_t fixed_lifo(Segment &seg, std::size_t batches)
+{
+   std::vector<void*> blocks(Slots);
+   const bench::nanoseconds_t t0 = bench::now_ns();
+   for(std::size_t b = 0; b != batches; ++b){
+      for(std::size_t i = 0; i != Slots; ++i){
+         blocks[i] = seg.allocate(FixedSize);
+      }
+      for(std::size_t i = Slots; i != 0; --i){
+         seg.deallocate(blocks[i-1u]);
+      }
+   }
+   return bench::now_ns() - t0;
+}
+
+//Random sequence of allocations of random size and deallocations of random blocks
+template<class Segment>
+bench::nanoseconds_t random_mix(Segment &seg, std::size_t ops, boost::uint32_t seed)
+{
+   std::vector<void*> slots(Slots, (void*)0);
+   bench::rand_gen rnd(seed);
+   const bench::nanoseconds_t t0 = bench::now_ns();
+   for(std::size_t i = 0; i != ops; ++i){
+      void *&slot = slots[rnd(Slots)];
+      if(slot){
+         seg.deallocate(slot);
+         slot = 0;
+      }
+      else{
+         slot = seg.allocate(MinBlockSize + rnd(MaxBlockSize - MinBlockSize));
+      }
+   }
+   const bench::nanoseconds_t t1 = bench::now_ns();
+   for(std::size_t i = 0; i != Slots; ++i){
+      if(slots[i])
+         seg.deallocate(slots[i]);
+   }
+   return t1 - t0;
+}
+
+template<class Segment>
+struct random_mix_thread
+{
+   random_mix_thread(Segment &seg, std::size_t ops, boost::uint32_t seed)
+      : m_seg(&seg), m_ops(ops), m_seed(seed)
+   {}
+
+   void operator()()
+   {  random_mix(*m_seg, m_ops, m_seed);  }
+
+   Segment *m_seg;
+   std::size_t m_ops;
+   boost::uint32_t m_seed;
+};
+
+template<class Segment>
+void bench_algorithm(const char *algo_name, const char *argv0, unsigned algo_idx, std::size_t ops)
+{
+   const char *const shm_name = test::get_process_id_name();
+   shared_memory_object::remove(shm_name);
+   {
+      Segment seg(create_only, shm_name, SegmentSize);
+
+      {
+         bench::result r("allocators", "fixed_lifo", algo_name, 1u);
+         const std::size_t batches = ops/(Slots*2u);
+         r.ops = batches*Slots*2u;
+         r.total_ns = fixed_lifo(seg, batches);
+         bench::print_result(r);
+      }
+      {
+         bench::result r("allocators", "random_mix", algo_name, 1u);
+         r.ops = ops;
+         r.total_ns = random_mix(seg, ops, 1u);
+         bench::print_result(r);
+      }
+      //Several threads share the segment
+      for(unsigned workers = 2u; workers <= MaxWorkers; workers *= 2u){
+         std::vector<random_mix_thread<Segment> > functors;
+         for(unsigned w = 0; w != workers; ++w){
+            functors.push_back(random_mix_thread<Segment>(seg, ops, w + 1u));
+         }
+         bench::result r("allocators", "random_mix_threads", algo_name, workers);
+         const bench::nanoseconds_t t0 = bench::now_ns();
+         bench::run_in_threads(functors);
+         r.total_ns = bench::now_ns() - t0;
+         r.ops = boost::uint64_t(ops)*workers;
+         bench::print_result(r);
+      }
+      //Several processes share the segment
+      for(unsigned workers = 2u; workers <= MaxWorkers; workers *= 2u){
+         start_gate *gate = seg.template construct<start_gate>(anonymous_instance)();
+         std::vector<bench::child_process*> children;
+         for(unsigned w = 0; w != workers; ++w){
+            children.push_back(new bench::child_process
+               (argv0, bench::to_string(algo_idx) + " " + shm_name + " " +
+                       bench::to_string(seg.get_handle_from_address(gate)) + " " +
+                       bench::to_string(ops) + " " + bench::to_string(w + 1u)));
+         }
+         for(unsigned w = 0; w != workers; ++w){
+            gate->ready.wait();
+         }
+         bench::result r("allocators", "random_mix_processes", algo_name, workers);
+         const bench::nanoseconds_t t0 = bench::now_ns();
+         for(unsigned w = 0; w != workers; ++w){
+            gate->go.post();
+         }
+         bool ok = true;
+         for(unsigned w = 0; w != workers; ++w){
+            ok = (0 == children[w]->join()) && ok;
+            delete children[w];
+         }
+         r.total_ns = bench::now_ns() - t0;
+         r.ops = boost::uint64_t(ops)*workers;
+         seg.destroy_ptr(gate);
+         if(ok)
+            bench::print_result(r);
+      }
+   }
+   shared_memory_object::remove(shm_name);
+}
+
+template<class Segment>
+int child_main(char *argv[])
+{
+   Segment seg(open_only, argv[3]);
+   typename Segment::handle_t handle = 0;
+   std::stringstream s;
+   s << argv[4]; s >> handle;
+   const std::size_t ops = (std::size_t)std::atol(argv[5]);
+   const boost::uint32_t seed = (boost::uint32_t)std::atol(argv[6]);
+   start_gate *gate = static_cast<start_gate*>(seg.get_address_from_handle(handle));
+   gate->ready.post();
+   gate->go.wait();
+   random_mix(seg, ops, seed);
+   return 0;
+}
+
+int main(int argc, char *argv[])
+{
+   if(bench::is_child(argc, argv)){
+      if(argc < 7)
+         return 1;
+      return std::atoi(argv[2]) == 0 ? child_main<rbtree_segment_t>(argv)
+                                     : child_main<seqfit_segment_t>(argv);
+   }
+   const std::size_t ops = 200000u*bench::get_scale(argc, argv);
+   bench::print_header();
+   bench_algorithm<rbtree_segment_t>("rbtree_best_fit", argv[0], 0u, ops);
+   bench_algorithm<seqfit_segment_t>("simple_seq_fit",  argv[0], 1u, ops);
+   return 0;
+}
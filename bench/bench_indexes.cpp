@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/indexes/flat_map_index.hpp>
+#include <boost/interprocess/indexes/map_index.hpp>
+#include <boost/interprocess/indexes/iset_index.hpp>
+#include <boost/interprocess/indexes/iunordered_set_index.hpp>
+#include <boost/interprocess/sync/mutex_family.hpp>
+#include <string>
+#include <vector>
+#include "bench_utils.hpp"
+#include "../test/get_process_id_name.hpp"
+
+//Measures named construction, lookup and destruction on every index type
+
+using namespace boost::interprocess;
+
+static const std::size_t SegmentSize = 64u*1024u*1024u;
+
+template<template<class> class IndexType>
+void bench_index( const char *index_name, const std::vector<std::string> &names
+                , const std::vector<std::string> &missing_names)
+{
+   typedef basic_managed_shared_memory
+      <char, rbtree_best_fit<mutex_family>, IndexType> segment_t;
+
+   const std::size_t n = names.size();
+   const char *const shm_name = test::get_process_id_name();
+   shared_memory_object::remove(shm_name);
+   {
+      segment_t seg(create_only, shm_name, SegmentSize);
+
+      {
+         bench::result r("indexes", "construct", index_name, 1u);
+         const bench::nanoseconds_t t0 = bench::now_ns();
+         for(std::size_t i = 0; i != n; ++i){
+            seg.template construct<int>(names[i].c_str())((int)i);
+         }
+         r.total_ns = bench::now_ns() - t0;
+         r.ops = n;
+         bench::print_result(r);
+      }
+      {
+         //Lookups in a reproducible random order, sampling individual latencies
+         bench::rand_gen rnd;
+         bench::latency_samples samples(n);
+         bench::result r("indexes", "find_hit", index_name, 1u);
+         for(std::size_t i = 0; i != n; ++i){
+            const char *name = names[rnd(n)].c_str();
+            const bench::nanoseconds_t t0 = bench::now_ns();
+            std::pair<int*, std::size_t> ret = seg.template find<int>(name);
+            const bench::nanoseconds_t t1 = bench::now_ns();
+            if(!ret.first)
+               std::abort();
+            samples.add(t1 - t0);
+            r.total_ns += t1 - t0;
+         }
+         r.ops = n;
+         r.set_latencies(samples);
+         bench::print_result(r);
+      }
+      {
+         bench::result r("indexes", "find_miss", index_name, 1u);
+         const bench::nanoseconds_t t0 = bench::now_ns();
+         for(std::size_t i = 0; i != n; ++i){
+            if(seg.template find<int>(missing_names[i].c_str()).first)
+               std::abort();
+         }
+         r.total_ns = bench::now_ns() - t0;
+         r.ops = n;
+         bench::print_result(r);
+      }
+      {
+         bench::result r("indexes", "destroy", index_name, 1u);
+         const bench::nanoseconds_t t0 = bench::now_ns();
+         for(std::size_t i = 0; i != n; ++i){
+            seg.template destroy<int>(names[i].c_str());
+         }
+         r.total_ns = bench::now_ns() - t0;
+         r.ops = n;
+         bench::print_result(r);
+      }
+   }
+   shared_memory_object::remove(shm_name);
+}
+
+int main(int argc, char *argv[])
+{
+   const std::size_t n = 20000u*bench::get_scale(argc, argv);
+   std::vector<std::string> names, missing_names;
+   names.reserve(n);
+   missing_names.reserve(n);
+   for(std::size_t i = 0; i != n; ++i){
+      names.push_back(std::string("object_") + bench::to_string(i));
+      missing_names.push_back(std::string("missing_") + bench::to_string(i));
+   }
+
+   bench::print_header();
+   bench_index<flat_map_index>      ("flat_map_index",       names, missing_names);
+   bench_index<map_index>           ("map_index",            names, missing_names);
+   bench_index<iset_index>          ("iset_index",           names, missing_names);
+   bench_index<iunordered_set_index>("iunordered_set_index", names, missing_names);
+   return 0;
+}
@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/ipc/message_queue.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "bench_utils.hpp"
+#include "../test/get_process_id_name.hpp"
+
+//Measures message_queue throughput and send-to-receive latency percentiles
+//depending on the message size and the queue depth, with the consumer in
+//another thread or in another process. Each message carries its send time,
+//so latency includes the time spent waiting in the queue.
+
+using namespace boost::interprocess;
+
+static const std::size_t MsgSizes[] = { 16u, 256u, 4096u };
+static const std::size_t Depths[]   = { 1u, 16u, 256u };
+
+//The child process signals through this queue that it has opened the
+//benchmarked queue, so that process startup is not measured
+std::string ready_queue_name(const char *mq_name)
+{  return std::string(mq_name) + "_ready";  }
+
+std::string param_name(std::size_t msg_size, std::size_t depth)
+{
+   return std::string("msg") + bench::to_string(msg_size) + "_depth" + bench::to_string(depth);
+}
+
+void send_messages(message_queue &mq, std::size_t msg_size, std::size_t n)
+{
+   std::vector<char> buf(msg_size, 0);
+   for(std::size_t i = 0; i != n; ++i){
+      const bench::nanoseconds_t now = bench::now_ns();
+      std::memcpy(&buf[0], &now, sizeof(now));
+      mq.send(&buf[0], msg_size, 0u);
+   }
+}
+
+//Receives n messages and fills the record
+void receive_messages(message_queue &mq, std::size_t msg_size, std::size_t n, bench::result &r)
+{
+   std::vector<char> buf(msg_size, 0);
+   bench::latency_samples samples(n);
+   bench::nanoseconds_t first_sent = 0u, last_received = 0u;
+   for(std::size_t i = 0; i != n; ++i){
+      message_queue::size_type recvd_size;
+      unsigned int prio;
+      mq.receive(&buf[0], msg_size, recvd_size, prio);
+      last_received = bench::now_ns();
+      bench::nanoseconds_t sent;
+      std::memcpy(&sent, &buf[0], sizeof(sent));
+      if(!i)
+         first_sent = sent;
+      samples.add(last_received - sent);
+   }
+   r.ops = n;
+   r.total_ns = last_received - first_sent;
+   r.set_latencies(samples);
+}
+
+struct producer
+{
+   producer(message_queue &mq, std::size_t msg_size, std::size_t n)
+      : m_mq(&mq), m_msg_size(msg_size), m_n(n)
+   {}
+
+   void operator()()
+   {  send_messages(*m_mq, m_msg_size, m_n);  }
+
+   message_queue *m_mq;
+   std::size_t m_msg_size;
+   std::size_t m_n;
+};
+
+void bench_queue(const char *argv0, std::size_t msg_size, std::size_t depth, std::size_t n)
+{
+   const char *const mq_name = test::get_process_id_name();
+   const std::string param(param_name(msg_size, depth));
+   const std::string ready_name(ready_queue_name(mq_name));
+   message_queue::remove(mq_name);
+   message_queue::remove(ready_name.c_str());
+   {
+      message_queue mq(create_only, mq_name, depth, msg_size);
+      message_queue ready(create_only, ready_name.c_str(), 1u, 1u);
+      //Consumer in this process, producer in another thread
+      {
+         bench::result r("message_queue", "threads", param, 2u);
+         ipcdetail::OS_thread_t th;
+         ipcdetail::thread_launch(th, producer(mq, msg_size, n));
+         receive_messages(mq, msg_size, n, r);
+         ipcdetail::thread_join(th);
+         bench::print_result(r);
+      }
+      //Consumer in a child process that prints the record
+      {
+         bench::child_process child
+            (argv0, std::string(mq_name) + " " + bench::to_string(msg_size) + " " +
+                    bench::to_string(depth) + " " + bench::to_string(n));
+         char c;
+         message_queue::size_type recvd_size;
+         unsigned int prio;
+         ready.receive(&c, 1u, recvd_size, prio);
+         send_messages(mq, msg_size, n);
+         child.join();
+      }
+   }
+   message_queue::remove(mq_name);
+   message_queue::remove(ready_name.c_str());
+}
+
+int child_main(char *argv[])
+{
+   message_queue mq(open_only, argv[2]);
+   message_queue ready(open_only, ready_queue_name(argv[2]).c_str());
+   const std::size_t msg_size = (std::size_t)std::atol(argv[3]);
+   const std::size_t depth    = (std::size_t)std::atol(argv[4]);
+   const std::size_t n        = (std::size_t)std::atol(argv[5]);
+   bench::result r("message_queue", "processes", param_name(msg_size, depth), 2u);
+   ready.send("", 1u, 0u);
+   receive_messages(mq, msg_size, n, r);
+   bench::print_result(r);
+   return 0;
+}
+
+int main(int argc, char *argv[])
+{
+   if(bench::is_child(argc, argv)){
+      return argc < 6 ? 1 : child_main(argv);
+   }
+   const std::size_t n = 20000u*bench::get_scale(argc, argv);
+   bench::print_header();
+   for(std::size_t s = 0; s != sizeof(MsgSizes)/sizeof(MsgSizes[0]); ++s){
+      for(std::size_t d = 0; d != sizeof(Depths)/sizeof(Depths[0]); ++d){
+         bench_queue(argv[0], MsgSizes[s], Depths[d], n);
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,213 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "bench_utils.hpp"
+#include "../test/get_process_id_name.hpp"
+
+//Measures the cost of process-shared mutexes and the round-trip latency
+//of mutex/condition and semaphore ping-pong between two threads or two
+//processes.
+
+using namespace boost::interprocess;
+
+static const unsigned MaxWorkers = 4u;
+
+//////////////////////////////////////////////
+//          Mutex acquisition cost
+//////////////////////////////////////////////
+
+struct mutex_hammer
+{
+   mutex_hammer(interprocess_mutex &m, std::size_t &counter, std::size_t n)
+      : m_mut(&m), m_counter(&counter), m_n(n)
+   {}
+
+   void operator()()
+   {
+      for(std::size_t i = 0; i != m_n; ++i){
+         scoped_lock<interprocess_mutex> lck(*m_mut);
+         ++*m_counter;
+      }
+   }
+
+   interprocess_mutex *m_mut;
+   std::size_t *m_counter;
+   std::size_t m_n;
+};
+
+void bench_mutex(std::size_t n)
+{
+   interprocess_mutex m;
+   std::size_t counter = 0;
+   for(unsigned workers = 1u; workers <= MaxWorkers; workers *= 2u){
+      std::vector<mutex_hammer> functors(workers, mutex_hammer(m, counter, n));
+      bench::result r( "sync", workers == 1u ? "mutex_uncontended" : "mutex_contended"
+                     , "interprocess_mutex", workers);
+      const bench::nanoseconds_t t0 = bench::now_ns();
+      bench::run_in_threads(functors);
+      r.total_ns = bench::now_ns() - t0;
+      r.ops = boost::uint64_t(n)*workers;
+      bench::print_result(r);
+   }
+}
+
+//////////////////////////////////////////////
+//          Ping-pong objects
+//////////////////////////////////////////////
+
+//Mutex and condition ping-pong: each side waits until "turn"
+//holds its own id and then passes the turn to the other side
+struct condition_pingpong
+{
+   condition_pingpong()
+      : turn(0u)
+   {}
+
+   void play(unsigned me)
+   {
+      scoped_lock<interprocess_mutex> lck(mut);
+      while(turn != me){
+         cond.wait(lck);
+      }
+      turn = 1u - me;
+      cond.notify_one();
+   }
+
+   interprocess_mutex mut;
+   interprocess_condition cond;
+   unsigned turn;
+};
+
+//Semaphore ping-pong: each side waits on its own semaphore and posts the other one
+struct semaphore_pingpong
+{
+   semaphore_pingpong()
+      : ping(1u), pong(0u)
+   {}
+
+   void play(unsigned me)
+   {
+      (me ? pong : ping).wait();
+      (me ? ping : pong).post();
+   }
+
+   interprocess_semaphore ping;
+   interprocess_semaphore pong;
+};
+
+//Side 1 of the ping-pong, plays n + 1 rounds (the first one is a warm-up)
+template<class PingPong>
+struct pong_player
+{
+   pong_player(PingPong &p, std::size_t n)
+      : m_p(&p), m_n(n)
+   {}
+
+   void operator()()
+   {
+      for(std::size_t i = 0; i != m_n + 1u; ++i){
+         m_p->play(1u);
+      }
+   }
+
+   PingPong *m_p;
+   std::size_t m_n;
+};
+
+//Side 0 of the ping-pong, samples the round-trip latency of n rounds
+template<class PingPong>
+void ping_player(PingPong &p, std::size_t n, bench::result &r)
+{
+   //Warm-up round, waits until the other side is running
+   p.play(0u);
+   bench::latency_samples samples(n);
+   const bench::nanoseconds_t t0 = bench::now_ns();
+   bench::nanoseconds_t last = t0;
+   for(std::size_t i = 0; i != n; ++i){
+      p.play(0u);
+      const bench::nanoseconds_t now = bench::now_ns();
+      samples.add(now - last);
+      last = now;
+   }
+   //Wait for the last pong
+   p.play(0u);
+   r.total_ns = bench::now_ns() - t0;
+   r.ops = n;
+   r.set_latencies(samples);
+}
+
+template<class PingPong>
+void bench_pingpong_threads(const char *name, std::size_t n)
+{
+   PingPong p;
+   bench::result r("sync", name, "threads", 2u);
+   ipcdetail::OS_thread_t th;
+   ipcdetail::thread_launch(th, pong_player<PingPong>(p, n));
+   ping_player(p, n, r);
+   ipcdetail::thread_join(th);
+   bench::print_result(r);
+}
+
+template<class PingPong>
+void bench_pingpong_processes(const char *name, const char *argv0, std::size_t n)
+{
+   const char *const shm_name = test::get_process_id_name();
+   shared_memory_object::remove(shm_name);
+   {
+      managed_shared_memory seg(create_only, shm_name, 65536u);
+      PingPong *p = seg.construct<PingPong>(name)();
+      bench::result r("sync", name, "processes", 2u);
+      bench::child_process child
+         (argv0, std::string(shm_name) + " " + name + " " + bench::to_string(n));
+      ping_player(*p, n, r);
+      if(0 == child.join())
+         bench::print_result(r);
+   }
+   shared_memory_object::remove(shm_name);
+}
+
+template<class PingPong>
+int child_pingpong(const char *shm_name, const char *name, std::size_t n)
+{
+   managed_shared_memory seg(open_only, shm_name);
+   PingPong *p = seg.find<PingPong>(name).first;
+   if(!p)
+      return 1;
+   pong_player<PingPong>(*p, n)();
+   return 0;
+}
+
+int main(int argc, char *argv[])
+{
+   if(bench::is_child(argc, argv)){
+      if(argc < 5)
+         return 1;
+      const std::size_t n = (std::size_t)std::atol(argv[4]);
+      return 0 == std::strcmp(argv[3], "condition_pingpong")
+         ? child_pingpong<condition_pingpong>(argv[2], argv[3], n)
+         : child_pingpong<semaphore_pingpong>(argv[2], argv[3], n);
+   }
+   const std::size_t scale = bench::get_scale(argc, argv);
+   bench::print_header();
+   bench_mutex(1000000u*scale);
+   bench_pingpong_threads<condition_pingpong>("condition_pingpong", 20000u*scale);
+   bench_pingpong_threads<semaphore_pingpong>("semaphore_pingpong", 20000u*scale);
+   bench_pingpong_processes<condition_pingpong>("condition_pingpong", argv[0], 20000u*scale);
+   bench_pingpong_processes<semaphore_pingpong>("semaphore_pingpong", argv[0], 20000u*scale);
+   return 0;
+}
@@ -0,0 +1,246 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_BENCH_UTILS_HPP
+#define BOOST_INTERPROCESS_BENCH_UTILS_HPP
+
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm> //std::sort
+#include <cstdio>    //std::printf
+#include <cstdlib>   //std::system, std::atoi
+#include <cstring>   //std::strcmp
+#include <sstream>
+#include <string>
+#include <vector>
+
+//Common utilities for the benchmark programs:
+//
+// - Every benchmark prints one CSV record per measured case to stdout, preceded by
+//   a single header line, so that results can be diffed and plotted between runs:
+//
+//      suite,case,param,workers,ops,total_ns,ns_per_op,p50_ns,p90_ns,p99_ns,max_ns
+//
+//   Percentile columns are zero when the case does not sample individual latencies.
+//
+// - All random workloads use a fixed-seed generator so that two runs perform
+//   exactly the same operation sequence.
+//
+// - Benchmarks accept an optional "-s <scale>" argument that multiplies the number
+//   of iterations (default 1), useful to obtain quick runs in CI or more stable
+//   numbers on a quiet machine.
+//
+// - Multi-process cases launch the same executable with "child" as the first argument.
+
+namespace boost {
+namespace interprocess {
+namespace bench {
+
+typedef boost::uint64_t nanoseconds_t;
+
+inline nanoseconds_t now_ns()
+{
+   return ipcdetail::system_highres_count_to_ns(ipcdetail::get_current_system_highres_count());
+}
+
+//Xorshift generator with a fixed default seed, enough for reproducible workloads
+class rand_gen
+{
+   public:
+   explicit rand_gen(boost::uint32_t seed = 2463534242u)
+      : m_state(seed ? seed : 2463534242u)
+   {}
+
+   boost::uint32_t operator()()
+   {
+      m_state ^= m_state << 13;
+      m_state ^= m_state >> 17;
+      m_state ^= m_state << 5;
+      return m_state;
+   }
+
+   //Returns a value in [0, n)
+   std::size_t operator()(std::size_t n)
+   {  return static_cast<std::size_t>((*this)() % n);  }
+
+   private:
+   boost::uint32_t m_state;
+};
+
+//Stores individual latencies and computes percentiles
+class latency_samples
+{
+   public:
+   explicit latency_samples(std::size_t reserve = 0)
+   {  m_samples.reserve(reserve);  }
+
+   void add(nanoseconds_t ns)
+   {  m_samples.push_back(ns);  }
+
+   void append(const latency_samples &other)
+   {  m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());  }
+
+   std::size_t size() const
+   {  return m_samples.size();  }
+
+   //Sorts the samples, must be called before percentile()
+   void finish()
+   {  std::sort(m_samples.begin(), m_samples.end());  }
+
+   //p in [0, 100]
+   nanoseconds_t percentile(unsigned p) const
+   {
+      if(m_samples.empty())
+         return 0u;
+      std::size_t idx = (m_samples.size() - 1u)*p/100u;
+      return m_samples[idx];
+   }
+
+   private:
+   std::vector<nanoseconds_t> m_samples;
+};
+
+struct result
+{
+   result(const char *suite, const char *case_name, const std::string &param, unsigned workers)
+      : suite(suite), case_name(case_name), param(param), workers(workers)
+      , ops(0u), total_ns(0u), p50(0u), p90(0u), p99(0u), max(0u)
+   {}
+
+   void set_latencies(latency_samples &s)
+   {
+      s.finish();
+      p50 = s.percentile(50u);
+      p90 = s.percentile(90u);
+      p99 = s.percentile(99u);
+      max = s.percentile(100u);
+   }
+
+   const char *suite;
+   const char *case_name;
+   std::string param;
+   unsigned workers;
+   boost::uint64_t ops;
+   nanoseconds_t total_ns;
+   nanoseconds_t p50, p90, p99, max;
+};
+
+inline void print_header()
+{
+   std::printf("suite,case,param,workers,ops,total_ns,ns_per_op,p50_ns,p90_ns,p99_ns,max_ns\n");
+   std::fflush(stdout);
+}
+
+inline void print_result(const result &r)
+{
+   const double ns_per_op = r.ops ? double(r.total_ns)/double(r.ops) : 0.0;
+   std::printf( "%s,%s,%s,%u,%llu,%llu,%.1f,%llu,%llu,%llu,%llu\n"
+              , r.suite, r.case_name, r.param.c_str(), r.workers
+              , (unsigned long long)r.ops, (unsigned long long)r.total_ns, ns_per_op
+              , (unsigned long long)r.p50, (unsigned long long)r.p90
+              , (unsigned long long)r.p99, (unsigned long long)r.max);
+   //Children processes share stdout, so flush each record
+   std::fflush(stdout);
+}
+
+template<class T>
+inline std::string to_string(const T &t)
+{
+   std::stringstream s;
+   s << t;
+   return s.str();
+}
+
+inline bool is_child(int argc, char *argv[])
+{  return argc > 1 && 0 == std::strcmp(argv[1], "child");  }
+
+//Parses "-s <scale>" returning 1 if not present
+inline unsigned get_scale(int argc, char *argv[])
+{
+   for(int i = 1; i < (argc - 1); ++i){
+      if(0 == std::strcmp(argv[i], "-s")){
+         const int s = std::atoi(argv[i+1]);
+         return s > 0 ? unsigned(s) : 1u;
+      }
+   }
+   return 1u;
+}
+
+//Runs "<argv0> child <args>" in a separate thread so that the caller can
+//keep working while the child process runs. join() returns the exit status.
+class child_process
+{
+   struct runner
+   {
+      runner(const std::string &cmd, int &status)
+         : m_cmd(cmd), m_status(status)
+      {}
+
+      void operator()()
+      {  m_status = std::system(m_cmd.c_str());  }
+
+      std::string m_cmd;
+      int &m_status;
+   };
+
+   public:
+   child_process(const char *argv0, const std::string &args)
+      : m_status(-1)
+   {
+      std::string cmd(argv0);
+      cmd += " child ";
+      cmd += args;
+      ipcdetail::thread_launch(m_thread, runner(cmd, m_status));
+   }
+
+   int join()
+   {
+      ipcdetail::thread_join(m_thread);
+      return m_status;
+   }
+
+   private:
+   ipcdetail::OS_thread_t m_thread;
+   int m_status;
+};
+
+//thread_launch copies the functor, this wrapper lets threads
+//store their results in the original object
+template<class Functor>
+struct ref_functor
+{
+   explicit ref_functor(Functor &f)
+      : m_f(&f)
+   {}
+
+   void operator()()
+   {  (*m_f)();  }
+
+   Functor *m_f;
+};
+
+//Launches each functor in its own thread and joins them
+template<class Functor>
+inline void run_in_threads(std::vector<Functor> &functors)
+{
+   std::vector<ipcdetail::OS_thread_t> threads(functors.size());
+   for(std::size_t i = 0; i != functors.size(); ++i){
+      ipcdetail::thread_launch(threads[i], ref_functor<Functor>(functors[i]));
+   }
+   for(std::size_t i = 0; i != functors.size(); ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+}
+
+}  //namespace bench {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#endif   //BOOST_INTERPROCESS_BENCH_UTILS_HPP
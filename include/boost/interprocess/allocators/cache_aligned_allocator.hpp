@@ -0,0 +1,260 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_CACHE_ALIGNED_ALLOCATOR_HPP
+#define BOOST_INTERPROCESS_CACHE_ALIGNED_ALLOCATOR_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+
+#include <boost/intrusive/pointer_traits.hpp>
+
+#include <boost/interprocess/interprocess_fwd.hpp>
+#include <boost/interprocess/allocators/detail/allocator_common.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/interprocess/containers/version_type.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/detail/type_traits.hpp>
+
+#include <boost/container/detail/placement_new.hpp>
+#include <boost/container/detail/addressof.hpp>
+#include <boost/container/detail/type_traits.hpp>  //alignment_of
+#include <boost/container/uses_allocator_construction.hpp>
+
+#include <cstddef>
+
+//!\file
+//!Describes an allocator that returns memory blocks aligned to and padded
+//!to a multiple of the cache line size.
+
+namespace boost {
+namespace interprocess {
+
+//!An STL compatible allocator that uses a segment manager as memory source and
+//!guarantees that every allocated block starts at an Alignment boundary
+//!(by default BOOST_INTERPROCESS_CACHE_LINE_SIZE) and that its size is padded
+//!to a multiple of Alignment. This way a container buffer never shares a
+//!cache line with other objects allocated from the segment.
+//!
+//!Note that elements inside a block are still contiguous: to give each element
+//!its own cache line use cache_aligned<T> as the value_type.
+//!
+//!Unlike boost::interprocess::allocator, in-place expansion is not offered
+//!(this is a version 1 allocator), as expanded blocks could not keep the
+//!padding guarantee.
+template<class T, class SegmentManager, std::size_t Alignment>
+class cache_aligned_allocator
+{
+   public:
+   //Segment manager
+   typedef SegmentManager                                segment_manager;
+   typedef typename SegmentManager::void_pointer         void_pointer;
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   BOOST_INTERPROCESS_STATIC_ASSERT((Alignment != 0u && (Alignment & (Alignment - 1u)) == 0u));
+
+   //Self type
+   typedef cache_aligned_allocator<T, SegmentManager, Alignment>   self_t;
+
+   //Typedef to const void pointer
+   typedef typename boost::intrusive::
+      pointer_traits<void_pointer>::template
+         rebind_pointer<const void>::type          cvoid_ptr;
+
+   //Pointer to the allocator
+   typedef typename boost::intrusive::
+      pointer_traits<cvoid_ptr>::template
+         rebind_pointer<segment_manager>::type     alloc_ptr_t;
+
+   //Not assignable from related allocator
+   template<class T2, class SegmentManager2, std::size_t Alignment2>
+   cache_aligned_allocator& operator=(const cache_aligned_allocator<T2, SegmentManager2, Alignment2>&);
+
+   //Not assignable from other allocator
+   cache_aligned_allocator& operator=(const cache_aligned_allocator&);
+
+   static const std::size_t t_alignment = ::boost::container::dtl::alignment_of<T>::value;
+
+   //Pointer to the allocator
+   alloc_ptr_t mp_mngr;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef T                                    value_type;
+   typedef typename boost::intrusive::
+      pointer_traits<cvoid_ptr>::template
+         rebind_pointer<T>::type                pointer;
+   typedef typename boost::intrusive::
+      pointer_traits<pointer>::template
+         rebind_pointer<const T>::type          const_pointer;
+   typedef typename ipcdetail::add_reference
+                     <value_type>::type         reference;
+   typedef typename ipcdetail::add_reference
+                     <const value_type>::type   const_reference;
+   typedef typename segment_manager::size_type               size_type;
+   typedef typename segment_manager::difference_type         difference_type;
+   typedef uses_segment_manager<SegmentManager> uses_segment_manager_t;
+
+   typedef boost::interprocess::version_type<cache_aligned_allocator, 1>   version;
+
+   //!The alignment of allocated blocks: the maximum of Alignment and the alignment of T
+   static const std::size_t alignment = Alignment > t_alignment ? Alignment : t_alignment;
+
+   //!Obtains an allocator that allocates
+   //!objects of type T2
+   template<class T2>
+   struct rebind
+   {
+      typedef cache_aligned_allocator<T2, SegmentManager, Alignment>     other;
+   };
+
+   //!Returns the segment manager.
+   //!Never throws
+   segment_manager* get_segment_manager()const
+   {  return ipcdetail::to_raw_pointer(mp_mngr);   }
+
+   //!Constructor from the segment manager.
+   //!Never throws
+   cache_aligned_allocator(segment_manager *segment_mngr)
+      : mp_mngr(segment_mngr) { }
+
+   //!Constructor that enables uses-allocator
+   //!Never throws
+   cache_aligned_allocator(uses_segment_manager_t usm)
+      : mp_mngr(usm.get_segment_manager())
+   {}
+
+   //!Constructor from other allocator.
+   //!Never throws
+   cache_aligned_allocator(const cache_aligned_allocator &other)
+      : mp_mngr(other.get_segment_manager()){ }
+
+   //!Constructor from related allocator.
+   //!Never throws
+   template<class T2>
+   cache_aligned_allocator(const cache_aligned_allocator<T2, SegmentManager, Alignment> &other)
+      : mp_mngr(other.get_segment_manager()){}
+
+   //!Allocates memory for an array of count elements. The returned block is aligned
+   //!to "alignment" and its usable size is a multiple of "alignment".
+   //!Throws boost::interprocess::bad_alloc if there is no enough memory
+   BOOST_INTERPROCESS_NODISCARD
+   pointer allocate(size_type count, cvoid_ptr hint = 0)
+   {
+      (void)hint;
+      if(size_overflows<sizeof(T)>(count)){
+         throw bad_alloc();
+      }
+      const size_type bytes = count*sizeof(T);
+      const size_type padded = bytes + (alignment - 1u);
+      if(padded < bytes){
+         throw bad_alloc();
+      }
+      return pointer(static_cast<value_type*>
+         (mp_mngr->allocate_aligned(padded - padded % alignment, alignment)));
+   }
+
+   //!Deallocates memory previously allocated.
+   //!Never throws
+   void deallocate(const pointer &ptr, size_type)
+   {  mp_mngr->deallocate((void*)ipcdetail::to_raw_pointer(ptr));  }
+
+   #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) || defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Construct a T object at p by uses-allocator construction with allocator
+   //!   argument constructible from `segment_manager*`
+   //!  and constructor arguments `std::forward<Args>(args)...`.
+   //!
+   //! <b>Throws</b>: Nothing unless the constructor for T throws.
+   template < typename U, class ...Args>
+   inline void construct(U* p, Args&& ...args)
+   {
+      boost::container::uninitialized_construct_using_allocator
+         (p, uses_segment_manager_t(this->get_segment_manager()), ::boost::forward<Args>(args)...);
+   }
+
+   #else // #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) || defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+
+   #define BOOST_INTERPROCESS_CACHE_ALIGNED_ALLOCATOR_CONSTRUCT_CODE(N) \
+   template < typename U BOOST_MOVE_I##N BOOST_MOVE_CLASSQ##N >\
+   void construct(U* p BOOST_MOVE_I##N BOOST_MOVE_UREFQ##N)\
+   {\
+      boost::container::uninitialized_construct_using_allocator\
+         (p, uses_segment_manager_t(this->get_segment_manager()) BOOST_MOVE_I##N BOOST_MOVE_FWDQ##N);\
+   }\
+   //
+   BOOST_MOVE_ITERATE_0TO9(BOOST_INTERPROCESS_CACHE_ALIGNED_ALLOCATOR_CONSTRUCT_CODE)
+   #undef BOOST_INTERPROCESS_CACHE_ALIGNED_ALLOCATOR_CONSTRUCT_CODE
+
+   #endif   //#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) || defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+
+   //!Returns the number of elements that could be allocated.
+   //!Never throws
+   size_type max_size() const
+   {  return mp_mngr->get_size()/sizeof(T);   }
+
+   //!Swap segment manager. Does not throw. If each allocator is placed in
+   //!different memory segments, the result is undefined.
+   friend void swap(self_t &alloc1, self_t &alloc2)
+   {  boost::adl_move_swap(alloc1.mp_mngr, alloc2.mp_mngr);   }
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+template<class T, class SegmentManager, std::size_t Alignment>
+const std::size_t cache_aligned_allocator<T, SegmentManager, Alignment>::t_alignment;
+
+template<class T, class SegmentManager, std::size_t Alignment>
+const std::size_t cache_aligned_allocator<T, SegmentManager, Alignment>::alignment;
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!Equality test for same type
+//!of allocator
+template<class T, class SegmentManager, std::size_t Alignment> inline
+bool operator==(const cache_aligned_allocator<T, SegmentManager, Alignment>  &alloc1,
+                const cache_aligned_allocator<T, SegmentManager, Alignment>  &alloc2)
+   {  return alloc1.get_segment_manager() == alloc2.get_segment_manager(); }
+
+//!Inequality test for same type
+//!of allocator
+template<class T, class SegmentManager, std::size_t Alignment> inline
+bool operator!=(const cache_aligned_allocator<T, SegmentManager, Alignment>  &alloc1,
+                const cache_aligned_allocator<T, SegmentManager, Alignment>  &alloc2)
+   {  return alloc1.get_segment_manager() != alloc2.get_segment_manager(); }
+
+}  //namespace interprocess {
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+template<class T>
+struct has_trivial_destructor;
+
+template<class T, class SegmentManager, std::size_t Alignment>
+struct has_trivial_destructor
+   <boost::interprocess::cache_aligned_allocator <T, SegmentManager, Alignment> >
+{
+   static const bool value = true;
+};
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_CACHE_ALIGNED_ALLOCATOR_HPP
@@ -0,0 +1,330 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_ATOMIC_OFFSET_PTR_HPP
+#define BOOST_INTERPROCESS_ATOMIC_OFFSET_PTR_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/offset_ptr.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+#include <atomic>
+#endif
+
+//!\file
+//!Describes atomic_offset_ptr and atomic_tagged_offset_ptr, offset pointers
+//!that can be atomically loaded, stored and compared-and-exchanged, to build
+//!lock-free structures placed in shared memory or memory mapped files.
+
+namespace boost {
+namespace interprocess {
+
+//!Memory ordering constraints accepted by atomic_offset_ptr and
+//!atomic_tagged_offset_ptr, with the same meaning as std::memory_order.
+//!The portable atomic primitives of the library are full barriers, so
+//!every operation is performed as memory_order_seq_cst, which is a valid
+//!(if stronger) implementation of any requested order.
+//!
+//!If the standard <atomic> header is available these are the std::memory_order
+//!type and constants themselves, so that they don't clash with the standard
+//!ones when both namespaces are brought in with using directives.
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+using std::memory_order;
+using std::memory_order_relaxed;
+using std::memory_order_consume;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_acq_rel;
+using std::memory_order_seq_cst;
+
+#else
+
+enum memory_order
+{
+   memory_order_relaxed,
+   memory_order_consume,
+   memory_order_acquire,
+   memory_order_release,
+   memory_order_acq_rel,
+   memory_order_seq_cst
+};
+
+#endif
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+namespace ipcdetail {
+
+//The stored offset is always 64 bit wide so that the same (lock-free) 64 bit
+//compare-and-swap is used in 32 and 64 bit processes. In 32 bit processes
+//the offset is sign-extended from uintptr_t.
+inline boost::uint64_t atomic_offset_ptr_encode(const volatile void *ptr, const volatile void *this_ptr)
+{
+   return boost::uint64_t(boost::int64_t(intptr_t(offset_ptr_to_offset<uintptr_t>(ptr, this_ptr))));
+}
+
+inline void *atomic_offset_ptr_decode(const volatile void *this_ptr, boost::uint64_t offset)
+{
+   return offset_ptr_to_raw_pointer<uintptr_t>(this_ptr, uintptr_t(offset));
+}
+
+}  //namespace ipcdetail {
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!atomic_offset_ptr is the atomic counterpart of offset_ptr: it stores the
+//!distance between itself and the pointee, so it can be placed in memory
+//!mapped at different addresses in each process, and all its operations are
+//!atomic and lock-free. Like std::atomic<T*>, values are exchanged as raw
+//!pointers, which are only valid in the calling process.
+//!
+//!The object and the pointee must be in the same mapping (e.g. the same
+//!managed segment). atomic_offset_ptr is not copyable or movable, as moving
+//!it would change the meaning of the stored offset.
+template<class T>
+class atomic_offset_ptr
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   atomic_offset_ptr(const atomic_offset_ptr &);
+   atomic_offset_ptr &operator=(const atomic_offset_ptr &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef T*                 value_type;
+   typedef offset_ptr<T>      pointer;
+
+   //!Constructor from a raw pointer (null by default). The initialization is not atomic.
+   //!Never throws.
+   atomic_offset_ptr(T *p = 0) BOOST_NOEXCEPT
+      : m_offset(ipcdetail::atomic_offset_ptr_encode(p, this))
+   {}
+
+   //!Atomically returns the stored pointer. Never throws.
+   T *load(memory_order = memory_order_seq_cst) const BOOST_NOEXCEPT
+   {  return this->priv_decode(ipcdetail::atomic_read64(&m_offset));  }
+
+   //!Atomically stores p. Never throws.
+   void store(T *p, memory_order order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {  this->exchange(p, order);  }
+
+   //!Atomically stores p and returns the previous pointer. Never throws.
+   T *exchange(T *p, memory_order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {
+      const boost::uint64_t desired = this->priv_encode(p);
+      boost::uint64_t c = ipcdetail::atomic_read64(&m_offset), old;
+      while((old = ipcdetail::atomic_cas64(&m_offset, desired, c)) != c){
+         c = old;
+      }
+      return this->priv_decode(c);
+   }
+
+   //!If the stored pointer is equal to "expected", atomically replaces it with
+   //!"desired" and returns true. Otherwise loads the stored pointer into "expected"
+   //!and returns false. Never throws.
+   bool compare_exchange_strong(T *&expected, T *desired, memory_order, memory_order) BOOST_NOEXCEPT
+   {
+      const boost::uint64_t cmp = this->priv_encode(expected);
+      const boost::uint64_t old = ipcdetail::atomic_cas64(&m_offset, this->priv_encode(desired), cmp);
+      if(old == cmp){
+         return true;
+      }
+      expected = this->priv_decode(old);
+      return false;
+   }
+
+   //!Same as compare_exchange_strong(expected, desired, order, order).
+   bool compare_exchange_strong(T *&expected, T *desired, memory_order order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {  return this->compare_exchange_strong(expected, desired, order, order);  }
+
+   //!Same as compare_exchange_strong: this implementation never fails spuriously.
+   bool compare_exchange_weak(T *&expected, T *desired, memory_order success, memory_order failure) BOOST_NOEXCEPT
+   {  return this->compare_exchange_strong(expected, desired, success, failure);  }
+
+   //!Same as compare_exchange_weak(expected, desired, order, order).
+   bool compare_exchange_weak(T *&expected, T *desired, memory_order order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {  return this->compare_exchange_strong(expected, desired, order, order);  }
+
+   //!Equivalent to load(). Never throws.
+   operator T*() const BOOST_NOEXCEPT
+   {  return this->load();  }
+
+   //!Equivalent to store(p). Never throws.
+   T *operator=(T *p) BOOST_NOEXCEPT
+   {  this->store(p);  return p;  }
+
+   //!Returns true: operations never take a lock. Never throws.
+   bool is_lock_free() const BOOST_NOEXCEPT
+   {  return true;  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   boost::uint64_t priv_encode(const volatile void *p) const
+   {  return ipcdetail::atomic_offset_ptr_encode(p, this);  }
+
+   T *priv_decode(boost::uint64_t offset) const
+   {  return static_cast<T*>(ipcdetail::atomic_offset_ptr_decode(this, offset));  }
+
+   mutable volatile boost::uint64_t m_offset;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+//!A pointer and a version tag, the value type of atomic_tagged_offset_ptr.
+template<class T>
+struct tagged_offset_ptr_value
+{
+   //!Type of the version tag. Only the lower
+   //!atomic_tagged_offset_ptr<T>::tag_bits bits are stored.
+   typedef boost::uint32_t tag_type;
+
+   tagged_offset_ptr_value(T *p = 0, tag_type t = 0) BOOST_NOEXCEPT
+      : ptr(p), tag(t)
+   {}
+
+   friend bool operator==(const tagged_offset_ptr_value &l, const tagged_offset_ptr_value &r) BOOST_NOEXCEPT
+   {  return l.ptr == r.ptr && l.tag == r.tag;  }
+
+   friend bool operator!=(const tagged_offset_ptr_value &l, const tagged_offset_ptr_value &r) BOOST_NOEXCEPT
+   {  return !(l == r);  }
+
+   T        *ptr;
+   tag_type  tag;
+};
+
+//!atomic_tagged_offset_ptr atomically updates an offset pointer and a version
+//!tag as a single unit, packed in a single 64 bit word, so that a single
+//!width compare-and-swap updates both. Incrementing the tag on each
+//!modification makes compare_exchange fail if the pointer was changed and
+//!then restored by other threads or processes (the ABA problem), which makes
+//!lock-free stacks (Treiber stacks) safe to share between processes.
+//!
+//!The lower offset_bits bits store the (signed) distance between the object
+//!and the pointee, so both must be less than 2^(offset_bits-1) bytes (512GB)
+//!apart. The upper tag_bits bits store the tag, which wraps around.
+//!
+//!The object and the pointee must be in the same mapping. atomic_tagged_offset_ptr
+//!is not copyable or movable, as moving it would change the meaning of the stored offset.
+template<class T>
+class atomic_tagged_offset_ptr
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   atomic_tagged_offset_ptr(const atomic_tagged_offset_ptr &);
+   atomic_tagged_offset_ptr &operator=(const atomic_tagged_offset_ptr &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef tagged_offset_ptr_value<T>        value_type;
+   typedef typename value_type::tag_type     tag_type;
+
+   //!Number of bits used to store the offset
+   static const unsigned offset_bits = 40u;
+   //!Number of bits used to store the tag
+   static const unsigned tag_bits = 64u - offset_bits;
+
+   //!Constructor from a raw pointer and tag. The initialization is not atomic.
+   //!Never throws.
+   atomic_tagged_offset_ptr(T *p = 0, tag_type t = 0) BOOST_NOEXCEPT
+      : m_value(this->priv_encode(value_type(p, t)))
+   {}
+
+   //!Atomically returns the stored pointer and tag. Never throws.
+   value_type load(memory_order = memory_order_seq_cst) const BOOST_NOEXCEPT
+   {  return this->priv_decode(ipcdetail::atomic_read64(&m_value));  }
+
+   //!Atomically stores v. Never throws.
+   void store(const value_type &v, memory_order order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {  this->exchange(v, order);  }
+
+   //!Atomically stores v and returns the previous value. Never throws.
+   value_type exchange(const value_type &v, memory_order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {
+      const boost::uint64_t desired = this->priv_encode(v);
+      boost::uint64_t c = ipcdetail::atomic_read64(&m_value), old;
+      while((old = ipcdetail::atomic_cas64(&m_value, desired, c)) != c){
+         c = old;
+      }
+      return this->priv_decode(c);
+   }
+
+   //!If both the stored pointer and tag are equal to "expected", atomically replaces
+   //!them with "desired" and returns true. Otherwise loads the stored value into "expected"
+   //!and returns false. Never throws.
+   bool compare_exchange_strong(value_type &expected, const value_type &desired, memory_order, memory_order) BOOST_NOEXCEPT
+   {
+      const boost::uint64_t cmp = this->priv_encode(expected);
+      const boost::uint64_t old = ipcdetail::atomic_cas64(&m_value, this->priv_encode(desired), cmp);
+      if(old == cmp){
+         return true;
+      }
+      expected = this->priv_decode(old);
+      return false;
+   }
+
+   //!Same as compare_exchange_strong(expected, desired, order, order).
+   bool compare_exchange_strong(value_type &expected, const value_type &desired, memory_order order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {  return this->compare_exchange_strong(expected, desired, order, order);  }
+
+   //!Same as compare_exchange_strong: this implementation never fails spuriously.
+   bool compare_exchange_weak(value_type &expected, const value_type &desired, memory_order success, memory_order failure) BOOST_NOEXCEPT
+   {  return this->compare_exchange_strong(expected, desired, success, failure);  }
+
+   //!Same as compare_exchange_weak(expected, desired, order, order).
+   bool compare_exchange_weak(value_type &expected, const value_type &desired, memory_order order = memory_order_seq_cst) BOOST_NOEXCEPT
+   {  return this->compare_exchange_strong(expected, desired, order, order);  }
+
+   //!Returns true: operations never take a lock. Never throws.
+   bool is_lock_free() const BOOST_NOEXCEPT
+   {  return true;  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   static const boost::uint64_t offset_mask = (boost::uint64_t(1u) << offset_bits) - 1u;
+   static const boost::uint64_t tag_mask = (boost::uint64_t(1u) << tag_bits) - 1u;
+
+   boost::uint64_t priv_encode(const value_type &v) const
+   {
+      const boost::uint64_t off = ipcdetail::atomic_offset_ptr_encode(v.ptr, this);
+      //The offset must be representable in offset_bits signed bits
+      BOOST_ASSERT(((off >> (offset_bits - 1u)) == 0u) ||
+                   ((off >> (offset_bits - 1u)) == (boost::uint64_t(-1) >> (offset_bits - 1u))));
+      return (off & offset_mask) | ((boost::uint64_t(v.tag) & tag_mask) << offset_bits);
+   }
+
+   value_type priv_decode(boost::uint64_t v) const
+   {
+      //Sign-extend the offset
+      const boost::uint64_t sign = boost::uint64_t(1u) << (offset_bits - 1u);
+      const boost::uint64_t off = ((v & offset_mask) ^ sign) - sign;
+      return value_type( static_cast<T*>(ipcdetail::atomic_offset_ptr_decode(this, off))
+                       , tag_type(v >> offset_bits));
+   }
+
+   mutable volatile boost::uint64_t m_value;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_ATOMIC_OFFSET_PTR_HPP
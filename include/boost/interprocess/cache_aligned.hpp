@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_CACHE_ALIGNED_HPP
+#define BOOST_INTERPROCESS_CACHE_ALIGNED_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/type_traits.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/container/detail/type_traits.hpp>  //alignment_of, aligned_storage
+#include <boost/container/detail/placement_new.hpp>
+#include <boost/move/utility_core.hpp>
+#if !defined(BOOST_INTERPROCESS_PERFECT_FORWARDING)
+#include <boost/move/detail/fwd_macros.hpp>
+#endif
+#include <cstddef>
+
+//!\file
+//!Describes cache_aligned, a wrapper that places an object in its own cache line(s).
+
+namespace boost {
+namespace interprocess {
+
+//!A wrapper that stores a T object aligned to Alignment bytes (by default
+//!BOOST_INTERPROCESS_CACHE_LINE_SIZE) and padded to a multiple of Alignment,
+//!so that no other object can share a cache line with it.
+//!
+//!Objects that are modified frequently by different processes (mutexes,
+//!per-process counters...) and placed next to each other in a segment suffer
+//!from false sharing. Constructing them as cache_aligned objects avoids it:
+//!
+//!\code
+//!   typedef cache_aligned<interprocess_mutex> aligned_mutex;
+//!   aligned_mutex *m = segment.construct<aligned_mutex>("mutex")();
+//!   scoped_lock<interprocess_mutex> lock(m->get());
+//!
+//!   //An array of per-process slots, each one in its own cache line
+//!   typedef cache_aligned<std::size_t> aligned_counter;
+//!   aligned_counter *slots = segment.construct<aligned_counter>("slots")[num_processes](0u);
+//!\endcode
+//!
+//!Alignments greater than the fundamental alignment require
+//!BOOST_INTERPROCESS_SEGMENT_MANAGER_ABI >= 2 (the default).
+//!
+//!cache_aligned is not copyable, as it's intended to hold process-shared objects.
+template<class T, std::size_t Alignment = BOOST_INTERPROCESS_CACHE_LINE_SIZE>
+class cache_aligned
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   BOOST_INTERPROCESS_STATIC_ASSERT((Alignment != 0u && (Alignment & (Alignment - 1u)) == 0u));
+
+   //Non-copyable
+   cache_aligned(const cache_aligned &);
+   cache_aligned &operator=(const cache_aligned &);
+
+   static const std::size_t t_alignment = ::boost::container::dtl::alignment_of<T>::value;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef T value_type;
+
+   //!The alignment of the object: the maximum of Alignment and the alignment of T
+   static const std::size_t alignment = Alignment > t_alignment ? Alignment : t_alignment;
+
+   //!The size of the stored object rounded up to a multiple of alignment
+   static const std::size_t padded_size = ((sizeof(T) - 1u)/alignment + 1u)*alignment;
+
+   #if defined(BOOST_INTERPROCESS_PERFECT_FORWARDING) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+   //!Constructs the stored T object forwarding args to its constructor.
+   template<class ...Args>
+   explicit cache_aligned(BOOST_FWD_REF(Args)... args)
+   {  ::new(this->priv_address(), boost_container_new_t()) T(::boost::forward<Args>(args)...);  }
+
+   #else
+
+   #define BOOST_INTERPROCESS_CACHE_ALIGNED_CTOR_CODE(N) \
+   BOOST_MOVE_TMPL_LT##N BOOST_MOVE_CLASS##N BOOST_MOVE_GT##N \
+   explicit cache_aligned(BOOST_MOVE_UREF##N)\
+   {  ::new(this->priv_address(), boost_container_new_t()) T(BOOST_MOVE_FWD##N);  }\
+   //
+   BOOST_MOVE_ITERATE_0TO9(BOOST_INTERPROCESS_CACHE_ALIGNED_CTOR_CODE)
+   #undef BOOST_INTERPROCESS_CACHE_ALIGNED_CTOR_CODE
+
+   #endif
+
+   //!Destroys the stored object
+   ~cache_aligned()
+   {  this->get().~T();  }
+
+   //!Returns a reference to the stored object
+   T &get()
+   {  return *static_cast<T*>(this->priv_address());  }
+
+   //!Returns a const reference to the stored object
+   const T &get() const
+   {  return *static_cast<const T*>(this->priv_address());  }
+
+   //!Returns a reference to the stored object
+   T &operator*()
+   {  return this->get();  }
+
+   //!Returns a const reference to the stored object
+   const T &operator*() const
+   {  return this->get();  }
+
+   //!Returns a pointer to the stored object
+   T *operator->()
+   {  return &this->get();  }
+
+   //!Returns a const pointer to the stored object
+   const T *operator->() const
+   {  return &this->get();  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   void *priv_address() const
+   {  return const_cast<void*>(static_cast<const void*>(&m_storage));  }
+
+   typename ::boost::container::dtl::aligned_storage<padded_size, alignment>::type m_storage;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+template<class T, std::size_t Alignment>
+const std::size_t cache_aligned<T, Alignment>::t_alignment;
+
+template<class T, std::size_t Alignment>
+const std::size_t cache_aligned<T, Alignment>::alignment;
+
+template<class T, std::size_t Alignment>
+const std::size_t cache_aligned<T, Alignment>::padded_size;
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_CACHE_ALIGNED_HPP
@@ -0,0 +1,648 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_HPP
+#define BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/interprocess_fwd.hpp>
+#include <boost/interprocess/offset_ptr.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/interprocess/detail/cast_tags.hpp>
+#include <boost/interprocess/detail/mpl.hpp>
+#include <boost/interprocess/detail/segment_base.hpp>
+#include <boost/container/detail/type_traits.hpp>  //alignment_of
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <iosfwd>
+#include <cstddef>
+
+//!\file
+//!Describes a smart pointer that stores a 32 bit offset scaled by the alignment of the pointee.
+
+namespace boost {
+namespace interprocess {
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+namespace ipcdetail {
+
+   //Offsets are scaled by the alignment of the pointee (up to
+   //BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_MAX_SCALE). Pointers to void
+   //can point to any byte so they are not scaled.
+   template<class T>
+   struct compact_offset_ptr_scale
+   {
+      static const std::size_t alignment = ::boost::container::dtl::alignment_of<T>::value;
+      static const std::size_t value = alignment < BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_MAX_SCALE
+                                     ? alignment : BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_MAX_SCALE;
+   };
+
+   template<>
+   struct compact_offset_ptr_scale<void>
+   {  static const std::size_t value = 1u;  };
+
+   template<>
+   struct compact_offset_ptr_scale<const void>
+   {  static const std::size_t value = 1u;  };
+
+   template<>
+   struct compact_offset_ptr_scale<volatile void>
+   {  static const std::size_t value = 1u;  };
+
+   template<>
+   struct compact_offset_ptr_scale<const volatile void>
+   {  static const std::size_t value = 1u;  };
+
+   //The most significant bit selects the encoding:
+   // - Set: unsigned offset from the segment base (pointees placed in the segment).
+   // - Clear: signed 31 bit offset from the address of the pointer rounded down
+   //   to Scale (used for pointees near the pointer outside the segment, e.g.
+   //   temporaries in the stack pointing to other temporaries).
+   static const boost::uint32_t compact_offset_ptr_based_bit = 0x80000000u;
+   static const boost::uint32_t compact_offset_ptr_null      = 0xFFFFFFFFu;
+
+   ////////////////////////////////////////////////////////////////////////
+   //
+   //                      compact_offset_ptr_to_raw_pointer
+   //
+   ////////////////////////////////////////////////////////////////////////
+   template<std::size_t Scale, class SegmentTag>
+   BOOST_INTERPROCESS_FORCEINLINE void * compact_offset_ptr_to_raw_pointer(const volatile void *this_ptr, boost::uint32_t offset)
+   {
+      if(offset & compact_offset_ptr_based_bit){
+         if(offset == compact_offset_ptr_null){
+            return 0;
+         }
+         return compact_offset_ptr_base<SegmentTag>::value
+            + (std::size_t(offset & ~compact_offset_ptr_based_bit) << ls_zeros<Scale>::value);
+      }
+      //Sign extend the 31 bit offset
+      const std::ptrdiff_t diff = std::ptrdiff_t(boost::int32_t(offset << 1u) / 2);
+      //Pointees in the attached segment always fit the based encoding (managed segments
+      //reject bigger segments), so only pointees outside it reach the relative encoding.
+      const uintptr_t base = reinterpret_cast<uintptr_t>(this_ptr) & ~uintptr_t(Scale - 1u);
+      return reinterpret_cast<void*>(base + (uintptr_t(diff) << ls_zeros<Scale>::value));
+   }
+
+   ////////////////////////////////////////////////////////////////////////
+   //
+   //                      compact_offset_ptr_to_offset
+   //
+   ////////////////////////////////////////////////////////////////////////
+   template<std::size_t Scale, class SegmentTag>
+   BOOST_INTERPROCESS_FORCEINLINE boost::uint32_t compact_offset_ptr_to_offset(const volatile void *ptr, const volatile void *this_ptr)
+   {
+      if(!ptr){
+         return compact_offset_ptr_null;
+      }
+      const uintptr_t uptr = reinterpret_cast<uintptr_t>(ptr);
+      //The pointee must be properly aligned
+      BOOST_ASSERT(0u == (uptr & uintptr_t(Scale - 1u)));
+      const uintptr_t seg_base = reinterpret_cast<uintptr_t>(compact_offset_ptr_base<SegmentTag>::value);
+      if(seg_base && uptr >= seg_base){
+         const uintptr_t index = (uptr - seg_base) >> ls_zeros<Scale>::value;
+         if(index < uintptr_t(compact_offset_ptr_null & ~compact_offset_ptr_based_bit)){
+            return boost::uint32_t(index) | compact_offset_ptr_based_bit;
+         }
+      }
+      //Pointees in the attached segment always fit the based encoding (managed segments
+      //reject bigger segments), so only pointees outside it reach the relative encoding.
+      const uintptr_t base = reinterpret_cast<uintptr_t>(this_ptr) & ~uintptr_t(Scale - 1u);
+      const boost::uint32_t offset = boost::uint32_t((uptr - base) >> ls_zeros<Scale>::value) & ~compact_offset_ptr_based_bit;
+      //The pointee must be in range
+      BOOST_ASSERT((compact_offset_ptr_to_raw_pointer<Scale, SegmentTag>(this_ptr, offset) == ptr));
+      return offset;
+   }
+
+   ////////////////////////////////////////////////////////////////////////
+   //
+   //                      compact_offset_ptr_to_offset_from_other
+   //
+   ////////////////////////////////////////////////////////////////////////
+   template<std::size_t Scale, class SegmentTag>
+   BOOST_INTERPROCESS_FORCEINLINE boost::uint32_t compact_offset_ptr_to_offset_from_other
+      (const volatile void *this_ptr, const volatile void *other_ptr, boost::uint32_t other_offset)
+   {
+      //Offsets from the segment base (and the null pointer) don't depend on the pointer's address
+      if(other_offset & compact_offset_ptr_based_bit){
+         return other_offset;
+      }
+      return compact_offset_ptr_to_offset<Scale, SegmentTag>
+         (compact_offset_ptr_to_raw_pointer<Scale, SegmentTag>(other_ptr, other_offset), this_ptr);
+   }
+
+}  //namespace ipcdetail {
+
+#endif   //#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+//!A smart pointer for segments mapped at different addresses in each process that
+//!stores a 31 bit offset from the beginning of the segment, counted in units of
+//!the alignment of the pointee (up to BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_MAX_SCALE,
+//!8 by default). Used as the VoidPointer of a memory algorithm (e.g.
+//!rbtree_best_fit<mutex_family, compact_offset_ptr<void> >) it propagates to
+//!allocators, node pools and containers and halves the size of the links stored
+//!in nodes in 64 bit systems, compared to offset_ptr.
+//!
+//!Pointees placed in the segment must be properly aligned and at less than
+//!2GB*scale bytes from its beginning (2GB for char or void, 16GB for types aligned
+//!to 8 bytes or more). Pointers placed outside the segment (e.g. temporaries in the
+//!stack) can also point to objects at less than 2GB*scale bytes from them, but
+//!containers using compact_offset_ptr must be placed in the segment, as their
+//!nodes can point back to the container.
+//!
+//!The segment base address is stored once per process and SegmentTag. Managed
+//!segments set it when they are created or opened, so only one segment
+//!per SegmentTag can be used at the same time in a process: creating or opening
+//!a second segment with the same tag throws interprocess_exception (already_exists_error).
+//!Use different tags to use several segments. Creating, opening or growing a
+//!segment bigger than 2GB throws interprocess_exception (size_error).
+//!
+//! \tparam PointedType The type of the pointee. It must be a complete
+//!   type when the pointer is used (but not when it's declared).
+//! \tparam SegmentTag A type that identifies the segment.
+template <class PointedType, class SegmentTag>
+class compact_offset_ptr
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   typedef compact_offset_ptr<PointedType, SegmentTag>   self_t;
+   void unspecified_bool_type_func() const {}
+   typedef void (self_t::*unspecified_bool_type)() const;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef PointedType                       element_type;
+   typedef PointedType *                     pointer;
+   typedef typename ipcdetail::
+      op_reference<PointedType>::type        reference;
+
+   typedef typename ipcdetail::
+      remove_volatile<typename ipcdetail::
+         remove_const<PointedType>::type
+            >::type                          value_type;
+   typedef std::ptrdiff_t                    difference_type;
+   typedef std::random_access_iterator_tag   iterator_category;
+   typedef boost::uint32_t                   offset_type;
+
+   public:   //Public Functions
+
+   //!Default constructor (null pointer).
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr() BOOST_NOEXCEPT
+      : m_offset(ipcdetail::compact_offset_ptr_null)
+   {}
+
+   //!Constructor from nullptr.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr(op_nullptr_t) BOOST_NOEXCEPT
+      : m_offset(ipcdetail::compact_offset_ptr_null)
+   {}
+
+   #if defined( BOOST_NO_CXX11_NULLPTR )
+   //!Constructor from nullptr. Some compilers in C++03 mode have problems with op_nullptr_t
+   //!so a helper overload is needed. Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr(int ipcdetail::op_nat::*) BOOST_NOEXCEPT
+      : m_offset(ipcdetail::compact_offset_ptr_null)
+   {}
+   #endif   //BOOST_NO_CXX11_NULLPTR
+
+   //!Constructor from raw pointer. Only takes part in overload resolution if T* is convertible to PointedType*
+   //!Never throws.
+   template <class T>
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr( T *ptr
+      #ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+             , typename ipcdetail::enable_if< ::boost::move_detail::is_convertible<T*, PointedType*> >::type * = 0
+      #endif
+      ) BOOST_NOEXCEPT
+      : m_offset(priv_to_offset(this, static_cast<PointedType*>(ptr)))
+   {}
+
+   //!Constructor from other compact_offset_ptr.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr(const compact_offset_ptr& ptr) BOOST_NOEXCEPT
+      : m_offset(ipcdetail::compact_offset_ptr_to_offset_from_other<priv_scale::value, SegmentTag>(this, &ptr, ptr.m_offset))
+   {}
+
+   //!Constructor from other compact_offset_ptr. Only takes part in overload resolution
+   //!if T2* is convertible to PointedType*. Never throws.
+   template<class T2>
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr( const compact_offset_ptr<T2, SegmentTag> &ptr
+             #ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+             , typename ipcdetail::enable_if< ::boost::move_detail::is_convertible<T2*, PointedType*> >::type * = 0
+             #endif
+             ) BOOST_NOEXCEPT
+      : m_offset(priv_to_offset(this, static_cast<PointedType*>(ptr.get())))
+   {}
+
+   #ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   //!Constructor from other compact_offset_ptr available so that static_cast<> works according to Allocator::pointer requirements:
+   //!   static_cast<pointer>(void_pointer()) + static_cast<const_pointer>(const_void_pointer())
+   template<class T2>
+   BOOST_INTERPROCESS_FORCEINLINE explicit compact_offset_ptr(const compact_offset_ptr<T2, SegmentTag> &ptr
+             , typename ipcdetail::enable_if_c< ipcdetail::is_cv_same<T2, void>::value &&
+                                                !::boost::move_detail::is_convertible<T2*, PointedType*>::value &&
+                                                ipcdetail::is_ptr_constructible<T2*, PointedType*>::value
+                                              >::type * = 0) BOOST_NOEXCEPT
+      : m_offset(priv_to_offset(this, static_cast<PointedType*>(ptr.get())))
+   {}
+
+   #endif
+
+   //!Emulates static_cast operator.
+   //!Never throws.
+   template<class T2>
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr(const compact_offset_ptr<T2, SegmentTag> & r, ipcdetail::static_cast_tag) BOOST_NOEXCEPT
+      : m_offset(priv_to_offset(this, static_cast<PointedType*>(r.get())))
+   {}
+
+   //!Emulates const_cast operator.
+   //!Never throws.
+   template<class T2>
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr(const compact_offset_ptr<T2, SegmentTag> & r, ipcdetail::const_cast_tag) BOOST_NOEXCEPT
+      : m_offset(priv_to_offset(this, const_cast<PointedType*>(r.get())))
+   {}
+
+   //!Emulates dynamic_cast operator.
+   //!Never throws.
+   template<class T2>
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr(const compact_offset_ptr<T2, SegmentTag> & r, ipcdetail::dynamic_cast_tag) BOOST_NOEXCEPT
+      : m_offset(priv_to_offset(this, dynamic_cast<PointedType*>(r.get())))
+   {}
+
+   //!Emulates reinterpret_cast operator.
+   //!Never throws.
+   template<class T2>
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr(const compact_offset_ptr<T2, SegmentTag> & r, ipcdetail::reinterpret_cast_tag) BOOST_NOEXCEPT
+      : m_offset(priv_to_offset(this, reinterpret_cast<PointedType*>(r.get())))
+   {}
+
+   //!Obtains raw pointer from offset.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE pointer get() const BOOST_NOEXCEPT
+   {
+      return static_cast<pointer>(ipcdetail::compact_offset_ptr_to_raw_pointer
+         <priv_scale::value, SegmentTag>(this, m_offset));
+   }
+
+   BOOST_INTERPROCESS_FORCEINLINE offset_type get_offset() const BOOST_NOEXCEPT
+   {  return m_offset;  }
+
+   //!Pointer-like -> operator. It can return 0 pointer.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE pointer operator->() const BOOST_NOEXCEPT
+   {  return this->get(); }
+
+   //!Dereferencing operator, if it is a null compact_offset_ptr behavior
+   //!   is undefined. Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE reference operator*() const BOOST_NOEXCEPT
+   {
+      pointer p = this->get();
+      reference r = *p;
+      return r;
+   }
+
+   //!Indexing operator.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE reference operator[](difference_type idx) const BOOST_NOEXCEPT
+   {  return this->get()[idx];  }
+
+   //!Assignment from raw pointer. Only takes part in overload resolution if T* is convertible to PointedType*
+   //!Never throws.
+   template<class T> BOOST_INTERPROCESS_FORCEINLINE
+   #ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   typename ipcdetail::enable_if_c
+      < ::boost::move_detail::is_convertible<T*, PointedType*>::value, compact_offset_ptr&>::type
+   #else
+   compact_offset_ptr&
+   #endif
+      operator= (T *ptr) BOOST_NOEXCEPT
+   {
+      m_offset = priv_to_offset(this, static_cast<PointedType*>(ptr));
+      return *this;
+   }
+
+   //!Assignment from other compact_offset_ptr.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr& operator= (const compact_offset_ptr & ptr) BOOST_NOEXCEPT
+   {
+      m_offset = ipcdetail::compact_offset_ptr_to_offset_from_other<priv_scale::value, SegmentTag>(this, &ptr, ptr.m_offset);
+      return *this;
+   }
+
+   //!Assignment from nullptr.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr& operator= (op_nullptr_t) BOOST_NOEXCEPT
+   {
+      m_offset = ipcdetail::compact_offset_ptr_null;
+      return *this;
+   }
+
+   #if defined( BOOST_NO_CXX11_NULLPTR )
+   //!Assignment from nullptr. Some compilers in C++03 mode have problems with op_nullptr_t
+   //!so a helper overload is needed. Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr& operator= (int ipcdetail::op_nat::*) BOOST_NOEXCEPT
+   {
+      m_offset = ipcdetail::compact_offset_ptr_null;
+      return *this;
+   }
+   #endif   //BOOST_NO_CXX11_NULLPTR
+
+   //!Assignment from related compact_offset_ptr.
+   //!Only takes part in overload resolution if T2* is convertible to PointedType*
+   //!Never throws.
+   template<class T2> BOOST_INTERPROCESS_FORCEINLINE
+   #ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   typename ipcdetail::enable_if_c
+      < ::boost::move_detail::is_convertible<T2*, PointedType*>::value, compact_offset_ptr&>::type
+   #else
+   compact_offset_ptr&
+   #endif
+      operator= (const compact_offset_ptr<T2, SegmentTag> &ptr) BOOST_NOEXCEPT
+   {
+      m_offset = priv_to_offset(this, static_cast<PointedType*>(ptr.get()));
+      return *this;
+   }
+
+   public:
+
+   //!compact_offset_ptr += difference_type.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr &operator+= (difference_type offset) BOOST_NOEXCEPT
+   {  this->priv_inc(offset);   return *this;  }
+
+   //!compact_offset_ptr -= difference_type.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr &operator-= (difference_type offset) BOOST_NOEXCEPT
+   {  this->priv_inc(-offset);   return *this;  }
+
+   //!++compact_offset_ptr.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr& operator++ (void) BOOST_NOEXCEPT
+   {  return *this += 1;  }
+
+   //!compact_offset_ptr++.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr operator++ (int) BOOST_NOEXCEPT
+   {
+      compact_offset_ptr tmp(*this);
+      *this += 1;
+      return tmp;
+   }
+
+   //!--compact_offset_ptr.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr& operator-- (void) BOOST_NOEXCEPT
+   {  return *this -= 1;  }
+
+   //!compact_offset_ptr--.
+   //!Never throws.
+   BOOST_INTERPROCESS_FORCEINLINE compact_offset_ptr operator-- (int) BOOST_NOEXCEPT
+   {
+      compact_offset_ptr tmp(*this);
+      *this -= 1;
+      return tmp;
+   }
+
+   //!safe bool conversion operator.
+   //!Never throws.
+   #if defined(BOOST_NO_CXX11_EXPLICIT_CONVERSION_OPERATORS)
+   BOOST_INTERPROCESS_FORCEINLINE operator unspecified_bool_type() const BOOST_NOEXCEPT
+   {  return m_offset != ipcdetail::compact_offset_ptr_null ? &self_t::unspecified_bool_type_func : 0;   }
+   #else
+   explicit operator bool() const BOOST_NOEXCEPT
+   {  return m_offset != ipcdetail::compact_offset_ptr_null;  }
+   #endif
+
+   //!Not operator. Not needed in theory, but improves portability.
+   //!Never throws
+   BOOST_INTERPROCESS_FORCEINLINE bool operator! () const BOOST_NOEXCEPT
+   {  return m_offset == ipcdetail::compact_offset_ptr_null;   }
+
+   //!Compatibility with pointer_traits
+   //!
+   #if defined(BOOST_NO_CXX11_TEMPLATE_ALIASES)
+   template <class U>
+   struct rebind
+   {  typedef compact_offset_ptr<U, SegmentTag> other;  };
+   #else
+   template <class U>
+   using rebind = compact_offset_ptr<U, SegmentTag>;
+   #ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   typedef compact_offset_ptr<PointedType, SegmentTag> other;
+   #endif //BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   #endif
+
+   //!Compatibility with pointer_traits
+   //!
+   BOOST_INTERPROCESS_FORCEINLINE static compact_offset_ptr pointer_to(typename ipcdetail::op_reference<PointedType>::type r) BOOST_NOEXCEPT
+   { return compact_offset_ptr(&r); }
+
+   //!difference_type + compact_offset_ptr
+   //!operation
+   BOOST_INTERPROCESS_FORCEINLINE friend compact_offset_ptr operator+(difference_type diff, compact_offset_ptr right) BOOST_NOEXCEPT
+   {  right += diff;  return right;  }
+
+   //!compact_offset_ptr + difference_type
+   //!operation
+   BOOST_INTERPROCESS_FORCEINLINE friend compact_offset_ptr operator+(compact_offset_ptr left, difference_type diff) BOOST_NOEXCEPT
+   {  left += diff;  return left; }
+
+   //!compact_offset_ptr - diff
+   //!operation
+   BOOST_INTERPROCESS_FORCEINLINE friend compact_offset_ptr operator-(compact_offset_ptr left, difference_type diff) BOOST_NOEXCEPT
+   {  left -= diff;  return left; }
+
+   //!compact_offset_ptr - diff
+   //!operation
+   BOOST_INTERPROCESS_FORCEINLINE friend compact_offset_ptr operator-(difference_type diff, compact_offset_ptr right) BOOST_NOEXCEPT
+   {  right -= diff; return right; }
+
+   //!compact_offset_ptr - compact_offset_ptr
+   //!operation
+   BOOST_INTERPROCESS_FORCEINLINE friend difference_type operator-(const compact_offset_ptr &pt, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return difference_type(pt.get()- pt2.get());   }
+
+   //Comparison
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator== (const compact_offset_ptr &pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1.get() == pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator!= (const compact_offset_ptr &pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1.get() != pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator<(const compact_offset_ptr &pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1.get() < pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator<=(const compact_offset_ptr &pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1.get() <= pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator>(const compact_offset_ptr &pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1.get() > pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator>=(const compact_offset_ptr &pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1.get() >= pt2.get();  }
+
+   //Comparison to raw ptr to support literal 0
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator== (pointer pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1 == pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator!= (pointer pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1 != pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator<(pointer pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1 < pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator<=(pointer pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1 <= pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator>(pointer pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1 > pt2.get();  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator>=(pointer pt1, const compact_offset_ptr &pt2) BOOST_NOEXCEPT
+   {  return pt1 >= pt2.get();  }
+
+   //Comparison
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator== (const compact_offset_ptr &pt1, pointer pt2) BOOST_NOEXCEPT
+   {  return pt1.get() == pt2;  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator!= (const compact_offset_ptr &pt1, pointer pt2) BOOST_NOEXCEPT
+   {  return pt1.get() != pt2;  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator<(const compact_offset_ptr &pt1, pointer pt2) BOOST_NOEXCEPT
+   {  return pt1.get() < pt2;  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator<=(const compact_offset_ptr &pt1, pointer pt2) BOOST_NOEXCEPT
+   {  return pt1.get() <= pt2;  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator>(const compact_offset_ptr &pt1, pointer pt2) BOOST_NOEXCEPT
+   {  return pt1.get() > pt2;  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend bool operator>=(const compact_offset_ptr &pt1, pointer pt2) BOOST_NOEXCEPT
+   {  return pt1.get() >= pt2;  }
+
+   BOOST_INTERPROCESS_FORCEINLINE friend void swap(compact_offset_ptr &left, compact_offset_ptr &right) BOOST_NOEXCEPT
+   {
+      pointer ptr = right.get();
+      right = left;
+      left = ptr;
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   typedef ipcdetail::compact_offset_ptr_scale<PointedType> priv_scale;
+
+   BOOST_INTERPROCESS_FORCEINLINE static offset_type priv_to_offset(const volatile void *this_ptr, const volatile void *ptr) BOOST_NOEXCEPT
+   {  return ipcdetail::compact_offset_ptr_to_offset<priv_scale::value, SegmentTag>(ptr, this_ptr);  }
+
+   BOOST_INTERPROCESS_FORCEINLINE void priv_inc(difference_type n) BOOST_NOEXCEPT
+   {  m_offset = priv_to_offset(this, this->get() + n);  }
+
+   offset_type m_offset;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+//!operator<<
+//!for compact offset ptr
+template<class E, class T, class W, class S>
+inline std::basic_ostream<E, T> & operator<<
+   (std::basic_ostream<E, T> & os, compact_offset_ptr<W, S> const & p)
+{  return os << p.get_offset();   }
+
+//!Simulation of static_cast between pointers. Never throws.
+template<class T1, class S, class T2>
+BOOST_INTERPROCESS_FORCEINLINE boost::interprocess::compact_offset_ptr<T1, S>
+   static_pointer_cast(const boost::interprocess::compact_offset_ptr<T2, S> & r) BOOST_NOEXCEPT
+{
+   return boost::interprocess::compact_offset_ptr<T1, S>
+            (r, boost::interprocess::ipcdetail::static_cast_tag());
+}
+
+//!Simulation of const_cast between pointers. Never throws.
+template<class T1, class S, class T2>
+BOOST_INTERPROCESS_FORCEINLINE boost::interprocess::compact_offset_ptr<T1, S>
+   const_pointer_cast(const boost::interprocess::compact_offset_ptr<T2, S> & r) BOOST_NOEXCEPT
+{
+   return boost::interprocess::compact_offset_ptr<T1, S>
+            (r, boost::interprocess::ipcdetail::const_cast_tag());
+}
+
+//!Simulation of dynamic_cast between pointers. Never throws.
+template<class T1, class S, class T2>
+BOOST_INTERPROCESS_FORCEINLINE boost::interprocess::compact_offset_ptr<T1, S>
+   dynamic_pointer_cast(const boost::interprocess::compact_offset_ptr<T2, S> & r) BOOST_NOEXCEPT
+{
+   return boost::interprocess::compact_offset_ptr<T1, S>
+            (r, boost::interprocess::ipcdetail::dynamic_cast_tag());
+}
+
+//!Simulation of reinterpret_cast between pointers. Never throws.
+template<class T1, class S, class T2>
+BOOST_INTERPROCESS_FORCEINLINE boost::interprocess::compact_offset_ptr<T1, S>
+   reinterpret_pointer_cast(const boost::interprocess::compact_offset_ptr<T2, S> & r) BOOST_NOEXCEPT
+{
+   return boost::interprocess::compact_offset_ptr<T1, S>
+            (r, boost::interprocess::ipcdetail::reinterpret_cast_tag());
+}
+
+}  //namespace interprocess {
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+///has_trivial_destructor<> == true_type specialization for optimizations
+template <class T, class S>
+struct has_trivial_destructor< ::boost::interprocess::compact_offset_ptr<T, S> >
+{
+   static const bool value = true;
+};
+
+namespace move_detail {
+
+///has_trivial_destructor<> == true_type specialization for optimizations
+template <class T, class S>
+struct is_trivially_destructible< ::boost::interprocess::compact_offset_ptr<T, S> >
+{
+   static const bool value = true;
+};
+
+}  //namespace move_detail {
+
+namespace interprocess {
+
+//!to_raw_pointer() enables boost::mem_fn to recognize compact_offset_ptr.
+//!Never throws.
+template <class T, class S>
+BOOST_INTERPROCESS_FORCEINLINE T * to_raw_pointer(boost::interprocess::compact_offset_ptr<T, S> const & p) BOOST_NOEXCEPT
+{  return ipcdetail::to_raw_pointer(p);   }
+
+}  //namespace interprocess
+
+//Backwards compatibility with pointer_to_other
+template <class PointedType, class SegmentTag, class U>
+struct pointer_to_other
+   < ::boost::interprocess::compact_offset_ptr<PointedType, SegmentTag>, U >
+{
+   typedef ::boost::interprocess::compact_offset_ptr<U, SegmentTag> type;
+};
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif //#ifndef BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_HPP
@@ -0,0 +1,807 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_CONTAINERS_BPLUS_TREE_MAP_HPP
+#define BOOST_INTERPROCESS_CONTAINERS_BPLUS_TREE_MAP_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/container/detail/placement_new.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/move/detail/type_traits.hpp>
+#include <boost/move/detail/iterator_traits.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+//!\file
+//!Describes bplus_tree_map, an ordered map for managed segments whose nodes
+//!are memory pages.
+
+namespace boost {
+namespace interprocess {
+
+//!An ordered map of unique keys implemented as a B+tree whose nodes are
+//!PageSize bytes long and PageSize aligned, allocated from the segment
+//!manager with allocate_aligned().
+//!
+//!Compared to map, which allocates a node with three offset pointers per
+//!element, leaves store hundreds of elements in contiguous memory, so lookups
+//!touch one page per level and range scans, which follow the linked list of
+//!leaves, touch one page per leaf. This improves the locality when the segment
+//!is a partially resident mapped file. Elements can be bulk loaded from
+//!sorted input, filling leaves completely.
+//!
+//!Key and T must be trivially copyable, default constructible and trivially
+//!destructible. Elements are moved when nodes are split or modified, so
+//!insertions and erasures invalidate iterators.
+//!
+//!Leaves are released when they become empty and nodes are not merged,
+//!which keeps erasure cheap and the tree valid, but leaves can remain sparse
+//!after many erasures.
+//!
+//!As other containers, the map must be protected by a mutex if several
+//!threads or processes modify it. It is constructed from the segment
+//!manager, so it can be used with find_or_construct:
+//!
+//!\code
+//!   typedef bplus_tree_map<int, double, managed_mapped_file::segment_manager> map_t;
+//!   map_t *m = file.find_or_construct<map_t>("map")(file.get_segment_manager());
+//!\endcode
+template< class Key, class T, class SegmentManager
+        , class Compare = std::less<Key>
+        , std::size_t PageSize = 4096u>
+class bplus_tree_map
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   BOOST_INTERPROCESS_STATIC_ASSERT((PageSize != 0u && (PageSize & (PageSize - 1u)) == 0u));
+   BOOST_INTERPROCESS_STATIC_ASSERT((boost::move_detail::is_trivially_copy_constructible<Key>::value &&
+                                     boost::move_detail::is_trivially_destructible<Key>::value));
+   BOOST_INTERPROCESS_STATIC_ASSERT((boost::move_detail::is_trivially_copy_constructible<T>::value &&
+                                     boost::move_detail::is_trivially_destructible<T>::value));
+
+   //Non-copyable
+   bplus_tree_map(const bplus_tree_map &);
+   bplus_tree_map &operator=(const bplus_tree_map &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef Key                                  key_type;
+   typedef T                                    mapped_type;
+   typedef Compare                              key_compare;
+   typedef SegmentManager                       segment_manager;
+   typedef std::size_t                          size_type;
+   typedef std::ptrdiff_t                       difference_type;
+
+   //!The element stored in the leaves. The key must not be modified.
+   struct value_type
+   {
+      key_type    first;
+      mapped_type second;
+   };
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   typedef typename SegmentManager::void_pointer                     void_pointer;
+   typedef typename boost::intrusive::pointer_traits
+      <void_pointer>::template rebind_pointer<SegmentManager>::type  segment_manager_ptr;
+
+   struct node
+   {
+      boost::uint16_t level;  //Zero for leaves
+      boost::uint16_t count;  //Elements of a leaf or keys of an inner node
+   };
+
+   typedef typename boost::intrusive::pointer_traits
+      <void_pointer>::template rebind_pointer<node>::type            node_ptr;
+
+   struct leaf_header : node
+   {
+      node_ptr prev;
+      node_ptr next;
+   };
+
+   static const std::size_t value_align = ::boost::container::dtl::alignment_of<value_type>::value;
+   static const std::size_t key_align   = ::boost::container::dtl::alignment_of<Key>::value;
+   static const std::size_t ptr_align   = ::boost::container::dtl::alignment_of<node_ptr>::value;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Maximum number of elements of a leaf
+   static const size_type leaf_capacity =
+      (PageSize - sizeof(leaf_header) - value_align)/sizeof(value_type);
+
+   //!Maximum number of keys of an inner node
+   static const size_type inner_capacity =
+      (PageSize - sizeof(node) - key_align - ptr_align - sizeof(node_ptr))/(sizeof(Key) + sizeof(node_ptr));
+
+   //!Size and alignment of nodes
+   static const size_type page_size = PageSize;
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   BOOST_INTERPROCESS_STATIC_ASSERT((leaf_capacity >= 2u && leaf_capacity < 65536u));
+   BOOST_INTERPROCESS_STATIC_ASSERT((inner_capacity >= 2u && inner_capacity < 65536u));
+
+   struct leaf : leaf_header
+   {
+      value_type values[leaf_capacity];
+   };
+
+   struct inner : node
+   {
+      Key      keys[inner_capacity];
+      node_ptr children[inner_capacity + 1u];
+   };
+
+   BOOST_INTERPROCESS_STATIC_ASSERT((sizeof(leaf) <= PageSize && sizeof(inner) <= PageSize));
+
+   //Inner nodes split when full, so the height is logarithmic
+   static const std::size_t max_depth = 48u;
+
+   struct path_entry
+   {
+      inner       *n;
+      std::size_t idx;
+   };
+
+   //Pages needed by an insertion are allocated before the
+   //tree is modified, so that allocation failures leave it unchanged
+   class page_reservation
+   {
+      public:
+      explicit page_reservation(SegmentManager *segment_mngr)
+         : mp_segment_mngr(segment_mngr), m_n(0u)
+      {}
+
+      void reserve(std::size_t n)
+      {
+         for(; m_n != n; ++m_n){
+            m_pages[m_n] = mp_segment_mngr->allocate_aligned(PageSize, PageSize);
+         }
+      }
+
+      void *get()
+      {
+         BOOST_ASSERT(m_n != 0u);
+         return m_pages[--m_n];
+      }
+
+      ~page_reservation()
+      {
+         while(m_n){
+            mp_segment_mngr->deallocate(m_pages[--m_n]);
+         }
+      }
+
+      private:
+      SegmentManager *mp_segment_mngr;
+      void *m_pages[max_depth + 2u];
+      std::size_t m_n;
+   };
+
+   template<bool IsConst>
+   class iterator_impl
+   {
+      typedef typename bplus_tree_map::value_type        map_value_type;
+      typedef typename boost::move_detail::if_c
+         <IsConst, const map_value_type, map_value_type>::type   qualified_value_type;
+
+      public:
+      typedef std::bidirectional_iterator_tag   iterator_category;
+      typedef map_value_type                    value_type;
+      typedef std::ptrdiff_t                    difference_type;
+      typedef qualified_value_type*             pointer;
+      typedef qualified_value_type&             reference;
+
+      iterator_impl()
+         : mp_leaf(), m_idx()
+      {}
+
+      iterator_impl(const iterator_impl<false> &other)
+         : mp_leaf(other.mp_leaf), m_idx(other.m_idx)
+      {}
+
+      iterator_impl &operator=(const iterator_impl<false> &other)
+      {
+         mp_leaf = other.mp_leaf;
+         m_idx = other.m_idx;
+         return *this;
+      }
+
+      reference operator*() const
+      {  return mp_leaf->values[m_idx];  }
+
+      pointer operator->() const
+      {  return &mp_leaf->values[m_idx];  }
+
+      iterator_impl &operator++()
+      {
+         if(++m_idx == mp_leaf->count && mp_leaf->next){
+            mp_leaf = static_cast<leaf*>(ipcdetail::to_raw_pointer(mp_leaf->next));
+            m_idx = 0u;
+         }
+         return *this;
+      }
+
+      iterator_impl operator++(int)
+      {  iterator_impl tmp(*this); ++*this; return tmp;  }
+
+      iterator_impl &operator--()
+      {
+         if(m_idx == 0u){
+            mp_leaf = static_cast<leaf*>(ipcdetail::to_raw_pointer(mp_leaf->prev));
+            m_idx = mp_leaf->count;
+         }
+         --m_idx;
+         return *this;
+      }
+
+      iterator_impl operator--(int)
+      {  iterator_impl tmp(*this); --*this; return tmp;  }
+
+      friend bool operator==(const iterator_impl &a, const iterator_impl &b)
+      {  return a.mp_leaf == b.mp_leaf && a.m_idx == b.m_idx;  }
+
+      friend bool operator!=(const iterator_impl &a, const iterator_impl &b)
+      {  return !(a == b);  }
+
+      private:
+      friend class bplus_tree_map;
+      friend class iterator_impl<!IsConst>;
+
+      iterator_impl(leaf *l, std::size_t idx)
+         : mp_leaf(l), m_idx(idx)
+      {}
+
+      leaf        *mp_leaf;
+      std::size_t m_idx;
+   };
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Bidirectional iterator to value_type
+   typedef iterator_impl<false>  iterator;
+   //!Bidirectional iterator to const value_type
+   typedef iterator_impl<true>   const_iterator;
+
+   //!Constructs an empty map whose nodes are allocated from "segment_mngr".
+   //!Throws if the allocation of the root leaf throws.
+   explicit bplus_tree_map(SegmentManager *segment_mngr, const key_compare &comp = key_compare())
+      : mp_segment_mngr(segment_mngr), m_root(), m_first(), m_last(), m_size(0u), m_num_pages(0u), m_comp(comp)
+   {
+      leaf *const l = this->priv_new_leaf(segment_mngr->allocate_aligned(PageSize, PageSize));
+      m_root = m_first = m_last = l;
+   }
+
+   //!Deallocates all nodes.
+   ~bplus_tree_map()
+   {  this->priv_destroy(ipcdetail::to_raw_pointer(m_root), 0);  }
+
+   //!Returns an iterator to the first element. Never throws.
+   iterator begin()
+   {  return iterator(this->priv_first(), 0u);  }
+
+   //!Returns a const iterator to the first element. Never throws.
+   const_iterator begin() const
+   {  return const_iterator(this->priv_first(), 0u);  }
+
+   //!Returns an iterator to the end of the map. Never throws.
+   iterator end()
+   {  return iterator(this->priv_last(), this->priv_last()->count);  }
+
+   //!Returns a const iterator to the end of the map. Never throws.
+   const_iterator end() const
+   {  return const_iterator(this->priv_last(), this->priv_last()->count);  }
+
+   //!Returns the number of elements. Never throws.
+   size_type size() const
+   {  return m_size;  }
+
+   //!Returns true if the map has no elements. Never throws.
+   bool empty() const
+   {  return m_size == 0u;  }
+
+   //!Returns the number of levels of the tree, 1 if the root is a leaf. Never throws.
+   size_type height() const
+   {  return size_type(m_root->level) + 1u;  }
+
+   //!Returns the number of allocated nodes. Never throws.
+   size_type page_count() const
+   {  return m_num_pages;  }
+
+   //!Returns a copy of the comparison function object.
+   key_compare key_comp() const
+   {  return m_comp;  }
+
+   //!Returns a pointer to the segment manager. Never throws.
+   SegmentManager *get_segment_manager() const
+   {  return ipcdetail::to_raw_pointer(mp_segment_mngr);  }
+
+   //!Inserts a copy of the key and the value if the key is not present.
+   //!Returns an iterator to the element with key "k" and true if the element was inserted.
+   //!Throws if the comparison function or the allocation of a node throws,
+   //!the map is unchanged in that case.
+   std::pair<iterator, bool> insert(const key_type &k, const mapped_type &v)
+   {
+      path_entry path[max_depth];
+      std::size_t depth;
+      leaf *const l = this->priv_descend(k, path, depth);
+      const std::size_t i = this->priv_lower_bound(l, k);
+      if(i != l->count && !m_comp(k, l->values[i].first)){
+         return std::pair<iterator, bool>(iterator(l, i), false);
+      }
+      return std::pair<iterator, bool>(this->priv_insert_at(l, i, k, v, path, depth), true);
+   }
+
+   //!Inserts a copy of the key and the value if the key is not present,
+   //!otherwise assigns v to the mapped value.
+   //!Returns true if the element was inserted.
+   //!Throws if the comparison function or the allocation of a node throws,
+   //!the map is unchanged in that case.
+   bool insert_or_assign(const key_type &k, const mapped_type &v)
+   {
+      const std::pair<iterator, bool> r = this->insert(k, v);
+      if(!r.second){
+         r.first->second = v;
+      }
+      return r.second;
+   }
+
+   //!Appends the elements of the sorted range [first, last), whose
+   //!keys must be greater than the keys of all elements of the map, e.g. to
+   //!load an empty map. Elements must have "first" and "second" members.
+   //!Leaves and inner nodes are filled completely, which is faster than
+   //!inserting elements one by one and uses fewer pages.
+   //!Throws if the allocation of a node throws,
+   //!the elements inserted before the exception remain in the map.
+   template<class InputIterator>
+   void bulk_load(InputIterator first, InputIterator last)
+   {
+      path_entry path[max_depth];
+      for(; first != last; ++first){
+         //Descend through the rightmost path
+         std::size_t depth = 0u;
+         node *n = ipcdetail::to_raw_pointer(m_root);
+         while(n->level){
+            inner *const in = static_cast<inner*>(n);
+            path[depth].n = in;
+            path[depth].idx = in->count;
+            ++depth;
+            n = ipcdetail::to_raw_pointer(in->children[in->count]);
+         }
+         leaf *const l = static_cast<leaf*>(n);
+         BOOST_ASSERT(m_size == 0u || m_comp(this->priv_last()->values[this->priv_last()->count - 1u].first, first->first));
+         this->priv_insert_at(l, l->count, first->first, first->second, path, depth);
+      }
+   }
+
+   //!Returns an iterator to the element with key k, or end() if not found.
+   //!Throws if the comparison function throws.
+   iterator find(const key_type &k)
+   {
+      const const_iterator it = static_cast<const bplus_tree_map&>(*this).find(k);
+      return iterator(it.mp_leaf, it.m_idx);
+   }
+
+   //!Returns a const iterator to the element with key k, or end() if not found.
+   //!Throws if the comparison function throws.
+   const_iterator find(const key_type &k) const
+   {
+      leaf *const l = this->priv_descend(k);
+      const std::size_t i = this->priv_lower_bound(l, k);
+      if(i == l->count || m_comp(k, l->values[i].first))
+         return this->end();
+      return const_iterator(l, i);
+   }
+
+   //!Returns true if the key is present. Throws if the comparison function throws.
+   bool contains(const key_type &k) const
+   {  return this->find(k) != this->end();  }
+
+   //!Returns the number of elements with key k (0 or 1).
+   //!Throws if the comparison function throws.
+   size_type count(const key_type &k) const
+   {  return this->contains(k) ? 1u : 0u;  }
+
+   //!Returns an iterator to the first element whose key is not less than k.
+   //!Throws if the comparison function throws.
+   iterator lower_bound(const key_type &k)
+   {
+      const const_iterator it = static_cast<const bplus_tree_map&>(*this).lower_bound(k);
+      return iterator(it.mp_leaf, it.m_idx);
+   }
+
+   //!Returns a const iterator to the first element whose key is not less than k.
+   //!Throws if the comparison function throws.
+   const_iterator lower_bound(const key_type &k) const
+   {
+      leaf *const l = this->priv_descend(k);
+      return this->priv_normalize(l, this->priv_lower_bound(l, k));
+   }
+
+   //!Returns an iterator to the first element whose key is greater than k.
+   //!Throws if the comparison function throws.
+   iterator upper_bound(const key_type &k)
+   {
+      const const_iterator it = static_cast<const bplus_tree_map&>(*this).upper_bound(k);
+      return iterator(it.mp_leaf, it.m_idx);
+   }
+
+   //!Returns a const iterator to the first element whose key is greater than k.
+   //!Throws if the comparison function throws.
+   const_iterator upper_bound(const key_type &k) const
+   {
+      leaf *const l = this->priv_descend(k);
+      std::size_t i = this->priv_lower_bound(l, k);
+      if(i != l->count && !m_comp(k, l->values[i].first)){
+         ++i;
+      }
+      return this->priv_normalize(l, i);
+   }
+
+   //!Erases the element with key k. Returns the number of erased elements.
+   //!Throws if the comparison function throws.
+   size_type erase(const key_type &k)
+   {
+      path_entry path[max_depth];
+      std::size_t depth;
+      leaf *const l = this->priv_descend(k, path, depth);
+      const std::size_t i = this->priv_lower_bound(l, k);
+      if(i == l->count || m_comp(k, l->values[i].first))
+         return 0u;
+      for(std::size_t j = i + 1u; j != l->count; ++j){
+         l->values[j - 1u] = l->values[j];
+      }
+      --l->count;
+      --m_size;
+      if(l->count == 0u && static_cast<node*>(l) != ipcdetail::to_raw_pointer(m_root)){
+         this->priv_remove_leaf(l, path, depth);
+      }
+      return 1u;
+   }
+
+   //!Erases all elements and deallocates all nodes but one leaf. Never throws.
+   void clear()
+   {
+      leaf *const keep = this->priv_first();
+      this->priv_destroy(ipcdetail::to_raw_pointer(m_root), keep);
+      keep->count = 0u;
+      keep->prev = keep->next = node_ptr();
+      m_root = m_first = m_last = keep;
+      m_size = 0u;
+      m_num_pages = 1u;
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   leaf *priv_first() const
+   {  return static_cast<leaf*>(ipcdetail::to_raw_pointer(m_first));  }
+
+   leaf *priv_last() const
+   {  return static_cast<leaf*>(ipcdetail::to_raw_pointer(m_last));  }
+
+   leaf *priv_new_leaf(void *mem)
+   {
+      leaf *const l = ::new(mem, boost_container_new_t()) leaf;
+      l->level = 0u;
+      l->count = 0u;
+      ++m_num_pages;
+      return l;
+   }
+
+   inner *priv_new_inner(void *mem, std::size_t level)
+   {
+      inner *const in = ::new(mem, boost_container_new_t()) inner;
+      in->level = static_cast<boost::uint16_t>(level);
+      in->count = 0u;
+      ++m_num_pages;
+      return in;
+   }
+
+   void priv_free(node *n)
+   {
+      mp_segment_mngr->deallocate(n);
+      --m_num_pages;
+   }
+
+   //Deallocates the subtree rooted at n, except the node "keep"
+   void priv_destroy(node *n, node *keep)
+   {
+      if(n->level){
+         inner *const in = static_cast<inner*>(n);
+         for(std::size_t i = 0; i != std::size_t(in->count) + 1u; ++i){
+            this->priv_destroy(ipcdetail::to_raw_pointer(in->children[i]), keep);
+         }
+      }
+      if(n != keep){
+         this->priv_free(n);
+      }
+   }
+
+   //Index of the child of "in" whose subtree can hold k
+   std::size_t priv_child_index(const inner *in, const key_type &k) const
+   {
+      std::size_t lo = 0u, hi = in->count;
+      while(lo < hi){
+         const std::size_t mid = (lo + hi)/2u;
+         if(m_comp(k, in->keys[mid])){
+            hi = mid;
+         }
+         else{
+            lo = mid + 1u;
+         }
+      }
+      return lo;
+   }
+
+   std::size_t priv_lower_bound(const leaf *l, const key_type &k) const
+   {
+      std::size_t lo = 0u, hi = l->count;
+      while(lo < hi){
+         const std::size_t mid = (lo + hi)/2u;
+         if(m_comp(l->values[mid].first, k)){
+            lo = mid + 1u;
+         }
+         else{
+            hi = mid;
+         }
+      }
+      return lo;
+   }
+
+   leaf *priv_descend(const key_type &k) const
+   {
+      node *n = ipcdetail::to_raw_pointer(m_root);
+      while(n->level){
+         const inner *const in = static_cast<inner*>(n);
+         n = ipcdetail::to_raw_pointer(in->children[this->priv_child_index(in, k)]);
+      }
+      return static_cast<leaf*>(n);
+   }
+
+   leaf *priv_descend(const key_type &k, path_entry *path, std::size_t &depth) const
+   {
+      depth = 0u;
+      node *n = ipcdetail::to_raw_pointer(m_root);
+      while(n->level){
+         BOOST_ASSERT(depth < max_depth);
+         inner *const in = static_cast<inner*>(n);
+         path[depth].n = in;
+         path[depth].idx = this->priv_child_index(in, k);
+         n = ipcdetail::to_raw_pointer(in->children[path[depth].idx]);
+         ++depth;
+      }
+      return static_cast<leaf*>(n);
+   }
+
+   //The position after the last element of a leaf is the first one of the next leaf
+   const_iterator priv_normalize(leaf *l, std::size_t i) const
+   {
+      if(i == l->count && l->next){
+         return const_iterator(static_cast<leaf*>(ipcdetail::to_raw_pointer(l->next)), 0u);
+      }
+      return const_iterator(l, i);
+   }
+
+   iterator priv_insert_at( leaf *l, std::size_t i, const key_type &k, const mapped_type &v
+                          , path_entry *path, std::size_t depth)
+   {
+      if(l->count != leaf_capacity){
+         this->priv_leaf_insert(l, i, k, v);
+         ++m_size;
+         return iterator(l, i);
+      }
+
+      //A new leaf, a new node for each full ancestor, and a new root if all are full
+      std::size_t needed = 1u;
+      std::size_t d = depth;
+      while(d && path[d - 1u].n->count == inner_capacity){
+         ++needed;
+         --d;
+      }
+      if(d == 0u){
+         ++needed;
+      }
+      page_reservation pages(this->get_segment_manager());
+      pages.reserve(needed);
+
+      //Appending to the last leaf leaves it full, so sorted
+      //insertions fill leaves completely
+      const bool append = l == this->priv_last() && i == l->count;
+      const std::size_t mid = append ? std::size_t(l->count) : std::size_t(l->count)/2u;
+      leaf *const r = this->priv_new_leaf(pages.get());
+      for(std::size_t j = mid; j != l->count; ++j){
+         r->values[j - mid] = l->values[j];
+      }
+      r->count = static_cast<boost::uint16_t>(l->count - mid);
+      l->count = static_cast<boost::uint16_t>(mid);
+      r->prev = l;
+      r->next = l->next;
+      if(l->next){
+         static_cast<leaf*>(ipcdetail::to_raw_pointer(l->next))->prev = r;
+      }
+      else{
+         m_last = r;
+      }
+      l->next = r;
+
+      iterator ret;
+      if(i < mid || (i == mid && !append)){
+         this->priv_leaf_insert(l, i, k, v);
+         ret = iterator(l, i);
+      }
+      else{
+         this->priv_leaf_insert(r, i - mid, k, v);
+         ret = iterator(r, i - mid);
+      }
+      ++m_size;
+      this->priv_insert_in_parent(r->values[0].first, r, path, depth, pages);
+      return ret;
+   }
+
+   static void priv_leaf_insert(leaf *l, std::size_t i, const key_type &k, const mapped_type &v)
+   {
+      for(std::size_t j = l->count; j != i; --j){
+         l->values[j] = l->values[j - 1u];
+      }
+      value_type &val = l->values[i];
+      val.first  = k;
+      val.second = v;
+      ++l->count;
+   }
+
+   //Inserts the separator "k" and the node "right", placed after the
+   //child path[depth-1].idx of the parent, splitting full ancestors
+   void priv_insert_in_parent(key_type k, node *right, path_entry *path, std::size_t depth, page_reservation &pages)
+   {
+      while(depth){
+         inner *const p = path[depth - 1u].n;
+         const std::size_t idx = path[depth - 1u].idx;
+         const std::size_t cnt = p->count;
+         if(cnt != inner_capacity){
+            for(std::size_t j = cnt; j != idx; --j){
+               p->keys[j] = p->keys[j - 1u];
+               p->children[j + 1u] = p->children[j];
+            }
+            p->keys[idx] = k;
+            p->children[idx + 1u] = right;
+            ++p->count;
+            return;
+         }
+
+         //Split the full node merging the new separator in temporary arrays.
+         //Separators appended to the rightmost position keep the node full.
+         Key   tk[inner_capacity + 1u];
+         node *tc[inner_capacity + 2u];
+         for(std::size_t j = 0, s = 0; j != cnt + 1u; ++j){
+            if(j == idx){
+               tk[j] = k;
+            }
+            else{
+               tk[j] = p->keys[s++];
+            }
+         }
+         for(std::size_t j = 0, s = 0; j != cnt + 2u; ++j){
+            if(j == idx + 1u){
+               tc[j] = right;
+            }
+            else{
+               tc[j] = ipcdetail::to_raw_pointer(p->children[s++]);
+            }
+         }
+         const std::size_t mid = idx == cnt ? cnt : (cnt + 1u)/2u;
+         inner *const q = this->priv_new_inner(pages.get(), p->level);
+         for(std::size_t j = 0; j != mid; ++j){
+            p->keys[j] = tk[j];
+            p->children[j] = tc[j];
+         }
+         p->children[mid] = tc[mid];
+         p->count = static_cast<boost::uint16_t>(mid);
+         for(std::size_t j = mid + 1u; j != cnt + 1u; ++j){
+            q->keys[j - mid - 1u] = tk[j];
+            q->children[j - mid - 1u] = tc[j];
+         }
+         q->children[cnt - mid] = tc[cnt + 1u];
+         q->count = static_cast<boost::uint16_t>(cnt - mid);
+         k = tk[mid];
+         right = q;
+         --depth;
+      }
+
+      //The root was split
+      node *const old_root = ipcdetail::to_raw_pointer(m_root);
+      inner *const root = this->priv_new_inner(pages.get(), std::size_t(old_root->level) + 1u);
+      root->keys[0] = k;
+      root->children[0] = old_root;
+      root->children[1] = right;
+      root->count = 1u;
+      m_root = root;
+   }
+
+   //Removes an empty leaf and the ancestors left without children
+   void priv_remove_leaf(leaf *l, path_entry *path, std::size_t depth)
+   {
+      leaf *const prev = static_cast<leaf*>(ipcdetail::to_raw_pointer(l->prev));
+      leaf *const next = static_cast<leaf*>(ipcdetail::to_raw_pointer(l->next));
+      if(prev){
+         prev->next = next;
+      }
+      else{
+         m_first = next;
+      }
+      if(next){
+         next->prev = prev;
+      }
+      else{
+         m_last = prev;
+      }
+      this->priv_free(l);
+
+      //The root has at least two children, so a node with more than one child is found
+      while(depth){
+         inner *const p = path[depth - 1u].n;
+         if(p->count == 0u){
+            this->priv_free(p);
+            --depth;
+            continue;
+         }
+         //The separator that precedes the child, or the following one for the first child
+         const std::size_t idx = path[depth - 1u].idx;
+         const std::size_t kidx = idx ? idx - 1u : 0u;
+         for(std::size_t j = kidx + 1u; j != p->count; ++j){
+            p->keys[j - 1u] = p->keys[j];
+         }
+         for(std::size_t j = idx + 1u; j != std::size_t(p->count) + 1u; ++j){
+            p->children[j - 1u] = p->children[j];
+         }
+         --p->count;
+         break;
+      }
+
+      //Remove roots with a single child
+      node *root = ipcdetail::to_raw_pointer(m_root);
+      while(root->level && root->count == 0u){
+         node *const child = ipcdetail::to_raw_pointer(static_cast<inner*>(root)->children[0]);
+         this->priv_free(root);
+         root = child;
+      }
+      m_root = root;
+   }
+
+   segment_manager_ptr  mp_segment_mngr;
+   node_ptr             m_root;
+   node_ptr             m_first;
+   node_ptr             m_last;
+   size_type            m_size;
+   size_type            m_num_pages;
+   key_compare          m_comp;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_CONTAINERS_BPLUS_TREE_MAP_HPP
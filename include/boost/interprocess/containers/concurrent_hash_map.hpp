@@ -0,0 +1,643 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_CONTAINERS_CONCURRENT_HASH_MAP_HPP
+#define BOOST_INTERPROCESS_CONTAINERS_CONCURRENT_HASH_MAP_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/cache_aligned.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/detail/placement_new.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/move/detail/type_traits.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+
+//!\file
+//!Describes concurrent_hash_map, a hash map that can be placed in a managed
+//!segment and accessed concurrently by several threads and processes.
+
+namespace boost {
+namespace interprocess {
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+namespace ipcdetail {
+
+//FNV-1a hash of the object representation
+template<class Key>
+struct object_representation_hash
+{
+   std::size_t operator()(const Key &k) const
+   {
+      const unsigned char *p = reinterpret_cast<const unsigned char*>(&k);
+      boost::uint64_t h = 14695981039346656037ULL;
+      for(std::size_t i = 0; i != sizeof(Key); ++i){
+         h = (h ^ p[i]) * 1099511628211ULL;
+      }
+      return static_cast<std::size_t>(h);
+   }
+};
+
+}  //namespace ipcdetail {
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!A hash map whose operations can be called concurrently from several threads
+//!and processes without external synchronization, unlike containers with
+//!an interprocess allocator, which need a mutex that serializes all accesses.
+//!
+//!Keys and mapped values are stored inline in an open addressing table with
+//!linear probing, so Key and T must be trivially copyable and trivially
+//!destructible, and they can't hold raw pointers or references to other objects,
+//!as usual for objects placed in shared memory. Tables store no pointers,
+//!only the handle to the allocated block.
+//!
+//!The table is divided in NumStripes contiguous regions, each one protected
+//!by a sharable mutex. Lookups lock the stripe of the key in sharable mode,
+//!so readers of the same stripe proceed in parallel, and modifications lock
+//!the stripe exclusively. Operations on different stripes don't block each other.
+//!
+//!When the table reaches a load factor of 3/4 a new table is allocated and
+//!the elements of each stripe are moved when that stripe is modified, or
+//!by later modifications of other stripes, so the map is never rehashed
+//!at once and lookups are not stopped while the rehash is in progress.
+//!
+//!Elements are returned by value, as the storage of an element can be moved
+//!to a new table once the stripe lock is released. Use visit() or cvisit()
+//!to access an element in place.
+//!
+//!The default hash function hashes the object representation of the key,
+//!which is not suitable for keys with padding bytes or with several
+//!representations for the same value (e.g. floating point zeros).
+//!
+//!The map can be constructed in a managed segment with find_or_construct,
+//!passing the segment manager or an allocator:
+//!
+//!\code
+//!   typedef concurrent_hash_map<int, int, allocator<char, managed_shared_memory::segment_manager> > map_t;
+//!   map_t *m = segment.find_or_construct<map_t>("map")(segment.get_segment_manager());
+//!\endcode
+template< class Key, class T, class Allocator
+        , class Hash = ipcdetail::object_representation_hash<Key>
+        , class Pred = std::equal_to<Key>
+        , std::size_t NumStripes = 64u>
+class concurrent_hash_map
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   BOOST_INTERPROCESS_STATIC_ASSERT((NumStripes != 0u && (NumStripes & (NumStripes - 1u)) == 0u));
+   BOOST_INTERPROCESS_STATIC_ASSERT((NumStripes <= 65536u));
+   BOOST_INTERPROCESS_STATIC_ASSERT((boost::move_detail::is_trivially_copy_constructible<Key>::value &&
+                                     boost::move_detail::is_trivially_destructible<Key>::value));
+   BOOST_INTERPROCESS_STATIC_ASSERT((boost::move_detail::is_trivially_copy_constructible<T>::value &&
+                                     boost::move_detail::is_trivially_destructible<T>::value));
+
+   //Non-copyable
+   concurrent_hash_map(const concurrent_hash_map &);
+   concurrent_hash_map &operator=(const concurrent_hash_map &);
+
+   typedef typename boost::container::allocator_traits<Allocator>::
+      template portable_rebind_alloc<char>::type                     char_allocator;
+   typedef typename boost::container::allocator_traits
+      <char_allocator>::pointer                                      char_ptr;
+
+   struct entry
+   {
+      Key   key;
+      T     value;
+   };
+
+   //Header of a table, followed by the control words and the entries
+   struct table
+   {
+      boost::uint32_t            log2_capacity;
+      volatile boost::uint32_t   used;
+   };
+
+   typedef typename boost::intrusive::pointer_traits
+      <char_ptr>::template rebind_pointer<table>::type               table_ptr;
+
+   //The control word of a slot stores the upper bits of the
+   //hash value and, in the two lower bits, the state of the slot.
+   static const boost::uint32_t empty_slot      = 0u;
+   static const boost::uint32_t busy_slot       = 1u;
+   static const boost::uint32_t full_slot       = 2u;
+   static const boost::uint32_t deleted_slot    = 3u;
+   static const unsigned        fragment_bits   = 30u;
+
+   static const std::size_t     npos            = std::size_t(-1);
+
+   //Elements of a stripe are in "gen" table until they are migrated
+   struct stripe
+   {
+      stripe()
+         : mtx(), gen(0u)
+      {}
+
+      interprocess_sharable_mutex   mtx;
+      boost::uint32_t               gen;
+   };
+
+   //Each stripe is locked by different threads, avoid false sharing
+   typedef cache_aligned<stripe> aligned_stripe;
+
+   class all_stripes_lock
+   {
+      public:
+      explicit all_stripes_lock(aligned_stripe *stripes)
+         : mp_stripes(stripes), m_locked(0u)
+      {}
+
+      void lock()
+      {
+         for(; m_locked != NumStripes; ++m_locked){
+            mp_stripes[m_locked]->mtx.lock();
+         }
+      }
+
+      ~all_stripes_lock()
+      {
+         while(m_locked){
+            mp_stripes[--m_locked]->mtx.unlock();
+         }
+      }
+
+      private:
+      aligned_stripe *mp_stripes;
+      std::size_t m_locked;
+   };
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef Key             key_type;
+   typedef T               mapped_type;
+   typedef Hash            hasher;
+   typedef Pred            key_equal;
+   typedef Allocator       allocator_type;
+   typedef std::size_t     size_type;
+
+   //!Number of stripes (independently locked regions) of the table
+   static const size_type num_stripes = NumStripes;
+
+   //!Constructs an empty map that can hold at least n elements
+   //!before growing. Memory is allocated with a copy of a.
+   //!Throws if the allocation or the mutex creation throws.
+   explicit concurrent_hash_map( const allocator_type &a, size_type n = 0u
+                               , const hasher &hf = hasher(), const key_equal &eql = key_equal())
+      : m_alloc(a), m_hash(hf), m_eq(eql), m_gen(0u), m_num_migrated(NumStripes)
+      , m_help_cursor(0u), m_old_pending(0u), m_size(0u), m_resize_mtx()
+   {  m_tables[0] = this->priv_allocate_table(this->priv_log2_capacity_for(n));  }
+
+   //!Deallocates the tables. No other thread or process
+   //!must be using the map.
+   ~concurrent_hash_map()
+   {
+      for(std::size_t i = 0; i != 2u; ++i){
+         if(m_tables[i]){
+            this->priv_deallocate_table(ipcdetail::to_raw_pointer(m_tables[i]));
+         }
+      }
+   }
+
+   //!Inserts a copy of the key and the value if the key is not present.
+   //!Returns true if the element was inserted.
+   //!Throws if the hash or the comparison functions throw or if
+   //!a new table is needed and the allocation throws.
+   bool insert(const key_type &k, const mapped_type &v)
+   {  return this->priv_insert(k, v, false);  }
+
+   //!Inserts a copy of the key and the value if the key is not present,
+   //!otherwise assigns v to the mapped value.
+   //!Returns true if the element was inserted.
+   //!Throws if the hash or the comparison functions throw or if
+   //!a new table is needed and the allocation throws.
+   bool insert_or_assign(const key_type &k, const mapped_type &v)
+   {  return this->priv_insert(k, v, true);  }
+
+   //!Copies the mapped value of the key to v if the key is present.
+   //!Returns true if the key was found.
+   //!Throws if the hash or the comparison functions throw.
+   bool find(const key_type &k, mapped_type &v) const
+   {
+      const boost::uint32_t frag = this->priv_fragment(k);
+      stripe &s = *m_stripes[this->priv_stripe(frag)];
+      sharable_lock<interprocess_sharable_mutex> lck(s.mtx);
+      table *const t = this->priv_table(s.gen);
+      const std::size_t i = this->priv_find(t, k, frag);
+      if(i == npos)
+         return false;
+      v = priv_entries(t)[i].value;
+      return true;
+   }
+
+   //!Returns true if the key is present.
+   //!Throws if the hash or the comparison functions throw.
+   bool contains(const key_type &k) const
+   {
+      const boost::uint32_t frag = this->priv_fragment(k);
+      stripe &s = *m_stripes[this->priv_stripe(frag)];
+      sharable_lock<interprocess_sharable_mutex> lck(s.mtx);
+      return this->priv_find(this->priv_table(s.gen), k, frag) != npos;
+   }
+
+   //!If the key is present calls f(v), where v is a reference to the mapped
+   //!value, with the stripe of the key locked exclusively, so the mapped
+   //!value can be updated atomically. f must not access the map.
+   //!Returns true if the key was found.
+   //!Throws if the hash or the comparison functions throw or f throws.
+   template<class F>
+   bool visit(const key_type &k, F f)
+   {
+      const boost::uint32_t frag = this->priv_fragment(k);
+      const std::size_t si = this->priv_stripe(frag);
+      bool found;
+      {
+         scoped_lock<interprocess_sharable_mutex> lck(m_stripes[si]->mtx);
+         table *const t = this->priv_prepare_write(si);
+         const std::size_t i = this->priv_find(t, k, frag);
+         found = i != npos;
+         if(found){
+            f(priv_entries(t)[i].value);
+         }
+      }
+      this->priv_help_migrate();
+      return found;
+   }
+
+   //!If the key is present calls f(v), where v is a const reference to the
+   //!mapped value, with the stripe of the key locked in sharable mode.
+   //!f must not access the map.
+   //!Returns true if the key was found.
+   //!Throws if the hash or the comparison functions throw or f throws.
+   template<class F>
+   bool cvisit(const key_type &k, F f) const
+   {
+      const boost::uint32_t frag = this->priv_fragment(k);
+      stripe &s = *m_stripes[this->priv_stripe(frag)];
+      sharable_lock<interprocess_sharable_mutex> lck(s.mtx);
+      table *const t = this->priv_table(s.gen);
+      const std::size_t i = this->priv_find(t, k, frag);
+      if(i == npos)
+         return false;
+      const mapped_type &v = priv_entries(t)[i].value;
+      f(v);
+      return true;
+   }
+
+   //!Erases the element with key k. Returns true if the element was found.
+   //!Throws if the hash or the comparison functions throw.
+   bool erase(const key_type &k)
+   {
+      const boost::uint32_t frag = this->priv_fragment(k);
+      const std::size_t si = this->priv_stripe(frag);
+      bool found;
+      {
+         scoped_lock<interprocess_sharable_mutex> lck(m_stripes[si]->mtx);
+         table *const t = this->priv_prepare_write(si);
+         const std::size_t i = this->priv_find(t, k, frag);
+         found = i != npos;
+         if(found){
+            //Erased slots are not reused until the next rehash,
+            //as lookups of other keys might be probing them.
+            ipcdetail::atomic_write32(&priv_ctrl(t)[i], deleted_slot);
+            ipcdetail::atomic_dec32(&m_size);
+         }
+      }
+      this->priv_help_migrate();
+      return found;
+   }
+
+   //!Erases all elements. Blocks all operations while in progress.
+   void clear()
+   {
+      scoped_lock<interprocess_mutex> lck(m_resize_mtx);
+      this->priv_finish_migration();
+      all_stripes_lock all(m_stripes);
+      all.lock();
+      table *const t = this->priv_table(m_gen);
+      std::memset(const_cast<boost::uint32_t*>(priv_ctrl(t)), 0, priv_capacity(t)*sizeof(boost::uint32_t));
+      t->used = 0u;
+      m_size = 0u;
+   }
+
+   //!Returns the number of elements. The value might be outdated if other
+   //!threads are modifying the map. Never throws.
+   size_type size() const
+   {  return ipcdetail::atomic_read32(&m_size);  }
+
+   //!Returns true if the map has no elements. The value might be outdated if other
+   //!threads are modifying the map. Never throws.
+   bool empty() const
+   {  return this->size() == 0u;  }
+
+   //!Returns the number of slots of the current table.
+   size_type capacity() const
+   {
+      scoped_lock<interprocess_mutex> lck(m_resize_mtx);
+      return priv_capacity(this->priv_table(m_gen));
+   }
+
+   //!Returns a copy of the allocator. Never throws.
+   allocator_type get_allocator() const
+   {  return allocator_type(m_alloc);  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   static volatile boost::uint32_t *priv_ctrl(table *t)
+   {  return reinterpret_cast<boost::uint32_t*>(reinterpret_cast<char*>(t) + sizeof(table));  }
+
+   static std::size_t priv_capacity(const table *t)
+   {  return std::size_t(1u) << t->log2_capacity;  }
+
+   static std::size_t priv_entries_offset(std::size_t capacity)
+   {
+      const std::size_t align = ::boost::container::dtl::alignment_of<entry>::value;
+      return ((sizeof(table) + capacity*sizeof(boost::uint32_t) - 1u)/align + 1u)*align;
+   }
+
+   static entry *priv_entries(table *t)
+   {  return reinterpret_cast<entry*>(reinterpret_cast<char*>(t) + priv_entries_offset(priv_capacity(t)));  }
+
+   static std::size_t priv_table_bytes(unsigned log2_capacity)
+   {
+      const std::size_t capacity = std::size_t(1u) << log2_capacity;
+      return priv_entries_offset(capacity) + capacity*sizeof(entry);
+   }
+
+   //Returns the binary logarithm of the smallest capacity whose
+   //maximum load is n, at least NumStripes and 16 slots
+   static unsigned priv_log2_capacity_for(size_type n)
+   {
+      unsigned log2 = 4u;
+      while((std::size_t(1u) << log2) < NumStripes){
+         ++log2;
+      }
+      for(; ((std::size_t(1u) << log2) - (std::size_t(1u) << log2)/4u) < n; ++log2){
+         if(log2 == fragment_bits)
+            throw_bad_alloc();
+      }
+      return log2;
+   }
+
+   table *priv_allocate_table(unsigned log2_capacity)
+   {
+      table *const t = reinterpret_cast<table*>
+         (ipcdetail::to_raw_pointer(m_alloc.allocate(priv_table_bytes(log2_capacity))));
+      t->log2_capacity = log2_capacity;
+      t->used = 0u;
+      std::memset(const_cast<boost::uint32_t*>(priv_ctrl(t)), 0, priv_capacity(t)*sizeof(boost::uint32_t));
+      return t;
+   }
+
+   void priv_deallocate_table(table *t)
+   {
+      m_alloc.deallocate( boost::intrusive::pointer_traits<char_ptr>::pointer_to(*reinterpret_cast<char*>(t))
+                        , priv_table_bytes(t->log2_capacity));
+   }
+
+   table *priv_table(boost::uint32_t gen) const
+   {  return ipcdetail::to_raw_pointer(m_tables[gen & 1u]);  }
+
+   static void throw_bad_alloc()
+   {  throw bad_alloc();  }
+
+   //The upper bits of the mixed hash value select the stripe and
+   //the home slot, so the home slots of a stripe are contiguous
+   boost::uint32_t priv_fragment(const key_type &k) const
+   {
+      const boost::uint64_t h = static_cast<boost::uint64_t>(m_hash(k)) * 0x9E3779B97F4A7C15ULL;
+      return static_cast<boost::uint32_t>(h >> (64u - fragment_bits));
+   }
+
+   static std::size_t priv_stripe(boost::uint32_t frag)
+   {  return static_cast<std::size_t>((boost::uint64_t(frag) * NumStripes) >> fragment_bits);  }
+
+   static std::size_t priv_home(const table *t, boost::uint32_t frag)
+   {  return static_cast<std::size_t>((boost::uint64_t(frag) << t->log2_capacity) >> fragment_bits);  }
+
+   //Must be called with the stripe of the key locked. Slots become non-empty
+   //before the elements that probe past them are inserted, and the lock
+   //orders those insertions, so plain reads of the control words are enough.
+   std::size_t priv_find(table *t, const key_type &k, boost::uint32_t frag) const
+   {
+      const std::size_t mask = priv_capacity(t) - 1u;
+      volatile boost::uint32_t *const ctrl = priv_ctrl(t);
+      entry *const entries = priv_entries(t);
+      const boost::uint32_t wanted = (frag << 2u) | full_slot;
+      for(std::size_t i = priv_home(t, frag); ; i = (i + 1u) & mask){
+         const boost::uint32_t c = ctrl[i];
+         if(c == empty_slot)
+            return npos;
+         else if(c == wanted && m_eq(entries[i].key, k))
+            return i;
+      }
+   }
+
+   //Writers of other stripes can claim slots concurrently
+   static void priv_emplace(table *t, boost::uint32_t frag, const key_type &k, const mapped_type &v)
+   {
+      const std::size_t mask = priv_capacity(t) - 1u;
+      volatile boost::uint32_t *const ctrl = priv_ctrl(t);
+      std::size_t i = priv_home(t, frag);
+      while(ctrl[i] != empty_slot || ipcdetail::atomic_cas32(&ctrl[i], busy_slot, empty_slot) != empty_slot){
+         i = (i + 1u) & mask;
+      }
+      entry &e = priv_entries(t)[i];
+      ::new(&e.key, boost_container_new_t()) key_type(k);
+      ::new(&e.value, boost_container_new_t()) mapped_type(v);
+      ipcdetail::atomic_write32(&ctrl[i], (frag << 2u) | full_slot);
+   }
+
+   //Reserves a slot for a new element, fails if the maximum load was reached
+   static bool priv_reserve(table *t)
+   {
+      const std::size_t capacity = priv_capacity(t);
+      if(ipcdetail::atomic_inc32(&t->used) >= capacity - capacity/4u){
+         ipcdetail::atomic_dec32(&t->used);
+         return false;
+      }
+      return true;
+   }
+
+   //Called with the stripe locked exclusively, returns the table to modify
+   table *priv_prepare_write(std::size_t si)
+   {
+      const boost::uint32_t gen = ipcdetail::atomic_read32(&m_gen);
+      if(m_stripes[si]->gen != gen){
+         this->priv_migrate(si, gen);
+      }
+      return this->priv_table(gen);
+   }
+
+   //Moves the elements of stripe si to the current table. Called with
+   //the stripe locked exclusively. The old table is no longer modified.
+   void priv_migrate(std::size_t si, boost::uint32_t gen)
+   {
+      stripe &s = *m_stripes[si];
+      table *const from = this->priv_table(s.gen);
+      table *const to   = this->priv_table(gen);
+      const std::size_t capacity = priv_capacity(from);
+      const std::size_t mask = capacity - 1u;
+      volatile boost::uint32_t *const ctrl = priv_ctrl(from);
+      entry *const entries = priv_entries(from);
+
+      //Elements whose home slot is in the region of the stripe are
+      //in the region or in the run of non-empty slots that follows it
+      const std::size_t first = si*(capacity/NumStripes);
+      const std::size_t last  = first + capacity/NumStripes;
+      for(std::size_t n = 0, i = first; n != capacity; ++n, i = (i + 1u) & mask){
+         const boost::uint32_t c = ctrl[i];
+         if(c == empty_slot){
+            if(n >= last - first)
+               break;
+         }
+         else if((c & 3u) == full_slot && priv_stripe(c >> 2u) == si){
+            //Slots for migrated elements were reserved when the table was allocated
+            priv_emplace(to, c >> 2u, entries[i].key, entries[i].value);
+         }
+      }
+      s.gen = gen;
+      ipcdetail::atomic_inc32(&m_num_migrated);
+   }
+
+   bool priv_insert(const key_type &k, const mapped_type &v, bool assign)
+   {
+      const boost::uint32_t frag = this->priv_fragment(k);
+      const std::size_t si = this->priv_stripe(frag);
+      bool inserted;
+      for(;;){
+         boost::uint32_t gen;
+         {
+            scoped_lock<interprocess_sharable_mutex> lck(m_stripes[si]->mtx);
+            table *const t = this->priv_prepare_write(si);
+            gen = m_stripes[si]->gen;
+            const std::size_t i = this->priv_find(t, k, frag);
+            if(i != npos){
+               if(assign){
+                  priv_entries(t)[i].value = v;
+               }
+               inserted = false;
+               break;
+            }
+            else if(priv_reserve(t)){
+               priv_emplace(t, frag, k, v);
+               ipcdetail::atomic_inc32(&m_size);
+               inserted = true;
+               break;
+            }
+         }
+         //Stripe locks must be released before growing
+         this->priv_grow(gen);
+      }
+      this->priv_help_migrate();
+      return inserted;
+   }
+
+   //Allocates a new table if "gen" is still the current generation.
+   //Must be called without holding any stripe lock.
+   void priv_grow(boost::uint32_t gen)
+   {
+      scoped_lock<interprocess_mutex> lck(m_resize_mtx);
+      if(m_gen != gen)
+         return;
+      this->priv_finish_migration();
+
+      //With all stripes locked the number of elements is exact and
+      //writers that hold a stripe lock can't be using the current table
+      all_stripes_lock all(m_stripes);
+      all.lock();
+      const boost::uint32_t live = m_size;
+      table *const t = this->priv_allocate_table(this->priv_log2_capacity_for(size_type(live)*2u + 1u));
+      t->used = live;
+      m_tables[(gen + 1u) & 1u] = t;
+      ipcdetail::atomic_write32(&m_num_migrated, 0u);
+      ipcdetail::atomic_write32(&m_old_pending, 1u);
+      ipcdetail::atomic_write32(&m_gen, gen + 1u);
+   }
+
+   //Migrates the remaining stripes and deallocates the previous table.
+   //Must be called with the resize mutex locked.
+   void priv_finish_migration()
+   {
+      if(!m_old_pending)
+         return;
+      const boost::uint32_t gen = m_gen;
+      for(std::size_t i = 0; i != NumStripes; ++i){
+         if(ipcdetail::atomic_read32(&m_num_migrated) == NumStripes)
+            break;
+         scoped_lock<interprocess_sharable_mutex> lck(m_stripes[i]->mtx);
+         if(m_stripes[i]->gen != gen){
+            this->priv_migrate(i, gen);
+         }
+      }
+      const std::size_t old = (gen + 1u) & 1u;
+      this->priv_deallocate_table(ipcdetail::to_raw_pointer(m_tables[old]));
+      m_tables[old] = table_ptr();
+      ipcdetail::atomic_write32(&m_old_pending, 0u);
+   }
+
+   //After a modification, migrates another stripe, so that the previous
+   //table is released even if some stripes are never modified.
+   //Must be called without holding any stripe lock.
+   void priv_help_migrate()
+   {
+      if(!ipcdetail::atomic_read32(&m_old_pending))
+         return;
+      if(ipcdetail::atomic_read32(&m_num_migrated) != NumStripes){
+         const std::size_t si = ipcdetail::atomic_inc32(&m_help_cursor) % NumStripes;
+         scoped_lock<interprocess_sharable_mutex> lck(m_stripes[si]->mtx, try_to_lock);
+         if(lck){
+            this->priv_prepare_write(si);
+         }
+      }
+      else{
+         scoped_lock<interprocess_mutex> lck(m_resize_mtx);
+         this->priv_finish_migration();
+      }
+   }
+
+   char_allocator                   m_alloc;
+   hasher                           m_hash;
+   key_equal                        m_eq;
+   table_ptr                        m_tables[2];
+   volatile boost::uint32_t         m_gen;
+   volatile boost::uint32_t         m_num_migrated;
+   volatile boost::uint32_t         m_help_cursor;
+   volatile boost::uint32_t         m_old_pending;
+   mutable volatile boost::uint32_t m_size;
+   mutable interprocess_mutex       m_resize_mtx;
+   mutable aligned_stripe           m_stripes[NumStripes];
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_CONTAINERS_CONCURRENT_HASH_MAP_HPP
@@ -61,6 +61,15 @@ inline void atomic_write32(volatile boost::uint32_t *mem, boost::uint32_t val);
 inline boost::uint32_t atomic_cas32
    (volatile boost::uint32_t *mem, boost::uint32_t with, boost::uint32_t cmp);
 
+//! Compare an boost::uint64_t's value with "cmp".
+//! If they are the same swap the value with "with"
+//! "mem": pointer to the value
+//! "with": what to swap it with
+//! "cmp": the value to compare it to
+//! Returns the old value of *mem
+inline boost::uint64_t atomic_cas64
+   (volatile boost::uint64_t *mem, boost::uint64_t with, boost::uint64_t cmp);
+
 }  //namespace ipcdetail{
 }  //namespace interprocess{
 }  //namespace boost{
@@ -78,6 +87,9 @@ inline boost::uint32_t atomic_cas32
             _ReadWriteBarrier() \
             BOOST_INTERPROCESS_RESTORE_WARNING
 
+   extern "C" __int64 _InterlockedCompareExchange64(__int64 volatile *, __int64, __int64);
+   #pragma intrinsic(_InterlockedCompareExchange64)
+
 #elif defined(__GNUC__)
 #  define BOOST_INTERPROCESS_READ_WRITE_BARRIER __sync_synchronize()
 #else
@@ -124,6 +136,50 @@ inline boost::uint32_t atomic_cas32
    (volatile boost::uint32_t *mem, boost::uint32_t with, boost::uint32_t cmp)
 {  return (boost::uint32_t)winapi::interlocked_compare_exchange(reinterpret_cast<volatile long*>(mem), (long)with, (long)cmp);  }
 
+//! Compare an boost::uint64_t's value with "cmp".
+//! If they are the same swap the value with "with"
+//! "mem": pointer to the value
+//! "with": what to swap it with
+//! "cmp": the value to compare it to
+//! Returns the old value of *mem
+inline boost::uint64_t atomic_cas64
+   (volatile boost::uint64_t *mem, boost::uint64_t with, boost::uint64_t cmp)
+{
+   #if defined( _MSC_VER )
+   return (boost::uint64_t)_InterlockedCompareExchange64
+      (reinterpret_cast<volatile __int64*>(mem), (__int64)with, (__int64)cmp);
+   #else
+   return __sync_val_compare_and_swap(const_cast<boost::uint64_t *>(mem), cmp, with);
+   #endif
+}
+
+//! Atomically add 'val' to an boost::uint64_t
+//! "mem": pointer to the object
+//! "val": amount to add
+//! Returns the old value pointed to by mem
+inline boost::uint64_t atomic_add64
+   (volatile boost::uint64_t *mem, boost::uint64_t val)
+{
+   boost::uint64_t old, c(*mem);
+   while((old = atomic_cas64(mem, c + val, c)) != c){
+      c = old;
+   }
+   return c;
+}
+
+//! Atomically read an boost::uint64_t from memory
+inline boost::uint64_t atomic_read64(volatile boost::uint64_t *mem)
+{
+   #if defined(_M_X64) || defined(_M_AMD64) || defined(_M_ARM64) || defined(__x86_64__) || defined(__aarch64__)
+   const boost::uint64_t val = *mem;
+   BOOST_INTERPROCESS_READ_WRITE_BARRIER;
+   return val;
+   #else
+   //A plain load could be torn on 32 bit targets
+   return atomic_cas64(mem, 0u, 0u);
+   #endif
+}
+
 }  //namespace ipcdetail{
 }  //namespace interprocess{
 }  //namespace boost{
@@ -174,6 +230,35 @@ inline boost::uint32_t atomic_cas32
 inline void atomic_write32(volatile boost::uint32_t *mem, boost::uint32_t val)
 {  __sync_synchronize(); *mem = val;  }
 
+//! Compare an boost::uint64_t's value with "cmp".
+//! If they are the same swap the value with "with"
+//! "mem": pointer to the value
+//! "with" what to swap it with
+//! "cmp": the value to compare it to
+//! Returns the old value of *mem
+inline boost::uint64_t atomic_cas64
+   (volatile boost::uint64_t *mem, boost::uint64_t with, boost::uint64_t cmp)
+{  return __sync_val_compare_and_swap(const_cast<boost::uint64_t *>(mem), cmp, with);   }
+
+//! Atomically add 'val' to an boost::uint64_t
+//! "mem": pointer to the object
+//! "val": amount to add
+//! Returns the old value pointed to by mem
+inline boost::uint64_t atomic_add64
+   (volatile boost::uint64_t *mem, boost::uint64_t val)
+{  return __sync_fetch_and_add(const_cast<boost::uint64_t *>(mem), val);   }
+
+//! Atomically read an boost::uint64_t from memory
+inline boost::uint64_t atomic_read64(volatile boost::uint64_t *mem)
+{
+   #if defined(__ATOMIC_SEQ_CST)
+   return __atomic_load_n(const_cast<boost::uint64_t *>(mem), __ATOMIC_SEQ_CST);
+   #else
+   //A plain load could be torn on 32 bit targets
+   return __sync_val_compare_and_swap(const_cast<boost::uint64_t *>(mem), 0u, 0u);
+   #endif
+}
+
 }  //namespace ipcdetail{
 }  //namespace interprocess{
 }  //namespace boost{
@@ -188,6 +273,29 @@ namespace boost{
 namespace interprocess{
 namespace ipcdetail{
 
+//! Full memory barrier: loads and stores are not reordered across it
+inline void atomic_fence()
+{
+   #if defined(__GNUC__)
+   __sync_synchronize();
+   #else
+   volatile boost::uint32_t dummy = 0u;
+   atomic_write32(&dummy, 0u);
+   #endif
+}
+
+//! Atomically set an boost::uint64_t in memory
+//! "mem": pointer to the object
+//! "param": val value that the object will assume
+inline void atomic_write64(volatile boost::uint64_t *mem, boost::uint64_t val)
+{
+   //A plain store could be torn on 32 bit targets
+   boost::uint64_t old, c(atomic_read64(mem));
+   while((old = atomic_cas64(mem, val, c)) != c){
+      c = old;
+   }
+}
+
 inline bool atomic_add_unless32
    (volatile boost::uint32_t *mem, boost::uint32_t value, boost::uint32_t unless_this)
 {
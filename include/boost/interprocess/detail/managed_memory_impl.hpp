@@ -31,6 +31,7 @@
 #include <boost/interprocess/sync/scoped_lock.hpp>
 #include <boost/interprocess/detail/nothrow.hpp>
 #include <boost/interprocess/detail/simple_swap.hpp>
+#include <boost/interprocess/detail/segment_base.hpp>
 //
 //
 #include <boost/intrusive/detail/minimal_pair_header.hpp>
@@ -172,6 +173,8 @@ class basic_managed_memory_impl
       if(size < segment_manager::get_min_size())
          return false;
 
+      //Throws if the pointers of the memory algorithm can't address the segment
+      ipcdetail::segment_base_hook<typename MemoryAlgorithm::void_pointer>::attach(addr, size);
       //This function should not throw. The index construction can
       //throw if constructor allocates memory. So we must catch it.
       BOOST_INTERPROCESS_TRY{
@@ -180,15 +183,18 @@ class basic_managed_memory_impl
          mp_header       = ::new(addr, boost_container_new_t()) segment_manager(size);
       }
       BOOST_INTERPROCESS_CATCH(...){
+         ipcdetail::segment_base_hook<typename MemoryAlgorithm::void_pointer>::detach(addr);
          return false;
       } BOOST_INTERPROCESS_CATCH_END
       return true;
    }
 
-   //!Connects to a segment manager in the reserved buffer. Never throws.
-   bool  open_impl     (void *addr, size_type)
+   //!Connects to a segment manager in the reserved buffer. Throws only if
+   //!the pointers of the memory algorithm can't address the segment.
+   bool  open_impl     (void *addr, size_type size)
    {
       if(mp_header)  return false;
+      ipcdetail::segment_base_hook<typename MemoryAlgorithm::void_pointer>::attach(addr, size);
       mp_header = static_cast<segment_manager*>(addr);
       return true;
    }
@@ -197,6 +203,9 @@ class basic_managed_memory_impl
    bool close_impl()
    {
       bool ret = mp_header != 0;
+      if(ret){
+         ipcdetail::segment_base_hook<typename MemoryAlgorithm::void_pointer>::detach(mp_header);
+      }
       mp_header = 0;
       return ret;
    }
@@ -213,7 +222,11 @@ class basic_managed_memory_impl
 
    //!
    void grow(size_type extra_bytes)
-   {  mp_header->grow(extra_bytes); }
+   {
+      ipcdetail::segment_base_hook<typename MemoryAlgorithm::void_pointer>::check_size
+         (mp_header, mp_header->get_size() + extra_bytes);
+      mp_header->grow(extra_bytes);
+   }
 
    void shrink_to_fit()
    {  mp_header->shrink_to_fit(); }
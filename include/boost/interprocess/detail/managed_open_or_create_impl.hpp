@@ -34,6 +34,7 @@
 #include <boost/interprocess/permissions.hpp>
 #include <boost/container/detail/type_traits.hpp>  //alignment_of, aligned_storage
 #include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
 #include <boost/interprocess/timed_utils.hpp>
 #include <boost/move/move.hpp>
 #include <boost/cstdint.hpp>
@@ -77,6 +78,9 @@ class managed_open_or_create_impl
 
    static const unsigned MaxCreateOrOpenTries = BOOST_INTERPROCESS_MANAGED_OPEN_OR_CREATE_INITIALIZE_MAX_TRIES;
    static const unsigned MaxInitializeTimeSec = BOOST_INTERPROCESS_MANAGED_OPEN_OR_CREATE_INITIALIZE_TIMEOUT_SEC;
+   #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   static const unsigned FutexWaitSliceMs = 100u;
+   #endif
 
    typedef managed_open_or_create_impl_device_holder<StoreDevice, DeviceAbstraction> DevHolder;
    enum
@@ -248,6 +252,21 @@ class managed_open_or_create_impl
    bool flush()
    {  return m_mapped_region.flush();  }
 
+   //Offset is relative to the start of the mapped region
+   bool flush(std::size_t offset, std::size_t numbytes, bool async)
+   {
+      //Flush functions need page aligned addresses
+      const std::size_t page_offset = offset % mapped_region::get_page_size();
+      //Zero means "until the end of the region"
+      if(numbytes && numbytes < (this->get_real_size() - offset)){
+         numbytes += page_offset;
+      }
+      else if(offset < this->get_real_size()){
+         numbytes = 0u;
+      }
+      return m_mapped_region.flush(offset - page_offset, numbytes, async);
+   }
+
    const mapped_region &get_mapped_region() const
    {  return m_mapped_region;  }
 
@@ -370,13 +389,13 @@ class managed_open_or_create_impl
                final_region.swap(region);
             }
             BOOST_INTERPROCESS_CATCH(...){
-               atomic_write32(patomic_word, CorruptedSegment);
+               publish_state(patomic_word, CorruptedSegment);
                BOOST_INTERPROCESS_RETHROW
             } BOOST_INTERPROCESS_CATCH_END
-            atomic_write32(patomic_word, InitializedSegment);
+            publish_state(patomic_word, InitializedSegment);
          }
          else{
-            atomic_write32(patomic_word, CorruptedSegment);
+            publish_state(patomic_word, CorruptedSegment);
             throw interprocess_exception(error_info(corrupted_error));
          }
       }
@@ -449,7 +468,19 @@ class managed_open_or_create_impl
             if (elapsed > TimeoutSec){
                throw interprocess_exception(error_info(corrupted_error));
             }
+            #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+            //Spin briefly as the creator might be about to finish, then sleep until the
+            //creator publishes the final state. Waits are bounded so that the timeout
+            //is still checked if the creator dies without waking us.
+            if(swait.count() < spin_wait::nop_pause_limit){
+               swait.yield();
+            }
+            else{
+               futex_timed_wait(patomic_word, value, usduration_from_milliseconds(FutexWaitSliceMs));
+            }
+            #else
             swait.yield();
+            #endif
          }
          //The size of the file might have grown while Uninitialized -> Initializing, so remap
          {
@@ -466,6 +497,15 @@ class managed_open_or_create_impl
       final_region.swap(region);
    }
 
+   //Publishes the final initialization state and wakes processes waiting for it
+   static void publish_state(boost::uint32_t *patomic_word, boost::uint32_t state)
+   {
+      atomic_write32(patomic_word, state);
+      #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+      futex_wake_all(patomic_word);
+      #endif
+   }
+
    template <class DeviceId, class ConstructFunc> inline
    void priv_open_or_create
       (create_enum_t type,
@@ -540,13 +580,13 @@ class managed_open_or_create_impl
             m_mapped_region.swap(region);
          }
          BOOST_INTERPROCESS_CATCH(...){
-            atomic_write32(patomic_word, CorruptedSegment);
+            publish_state(patomic_word, CorruptedSegment);
             BOOST_INTERPROCESS_RETHROW
          } BOOST_INTERPROCESS_CATCH_END
-         atomic_write32(patomic_word, InitializedSegment);
+         publish_state(patomic_word, InitializedSegment);
       }
       else{
-         atomic_write32(patomic_word, CorruptedSegment);
+         publish_state(patomic_word, CorruptedSegment);
          throw interprocess_exception(error_info(corrupted_error));
       }
    }
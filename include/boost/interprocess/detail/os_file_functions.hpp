@@ -190,6 +190,21 @@ inline bool delete_file(const char *name)
 inline bool delete_file(const wchar_t *name)
 {  return winapi::unlink_file(name);   }
 
+inline bool flush_file(file_handle_t hnd)
+{  return winapi::flush_file_buffers(hnd);   }
+
+template<class CharT>
+inline bool rename_file(const CharT *old_name, const CharT *new_name)
+{
+   return winapi::move_file
+      (old_name, new_name, winapi::movefile_replace_existing | winapi::movefile_write_through);
+}
+
+//The renames of rename_file are already written through
+template<class CharT>
+inline bool flush_parent_directory(const CharT *)
+{  return true;   }
+
 inline bool truncate_file (file_handle_t hnd, std::size_t size)
 {
    offset_t filesize;
@@ -594,6 +609,30 @@ inline file_handle_t open_existing_file
 inline bool delete_file(const char *name)
 {  return BOOST_INTERPROCESS_EINTR_RETRY(int, -1, ::unlink(name)) == 0;   }
 
+inline bool flush_file(file_handle_t hnd)
+{  return BOOST_INTERPROCESS_EINTR_RETRY(int, -1, ::fsync(hnd)) == 0;   }
+
+inline bool rename_file(const char *old_name, const char *new_name)
+{  return ::rename(old_name, new_name) == 0;   }
+
+//Makes the creation, removal or renaming of the file "name" durable
+inline bool flush_parent_directory(const char *name)
+{
+   const char *const sep = std::strrchr(name, '/');
+   std::string dir;
+   if(!sep)
+      dir = ".";
+   else if(sep == name)
+      dir = "/";
+   else
+      dir.assign(name, sep);
+   const int fd = BOOST_INTERPROCESS_EINTR_RETRY(int, -1, ::open(dir.c_str(), O_RDONLY));
+   if(fd < 0)
+      return false;
+   const bool ok = BOOST_INTERPROCESS_EINTR_RETRY(int, -1, ::fsync(fd)) == 0;
+   return ::close(fd) == 0 && ok;
+}
+
 inline bool truncate_file (file_handle_t hnd, std::size_t size)
 {
    typedef boost::move_detail::make_unsigned<off_t>::type uoff_t;
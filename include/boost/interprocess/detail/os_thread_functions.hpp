@@ -33,6 +33,7 @@
 #include <boost/interprocess/detail/config_begin.hpp>
 #include <boost/interprocess/detail/workaround.hpp>
 #include <boost/interprocess/streams/bufferstream.hpp>
+#include <boost/cstdint.hpp>
 #include <cstddef>
 #include <cassert>
 
@@ -45,6 +46,7 @@
 #  include <sched.h>
 #  include <time.h>
 #  include <errno.h>
+#  include <signal.h>
 #  include <sys/types.h>
 #  ifdef BOOST_INTERPROCESS_BSD_DERIVATIVE
       //Some *BSD systems (OpenBSD & NetBSD) need sys/param.h before sys/sysctl.h, whereas
@@ -58,6 +60,8 @@
 
 #if defined(__linux__)
    #include <sys/syscall.h>
+   #include <fcntl.h>
+   #include <cstring>
 #elif defined(__FreeBSD__)
    #include <pthread_np.h>
 #elif defined(__APPLE__)
@@ -133,6 +137,20 @@ inline OS_process_id_t get_current_process_id()
 inline OS_process_id_t get_invalid_process_id()
 {  return OS_process_id_t(0);  }
 
+//Returns false if the process does not exist. The process
+//identifier might have been reused by a new process.
+inline bool is_process_alive(OS_process_id_t pid)
+{
+   void *const hnd = winapi::open_process(winapi::synchronize_access, false, pid);
+   if(!hnd){
+      //Processes owned by other users exist but can't be opened
+      return winapi::get_last_error() == winapi::error_access_denied;
+   }
+   const bool alive = winapi::wait_for_single_object(hnd, 0) == winapi::wait_timeout;
+   winapi::close_handle(hnd);
+   return alive;
+}
+
 //thread
 inline OS_thread_id_t get_current_thread_id()
 {  return winapi::get_current_thread_id();  }
@@ -218,6 +236,19 @@ inline bool system_highres_count_less(const OS_highres_count_t &l, const OS_high
 inline bool system_highres_count_less_ul(const OS_highres_count_t &l, unsigned long r)
 {  return l < static_cast<OS_highres_count_t>(r);  }
 
+//Converts a highres count (or a difference of counts) to nanoseconds
+inline boost::uint64_t system_highres_count_to_ns(const OS_highres_count_t &count)
+{
+   __int64 freq;
+   if(!winapi::query_performance_frequency(&freq) || freq <= 0){
+      //get_tick_count was used, so count holds milliseconds
+      return static_cast<boost::uint64_t>(count)*1000000u;
+   }
+   const boost::uint64_t f = static_cast<boost::uint64_t>(freq);
+   //Split the conversion to avoid overflowing for big counts
+   return (count / f)*1000000000u + ((count % f)*1000000000u)/f;
+}
+
 inline void thread_sleep_tick()
 {  winapi::sleep_tick();   }
 
@@ -290,6 +321,14 @@ inline OS_process_id_t get_current_process_id()
 inline OS_process_id_t get_invalid_process_id()
 {  return pid_t(0);  }
 
+//Returns false if the process does not exist. The process
+//identifier might have been reused by a new process.
+inline bool is_process_alive(OS_process_id_t pid)
+{
+   //Processes owned by other users exist but can't be signaled
+   return 0 == ::kill(pid, 0) || errno == EPERM;
+}
+
 //thread
 inline OS_thread_id_t get_current_thread_id()
 {  return ::pthread_self();  }
@@ -546,6 +585,10 @@ inline bool system_highres_count_less(const OS_highres_count_t &l, const OS_high
 inline bool system_highres_count_less_ul(const OS_highres_count_t &l, unsigned long r)
 {  return !l.tv_sec && (static_cast<unsigned long>(l.tv_nsec) < r);  }
 
+//Converts a highres count (or a difference of counts) to nanoseconds
+inline boost::uint64_t system_highres_count_to_ns(const OS_highres_count_t &count)
+{  return static_cast<boost::uint64_t>(count.tv_sec)*1000000000u + static_cast<boost::uint64_t>(count.tv_nsec);  }
+
 #else
 
 inline void zero_highres_count(OS_highres_count_t &count)
@@ -570,6 +613,15 @@ inline bool system_highres_count_less(const OS_highres_count_t &l, const OS_high
 inline bool system_highres_count_less_ul(const OS_highres_count_t &l, unsigned long r)
 {  return l < static_cast<OS_highres_count_t>(r);  }
 
+//Converts a highres count (or a difference of counts) to nanoseconds
+inline boost::uint64_t system_highres_count_to_ns(const OS_highres_count_t &count)
+{
+   mach_timebase_info_data_t info;
+   mach_timebase_info(&info);
+   return static_cast<boost::uint64_t>
+      (static_cast<double>(count) * (static_cast<double>(info.numer) / info.denom));
+}
+
 #endif
 
 inline void thread_sleep_tick()
@@ -670,6 +722,72 @@ inline void get_pid_str(pid_str_t &pid_str, OS_process_id_t pid)
 inline void get_pid_str(pid_str_t &pid_str)
 {  get_pid_str(pid_str, get_current_process_id());  }
 
+//Returns a value that identifies when the process "pid" was started, so that
+//the pid and the start time identify a process even if the pid is reused.
+//Returns zero if it can't be obtained.
+#if defined(BOOST_INTERPROCESS_WINDOWS)
+
+inline unsigned long long get_process_start_time(OS_process_id_t pid)
+{
+   void *const hnd = winapi::open_process(winapi::process_query_limited_information, false, pid);
+   if(!hnd){
+      return 0u;
+   }
+   winapi::interprocess_filetime CreationTime, ExitTime, KernelTime, UserTime;
+   unsigned long long start = 0u;
+   if(winapi::get_process_times(hnd, &CreationTime, &ExitTime, &KernelTime, &UserTime)){
+      start = CreationTime.dwHighDateTime;
+      start <<= 32u;
+      start |= CreationTime.dwLowDateTime;
+   }
+   winapi::close_handle(hnd);
+   return start;
+}
+
+#elif defined(__linux__)
+
+inline unsigned long long get_process_start_time(OS_process_id_t pid)
+{
+   //Field 22 of /proc/<pid>/stat is the start time in clock ticks since boot
+   pid_str_t pid_str;
+   get_pid_str(pid_str, pid);
+   char path[sizeof("/proc//stat") + sizeof(pid_str_t)];
+   std::strcpy(path, "/proc/");
+   std::strcat(path, pid_str);
+   std::strcat(path, "/stat");
+
+   const int fd = ::open(path, O_RDONLY);
+   if(fd < 0){
+      return 0u;
+   }
+   char buf[512];
+   const ssize_t n = ::read(fd, buf, sizeof(buf) - 1u);
+   ::close(fd);
+   if(n <= 0){
+      return 0u;
+   }
+   buf[n] = 0;
+   //The command name (field 2) can contain spaces and parentheses
+   const char *p = std::strrchr(buf, ')');
+   for(unsigned field = 2u; p && field != 22u; ++field){
+      p = std::strchr(p + 1, ' ');
+   }
+   unsigned long long start = 0u;
+   if(p){
+      for(++p; *p >= '0' && *p <= '9'; ++p){
+         start = start*10u + static_cast<unsigned>(*p - '0');
+      }
+   }
+   return start;
+}
+
+#else
+
+inline unsigned long long get_process_start_time(OS_process_id_t)
+{  return 0u;  }
+
+#endif
+
 #if defined(BOOST_INTERPROCESS_WINDOWS)
 
 inline int thread_create( OS_thread_t * thread, boost::ipwinapiext::LPTHREAD_START_ROUTINE_ start_routine, void* arg )
@@ -24,6 +24,7 @@
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/interprocess_recursive_mutex.hpp>
 #include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/timed_utils.hpp>
 #include <boost/interprocess/detail/os_file_functions.hpp>
 #include <boost/interprocess/detail/shared_dir_helpers.hpp>
 #include <boost/interprocess/detail/intermodule_singleton.hpp>
@@ -33,6 +34,15 @@
 #include <boost/interprocess/sync/detail/common_algorithms.hpp>
 #include <string>
 
+//Robust emulation detects the death of the owner of a mutex checking if the process
+//whose pid is stored in the mutex is still alive and, if the platform can
+//tell it, if it was started when the mutex was locked (so that a process that reuses
+//the pid is not taken as the owner). The pid and the start time are stored in a
+//single word, so that a process that dies while taking the ownership never leaves
+//a partially written owner. Define BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES
+//to use the previous mechanism: each process holds a locked file named after its pid,
+//so that the owner is dead if its file can be locked.
+
 namespace boost{
 namespace interprocess{
 namespace ipcdetail{
@@ -47,6 +57,70 @@ class mutex_traits
    {  t.take_ownership(); }
 };
 
+#if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
+
+//Start time of a process (zero if unknown), truncated to the 32 bits stored
+//with the pid of the owner. A process that reuses the pid of a dead owner is only
+//taken as the owner if its start time is the same modulo 2^32 clock units (100Hz
+//ticks since boot in Linux, that wrap after 497 days, 100ns units in Windows),
+//so the truncation just makes the (already unlikely) match possible.
+inline boost::uint32_t process_start_time32(OS_process_id_t pid)
+{  return static_cast<boost::uint32_t>(get_process_start_time(pid));  }
+
+//Start time of the current process, cached per process
+inline boost::uint32_t current_process_start_time()
+{
+   static volatile boost::uint32_t cached_pid = 0u;
+   static volatile boost::uint32_t cached_start = 0u;
+   const OS_process_id_t pid = get_current_process_id();
+   //The cache of a forked child holds the values of its parent
+   if(atomic_read32(&cached_pid) != static_cast<boost::uint32_t>(pid)){
+      atomic_write32(&cached_start, process_start_time32(pid));
+      atomic_write32(&cached_pid, static_cast<boost::uint32_t>(pid));
+   }
+   return atomic_read32(&cached_start);
+}
+
+//Owners (pid and start time) whose start time was recently checked, so that waiters
+//of a contended mutex don't read the start time of the owner in each check. A
+//process that reuses the pid of a dead owner is detected when its entry expires.
+class verified_owner_cache
+{
+   static const unsigned int num_entries = 16u;
+   static const boost::uint64_t expiration_us = 1000000u;
+
+   struct entry
+   {
+      volatile boost::uint64_t m_owner;
+      volatile boost::uint64_t m_time;
+   };
+
+   static entry &get_entry(boost::uint64_t own)
+   {
+      static entry entries[num_entries];
+      return entries[static_cast<boost::uint32_t>(own) % num_entries];
+   }
+
+   public:
+   static bool is_verified(boost::uint64_t own)
+   {
+      entry &e = get_entry(own);
+      //Entries are not updated atomically, but concurrent updates
+      //only pair an owner with the time another owner was checked
+      return atomic_read64(&e.m_owner) == own &&
+             universal_time_u64_us() - atomic_read64(&e.m_time) < expiration_us;
+   }
+
+   static void set_verified(boost::uint64_t own)
+   {
+      entry &e = get_entry(own);
+      atomic_write64(&e.m_time, universal_time_u64_us());
+      atomic_write64(&e.m_owner, own);
+   }
+};
+
+#endif   //#if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
+
 inline void remove_if_can_lock_file(const char *file_path)
 {
    file_handle_t fhnd = open_existing_file(file_path, read_write);
@@ -201,28 +275,73 @@ class robust_spin_mutex
    bool previous_owner_dead();
 
    private:
+   //Failed lock attempts between checks of the owner
    static const unsigned int spin_threshold = 100u;
+   static boost::uint64_t current_owner();
+   static boost::uint64_t invalid_owner();
+   static OS_process_id_t owner_pid(boost::uint64_t own);
    bool lock_own_unique_file();
-   bool robust_check();
-   bool check_if_owner_dead_and_take_ownership_atomically();
-   bool is_owner_dead(boost::uint32_t own);
-   void owner_to_filename(boost::uint32_t own, std::string &s);
+   bool robust_check(boost::uint64_t cur_owner);
+   bool check_if_owner_dead_and_take_ownership_atomically(boost::uint64_t cur_owner);
+   bool is_owner_dead(boost::uint64_t own);
+   void owner_to_filename(boost::uint64_t own, std::string &s);
    //The real mutex
    Mutex mtx;
-   //The pid of the owner
-   volatile boost::uint32_t owner;
+   //The pid of the owner in the lower half and its
+   //start time (zero if unknown) in the upper half
+   volatile boost::uint64_t owner;
    //The state of the mutex (correct, fixing, broken)
    volatile boost::uint32_t state;
 };
 
 template<class Mutex>
 inline robust_spin_mutex<Mutex>::robust_spin_mutex()
-   : mtx(), owner((boost::uint32_t)get_invalid_process_id()), state(correct_state)
+   : mtx(), owner(invalid_owner()), state(correct_state)
 {}
 
+template<class Mutex>
+inline boost::uint64_t robust_spin_mutex<Mutex>::current_owner()
+{
+   const boost::uint64_t pid = static_cast<boost::uint32_t>(get_current_process_id());
+   #if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
+   return pid | (boost::uint64_t(robust_emulation_helpers::current_process_start_time()) << 32u);
+   #else
+   return pid;
+   #endif
+}
+
+template<class Mutex>
+inline boost::uint64_t robust_spin_mutex<Mutex>::invalid_owner()
+{  return static_cast<boost::uint32_t>(get_invalid_process_id());  }
+
+template<class Mutex>
+inline OS_process_id_t robust_spin_mutex<Mutex>::owner_pid(boost::uint64_t own)
+{  return static_cast<OS_process_id_t>(static_cast<boost::uint32_t>(own));  }
+
 template<class Mutex>
 inline void robust_spin_mutex<Mutex>::lock()
-{  try_based_lock(*this);  }
+{
+   if(this->try_lock()){
+      return;
+   }
+   const boost::uint64_t cur_owner = current_owner();
+   //Checking the owner is expensive compared to a lock try,
+   //so only check it every spin_threshold tries
+   spin_wait swait;
+   for(unsigned int tries = 1u; ; ++tries){
+      if(atomic_read32(&this->state) == broken_state){
+         throw interprocess_exception(lock_error, "Broken id");
+      }
+      if(mtx.try_lock()){
+         atomic_write64(&this->owner, cur_owner);
+         return;
+      }
+      if(!(tries % spin_threshold) && this->robust_check(cur_owner)){
+         return;
+      }
+      swait.yield();
+   }
+}
 
 template<class Mutex>
 inline bool robust_spin_mutex<Mutex>::try_lock()
@@ -236,12 +355,14 @@ inline bool robust_spin_mutex<Mutex>::try_lock()
       throw interprocess_exception(lock_error, "Broken id");
    }
 
+   //Obtained before locking, as the start time might need a system call
+   const boost::uint64_t cur_owner = current_owner();
    if (mtx.try_lock()){
-      atomic_write32(&this->owner, static_cast<boost::uint32_t>(get_current_process_id()));
+      atomic_write64(&this->owner, cur_owner);
       return true;
    }
    else{
-      if(!this->robust_check()){
+      if(!this->robust_check(cur_owner)){
          return false;
       }
       else{
@@ -257,18 +378,18 @@ inline bool robust_spin_mutex<Mutex>::timed_lock
 {  return try_based_timed_lock(*this, abs_time);   }
 
 template<class Mutex>
-inline void robust_spin_mutex<Mutex>::owner_to_filename(boost::uint32_t own, std::string &s)
+inline void robust_spin_mutex<Mutex>::owner_to_filename(boost::uint64_t own, std::string &s)
 {
-   robust_emulation_helpers::create_and_get_robust_lock_file_path(s, (OS_process_id_t)own);
+   robust_emulation_helpers::create_and_get_robust_lock_file_path(s, owner_pid(own));
 }
 
 template<class Mutex>
-inline bool robust_spin_mutex<Mutex>::robust_check()
+inline bool robust_spin_mutex<Mutex>::robust_check(boost::uint64_t cur_owner)
 {
    //If the old owner was dead, and we've acquired ownership, mark
    //the mutex as 'fixing'. This means that a "consistent()" is needed
    //to avoid marking the mutex as "broken" when the mutex is unlocked.
-   if(!this->check_if_owner_dead_and_take_ownership_atomically()){
+   if(!this->check_if_owner_dead_and_take_ownership_atomically(cur_owner)){
       return false;
    }
    atomic_write32(&this->state, fixing_state);
@@ -276,10 +397,10 @@ inline bool robust_spin_mutex<Mutex>::robust_check()
 }
 
 template<class Mutex>
-inline bool robust_spin_mutex<Mutex>::check_if_owner_dead_and_take_ownership_atomically()
+inline bool robust_spin_mutex<Mutex>::check_if_owner_dead_and_take_ownership_atomically
+   (boost::uint64_t cur_owner)
 {
-   boost::uint32_t cur_owner = static_cast<boost::uint32_t>(get_current_process_id());
-   boost::uint32_t old_owner = atomic_read32(&this->owner), old_owner2;
+   boost::uint64_t old_owner = atomic_read64(&this->owner), old_owner2;
    //The cas loop guarantees that only one thread from this or another process
    //will succeed taking ownership
    do{
@@ -287,9 +408,9 @@ inline bool robust_spin_mutex<Mutex>::check_if_owner_dead_and_take_ownership_ato
       if(!this->is_owner_dead(old_owner)){
          return false;
       }
-      //If it's dead, try to mark this process as the owner in the owner field
+      //If it's dead, try to mark this process (and its start time) as the owner
       old_owner2 = old_owner;
-      old_owner = atomic_cas32(&this->owner, cur_owner, old_owner);
+      old_owner = atomic_cas64(&this->owner, cur_owner, old_owner);
    }while(old_owner2 != old_owner);
    //If success, we fix mutex internals to assure our ownership
    mutex_traits_t::take_ownership(mtx);
@@ -297,13 +418,33 @@ inline bool robust_spin_mutex<Mutex>::check_if_owner_dead_and_take_ownership_ato
 }
 
 template<class Mutex>
-inline bool robust_spin_mutex<Mutex>::is_owner_dead(boost::uint32_t own)
+inline bool robust_spin_mutex<Mutex>::is_owner_dead(boost::uint64_t own)
 {
    //If owner is an invalid id, then it's clear it's dead
-   if(own == static_cast<boost::uint32_t>(get_invalid_process_id())){
+   if(own == invalid_owner()){
       return true;
    }
 
+   #if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
+   const OS_process_id_t pid = owner_pid(own);
+   if(!is_process_alive(pid)){
+      return true;
+   }
+   //The process is alive, but its pid might have been reused
+   const boost::uint32_t start = static_cast<boost::uint32_t>(own >> 32u);
+   if(!start || robust_emulation_helpers::verified_owner_cache::is_verified(own)){
+      return false;
+   }
+   const boost::uint32_t cur_start = robust_emulation_helpers::process_start_time32(pid);
+   if(!cur_start){
+      return false;
+   }
+   else if(cur_start != start){
+      return true;
+   }
+   robust_emulation_helpers::verified_owner_cache::set_verified(own);
+   return false;
+   #else
    //Obtain the lock filename of the owner field
    std::string file;
    this->owner_to_filename(own, file);
@@ -332,6 +473,7 @@ inline bool robust_spin_mutex<Mutex>::is_owner_dead(boost::uint32_t own)
       }
    }
    return false;
+   #endif   //#if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
 }
 
 template<class Mutex>
@@ -340,7 +482,7 @@ inline void robust_spin_mutex<Mutex>::consistent()
    //This function supposes the previous state was "fixing"
    //and the current process holds the mutex
    if(atomic_read32(&this->state) != fixing_state &&
-      atomic_read32(&this->owner) != (boost::uint32_t)get_current_process_id()){
+      owner_pid(atomic_read64(&this->owner)) != get_current_process_id()){
       throw interprocess_exception(lock_error, "Broken id");
    }
    //If that's the case, just update mutex state
@@ -364,18 +506,23 @@ inline void robust_spin_mutex<Mutex>::unlock()
       atomic_write32(&this->state, broken_state);
    }
    //Write an invalid owner to minimize pid reuse possibility
-   atomic_write32(&this->owner, static_cast<boost::uint32_t>(get_invalid_process_id()));
+   atomic_write64(&this->owner, invalid_owner());
    mtx.unlock();
 }
 
 template<class Mutex>
 inline bool robust_spin_mutex<Mutex>::lock_own_unique_file()
 {
+   #if defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
    //This function forces instantiation of the singleton
    robust_emulation_helpers::robust_mutex_lock_file* dummy =
       &ipcdetail::intermodule_singleton
          <robust_emulation_helpers::robust_mutex_lock_file>::get();
    return dummy != 0;
+   #else
+   //No lock file is needed to check the liveness of this process
+   return true;
+   #endif
 }
 
 }  //namespace ipcdetail{
@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_SEGMENT_BASE_HPP
+#define BOOST_INTERPROCESS_DETAIL_SEGMENT_BASE_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/interprocess_fwd.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+
+// Maximum alignment used to scale compact_offset_ptr offsets
+#ifndef BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_MAX_SCALE
+   #define BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_MAX_SCALE 8u
+#endif
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//Per process base address of the segment that compact_offset_ptr
+//pointers with tag SegmentTag point to.
+template<class SegmentTag>
+struct compact_offset_ptr_base
+{
+   static char *value;
+   //Number of managed segment objects attached to the base
+   static boost::uint32_t attached;
+   //Protects the base and the count
+   static volatile boost::uint32_t lock;
+};
+
+template<class SegmentTag>
+char *compact_offset_ptr_base<SegmentTag>::value = 0;
+
+template<class SegmentTag>
+boost::uint32_t compact_offset_ptr_base<SegmentTag>::attached = 0u;
+
+template<class SegmentTag>
+volatile boost::uint32_t compact_offset_ptr_base<SegmentTag>::lock = 0u;
+
+//Called by managed segments with the address of the segment manager and the
+//size of the memory it manages before constructing or connecting to it, and
+//when they are closed. Pointers that are not relative to a segment base ignore it.
+template<class VoidPointer>
+struct segment_base_hook
+{
+   static void attach(void *, std::size_t)
+   {}
+
+   static void check_size(void *, std::size_t)
+   {}
+
+   static void detach(void *)
+   {}
+};
+
+template<class SegmentTag>
+struct segment_base_hook< compact_offset_ptr<void, SegmentTag> >
+{
+   typedef compact_offset_ptr_base<SegmentTag> base_t;
+
+   //Offsets are scaled, so the base must be aligned to the maximum scale
+   static char *base_of(void *addr)
+   {
+      return reinterpret_cast<char*>
+         (reinterpret_cast<uintptr_t>(addr) & ~uintptr_t(BOOST_INTERPROCESS_COMPACT_OFFSET_PTR_MAX_SCALE - 1u));
+   }
+
+   //Pointers to void and char are not scaled, so every byte of the segment
+   //must be at less than 2^31 - 1 bytes (the largest offset) from the base
+   static void check_size(void *addr, std::size_t size)
+   {
+      const std::size_t max_size = 0x7FFFFFFFu;
+      const std::size_t skipped = std::size_t(static_cast<char*>(addr) - base_of(addr));
+      if(size > max_size - skipped){
+         throw interprocess_exception(error_info(size_error), "Segment too big for compact_offset_ptr");
+      }
+   }
+
+   //Only one segment per SegmentTag can be used at the same time
+   static void attach(void *addr, std::size_t size)
+   {
+      check_size(addr, size);
+      char *const base = base_of(addr);
+      priv_lock();
+      if(base_t::attached && base_t::value != base){
+         priv_unlock();
+         throw interprocess_exception(error_info(already_exists_error), "Another segment uses the same compact_offset_ptr tag");
+      }
+      base_t::value = base;
+      ++base_t::attached;
+      priv_unlock();
+   }
+
+   static void detach(void *)
+   {
+      priv_lock();
+      if(base_t::attached && !--base_t::attached){
+         base_t::value = 0;
+      }
+      priv_unlock();
+   }
+
+   private:
+   static void priv_lock()
+   {
+      spin_wait swait;
+      while(atomic_cas32(&base_t::lock, 1u, 0u) != 0u){
+         swait.yield();
+      }
+   }
+
+   static void priv_unlock()
+   {  atomic_write32(&base_t::lock, 0u);  }
+};
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_SEGMENT_BASE_HPP
@@ -278,6 +278,7 @@ enum section_information_class
 #include <boost/winapi/get_current_thread_id.hpp>
 #include <boost/winapi/get_current_process.hpp>
 #include <boost/winapi/get_process_times.hpp>
+#include <boost/winapi/process.hpp>
 #include <boost/winapi/error_codes.hpp>
 #include <boost/winapi/thread.hpp>
 #include <boost/winapi/system.hpp>
@@ -513,6 +514,7 @@ static const unsigned long error_sharing_violation_sleep_ms = 250L;
 static const unsigned long error_file_too_large = 223L;
 static const unsigned long error_insufficient_buffer = 122L;
 static const unsigned long error_handle_eof = 38L;
+static const unsigned long error_access_denied = 5L;
 static const unsigned long semaphore_all_access = (0x000F0000L)|(0x00100000L)|0x3;
 static const unsigned long mutex_all_access     = (0x000F0000L)|(0x00100000L)|0x0001;
 
@@ -571,6 +573,8 @@ static const unsigned long file_attribute_temporary   = 0x00000100;
 
 static const unsigned long generic_read         = 0x80000000L;
 static const unsigned long generic_write        = 0x40000000L;
+static const unsigned long synchronize_access   = 0x00100000L;
+static const unsigned long process_query_limited_information = 0x00001000L;
 
 static const unsigned long wait_object_0        = 0;
 static const unsigned long wait_abandoned       = 0x00000080L;
@@ -616,6 +620,9 @@ static const unsigned long file_begin     = 0;
 static const unsigned long file_current   = 1;
 static const unsigned long file_end       = 2;
 
+static const unsigned long movefile_replace_existing  = 0x00000001;
+static const unsigned long movefile_write_through     = 0x00000008;
+
 static const unsigned long lockfile_fail_immediately  = 1;
 static const unsigned long lockfile_exclusive_lock    = 2;
 static const unsigned long error_lock_violation       = 33;
@@ -709,6 +716,9 @@ inline unsigned long get_current_process_id()
 inline bool close_handle(void* handle)
 {  return CloseHandle(handle) != 0;   }
 
+inline void *open_process(unsigned long access, bool inherit, unsigned long pid)
+{  return boost::winapi::OpenProcess(access, inherit, pid);  }
+
 inline void * find_first_file(const char *lpFileName, win32_find_data_a *lpFindFileData)
 {  return FindFirstFileA(lpFileName, lpFindFileData);   }
 
@@ -864,6 +874,10 @@ inline bool flush_file_buffers(void *handle)
 inline bool get_file_size(void *handle, __int64 &size)
 {  return 0 != boost::winapi::GetFileSizeEx(handle, (boost::winapi::LARGE_INTEGER_*)&size);  }
 
+template<class CharT>
+inline bool move_file(const CharT *existing_name, const CharT *new_name, unsigned long flags)
+{  return 0 != boost::winapi::move_file(existing_name, new_name, flags);  }
+
 template<class CharT>
 inline bool create_directory(const CharT *name)
 {
@@ -90,6 +90,13 @@
       #define BOOST_INTERPROCESS_POSIX_ROBUST_MUTEXES
    #endif
 
+   //////////////////////////////////////////////////////
+   // _POSIX_THREAD_PRIO_INHERIT (priority inheritance mutexes)
+   //////////////////////////////////////////////////////
+   #if defined(_POSIX_THREAD_PRIO_INHERIT) && ((_POSIX_THREAD_PRIO_INHERIT + 0) > 0)
+      #define BOOST_INTERPROCESS_POSIX_PRIO_INHERIT
+   #endif
+
    //////////////////////////////////////////////////////
    // _POSIX_SHARED_MEMORY_OBJECTS (POSIX.1b/POSIX.4)
    //////////////////////////////////////////////////////
@@ -182,6 +189,13 @@
    #define BOOST_INTERPROCESS_POSIX_FALLOCATE
    #endif
 
+   //////////////////////////////////////////////////////
+   //Linux futexes, shared between processes
+   //////////////////////////////////////////////////////
+   #if defined(__linux__) && !defined(BOOST_INTERPROCESS_DISABLE_FUTEX)
+   #define BOOST_INTERPROCESS_HAS_FUTEX
+   #endif
+
 #endif   //!defined(BOOST_INTERPROCESS_WINDOWS)
 
 #if defined(BOOST_INTERPROCESS_WINDOWS) || defined(BOOST_INTERPROCESS_POSIX_MAPPED_FILES)
@@ -203,6 +217,16 @@
    #define BOOST_INTERPROCESS_TIMEOUT_WHEN_LOCKING_DURATION_MS 10000
 #endif
 
+// Destructive interference size used by cache_aligned and cache_aligned_allocator.
+// Apple Silicon and POWER use 128 byte cache lines.
+#ifndef BOOST_INTERPROCESS_CACHE_LINE_SIZE
+   #if (defined(__APPLE__) && defined(__aarch64__)) || defined(__powerpc64__) || defined(_ARCH_PPC64)
+      #define BOOST_INTERPROCESS_CACHE_LINE_SIZE 128u
+   #else
+      #define BOOST_INTERPROCESS_CACHE_LINE_SIZE 64u
+   #endif
+#endif
+
 
 // Max open or create tries with managed memory segments
 #ifndef BOOST_INTERPROCESS_MANAGED_OPEN_OR_CREATE_INITIALIZE_MAX_TRIES
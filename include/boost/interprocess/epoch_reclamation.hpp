@@ -0,0 +1,441 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_EPOCH_RECLAMATION_HPP
+#define BOOST_INTERPROCESS_EPOCH_RECLAMATION_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/cache_aligned.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/container/detail/placement_new.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+
+//!\file
+//!Describes epoch_reclamation_domain, a safe memory reclamation scheme for
+//!lock-free structures placed in managed segments.
+
+namespace boost {
+namespace interprocess {
+
+//!Lock-free structures can't deallocate an unlinked node immediately, as
+//!other threads or processes might still be reading it.
+//!epoch_reclamation_domain defers the deallocation of retired nodes until no
+//!reader can hold a reference to them, using epoch-based reclamation:
+//!
+//! - Each thread that accesses the structure acquires a participant, which
+//!   owns one of the MaxParticipants slots of the domain.
+//! - Readers enclose accesses in a critical section (see guard), which
+//!   only publishes the current global epoch in the slot: readers never take locks.
+//! - Writers retire unlinked blocks, tagging them with the current epoch.
+//!   The global epoch advances when all participants in a critical section
+//!   have observed it, and blocks retired two epochs ago are returned to the
+//!   segment manager with deallocate().
+//!
+//!Slots of processes that die, even inside a critical section, are detected
+//!(the owner process identifier is stored in the slot) and reclaimed
+//!along with their retired blocks, so a crashed process does not block
+//!reclamation forever. Process identifiers can be reused by the operating
+//!system, which can only delay the reclamation of a slot.
+//!
+//!The domain must be constructed in the segment managed by SegmentManager,
+//!e.g. with find_or_construct.
+template<class SegmentManager, std::size_t MaxParticipants = 64u>
+class epoch_reclamation_domain
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   BOOST_INTERPROCESS_STATIC_ASSERT(MaxParticipants != 0u);
+
+   //Non-copyable
+   epoch_reclamation_domain(const epoch_reclamation_domain &);
+   epoch_reclamation_domain &operator=(const epoch_reclamation_domain &);
+
+   typedef typename SegmentManager::void_pointer                     void_pointer;
+   typedef typename boost::intrusive::pointer_traits
+      <void_pointer>::template rebind_pointer<SegmentManager>::type  segment_manager_ptr;
+
+   struct retired_node;
+   typedef typename boost::intrusive::pointer_traits
+      <void_pointer>::template rebind_pointer<retired_node>::type    node_ptr;
+
+   struct retired_node
+   {
+      node_ptr          next;
+      void_pointer      block;
+      boost::uint32_t   epoch;
+   };
+
+   //Values of the owner field that are not process identifiers
+   static const boost::uint32_t free_slot     = 0u;
+   static const boost::uint32_t orphan_slot   = 0xFFFFFFFFu;
+   static const boost::uint32_t adopting_slot = 0xFFFFFFFEu;
+
+   //Epochs are stored in the upper 31 bits of the local epoch,
+   //the lowest bit marks an active critical section
+   static const boost::uint32_t epoch_mask    = 0x7FFFFFFFu;
+
+   struct slot
+   {
+      slot()
+         : owner(free_slot), local_epoch(0u), num_retired(0u), retired()
+      {}
+
+      volatile boost::uint32_t owner;
+      volatile boost::uint32_t local_epoch;
+      volatile boost::uint32_t num_retired;
+      node_ptr                 retired;
+   };
+
+   //Each slot is written by a different thread, avoid false sharing
+   typedef cache_aligned<slot> aligned_slot;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   class participant;
+
+   //!Maximum number of simultaneous participants
+   static const std::size_t max_participants = MaxParticipants;
+
+   //!participant::retire() calls participant::reclaim()
+   //!once every reclaim_threshold calls
+   static const std::size_t reclaim_threshold = 64u;
+
+   //!Constructs the domain. "segment_mngr" is the segment manager
+   //!of the segment where the domain is placed. Never throws.
+   explicit epoch_reclamation_domain(SegmentManager *segment_mngr)
+      : m_global_epoch(0u), mp_segment_mngr(segment_mngr)
+   {}
+
+   //!Deallocates all retired blocks. No participant must be alive.
+   ~epoch_reclamation_domain()
+   {
+      for(std::size_t i = 0; i != MaxParticipants; ++i){
+         this->priv_deallocate_list(ipcdetail::to_raw_pointer(m_slots[i]->retired));
+      }
+   }
+
+   //!Returns the number of blocks retired and not yet deallocated
+   //!by all participants. Never throws.
+   std::size_t num_retired() const
+   {
+      std::size_t n = 0;
+      for(std::size_t i = 0; i != MaxParticipants; ++i){
+         n += ipcdetail::atomic_read32(&const_cast<slot&>(*m_slots[i]).num_retired);
+      }
+      return n;
+   }
+
+   //!A participant owns a slot of the domain and is used by a single thread
+   //!to enter critical sections and retire blocks. It's a process-local object.
+   class participant
+   {
+      #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+      //Non-copyable
+      participant(const participant &);
+      participant &operator=(const participant &);
+      friend class epoch_reclamation_domain;
+      #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+      public:
+      //!Acquires a free slot of "domain", or the slot of a dead process.
+      //!Throws interprocess_exception if all slots are in use.
+      explicit participant(epoch_reclamation_domain &domain)
+         : mp_domain(&domain)
+         , mp_slot(domain.priv_acquire_slot())
+         , m_nesting(0u)
+         , m_num_retires(0u)
+      {}
+
+      //!Tries to deallocate pending retired blocks and releases the slot.
+      //!Blocks that can't be reclaimed yet are left to other participants.
+      //!Must be called out of any critical section.
+      ~participant()
+      {
+         BOOST_ASSERT(!m_nesting);
+         this->reclaim();
+         mp_domain->priv_release_slot(*mp_slot);
+      }
+
+      //!Enters a critical section. Blocks that are reachable from the protected
+      //!structure when the call returns won't be deallocated until leave() is
+      //!called. Critical sections can be nested. Never throws.
+      void enter()
+      {
+         if(!m_nesting++){
+            mp_domain->priv_enter(*mp_slot);
+         }
+      }
+
+      //!Leaves a critical section. Never throws.
+      void leave()
+      {
+         BOOST_ASSERT(m_nesting);
+         if(!--m_nesting){
+            ipcdetail::atomic_write32(&mp_slot->local_epoch, 0u);
+         }
+      }
+
+      //!Schedules the deallocation of "block", that must have been allocated with
+      //!the segment manager of the domain and must be unreachable for new readers.
+      //!The block is deallocated with SegmentManager::deallocate, destructors are not run.
+      //!Throws if the bookkeeping node can't be allocated (and "block" is not retired).
+      void retire(void *block)
+      {
+         mp_domain->priv_retire(*mp_slot, block);
+         if(++m_num_retires >= reclaim_threshold){
+            m_num_retires = 0u;
+            this->reclaim();
+         }
+      }
+
+      //!Tries to advance the global epoch and deallocates the blocks retired by
+      //!this participant that are no longer reachable. Adopts the blocks retired
+      //!by dead processes and released participants. Returns the number of
+      //!deallocated blocks. The global epoch can't advance while this participant
+      //!is inside a critical section.
+      std::size_t reclaim()
+      {
+         return mp_domain->priv_reclaim(*mp_slot);
+      }
+
+      //!Returns the number of blocks retired by this participant
+      //!that have not been deallocated. Never throws.
+      std::size_t num_retired() const
+      {  return mp_slot->num_retired;  }
+
+      #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+      private:
+      epoch_reclamation_domain  *mp_domain;
+      slot                      *mp_slot;
+      std::size_t                m_nesting;
+      std::size_t                m_num_retires;
+      #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   };
+
+   //!Enters a critical section of a participant on construction and leaves it
+   //!on destruction.
+   class guard
+   {
+      #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+      //Non-copyable
+      guard(const guard &);
+      guard &operator=(const guard &);
+      #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+      public:
+      //!Calls p.enter(). Never throws.
+      explicit guard(participant &p)
+         : mp_participant(&p)
+      {  p.enter();  }
+
+      //!Calls leave() in the participant. Never throws.
+      ~guard()
+      {  mp_participant->leave();  }
+
+      #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+      private:
+      participant *mp_participant;
+      #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   };
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   static boost::uint32_t priv_current_owner()
+   {  return static_cast<boost::uint32_t>(ipcdetail::get_current_process_id());  }
+
+   static bool priv_is_dead(boost::uint32_t owner)
+   {
+      return owner != free_slot && owner != orphan_slot && owner != adopting_slot &&
+             owner != priv_current_owner() &&
+             !ipcdetail::is_process_alive(static_cast<ipcdetail::OS_process_id_t>(owner));
+   }
+
+   slot *priv_acquire_slot()
+   {
+      const boost::uint32_t me = priv_current_owner();
+      //First free and released slots, then slots of dead processes
+      for(int pass = 0; pass != 2; ++pass){
+         for(std::size_t i = 0; i != MaxParticipants; ++i){
+            slot &s = *m_slots[i];
+            const boost::uint32_t owner = ipcdetail::atomic_read32(&s.owner);
+            const bool candidate = (owner == free_slot || owner == orphan_slot) ||
+                                   (pass && priv_is_dead(owner));
+            if(candidate && ipcdetail::atomic_cas32(&s.owner, me, owner) == owner){
+               //Pending blocks are inherited. A dead owner might have
+               //died inside a critical section.
+               ipcdetail::atomic_write32(&s.local_epoch, 0u);
+               return &s;
+            }
+         }
+      }
+      throw interprocess_exception(other_error, "epoch_reclamation_domain: no free participant slot");
+   }
+
+   void priv_release_slot(slot &s)
+   {
+      ipcdetail::atomic_write32(&s.local_epoch, 0u);
+      ipcdetail::atomic_write32(&s.owner, s.retired ? orphan_slot : free_slot);
+   }
+
+   void priv_enter(slot &s)
+   {
+      boost::uint32_t e = ipcdetail::atomic_read32(&m_global_epoch);
+      boost::uint32_t old = ipcdetail::atomic_read32(&s.local_epoch);
+      for(;;){
+         const boost::uint32_t announced = boost::uint32_t(e << 1u) | 1u;
+         //The compare and swap is a full barrier: the announcement is visible
+         //before any access to the protected structure
+         const boost::uint32_t prev = ipcdetail::atomic_cas32(&s.local_epoch, announced, old);
+         if(prev != old){
+            //Only this thread writes the local epoch unless the slot is adopted
+            //because it was wrongly considered dead, just retry
+            old = prev;
+            continue;
+         }
+         old = announced;
+         //If the epoch advanced while announcing, the announcement might
+         //have been ignored by the thread that advanced it
+         const boost::uint32_t now = ipcdetail::atomic_read32(&m_global_epoch);
+         if(now == e){
+            break;
+         }
+         e = now;
+      }
+   }
+
+   void priv_retire(slot &s, void *block)
+   {
+      SegmentManager *const sm = ipcdetail::to_raw_pointer(mp_segment_mngr);
+      retired_node *const n = static_cast<retired_node*>(sm->allocate(sizeof(retired_node)));
+      ::new(n, boost_container_new_t()) retired_node;
+      n->block = block;
+      n->epoch = ipcdetail::atomic_read32(&m_global_epoch);
+      n->next  = s.retired;
+      s.retired = n;
+      ipcdetail::atomic_write32(&s.num_retired, s.num_retired + 1u);
+   }
+
+   //Moves the retired blocks of "from", owned by "owner", to "to"
+   void priv_adopt(slot &to, slot &from, boost::uint32_t owner)
+   {
+      if(ipcdetail::atomic_cas32(&from.owner, adopting_slot, owner) != owner){
+         return;
+      }
+      retired_node *n = ipcdetail::to_raw_pointer(from.retired);
+      if(n){
+         retired_node *last = n;
+         while(last->next){
+            last = ipcdetail::to_raw_pointer(last->next);
+         }
+         last->next = to.retired;
+         to.retired = n;
+         ipcdetail::atomic_write32(&to.num_retired, to.num_retired + from.num_retired);
+      }
+      from.retired = node_ptr();
+      ipcdetail::atomic_write32(&from.num_retired, 0u);
+      ipcdetail::atomic_write32(&from.local_epoch, 0u);
+      ipcdetail::atomic_write32(&from.owner, free_slot);
+   }
+
+   //Advances the global epoch if all active participants have observed it
+   void priv_try_advance(slot &me)
+   {
+      const boost::uint32_t e = ipcdetail::atomic_read32(&m_global_epoch);
+      for(std::size_t i = 0; i != MaxParticipants; ++i){
+         slot &s = *m_slots[i];
+         const boost::uint32_t local = ipcdetail::atomic_read32(&s.local_epoch);
+         if((local & 1u) && (local >> 1u) != e){
+            const boost::uint32_t owner = ipcdetail::atomic_read32(&s.owner);
+            if(&s == &me || !priv_is_dead(owner)){
+               return;
+            }
+            //A process died inside a critical section
+            this->priv_adopt(me, s, owner);
+         }
+      }
+      ipcdetail::atomic_cas32(&m_global_epoch, (e + 1u) & epoch_mask, e);
+   }
+
+   std::size_t priv_reclaim(slot &me)
+   {
+      //Adopt blocks of released slots and dead processes
+      for(std::size_t i = 0; i != MaxParticipants; ++i){
+         slot &s = *m_slots[i];
+         if(&s != &me && ipcdetail::atomic_read32(&s.num_retired)){
+            const boost::uint32_t owner = ipcdetail::atomic_read32(&s.owner);
+            if(owner == orphan_slot || priv_is_dead(owner)){
+               this->priv_adopt(me, s, owner);
+            }
+         }
+      }
+      this->priv_try_advance(me);
+
+      //Blocks retired two epochs ago can't be reachable
+      const boost::uint32_t e = ipcdetail::atomic_read32(&m_global_epoch);
+      std::size_t freed = 0;
+      node_ptr *link = &me.retired;
+      while(retired_node *n = ipcdetail::to_raw_pointer(*link)){
+         if(((e - n->epoch) & epoch_mask) >= 2u){
+            //Unlink first: a crash leaks the node but never frees it twice
+            *link = n->next;
+            ipcdetail::atomic_write32(&me.num_retired, me.num_retired - 1u);
+            this->priv_deallocate_node(n);
+            ++freed;
+         }
+         else{
+            link = &n->next;
+         }
+      }
+      return freed;
+   }
+
+   void priv_deallocate_node(retired_node *n)
+   {
+      SegmentManager *const sm = ipcdetail::to_raw_pointer(mp_segment_mngr);
+      sm->deallocate(ipcdetail::to_raw_pointer(n->block));
+      n->~retired_node();
+      sm->deallocate(n);
+   }
+
+   void priv_deallocate_list(retired_node *n)
+   {
+      while(n){
+         retired_node *const next = ipcdetail::to_raw_pointer(n->next);
+         this->priv_deallocate_node(n);
+         n = next;
+      }
+   }
+
+   volatile boost::uint32_t   m_global_epoch;
+   segment_manager_ptr        mp_segment_mngr;
+   aligned_slot               m_slots[MaxParticipants];
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_EPOCH_RECLAMATION_HPP
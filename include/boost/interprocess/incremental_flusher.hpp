@@ -0,0 +1,351 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_HPP
+#define BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+//!\file
+//!Describes incremental_flusher, a class that writes back to disk only the
+//!modified portions of a managed mapped file, optionally from a background thread.
+
+// Default number of pages per dirty-tracking granule
+#ifndef BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_GRANULE_PAGES
+   #define BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_GRANULE_PAGES 16u
+#endif
+
+namespace boost {
+namespace interprocess {
+
+//!Flushing a big managed_mapped_file with flush() writes back the whole mapping,
+//!stalling the caller. incremental_flusher tracks which parts of the segment were
+//!modified (the user marks them calling mark_dirty()) and writes back only those
+//!ranges, coalescing adjacent ones, either in the calling thread (flush()) or in
+//!a background thread (async_flush()). Tickets returned by async_flush() allow
+//!waiting for durability points.
+//!
+//!ManagedMappedFile must offer get_address(), get_size() and
+//!flush(offset, numbytes, async), like basic_managed_mapped_file.
+//!
+//!Dirty-range tracking is local to the process and to the incremental_flusher
+//!object. The object must be destroyed before the managed segment.
+template<class ManagedMappedFile>
+class incremental_flusher
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   incremental_flusher(const incremental_flusher &);
+   incremental_flusher &operator=(const incremental_flusher &);
+
+   typedef boost::uint32_t                         word_t;
+   typedef std::pair<std::size_t, std::size_t>     range_t;
+   typedef std::vector<range_t>                    range_vector_t;
+   static const std::size_t BitsPerWord = 32u;
+
+   struct job
+   {
+      boost::uint64_t ticket;
+      range_vector_t  ranges;
+   };
+
+   struct worker
+   {
+      explicit worker(incremental_flusher &f)
+         : mp_flusher(&f)
+      {}
+
+      void operator()()
+      {  mp_flusher->priv_run();  }
+
+      incremental_flusher *mp_flusher;
+   };
+
+   typedef scoped_lock<interprocess_mutex> lock_t;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Identifies an asynchronous flush request. Tickets increase monotonically.
+   typedef boost::uint64_t ticket_type;
+
+   //!Prepares dirty tracking for the whole segment using granules of granule_size bytes
+   //!(rounded up to a multiple of the page size). If granule_size is zero,
+   //!BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_GRANULE_PAGES pages are used.
+   //!The background thread is only launched on the first call to async_flush().
+   //!Throws std::bad_alloc if the tracking bitmap can't be allocated.
+   explicit incremental_flusher(ManagedMappedFile &mfile, std::size_t granule_size = 0u)
+      : m_mfile(mfile)
+      , m_granule(priv_granule_size(granule_size))
+      , m_num_granules((mfile.get_size() + m_granule - 1u)/m_granule)
+      , m_bits((m_num_granules + BitsPerWord - 1u)/BitsPerWord, 0u)
+      , m_last_ticket(0u)
+      , m_done_ticket(0u)
+      , m_error(false)
+      , m_stop(false)
+      , m_thread_launched(false)
+   {}
+
+   //!Waits until pending asynchronous flushes are completed and stops
+   //!the background thread. Ranges marked but not flushed are not written.
+   ~incremental_flusher()
+   {
+      {
+         lock_t lck(m_mut);
+         m_stop = true;
+         m_cond.notify_all();
+      }
+      if(m_thread_launched){
+         ipcdetail::thread_join(m_thread);
+      }
+   }
+
+   //!Returns the size of the tracking granule in bytes
+   std::size_t granule_size() const
+   {  return m_granule;  }
+
+   //!Marks the range [addr, addr + numbytes) of the segment as modified.
+   //!Can be called concurrently from several threads. Never throws.
+   void mark_dirty(const void *addr, std::size_t numbytes)
+   {
+      const char *const base = static_cast<const char*>(m_mfile.get_address());
+      const char *const p    = static_cast<const char*>(addr);
+      BOOST_ASSERT(p >= base && std::size_t(p - base) + numbytes <= m_mfile.get_size());
+      if(numbytes){
+         this->priv_mark(std::size_t(p - base), numbytes);
+      }
+   }
+
+   //!Returns the number of bytes (in granules) currently marked as modified.
+   //!Never throws.
+   std::size_t dirty_bytes() const
+   {
+      std::size_t n = 0u;
+      for(std::size_t i = 0; i != m_bits.size(); ++i){
+         for(word_t w = ipcdetail::atomic_read32(priv_word(i)); w; w &= w - 1u){
+            ++n;
+         }
+      }
+      return n*m_granule;
+   }
+
+   //!Writes back the ranges marked as modified in the calling thread and
+   //!waits until previously requested asynchronous flushes are completed.
+   //!Returns true if all data marked before the call has been written.
+   //!Ranges that could not be written are marked again.
+   bool flush()
+   {
+      range_vector_t ranges;
+      ticket_type previous;
+      {
+         lock_t lck(m_mut);
+         this->priv_collect(ranges);
+         previous = m_last_ticket;
+      }
+      bool ok = this->priv_flush_ranges(ranges);
+      lock_t lck(m_mut);
+      while(m_done_ticket < previous){
+         m_cond.wait(lck);
+      }
+      ok = ok && !m_error;
+      m_error = false;
+      return ok;
+   }
+
+   //!Hands the ranges currently marked as modified to the background thread,
+   //!which writes them back synchronously, and returns immediately.
+   //!The returned ticket can be passed to wait() or is_complete().
+   //!Throws interprocess_exception if the background thread can't be launched.
+   ticket_type async_flush()
+   {
+      lock_t lck(m_mut);
+      if(!m_thread_launched){
+         if(0 != ipcdetail::thread_launch(m_thread, worker(*this))){
+            throw interprocess_exception(other_error);
+         }
+         m_thread_launched = true;
+      }
+      m_jobs.push_back(job());
+      job &j = m_jobs.back();
+      j.ticket = ++m_last_ticket;
+      this->priv_collect(j.ranges);
+      m_cond.notify_all();
+      return j.ticket;
+   }
+
+   //!Returns true if the asynchronous flush identified by t
+   //!(and all previous ones) has been completed. Never throws.
+   bool is_complete(ticket_type t)
+   {
+      lock_t lck(m_mut);
+      return m_done_ticket >= t;
+   }
+
+   //!Waits until the asynchronous flush identified by t (and all previous ones)
+   //!has been completed. Returns false if any flush completed since the last call
+   //!to wait(), barrier() or flush() failed (failed ranges are marked again).
+   bool wait(ticket_type t)
+   {
+      lock_t lck(m_mut);
+      while(m_done_ticket < t){
+         m_cond.wait(lck);
+      }
+      const bool ok = !m_error;
+      m_error = false;
+      return ok;
+   }
+
+   //!Durability point: equivalent to wait(async_flush()).
+   bool barrier()
+   {  return this->wait(this->async_flush());  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+
+   static std::size_t priv_granule_size(std::size_t granule_size)
+   {
+      const std::size_t page = mapped_region::get_page_size();
+      if(!granule_size){
+         return page*BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_GRANULE_PAGES;
+      }
+      return ((granule_size - 1u)/page + 1u)*page;
+   }
+
+   volatile word_t *priv_word(std::size_t i) const
+   {  return const_cast<volatile word_t*>(&m_bits[i]);  }
+
+   void priv_mark(std::size_t offset, std::size_t numbytes)
+   {
+      const std::size_t last = (offset + numbytes - 1u)/m_granule;
+      for(std::size_t g = offset/m_granule; g <= last; ++g){
+         volatile word_t *const w = priv_word(g/BitsPerWord);
+         const word_t mask = word_t(1u) << (g % BitsPerWord);
+         word_t old = ipcdetail::atomic_read32(w);
+         while(!(old & mask)){
+            const word_t prev = ipcdetail::atomic_cas32(w, old | mask, old);
+            if(prev == old)
+               break;
+            old = prev;
+         }
+      }
+   }
+
+   //Atomically clears the dirty bitmap and appends the coalesced dirty ranges
+   void priv_collect(range_vector_t &ranges)
+   {
+      const std::size_t size = m_mfile.get_size();
+      for(std::size_t i = 0; i != m_bits.size(); ++i){
+         volatile word_t *const w = priv_word(i);
+         word_t old = ipcdetail::atomic_read32(w);
+         while(old){
+            const word_t prev = ipcdetail::atomic_cas32(w, 0u, old);
+            if(prev == old)
+               break;
+            old = prev;
+         }
+         for(std::size_t b = 0; old; ++b, old >>= 1u){
+            if(old & 1u){
+               const std::size_t offset = (i*BitsPerWord + b)*m_granule;
+               const std::size_t bytes  = (size - offset) < m_granule ? (size - offset) : m_granule;
+               if(!ranges.empty() && (ranges.back().first + ranges.back().second) == offset){
+                  ranges.back().second += bytes;
+               }
+               else{
+                  ranges.push_back(range_t(offset, bytes));
+               }
+            }
+         }
+      }
+   }
+
+   bool priv_flush_ranges(const range_vector_t &ranges)
+   {
+      bool ok = true;
+      for(std::size_t i = 0; i != ranges.size(); ++i){
+         if(!m_mfile.flush(ranges[i].first, ranges[i].second, false)){
+            this->priv_mark(ranges[i].first, ranges[i].second);
+            ok = false;
+         }
+      }
+      return ok;
+   }
+
+   void priv_run()
+   {
+      lock_t lck(m_mut);
+      for(;;){
+         while(m_jobs.empty() && !m_stop){
+            m_cond.wait(lck);
+         }
+         if(m_jobs.empty()){
+            break;
+         }
+         range_vector_t ranges;
+         ranges.swap(m_jobs.front().ranges);
+         const ticket_type t = m_jobs.front().ticket;
+         m_jobs.pop_front();
+         lck.unlock();
+         const bool ok = this->priv_flush_ranges(ranges);
+         lck.lock();
+         m_error = m_error || !ok;
+         m_done_ticket = t;
+         m_cond.notify_all();
+      }
+   }
+
+   ManagedMappedFile      &m_mfile;
+   const std::size_t       m_granule;
+   const std::size_t       m_num_granules;
+   std::vector<word_t>     m_bits;
+   interprocess_mutex      m_mut;
+   interprocess_condition  m_cond;
+   std::deque<job>         m_jobs;
+   ticket_type             m_last_ticket;
+   ticket_type             m_done_ticket;
+   bool                    m_error;
+   bool                    m_stop;
+   bool                    m_thread_launched;
+   ipcdetail::OS_thread_t  m_thread;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+template<class ManagedMappedFile>
+const std::size_t incremental_flusher<ManagedMappedFile>::BitsPerWord;
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_HPP
@@ -27,6 +27,7 @@
 //! \file
 //! This header file forward declares the basic interprocess types:
 //!   - boost::interprocess::offset_ptr;
+//!   - boost::interprocess::compact_offset_ptr;
 //!   - boost::interprocess::permissions;
 //!   - boost::interprocess::mapped_region;
 //!   - boost::interprocess::file_mapping;
@@ -50,6 +51,7 @@
 //!
 //! The following mutex families:
 //!   - boost::interprocess::mutex_family;
+//!   - boost::interprocess::queue_mutex_family;
 //!   - boost::interprocess::null_mutex_family;
 //!
 //! The following allocators:
@@ -60,6 +62,7 @@
 //!   - boost::interprocess::adaptive_pool;
 //!   - boost::interprocess::private_adaptive_pool;
 //!   - boost::interprocess::cached_adaptive_pool;
+//!   - boost::interprocess::cache_aligned_allocator;
 //!
 //! The following allocation algorithms:
 //!   - boost::interprocess::simple_seq_fit;
@@ -184,6 +187,7 @@ class named_semaphore;
 //////////////////////////////////////////////////////////////////////////////
 
 struct mutex_family;
+struct queue_mutex_family;
 struct null_mutex_family;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -234,6 +238,9 @@ template< class T, class SegmentManager, std::size_t NodesPerBlock = 64
         , std::size_t MaxFreeBlocks = 2, unsigned char OverheadPercent = 5 >
 class cached_adaptive_pool;
 
+template<class T, class SegmentManager, std::size_t Alignment = BOOST_INTERPROCESS_CACHE_LINE_SIZE>
+class cache_aligned_allocator;
+
 
 //////////////////////////////////////////////////////////////////////////////
 //                            offset_ptr
@@ -253,6 +260,9 @@ template < class T, class DifferenceType = std::ptrdiff_t
          , class OffsetType = uintptr_t, std::size_t Alignment = offset_type_alignment>
 class offset_ptr;
 
+template <class T, class SegmentTag = void>
+class compact_offset_ptr;
+
 //////////////////////////////////////////////////////////////////////////////
 //                    Memory allocation algorithms
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,541 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_BROADCAST_RING_HPP
+#define BOOST_INTERPROCESS_BROADCAST_RING_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/cache_aligned.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstring>
+
+//!\file
+//!Describes broadcast_ring, a single writer ring buffer whose messages
+//!are received by all the attached readers.
+
+namespace boost {
+namespace interprocess {
+
+//!A ring buffer placed in a managed segment where a single writer publishes
+//!messages that are received by every attached reader, so a stream can be
+//!fanned out to many processes copying each message only once, instead of
+//!sending it to a message_queue per consumer.
+//!
+//!The ring has a fixed number of slots of max_msg_size bytes. Each message
+//!receives a sequence number and each reader tracks the sequence number of
+//!the next message it will receive, so readers are independent and don't
+//!modify any shared state but their own cursor: readers never take locks and
+//!can read messages in place, without copying them.
+//!
+//!When the ring is full, the overflow policy chosen on construction decides:
+//!
+//! - wait_for_readers: the writer waits until the slowest reader receives
+//!   the oldest message, so no message is lost (backpressure).
+//! - overwrite_oldest: the writer never waits. Readers that are lapped by the
+//!   writer skip the overwritten messages and count them as lost.
+//!
+//!Readers are attached with the process-local reader class, which owns one of
+//!the MaxReaders cursors of the ring. Cursors of processes that die are
+//!released by the writer, so a crashed reader does not block the writer forever.
+//!
+//!Only one thread can send messages at a time. Waiting operations spin and
+//!yield, like the spin family of synchronization primitives.
+template<class SegmentManager, std::size_t MaxReaders = 32u>
+class broadcast_ring
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   BOOST_INTERPROCESS_STATIC_ASSERT(MaxReaders != 0u);
+
+   //Non-copyable
+   broadcast_ring(const broadcast_ring &);
+   broadcast_ring &operator=(const broadcast_ring &);
+
+   typedef typename SegmentManager::void_pointer                     void_pointer;
+   typedef typename boost::intrusive::pointer_traits
+      <void_pointer>::template rebind_pointer<SegmentManager>::type  segment_manager_ptr;
+   typedef typename boost::intrusive::pointer_traits
+      <void_pointer>::template rebind_pointer<char>::type            char_ptr;
+
+   //Placed before the payload of each slot. "seq" is 2*n + 1 while
+   //message n is being written and 2*n + 2 once it is complete.
+   struct slot_header
+   {
+      volatile boost::uint64_t seq;
+      boost::uint64_t          size;
+   };
+
+   //Values of the owner field that are not process identifiers
+   static const boost::uint32_t free_owner       = 0u;
+   static const boost::uint32_t releasing_owner  = 0xFFFFFFFFu;
+
+   //Cursor of a slot that is not used by a reader
+   static const boost::uint64_t detached_cursor  = ~boost::uint64_t(0u);
+
+   struct reader_slot
+   {
+      reader_slot()
+         : owner(free_owner), cursor(detached_cursor)
+      {}
+
+      volatile boost::uint32_t owner;
+      volatile boost::uint64_t cursor;
+   };
+
+   struct writer_state
+   {
+      writer_state()
+         : published(0u), min_cursor(0u)
+      {}
+
+      volatile boost::uint64_t published;
+      //Minimum reader cursor found by the last scan
+      boost::uint64_t          min_cursor;
+   };
+
+   //Cursors are written by each reader and the sequence by the writer, avoid false sharing
+   typedef cache_aligned<reader_slot>  aligned_reader_slot;
+   typedef cache_aligned<writer_state> aligned_writer_state;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef std::size_t size_type;
+
+   //!What the writer does when the ring is full
+   enum overflow_policy
+   {
+      //!The writer waits until all readers have received the oldest message
+      wait_for_readers,
+      //!The oldest message is overwritten and lapped readers lose it
+      overwrite_oldest
+   };
+
+   //!Maximum number of simultaneous readers
+   static const size_type max_readers = MaxReaders;
+
+   class reader;
+
+   //!Constructs a ring of "num_slots" messages of up to "max_msg_size" bytes.
+   //!"segment_mngr" is the segment manager of the segment where the ring is placed,
+   //!the slots are allocated from it.
+   //!Throws if num_slots is zero or the allocation throws.
+   broadcast_ring( SegmentManager *segment_mngr, size_type num_slots, size_type max_msg_size
+                 , overflow_policy policy = wait_for_readers)
+      : mp_segment_mngr(segment_mngr)
+      , m_num_slots(num_slots)
+      , m_max_msg_size(max_msg_size)
+      , m_slot_stride(priv_slot_stride(max_msg_size))
+      , m_policy(policy)
+      , mp_slots()
+   {
+      if(!num_slots){
+         throw interprocess_exception(other_error, "broadcast_ring: zero slots");
+      }
+      void *const mem = segment_mngr->allocate_aligned(num_slots*m_slot_stride, BOOST_INTERPROCESS_CACHE_LINE_SIZE);
+      std::memset(mem, 0, num_slots*m_slot_stride);
+      mp_slots = static_cast<char*>(mem);
+   }
+
+   //!Deallocates the slots. No reader or writer must be using the ring.
+   ~broadcast_ring()
+   {  ipcdetail::to_raw_pointer(mp_segment_mngr)->deallocate(ipcdetail::to_raw_pointer(mp_slots));  }
+
+   //!Returns the number of slots. Never throws.
+   size_type num_slots() const
+   {  return m_num_slots;  }
+
+   //!Returns the maximum size of a message. Never throws.
+   size_type max_msg_size() const
+   {  return m_max_msg_size;  }
+
+   //!Returns the overflow policy. Never throws.
+   overflow_policy policy() const
+   {  return m_policy;  }
+
+   //!Returns the number of messages published since the ring was constructed. Never throws.
+   boost::uint64_t sequence() const
+   {  return ipcdetail::atomic_read64(&m_writer->published);  }
+
+   //!Returns the number of attached readers. Never throws.
+   size_type num_readers() const
+   {
+      size_type n = 0u;
+      for(std::size_t i = 0; i != MaxReaders; ++i){
+         const boost::uint32_t owner = ipcdetail::atomic_read32(&m_readers[i]->owner);
+         n += owner != free_owner && owner != releasing_owner;
+      }
+      return n;
+   }
+
+   //!Publishes a copy of "size" bytes of "buffer". If the policy is
+   //!wait_for_readers and the ring is full, waits until there is a free slot.
+   //!Throws interprocess_exception if size is greater than max_msg_size().
+   void send(const void *buffer, size_type size)
+   {
+      this->priv_check_size(size);
+      spin_wait swait;
+      while(!this->priv_writable()){
+         swait.yield();
+      }
+      this->priv_publish(buffer, size);
+   }
+
+   //!Publishes a copy of "size" bytes of "buffer". If the policy is
+   //!wait_for_readers and the ring is full, returns false immediately.
+   //!Throws interprocess_exception if size is greater than max_msg_size().
+   bool try_send(const void *buffer, size_type size)
+   {
+      this->priv_check_size(size);
+      if(!this->priv_writable())
+         return false;
+      this->priv_publish(buffer, size);
+      return true;
+   }
+
+   //!Publishes a copy of "size" bytes of "buffer". If the policy is
+   //!wait_for_readers and the ring is full, waits until there is a free slot
+   //!or abs_time is reached. Returns false on timeout.
+   //!Throws interprocess_exception if size is greater than max_msg_size().
+   template<class TimePoint>
+   bool timed_send(const void *buffer, size_type size, const TimePoint &abs_time)
+   {
+      this->priv_check_size(size);
+      spin_wait swait;
+      while(!this->priv_writable()){
+         if(!is_pos_infinity(abs_time) && !(ipcdetail::microsec_clock<TimePoint>::universal_time() < abs_time))
+            return false;
+         swait.yield();
+      }
+      this->priv_publish(buffer, size);
+      return true;
+   }
+
+   //!Receives the messages of a broadcast_ring. Each reader owns a cursor of
+   //!the ring and receives all messages published after it was attached.
+   //!It's a process-local object that must be used by a single thread.
+   class reader
+   {
+      #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+      //Non-copyable
+      reader(const reader &);
+      reader &operator=(const reader &);
+      #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+      public:
+      //!Attaches to "ring" acquiring a free cursor or the cursor of a dead process.
+      //!The first received message will be the next published one.
+      //!Throws interprocess_exception if all cursors are in use.
+      explicit reader(broadcast_ring &ring)
+         : mp_ring(&ring), mp_slot(ring.priv_acquire_slot()), m_cursor(), m_lost(0u), m_peeked(false)
+      {
+         //The writer can miss a cursor stored concurrently with a scan, so
+         //retry until no message was published while the cursor was stored.
+         boost::uint64_t p = ring.sequence();
+         for(;;){
+            ipcdetail::atomic_write64(&mp_slot->cursor, p);
+            const boost::uint64_t p2 = ring.sequence();
+            if(p2 == p)
+               break;
+            p = p2;
+         }
+         m_cursor = p;
+      }
+
+      //!Releases the cursor. Never throws.
+      ~reader()
+      {
+         ipcdetail::atomic_write64(&mp_slot->cursor, detached_cursor);
+         ipcdetail::atomic_write32(&mp_slot->owner, free_owner);
+      }
+
+      //!Returns the number of published messages not received yet,
+      //!including the ones that will be lost if the reader was lapped. Never throws.
+      boost::uint64_t available() const
+      {  return mp_ring->sequence() - m_cursor;  }
+
+      //!Returns the number of messages that were overwritten before
+      //!being received (overwrite_oldest policy). Never throws.
+      boost::uint64_t lost() const
+      {  return m_lost;  }
+
+      //!Copies the next message to "buffer" and stores its size in "recvd_size".
+      //!Returns false if there is no message.
+      //!Throws interprocess_exception if buffer_size is less than the size of the message.
+      bool try_receive(void *buffer, size_type buffer_size, size_type &recvd_size)
+      {
+         BOOST_ASSERT(!m_peeked);
+         for(;;){
+            slot_header *const h = this->priv_next();
+            if(!h)
+               return false;
+            const size_type size = static_cast<size_type>(h->size);
+            if(size > buffer_size || size > mp_ring->m_max_msg_size){
+               //The size is not valid if the writer overwrote the slot meanwhile
+               if(!this->priv_intact(h)){
+                  this->priv_skip();
+                  continue;
+               }
+               throw interprocess_exception(size_error);
+            }
+            std::memcpy(buffer, h + 1, size);
+            //Discard the copy if the writer overwrote the slot meanwhile
+            if(this->priv_consume(h)){
+               recvd_size = size;
+               return true;
+            }
+         }
+      }
+
+      //!Copies the next message to "buffer" and stores its size in "recvd_size",
+      //!waiting until a message is published.
+      //!Throws interprocess_exception if buffer_size is less than the size of the message.
+      void receive(void *buffer, size_type buffer_size, size_type &recvd_size)
+      {
+         spin_wait swait;
+         while(!this->try_receive(buffer, buffer_size, recvd_size)){
+            swait.yield();
+         }
+      }
+
+      //!Copies the next message to "buffer" and stores its size in "recvd_size",
+      //!waiting until a message is published or abs_time is reached.
+      //!Returns false on timeout.
+      //!Throws interprocess_exception if buffer_size is less than the size of the message.
+      template<class TimePoint>
+      bool timed_receive(void *buffer, size_type buffer_size, size_type &recvd_size, const TimePoint &abs_time)
+      {
+         spin_wait swait;
+         while(!this->try_receive(buffer, buffer_size, recvd_size)){
+            if(!is_pos_infinity(abs_time) && !(ipcdetail::microsec_clock<TimePoint>::universal_time() < abs_time))
+               return false;
+            swait.yield();
+         }
+         return true;
+      }
+
+      //!Returns a pointer to the next message in the ring and stores its
+      //!size in "size", or a null pointer if there is no message.
+      //!The message is not copied and must be released with release() before
+      //!receiving another message. Never throws.
+      const void *try_peek(size_type &size)
+      {
+         BOOST_ASSERT(!m_peeked);
+         for(;;){
+            slot_header *const h = this->priv_next();
+            if(!h)
+               return 0;
+            size = static_cast<size_type>(h->size);
+            //The writer never writes a bigger size, so the slot is being overwritten
+            if(size > mp_ring->m_max_msg_size){
+               this->priv_skip();
+               continue;
+            }
+            m_peeked = true;
+            return h + 1;
+         }
+      }
+
+      //!Consumes the message returned by try_peek(). With the overwrite_oldest
+      //!policy, returns false if the writer overwrote the message while it was
+      //!being read, so the data read might be inconsistent and the message is
+      //!counted as lost. Never throws.
+      bool release()
+      {
+         BOOST_ASSERT(m_peeked);
+         m_peeked = false;
+         return this->priv_consume(mp_ring->priv_slot(m_cursor));
+      }
+
+      #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+      private:
+      //Returns the header of the message at the cursor, skipping lost messages
+      slot_header *priv_next()
+      {
+         for(;;){
+            const boost::uint64_t published = mp_ring->sequence();
+            if(m_cursor == published)
+               return 0;
+            if(published - m_cursor > mp_ring->m_num_slots){
+               m_lost += published - mp_ring->m_num_slots - m_cursor;
+               this->priv_set_cursor(published - mp_ring->m_num_slots);
+            }
+            slot_header *const h = mp_ring->priv_slot(m_cursor);
+            if(ipcdetail::atomic_read64(&h->seq) == 2u*m_cursor + 2u)
+               return h;
+            //Overwritten after the sequence was read
+            this->priv_skip();
+         }
+      }
+
+      //Returns true if the message at the cursor was not overwritten
+      //while its size and payload were read
+      bool priv_intact(slot_header *h) const
+      {
+         //Reads of the message must not be reordered after the check
+         ipcdetail::atomic_fence();
+         return ipcdetail::atomic_read64(&h->seq) == 2u*m_cursor + 2u;
+      }
+
+      //Advances the cursor, returns false if the message was overwritten
+      bool priv_consume(slot_header *h)
+      {
+         const bool intact = this->priv_intact(h);
+         m_lost += !intact;
+         this->priv_set_cursor(m_cursor + 1u);
+         return intact;
+      }
+
+      //Counts the message at the cursor as lost
+      void priv_skip()
+      {
+         ++m_lost;
+         this->priv_set_cursor(m_cursor + 1u);
+      }
+
+      void priv_set_cursor(boost::uint64_t c)
+      {
+         m_cursor = c;
+         ipcdetail::atomic_write64(&mp_slot->cursor, c);
+      }
+
+      broadcast_ring  *mp_ring;
+      reader_slot     *mp_slot;
+      boost::uint64_t  m_cursor;
+      boost::uint64_t  m_lost;
+      bool             m_peeked;
+      #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   };
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   static size_type priv_slot_stride(size_type max_msg_size)
+   {
+      const size_type line = BOOST_INTERPROCESS_CACHE_LINE_SIZE;
+      return ((sizeof(slot_header) + max_msg_size - 1u)/line + 1u)*line;
+   }
+
+   static boost::uint32_t priv_current_owner()
+   {  return static_cast<boost::uint32_t>(ipcdetail::get_current_process_id());  }
+
+   static bool priv_is_dead(boost::uint32_t owner)
+   {
+      return owner != free_owner && owner != releasing_owner && owner != priv_current_owner() &&
+             !ipcdetail::is_process_alive(static_cast<ipcdetail::OS_process_id_t>(owner));
+   }
+
+   slot_header *priv_slot(boost::uint64_t seq) const
+   {
+      return reinterpret_cast<slot_header*>
+         (ipcdetail::to_raw_pointer(mp_slots) + static_cast<size_type>(seq % m_num_slots)*m_slot_stride);
+   }
+
+   void priv_check_size(size_type size) const
+   {
+      if(size > m_max_msg_size){
+         throw interprocess_exception(size_error);
+      }
+   }
+
+   reader_slot *priv_acquire_slot()
+   {
+      const boost::uint32_t me = priv_current_owner();
+      //First free slots, then slots of dead processes
+      for(int pass = 0; pass != 2; ++pass){
+         for(std::size_t i = 0; i != MaxReaders; ++i){
+            reader_slot &s = *m_readers[i];
+            const boost::uint32_t owner = ipcdetail::atomic_read32(&s.owner);
+            const bool candidate = owner == free_owner || (pass && priv_is_dead(owner));
+            if(candidate && ipcdetail::atomic_cas32(&s.owner, me, owner) == owner){
+               return &s;
+            }
+         }
+      }
+      throw interprocess_exception(other_error, "broadcast_ring: no free reader slot");
+   }
+
+   //Returns true if the next message can be published without
+   //overwriting a message that a reader has not received
+   bool priv_writable()
+   {
+      writer_state &w = *m_writer;
+      const boost::uint64_t seq = w.published;
+      if(m_policy == overwrite_oldest || seq - w.min_cursor < m_num_slots)
+         return true;
+
+      boost::uint64_t min_cursor = seq;
+      for(std::size_t i = 0; i != MaxReaders; ++i){
+         reader_slot &s = *m_readers[i];
+         const boost::uint64_t c = ipcdetail::atomic_read64(&s.cursor);
+         if(c == detached_cursor)
+            continue;
+         if(seq - c >= m_num_slots){
+            //Release the cursor if its owner died. The cursor is detached
+            //before the slot is freed so that a new owner's cursor is not overwritten.
+            const boost::uint32_t owner = ipcdetail::atomic_read32(&s.owner);
+            if(priv_is_dead(owner) && ipcdetail::atomic_cas32(&s.owner, releasing_owner, owner) == owner){
+               ipcdetail::atomic_write64(&s.cursor, detached_cursor);
+               ipcdetail::atomic_write32(&s.owner, free_owner);
+               continue;
+            }
+         }
+         if(c < min_cursor){
+            min_cursor = c;
+         }
+      }
+      w.min_cursor = min_cursor;
+      return seq - min_cursor < m_num_slots;
+   }
+
+   void priv_publish(const void *buffer, size_type size)
+   {
+      writer_state &w = *m_writer;
+      const boost::uint64_t seq = w.published;
+      slot_header *const h = this->priv_slot(seq);
+      ipcdetail::atomic_write64(&h->seq, 2u*seq + 1u);
+      h->size = size;
+      std::memcpy(h + 1, buffer, size);
+      ipcdetail::atomic_write64(&h->seq, 2u*seq + 2u);
+      ipcdetail::atomic_write64(&w.published, seq + 1u);
+   }
+
+   segment_manager_ptr           mp_segment_mngr;
+   const size_type               m_num_slots;
+   const size_type               m_max_msg_size;
+   const size_type               m_slot_stride;
+   const overflow_policy         m_policy;
+   char_ptr                      mp_slots;
+   mutable aligned_writer_state  m_writer;
+   mutable aligned_reader_slot   m_readers[MaxReaders];
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_BROADCAST_RING_HPP
@@ -38,11 +38,22 @@
 #include <boost/move/detail/type_traits.hpp> //make_unsigned, alignment_of
 #include <boost/intrusive/pointer_traits.hpp>
 #include <boost/move/detail/force_ptr.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/assert.hpp>
 #include <algorithm> //std::lower_bound
 #include <cstddef>   //std::size_t
 #include <cstring>   //memcpy
 
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+#  include <boost/interprocess/detail/shared_dir_helpers.hpp>
+#  include <string>
+#  include <cerrno>
+#  include <fcntl.h>       //open, O_*
+#  include <unistd.h>      //read, write, close, unlink
+#  include <sys/types.h>
+#  include <sys/stat.h>    //mkfifo
+#endif
+
 
 //!\file
 //!Describes an inter-process message queue. This class allows sending
@@ -56,11 +67,215 @@ namespace ipcdetail
    template<class VoidPointer>
    class msg_queue_initialization_func_t;
 
+//!Returns the mode of the fifo of a queue created with "perm".
+inline boost::uint32_t msg_queue_notify_mode(const permissions &perm)
+{
+   #if !defined(BOOST_INTERPROCESS_WINDOWS)
+   return static_cast<boost::uint32_t>(perm.get_permissions());
+   #else
+   (void)perm;
+   return 0u;
+   #endif
+}
+
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
+//!Process-local end of the notification channel of a named message queue:
+//!a named fifo placed in the shared directory, where a byte is written when
+//!a message is sent to an empty queue.
+class msg_queue_notifier
+{
+   //Non-copyable
+   msg_queue_notifier(const msg_queue_notifier &);
+   msg_queue_notifier &operator=(const msg_queue_notifier &);
+
+   public:
+   msg_queue_notifier()
+      : m_name(), m_rfd(-1), m_wfd(-1), m_wgen(0u)
+   {}
+
+   explicit msg_queue_notifier(const char *name)
+      : m_name(name), m_rfd(-1), m_wfd(-1), m_wgen(0u)
+   {}
+
+   ~msg_queue_notifier()
+   {
+      if(m_rfd >= 0)
+         ::close(m_rfd);
+      if(m_wfd >= 0)
+         ::close(m_wfd);
+   }
+
+   //!Creates the fifo with the permissions "mode" (those of the queue) if it does
+   //!not exist and returns a non-blocking descriptor to its read end. "created" is
+   //!set to true if this call created the fifo. Throws on error.
+   int get_read_end(boost::uint32_t mode, bool &created)
+   {
+      created = false;
+      if(m_rfd < 0){
+         if(m_name.empty()){
+            throw interprocess_exception(other_error, "message_queue: notifications need a named queue");
+         }
+         std::string path;
+         create_shared_dir_cleaning_old_and_get_filepath(priv_fifo_name(m_name.c_str()).c_str(), path);
+         const ::mode_t fifo_mode = static_cast< ::mode_t>(mode ? mode : 0644);
+         if(::mkfifo(path.c_str(), fifo_mode) == 0){
+            //The mode of the new fifo was filtered by the umask
+            ::chmod(path.c_str(), fifo_mode);
+            created = true;
+         }
+         else if(errno != EEXIST){
+            error_info err(system_error_code());
+            throw interprocess_exception(err);
+         }
+         m_rfd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+         if(m_rfd < 0){
+            error_info err(system_error_code());
+            throw interprocess_exception(err);
+         }
+      }
+      return m_rfd;
+   }
+
+   //!Writes a notification byte to the fifo whose generation is "gen". A full fifo
+   //!already has pending notifications so errors are ignored. Never throws.
+   void notify(boost::uint32_t gen)
+   {
+      if(m_name.empty())
+         return;
+      //The fifo might have been removed and created again, which changes its
+      //generation, so the cached descriptor is only reopened in that case or
+      //after a write fails for any reason other than a full fifo
+      if(m_wfd >= 0 && m_wgen != gen)
+         this->priv_close_write_end();
+      if(m_wfd < 0 && !this->priv_open_write_end(gen))
+         return;
+      if(!this->priv_write() && errno != EAGAIN){
+         this->priv_close_write_end();
+         if(this->priv_open_write_end(gen))
+            this->priv_write();
+      }
+   }
+
+   //!Discards pending notifications of the read end. Never throws.
+   void clear()
+   {
+      if(m_rfd < 0)
+         return;
+      char buf[64];
+      ssize_t r;
+      while((r = ::read(m_rfd, buf, sizeof(buf))) > 0 || (r < 0 && errno == EINTR)){}
+   }
+
+   //!Removes the fifo associated with a queue name. Never throws.
+   static void remove(const char *name)
+   {
+      BOOST_INTERPROCESS_TRY{
+         std::string path;
+         shared_filepath(priv_fifo_name(name).c_str(), path);
+         ::unlink(path.c_str());
+      }
+      BOOST_INTERPROCESS_CATCH(...){
+      } BOOST_INTERPROCESS_CATCH_END
+   }
+
+   private:
+   bool priv_open_write_end(boost::uint32_t gen)
+   {
+      if(m_wpath.empty()){
+         BOOST_INTERPROCESS_TRY{
+            shared_filepath(priv_fifo_name(m_name.c_str()).c_str(), m_wpath);
+         }
+         BOOST_INTERPROCESS_CATCH(...){
+            return false;
+         } BOOST_INTERPROCESS_CATCH_END
+      }
+      //Opened for reading and writing so that opening does not fail and writing
+      //does not raise SIGPIPE when no process has the read end open.
+      m_wfd = ::open(m_wpath.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+      m_wgen = gen;
+      return m_wfd >= 0;
+   }
+
+   bool priv_write()
+   {
+      const char c = 0;
+      ssize_t r;
+      while((r = ::write(m_wfd, &c, 1)) < 0 && errno == EINTR){}
+      return r == 1;
+   }
+
+   void priv_close_write_end()
+   {
+      if(m_wfd >= 0){
+         ::close(m_wfd);
+         m_wfd = -1;
+      }
+   }
+
+   static std::string priv_fifo_name(const char *name)
+   {
+      //Skip the leading slash some users add to POSIX names
+      std::string fifo_name(name + (*name == '/'));
+      fifo_name += ".mq_notify";
+      return fifo_name;
+   }
+
+   std::string m_name;
+   std::string m_wpath;
+   int m_rfd;
+   int m_wfd;
+   //Generation of the fifo opened by m_wfd
+   boost::uint32_t m_wgen;
+};
+
+#else
+
+class msg_queue_notifier
+{
+   public:
+   msg_queue_notifier()
+   {}
+
+   template<class CharT>
+   explicit msg_queue_notifier(const CharT *)
+   {}
+
+   void notify(boost::uint32_t)
+   {}
+
+   template<class CharT>
+   static void remove(const CharT *)
+   {}
+};
+
+#endif   //#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
 }
 
 //Blocking modes
 enum mqblock_types   {  blocking,   timed,   non_blocking   };
 
+//!Passed to message_queue_t constructors to store messages contiguously in
+//!a buffer of "bytes" bytes, each message using only the space needed for its
+//!length, instead of preallocating "max_num_msg" messages of "max_msg_size" bytes.
+class packed_message_storage
+{
+   public:
+   explicit packed_message_storage(std::size_t bytes)
+      : m_bytes(bytes)
+   {}
+
+   //!Returns the requested buffer size
+   std::size_t size() const
+   {  return m_bytes;  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   std::size_t m_bytes;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
 //!A class that allows sending messages
 //!between processes.
 template<class VoidPointer>
@@ -104,6 +319,29 @@ class message_queue_t
    //!throws an error.
    message_queue_t(open_only_t, const char *name);
 
+   //!Creates a process shared message queue with name "name" that stores messages
+   //!packed in a buffer of storage.size() bytes, rounded up to hold at least a message
+   //!of "max_msg_size" bytes. For this message queue, the maximum number of messages
+   //!will be "max_num_msg" and the maximum message size will be "max_msg_size".
+   //!Throws on error and if the queue was previously created.
+   message_queue_t(create_only_t,
+                 const char *name,
+                 size_type max_num_msg,
+                 size_type max_msg_size,
+                 const packed_message_storage &storage,
+                 const permissions &perm = permissions());
+
+   //!Opens or creates a process shared message queue with name "name".
+   //!If the queue is created, it stores messages packed in a buffer of storage.size()
+   //!bytes as in the create_only_t overload. If queue was previously created
+   //!the queue will be opened and the rest of parameters are ignored. Throws on error.
+   message_queue_t(open_or_create_t,
+                 const char *name,
+                 size_type max_num_msg,
+                 size_type max_msg_size,
+                 const packed_message_storage &storage,
+                 const permissions &perm = permissions());
+
    #if defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
    //!Creates a process shared message queue with name "name". For this message queue,
@@ -140,6 +378,35 @@ class message_queue_t
    //!      native wchar_t APIs (e.g. Windows).
    message_queue_t(open_only_t, const wchar_t *name);
 
+   //!Creates a process shared message queue with name "name" that stores messages
+   //!packed in a buffer of storage.size() bytes, rounded up to hold at least a message
+   //!of "max_msg_size" bytes. For this message queue, the maximum number of messages
+   //!will be "max_num_msg" and the maximum message size will be "max_msg_size".
+   //!Throws on error and if the queue was previously created.
+   //! 
+   //!Note: This function is only available on operating systems with
+   //!      native wchar_t APIs (e.g. Windows).
+   message_queue_t(create_only_t,
+                 const wchar_t *name,
+                 size_type max_num_msg,
+                 size_type max_msg_size,
+                 const packed_message_storage &storage,
+                 const permissions &perm = permissions());
+
+   //!Opens or creates a process shared message queue with name "name".
+   //!If the queue is created, it stores messages packed in a buffer of storage.size()
+   //!bytes as in the create_only_t overload. If queue was previously created
+   //!the queue will be opened and the rest of parameters are ignored. Throws on error.
+   //! 
+   //!Note: This function is only available on operating systems with
+   //!      native wchar_t APIs (e.g. Windows).
+   message_queue_t(open_or_create_t,
+                 const wchar_t *name,
+                 size_type max_num_msg,
+                 size_type max_msg_size,
+                 const packed_message_storage &storage,
+                 const permissions &perm = permissions());
+
    #endif //defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
    //!Creates a process shared message queue in anonymous memory. For this message queue,
@@ -148,6 +415,15 @@ class message_queue_t
    message_queue_t(size_type max_num_msg,
                  size_type max_msg_size);
 
+   //!Creates a process shared message queue in anonymous memory that stores messages
+   //!packed in a buffer of storage.size() bytes, rounded up to hold at least a message
+   //!of "max_msg_size" bytes. For this message queue, the maximum number of messages
+   //!will be "max_num_msg" and the maximum message size will be "max_msg_size".
+   //!Throws on error.
+   message_queue_t(size_type max_num_msg,
+                 size_type max_msg_size,
+                 const packed_message_storage &storage);
+
    //!Destroys *this and indicates that the calling process is finished using
    //!the resource. All opened message queues are still
    //!valid after destruction. The destructor function will deallocate
@@ -219,6 +495,37 @@ class message_queue_t
    //!Never throws
    size_type get_num_msg() const;
 
+   //!Returns true if the queue stores messages packed in a buffer
+   //!(see packed_message_storage). Never throws
+   bool is_packed() const;
+
+   #if !defined(BOOST_INTERPROCESS_WINDOWS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+   //!Returns a non-blocking file descriptor that becomes readable when a message
+   //!is sent to the queue while it's empty, so that the queue can be waited with
+   //!poll, epoll or similar event loops. The descriptor is owned by *this.
+   //!
+   //!Notifications are only written when the queue becomes non-empty, so after
+   //!the descriptor becomes readable, clear_notification() must be called and then
+   //!messages must be received with try_receive until the queue is empty.
+   //!If the queue already holds messages, this function writes a notification
+   //!so that the descriptor is readable.
+   //!
+   //!The first call creates a named fifo associated with the queue, which is
+   //!removed by remove(). Senders only write to the fifo once it's created.
+   //!Throws interprocess_exception on error or if the queue is anonymous.
+   //!
+   //!Note: This function is only available on POSIX systems.
+   int get_notification_handle();
+
+   //!Discards the pending notifications of the descriptor returned
+   //!by get_notification_handle(). Never throws.
+   //!
+   //!Note: This function is only available on POSIX systems.
+   void clear_notification();
+
+   #endif   //#if !defined(BOOST_INTERPROCESS_WINDOWS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
    //!Removes the message queue from the system.
    //!Returns false on error. Never throws
    static bool remove(const char *name);
@@ -250,9 +557,10 @@ class message_queue_t
 
    //!Returns the needed memory size for the shared message queue.
    //!Never throws
-   static size_type get_mem_size(size_type max_msg_size, size_type max_num_msg);
+   static size_type get_mem_size(size_type max_msg_size, size_type max_num_msg, size_type packed_size = 0u);
    typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> open_create_impl_t;
    open_create_impl_t m_shmem;
+   ipcdetail::msg_queue_notifier m_notifier;
 
    template<class Lock, class TimePoint>
    static bool do_cond_wait(ipcdetail::bool_<true>, interprocess_condition &cond, Lock &lock, const TimePoint &abs_time)
@@ -337,6 +645,22 @@ class priority_functor
 //!   An array of buffers of preallocated messages, each one prefixed with the
 //!   msg_hdr_t structure. Each of this message is pointed by one pointer of
 //!   the index structure.
+//!
+//!If the queue is packed (m_ring_size != 0), the array of messages is replaced by
+//!a circular buffer of m_ring_size bytes where messages are allocated in sending
+//!order, using only the space needed for their length:
+//!
+//!-> struct packed_block
+//!   {
+//!      size_type            block_size;  //Low bit set if the block is free
+//!      msg_hdr_t            header;
+//!      char[len]            data;
+//!   }
+//!
+//!   Free pointers of the index are null. Messages can be received out of
+//!   sending order due to priorities, so received blocks are only marked as free
+//!   and reclaimed when they reach the oldest position of the buffer. If a block does
+//!   not fit at the end of the buffer, the end is filled with a free block.
 template<class VoidPointer>
 class mq_hdr_t
    : public ipcdetail::priority_functor<VoidPointer>
@@ -353,6 +677,9 @@ class mq_hdr_t
    typedef typename boost::intrusive::
       pointer_traits<void_pointer>::template
          rebind_pointer<msg_hdr_ptr_t>::type                              msg_hdr_ptr_ptr_t;
+   typedef typename boost::intrusive::
+      pointer_traits<void_pointer>::template
+         rebind_pointer<char>::type                                        char_ptr;
    typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> open_create_impl_t;
 
    public:
@@ -360,13 +687,20 @@ class mq_hdr_t
    //!shared memory of the size returned by the function "get_mem_size".
    //!This constructor initializes the needed resources and creates
    //!the internal structures like the priority index. This can throw.
-   mq_hdr_t(size_type max_num_msg, size_type max_msg_size)
+   mq_hdr_t(size_type max_num_msg, size_type max_msg_size, size_type packed_size = 0u)
       : m_max_num_msg(max_num_msg)
       , m_max_msg_size(max_msg_size)
       , m_cur_num_msg(0)
       , m_cur_first_msg(0u)
       , m_blocked_senders(0u)
       , m_blocked_receivers(0u)
+      , mp_ring()
+      , m_ring_size(packed_size ? get_packed_ring_size(max_msg_size, packed_size) : 0u)
+      , m_ring_head(0u)
+      , m_ring_tail(0u)
+      , m_ring_used(0u)
+      , m_notify(0u)
+      , m_notify_mode(0u)
       {  this->initialize_memory();  }
 
    //!Returns true if the message queue is full
@@ -377,9 +711,25 @@ class mq_hdr_t
    bool is_empty() const
       {  return !m_cur_num_msg;  }
 
+   //!Returns true if messages are packed in a circular buffer
+   bool is_packed() const
+      {  return m_ring_size != 0u;  }
+
+   //!Returns true if a message of "len" bytes can be stored
+   bool has_room(size_type len) const
+   {
+      return !this->is_full() &&
+         (!this->is_packed() || this->packed_fits(get_packed_block_size(len)));
+   }
+
    //!Frees the top priority message and saves it in the free message list
    void free_top_msg()
-      {  --m_cur_num_msg;  }
+   {
+      if(this->is_packed()){
+         this->packed_deallocate(this->top_msg());
+      }
+      --m_cur_num_msg;
+   }
 
    typedef msg_hdr_ptr_t *iterator;
 
@@ -430,7 +780,7 @@ class mq_hdr_t
       }
    }
 
-   msg_header & insert_at(iterator where)
+   msg_hdr_ptr_t & insert_at(iterator where)
    {
       iterator it_inserted_ptr_end = this->inserted_ptr_end();
       iterator it_inserted_ptr_beg = this->inserted_ptr_begin();
@@ -439,11 +789,11 @@ class mq_hdr_t
          m_cur_first_msg = m_cur_first_msg ? m_cur_first_msg : m_max_num_msg;
          --m_cur_first_msg;
          ++m_cur_num_msg;
-         return *mp_index[difference_type(m_cur_first_msg)];
+         return mp_index[difference_type(m_cur_first_msg)];
       }
       else if(where == it_inserted_ptr_end){
          ++m_cur_num_msg;
-         return **it_inserted_ptr_end;
+         return *it_inserted_ptr_end;
       }
       else{
          size_type pos  = size_type(where - &mp_index[0]);
@@ -480,7 +830,7 @@ class mq_hdr_t
             m_cur_first_msg = m_cur_first_msg ? m_cur_first_msg : m_max_num_msg;
             --m_cur_first_msg;
             ++m_cur_num_msg;
-            return **where;
+            return *where;
          }
          else{
             //The queue can't be full so end_pos < m_cur_first_msg
@@ -505,13 +855,14 @@ class mq_hdr_t
                               , &mp_index[0] + first_segment_end + 1u);
             *where = backup;
             ++m_cur_num_msg;
-            return **where;
+            return *where;
          }
       }
    }
 
-   //!Inserts the first free message in the priority queue
-   msg_header & queue_free_msg(unsigned int priority)
+   //!Inserts the first free message in the priority queue and returns
+   //!the index position that points to it
+   msg_hdr_ptr_t & queue_free_msg(unsigned int priority)
    {
       //Get priority queue's range
       iterator it  (inserted_ptr_begin()), it_end(inserted_ptr_end());
@@ -541,19 +892,103 @@ class mq_hdr_t
    //!Returns the number of bytes needed to construct a message queue with
    //!"max_num_size" maximum number of messages and "max_msg_size" maximum
    //!message size. Never throws.
+   //!If "packed_size" is not zero, messages are packed in a buffer of that size.
    static size_type get_mem_size
-      (size_type max_msg_size, size_type max_num_msg)
+      (size_type max_msg_size, size_type max_num_msg, size_type packed_size = 0u)
    {
       const size_type
        msg_hdr_align  = ::boost::container::dtl::alignment_of<msg_header>::value,
        index_align    = ::boost::container::dtl::alignment_of<msg_hdr_ptr_t>::value,
          r_hdr_size     = ipcdetail::ct_rounded_size<sizeof(mq_hdr_t), index_align>::value,
          r_index_size   = ipcdetail::get_rounded_size<size_type>(max_num_msg*sizeof(msg_hdr_ptr_t), msg_hdr_align),
-         r_max_msg_size = ipcdetail::get_rounded_size<size_type>(max_msg_size, msg_hdr_align) + sizeof(msg_header);
-      return r_hdr_size + r_index_size + (max_num_msg*r_max_msg_size) +
+         r_max_msg_size = ipcdetail::get_rounded_size<size_type>(max_msg_size, msg_hdr_align) + sizeof(msg_header),
+         r_msgs_size    = packed_size ? get_packed_ring_size(max_msg_size, packed_size) : max_num_msg*r_max_msg_size;
+      return r_hdr_size + r_index_size + r_msgs_size +
          open_create_impl_t::ManagedOpenOrCreateUserOffset;
    }
 
+   //!Returns the number of bytes of a packed message of "len" bytes
+   static size_type get_packed_block_size(size_type len)
+   {
+      const size_type msg_hdr_align = ::boost::container::dtl::alignment_of<msg_header>::value;
+      return ipcdetail::get_rounded_size<size_type>(sizeof(size_type) + sizeof(msg_header) + len, msg_hdr_align);
+   }
+
+   //!Returns the size of the circular buffer, big enough for at least a message of "max_msg_size"
+   static size_type get_packed_ring_size(size_type max_msg_size, size_type packed_size)
+   {
+      const size_type msg_hdr_align = ::boost::container::dtl::alignment_of<msg_header>::value;
+      const size_type min_size = get_packed_block_size(max_msg_size);
+      const size_type r_packed_size = ipcdetail::get_rounded_size<size_type>(packed_size, msg_hdr_align);
+      return r_packed_size < min_size ? min_size : r_packed_size;
+   }
+
+   //!Returns true if a block of "block_size" bytes can be allocated in the circular buffer
+   bool packed_fits(size_type block_size) const
+   {
+      if(!m_ring_used){
+         return block_size <= m_ring_size;
+      }
+      else if(m_ring_tail < m_ring_head){
+         //Free space at the end and at the beginning of the buffer
+         return block_size <= (m_ring_size - m_ring_head) || block_size <= m_ring_tail;
+      }
+      else{
+         return block_size <= (m_ring_tail - m_ring_head);
+      }
+   }
+
+   //!Allocates a message of "len" bytes in the circular buffer.
+   //!packed_fits must have returned true. Never throws.
+   msg_header *packed_allocate(size_type len)
+   {
+      const size_type block_size = get_packed_block_size(len);
+      BOOST_ASSERT(this->packed_fits(block_size));
+      char *const ring = ipcdetail::to_raw_pointer(mp_ring);
+      if(m_ring_tail < m_ring_head && block_size > (m_ring_size - m_ring_head)){
+         //Wrap around, filling the end of the buffer with a free block
+         const size_type skip = m_ring_size - m_ring_head;
+         *move_detail::force_ptr<size_type*>(ring + m_ring_head) = skip | 1u;
+         m_ring_used += skip;
+         m_ring_head = 0u;
+      }
+      char *const block = ring + m_ring_head;
+      *move_detail::force_ptr<size_type*>(block) = block_size;
+      m_ring_used += block_size;
+      m_ring_head += block_size;
+      if(m_ring_head == m_ring_size){
+         m_ring_head = 0u;
+      }
+      msg_header *const hdr = move_detail::force_ptr<msg_header*>(block + sizeof(size_type));
+      hdr->len = 0u;
+      hdr->priority = 0u;
+      return hdr;
+   }
+
+   //!Frees a message allocated with packed_allocate and reclaims the
+   //!free blocks at the oldest position of the buffer. Never throws.
+   void packed_deallocate(msg_header &hdr)
+   {
+      char *const ring = ipcdetail::to_raw_pointer(mp_ring);
+      *move_detail::force_ptr<size_type*>(reinterpret_cast<char*>(&hdr) - sizeof(size_type)) |= 1u;
+      while(m_ring_used){
+         const size_type tagged_size = *move_detail::force_ptr<size_type*>(ring + m_ring_tail);
+         if(!(tagged_size & 1u)){
+            break;
+         }
+         const size_type block_size = tagged_size & ~size_type(1u);
+         m_ring_used -= block_size;
+         m_ring_tail += block_size;
+         if(m_ring_tail == m_ring_size){
+            m_ring_tail = 0u;
+         }
+      }
+      //Restart from the beginning to maximize contiguous space
+      if(!m_ring_used){
+         m_ring_head = m_ring_tail = 0u;
+      }
+   }
+
    //!Initializes the memory structures to preallocate messages and constructs the
    //!message index. Never throws.
    void initialize_memory()
@@ -576,6 +1011,15 @@ class mq_hdr_t
       //Initialize the pointer to the index
       mp_index             = index;
 
+      if(this->is_packed()){
+         //Messages will be allocated from the circular buffer
+         mp_ring = reinterpret_cast<char*>(msg_hdr);
+         for(size_type i = 0; i < m_max_num_msg; ++i){
+            index[i] = msg_hdr_ptr_t();
+         }
+         return;
+      }
+
       //Initialize the index so each slot points to a preallocated message
       for(size_type i = 0; i < m_max_num_msg; ++i){
          index[i] = msg_hdr;
@@ -603,6 +1047,21 @@ class mq_hdr_t
    size_type                  m_cur_first_msg;
    size_type                  m_blocked_senders;
    size_type                  m_blocked_receivers;
+   //Circular buffer of packed messages
+   char_ptr                   mp_ring;
+   //Size of the circular buffer, zero if messages are not packed
+   const size_type            m_ring_size;
+   //Offset where the next message will be allocated
+   size_type                  m_ring_head;
+   //Offset of the oldest allocated block
+   size_type                  m_ring_tail;
+   //Bytes between the tail and the head
+   size_type                  m_ring_used;
+   //Non-zero if senders must notify the fifo of the queue: the generation
+   //of the fifo, which changes each time a handle creates the fifo
+   boost::uint32_t            m_notify;
+   //Permissions of the fifo, those the queue was created with
+   boost::uint32_t            m_notify_mode;
 };
 
 
@@ -621,8 +1080,10 @@ class msg_queue_initialization_func_t
       make_unsigned<difference_type>::type                        size_type;
 
    msg_queue_initialization_func_t(size_type maxmsg = 0,
-                         size_type maxmsgsize = 0)
-      : m_maxmsg (maxmsg), m_maxmsgsize(maxmsgsize) {}
+                         size_type maxmsgsize = 0,
+                         size_type packedsize = 0,
+                         boost::uint32_t notify_mode = 0u)
+      : m_maxmsg (maxmsg), m_maxmsgsize(maxmsgsize), m_packedsize(packedsize), m_notify_mode(notify_mode) {}
 
    bool operator()(void *address, size_type, bool created)
    {
@@ -632,7 +1093,8 @@ class msg_queue_initialization_func_t
          mptr     = reinterpret_cast<char*>(address);
          //Construct the message queue header at the beginning
          BOOST_INTERPROCESS_TRY{
-            new (mptr) mq_hdr_t<VoidPointer>(m_maxmsg, m_maxmsgsize);
+            mq_hdr_t<VoidPointer> *const p_hdr = new (mptr) mq_hdr_t<VoidPointer>(m_maxmsg, m_maxmsgsize, m_packedsize);
+            p_hdr->m_notify_mode = m_notify_mode;
          }
          BOOST_INTERPROCESS_CATCH(...){
             return false;
@@ -643,12 +1105,14 @@ class msg_queue_initialization_func_t
 
    std::size_t get_min_size() const
    {
-      return mq_hdr_t<VoidPointer>::get_mem_size(m_maxmsgsize, m_maxmsg)
+      return mq_hdr_t<VoidPointer>::get_mem_size(m_maxmsgsize, m_maxmsg, m_packedsize)
       - message_queue_t<VoidPointer>::open_create_impl_t::ManagedOpenOrCreateUserOffset;
    }
 
    const size_type m_maxmsg;
    const size_type m_maxmsgsize;
+   const size_type m_packedsize;
+   const boost::uint32_t m_notify_mode;
 };
 
 }  //namespace ipcdetail {
@@ -659,8 +1123,8 @@ inline message_queue_t<VoidPointer>::~message_queue_t()
 
 template<class VoidPointer>
 inline typename message_queue_t<VoidPointer>::size_type message_queue_t<VoidPointer>::get_mem_size
-   (size_type max_msg_size, size_type max_num_msg)
-{  return ipcdetail::mq_hdr_t<VoidPointer>::get_mem_size(max_msg_size, max_num_msg);   }
+   (size_type max_msg_size, size_type max_num_msg, size_type packed_size)
+{  return ipcdetail::mq_hdr_t<VoidPointer>::get_mem_size(max_msg_size, max_num_msg, packed_size);   }
 
 template<class VoidPointer>
 inline message_queue_t<VoidPointer>::message_queue_t(create_only_t,
@@ -675,8 +1139,9 @@ inline message_queue_t<VoidPointer>::message_queue_t(create_only_t,
               read_write,
               static_cast<void*>(0),
               //Prepare initialization functor
-              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size),
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, 0u, ipcdetail::msg_queue_notify_mode(perm)),
               perm)
+   ,  m_notifier(name)
 {}
 
 template<class VoidPointer>
@@ -692,8 +1157,9 @@ inline message_queue_t<VoidPointer>::message_queue_t(open_or_create_t,
               read_write,
               static_cast<void*>(0),
               //Prepare initialization functor
-              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size),
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, 0u, ipcdetail::msg_queue_notify_mode(perm)),
               perm)
+   ,  m_notifier(name)
 {}
 
 template<class VoidPointer>
@@ -705,6 +1171,45 @@ inline message_queue_t<VoidPointer>::message_queue_t(open_only_t, const char *na
               static_cast<void*>(0),
               //Prepare initialization functor
               ipcdetail::msg_queue_initialization_func_t<VoidPointer> ())
+   ,  m_notifier(name)
+{}
+
+template<class VoidPointer>
+inline message_queue_t<VoidPointer>::message_queue_t(create_only_t,
+                                    const char *name,
+                                    size_type max_num_msg,
+                                    size_type max_msg_size,
+                                    const packed_message_storage &storage,
+                                    const permissions &perm)
+      //Create shared memory and execute functor atomically
+   :  m_shmem(create_only,
+              name,
+              get_mem_size(max_msg_size, max_num_msg, storage.size()),
+              read_write,
+              static_cast<void*>(0),
+              //Prepare initialization functor
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, storage.size(), ipcdetail::msg_queue_notify_mode(perm)),
+              perm)
+   ,  m_notifier(name)
+{}
+
+template<class VoidPointer>
+inline message_queue_t<VoidPointer>::message_queue_t(open_or_create_t,
+                                    const char *name,
+                                    size_type max_num_msg,
+                                    size_type max_msg_size,
+                                    const packed_message_storage &storage,
+                                    const permissions &perm)
+      //Create shared memory and execute functor atomically
+   :  m_shmem(open_or_create,
+              name,
+              get_mem_size(max_msg_size, max_num_msg, storage.size()),
+              read_write,
+              static_cast<void*>(0),
+              //Prepare initialization functor
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, storage.size(), ipcdetail::msg_queue_notify_mode(perm)),
+              perm)
+   ,  m_notifier(name)
 {}
 
 #if defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
@@ -722,8 +1227,9 @@ inline message_queue_t<VoidPointer>::message_queue_t(create_only_t,
               read_write,
               static_cast<void*>(0),
               //Prepare initialization functor
-              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size),
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, 0u, ipcdetail::msg_queue_notify_mode(perm)),
               perm)
+   ,  m_notifier(name)
 {}
 
 template<class VoidPointer>
@@ -739,8 +1245,9 @@ inline message_queue_t<VoidPointer>::message_queue_t(open_or_create_t,
               read_write,
               static_cast<void*>(0),
               //Prepare initialization functor
-              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size),
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, 0u, ipcdetail::msg_queue_notify_mode(perm)),
               perm)
+   ,  m_notifier(name)
 {}
 
 template<class VoidPointer>
@@ -752,6 +1259,45 @@ inline message_queue_t<VoidPointer>::message_queue_t(open_only_t, const wchar_t
               static_cast<void*>(0),
               //Prepare initialization functor
               ipcdetail::msg_queue_initialization_func_t<VoidPointer> ())
+   ,  m_notifier(name)
+{}
+
+template<class VoidPointer>
+inline message_queue_t<VoidPointer>::message_queue_t(create_only_t,
+                                    const wchar_t *name,
+                                    size_type max_num_msg,
+                                    size_type max_msg_size,
+                                    const packed_message_storage &storage,
+                                    const permissions &perm)
+      //Create shared memory and execute functor atomically
+   :  m_shmem(create_only,
+              name,
+              get_mem_size(max_msg_size, max_num_msg, storage.size()),
+              read_write,
+              static_cast<void*>(0),
+              //Prepare initialization functor
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, storage.size(), ipcdetail::msg_queue_notify_mode(perm)),
+              perm)
+   ,  m_notifier(name)
+{}
+
+template<class VoidPointer>
+inline message_queue_t<VoidPointer>::message_queue_t(open_or_create_t,
+                                    const wchar_t *name,
+                                    size_type max_num_msg,
+                                    size_type max_msg_size,
+                                    const packed_message_storage &storage,
+                                    const permissions &perm)
+      //Create shared memory and execute functor atomically
+   :  m_shmem(open_or_create,
+              name,
+              get_mem_size(max_msg_size, max_num_msg, storage.size()),
+              read_write,
+              static_cast<void*>(0),
+              //Prepare initialization functor
+              ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, storage.size(), ipcdetail::msg_queue_notify_mode(perm)),
+              perm)
+   ,  m_notifier(name)
 {}
 
 #endif //defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
@@ -765,6 +1311,16 @@ inline message_queue_t<VoidPointer>::message_queue_t(size_type max_num_msg,
             ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size))
 {}
 
+template <class VoidPointer>
+inline message_queue_t<VoidPointer>::message_queue_t(size_type max_num_msg,
+                                    size_type max_msg_size,
+                                    const packed_message_storage &storage)
+   :  m_shmem(get_mem_size(max_msg_size, max_num_msg, storage.size()),
+            static_cast<void*>(0),
+            //Prepare initialization functor
+            ipcdetail::msg_queue_initialization_func_t<VoidPointer> (max_num_msg, max_msg_size, storage.size()))
+{}
+
 template<class VoidPointer>
 inline void message_queue_t<VoidPointer>::send
    (const void *buffer, size_type buffer_size, unsigned int priority)
@@ -801,13 +1357,15 @@ inline bool message_queue_t<VoidPointer>::do_send(
    }
 
    bool notify_blocked_receivers = false;
+   //Generation of the fifo to notify, zero if not needed
+   boost::uint32_t notify_fifo = 0u;
    {
       //---------------------------------------------
       scoped_lock<interprocess_mutex> lock(p_hdr->m_mutex);
       //---------------------------------------------
 
       //If the queue is full execute blocking logic
-      if (p_hdr->is_full()) {
+      if (!p_hdr->has_room(buffer_size)) {
          BOOST_INTERPROCESS_TRY{
             ++p_hdr->m_blocked_senders;
             switch(Block){
@@ -820,20 +1378,20 @@ inline bool message_queue_t<VoidPointer>::do_send(
                   do{
                      (void)do_cond_wait(ipcdetail::bool_<false>(), p_hdr->m_cond_send, lock, abs_time);
                   }
-                  while (p_hdr->is_full());
+                  while (!p_hdr->has_room(buffer_size));
                break;
 
                case timed :
                   do{
                      if(!do_cond_wait(ipcdetail::bool_<Block == timed>(), p_hdr->m_cond_send, lock, abs_time)) {
-                        if(p_hdr->is_full()){
+                        if(!p_hdr->has_room(buffer_size)){
                            --p_hdr->m_blocked_senders;
                            return false;
                         }
                         break;
                      }
                   }
-                  while (p_hdr->is_full());
+                  while (!p_hdr->has_room(buffer_size));
                break;
                default:
                break;
@@ -847,8 +1405,16 @@ inline bool message_queue_t<VoidPointer>::do_send(
       }
 
       notify_blocked_receivers = 0 != p_hdr->m_blocked_receivers;
+      notify_fifo = p_hdr->is_empty() ? p_hdr->m_notify : 0u;
       //Insert the first free message in the priority queue
-      ipcdetail::msg_hdr_t<VoidPointer> &free_msg_hdr = p_hdr->queue_free_msg(priority);
+      typedef typename boost::intrusive::pointer_traits<VoidPointer>::template
+         rebind_pointer<ipcdetail::msg_hdr_t<VoidPointer> >::type msg_hdr_ptr_t;
+      msg_hdr_ptr_t &free_msg_ptr = p_hdr->queue_free_msg(priority);
+      //Packed messages are allocated with the exact size
+      if(p_hdr->is_packed()){
+         free_msg_ptr = p_hdr->packed_allocate(buffer_size);
+      }
+      ipcdetail::msg_hdr_t<VoidPointer> &free_msg_hdr = *free_msg_ptr;
 
       //Sanity check, free msgs are always cleaned when received
       BOOST_ASSERT(free_msg_hdr.priority == 0);
@@ -868,6 +1434,10 @@ inline bool message_queue_t<VoidPointer>::do_send(
    if (notify_blocked_receivers){
       p_hdr->m_cond_recv.notify_one();
    }
+   //Event loops are notified when the queue becomes non-empty
+   if (notify_fifo){
+      m_notifier.notify(notify_fifo);
+   }
 
    return true;
 }
@@ -981,9 +1551,14 @@ inline bool
 
    //Notify outside lock to avoid contention. This might produce some
    //spurious wakeups, but it's usually far better than notifying inside.
-   //If this reception changes the queue full state, notify senders
+   //If this reception changes the queue full state, notify senders.
+   //Packed messages have different sizes, so a single sender might
+   //not have room for its message while others have.
    if (notify_blocked_senders){
-      p_hdr->m_cond_send.notify_one();
+      if(p_hdr->is_packed())
+         p_hdr->m_cond_send.notify_all();
+      else
+         p_hdr->m_cond_send.notify_one();
    }
 
    return true;
@@ -1016,9 +1591,56 @@ inline typename message_queue_t<VoidPointer>::size_type message_queue_t<VoidPoin
    return 0;
 }
 
+template<class VoidPointer>
+inline bool message_queue_t<VoidPointer>::is_packed() const
+{
+   ipcdetail::mq_hdr_t<VoidPointer> *p_hdr = static_cast<ipcdetail::mq_hdr_t<VoidPointer>*>(m_shmem.get_user_address());
+   return p_hdr && p_hdr->is_packed();
+}
+
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
+template<class VoidPointer>
+inline int message_queue_t<VoidPointer>::get_notification_handle()
+{
+   ipcdetail::mq_hdr_t<VoidPointer> *p_hdr = static_cast<ipcdetail::mq_hdr_t<VoidPointer>*>(m_shmem.get_user_address());
+   bool created;
+   const int fd = m_notifier.get_read_end(p_hdr->m_notify_mode, created);
+   boost::uint32_t notify_fifo = 0u;
+   {
+      //---------------------------------------------
+      scoped_lock<interprocess_mutex> lock(p_hdr->m_mutex);
+      //---------------------------------------------
+      //A new fifo gets a new generation so that senders
+      //drop the write ends of removed fifos
+      if(created || !p_hdr->m_notify){
+         if(++p_hdr->m_notify == 0u)
+            p_hdr->m_notify = 1u;
+      }
+      //Senders only notify when the queue becomes non-empty, so a queue that
+      //already holds messages is notified here or the descriptor would never
+      //become readable for them
+      if(!p_hdr->is_empty())
+         notify_fifo = p_hdr->m_notify;
+   }
+   if(notify_fifo){
+      m_notifier.notify(notify_fifo);
+   }
+   return fd;
+}
+
+template<class VoidPointer>
+inline void message_queue_t<VoidPointer>::clear_notification()
+{  m_notifier.clear();  }
+
+#endif   //#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
 template<class VoidPointer>
 inline bool message_queue_t<VoidPointer>::remove(const char *name)
-{  return shared_memory_object::remove(name);  }
+{
+   ipcdetail::msg_queue_notifier::remove(name);
+   return shared_memory_object::remove(name);
+}
 
 #if defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
@@ -268,6 +268,13 @@ class basic_managed_mapped_file
    bool flush()
    {  return m_mfile.flush();  }
 
+   //!Flushes cached data of the byte range [offset, offset + numbytes), where offset
+   //!is relative to get_address(). If numbytes is zero, the range extends to the end of the segment.
+   //!If 'async' is false the function returns once data has been written to the file.
+   //!Never throws. Returns false if operation could not be performed.
+   bool flush(size_type offset, size_type numbytes, bool async = false)
+   {  return m_mfile.flush(offset, numbytes, async);  }
+
    //!Tries to resize mapped file so that we have room for
    //!more objects.
    //!
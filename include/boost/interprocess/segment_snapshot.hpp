@@ -0,0 +1,349 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_SEGMENT_SNAPSHOT_HPP
+#define BOOST_INTERPROCESS_SEGMENT_SNAPSHOT_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/permissions.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/detail/os_file_functions.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <string>
+
+//!\file
+//!Describes segment_snapshot_writer, a class that writes point-in-time copies
+//!of a managed segment to disk, and restore_snapshot(), a function that puts
+//!a snapshot in place of a damaged managed mapped file.
+
+namespace boost {
+namespace interprocess {
+
+//!A managed_mapped_file updated in place is left inconsistent if the process
+//!crashes in the middle of a modification. segment_snapshot_writer produces
+//!crash-consistent checkpoints of a managed segment:
+//!
+//! - The calling thread copies the whole segment to a new temporary file
+//!   "<path>.<pid>.<n>.tmp" through a memory mapping. This is the only pause and it's
+//!   a memory to memory copy: disk writes are only scheduled.
+//! - A background thread then synchronizes the temporary file with the disk,
+//!   atomically renames it to "path" and synchronizes the directory. A crash at any
+//!   point leaves either the previous snapshot or the new one, never a partially written file.
+//!
+//!Temporary files are created exclusively, so several writers (in this or other
+//!processes) can write snapshots to the same path. A process that crashes while
+//!writing a snapshot leaves its temporary file, that is never removed by other writers.
+//!
+//!The snapshot is a byte-by-byte image of the segment, so recovering from it
+//!requires no replay: the snapshot file can be opened directly as a
+//!managed_mapped_file (with open_copy_on_write to inspect it) or
+//!put in place of the damaged file with restore_snapshot().
+//!
+//!The copy is only point-in-time if no thread or process modifies the segment
+//!while snapshot() or async_snapshot() runs: the application must quiesce
+//!writers (e.g. holding the locks that protect its data) during the call.
+//!
+//!ManagedSegment must offer get_address() and get_size(), like
+//!basic_managed_mapped_file or basic_managed_shared_memory, although only
+//!snapshots of managed mapped files can be reopened with the same type.
+//!The object must be destroyed before the managed segment.
+template<class ManagedSegment>
+class segment_snapshot_writer
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   segment_snapshot_writer(const segment_snapshot_writer &);
+   segment_snapshot_writer &operator=(const segment_snapshot_writer &);
+
+   struct job
+   {
+      job()
+         : ticket(0u), hnd(ipcdetail::invalid_file())
+      {}
+
+      boost::uint64_t ticket;
+      std::string     tmp_name;
+      std::string     name;
+      //The temporary file, open until the job is committed
+      file_handle_t   hnd;
+   };
+
+   struct worker
+   {
+      explicit worker(segment_snapshot_writer &w)
+         : mp_writer(&w)
+      {}
+
+      void operator()()
+      {  mp_writer->priv_run();  }
+
+      segment_snapshot_writer *mp_writer;
+   };
+
+   //Maps the temporary file through the handle that created it
+   struct tmp_file
+   {
+      explicit tmp_file(file_handle_t h)
+         : hnd(h)
+      {}
+
+      mapping_handle_t get_mapping_handle() const
+      {  return ipcdetail::mapping_handle_from_file_handle(hnd);  }
+
+      file_handle_t hnd;
+   };
+
+   typedef scoped_lock<interprocess_mutex> lock_t;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Identifies an asynchronous snapshot request. Tickets increase monotonically.
+   typedef boost::uint64_t ticket_type;
+
+   //!Associates the writer with the managed segment. Snapshot files will be
+   //!created with permissions "perm". The background thread is only launched
+   //!on the first call to async_snapshot(). Never throws.
+   explicit segment_snapshot_writer(ManagedSegment &segment, const permissions &perm = permissions())
+      : m_segment(segment)
+      , m_perm(perm)
+      , m_num_files(0u)
+      , m_last_ticket(0u)
+      , m_done_ticket(0u)
+      , m_error(false)
+      , m_stop(false)
+      , m_thread_launched(false)
+   {}
+
+   //!Waits until pending asynchronous snapshots are completed
+   //!and stops the background thread.
+   ~segment_snapshot_writer()
+   {
+      {
+         lock_t lck(m_mut);
+         m_stop = true;
+         m_cond.notify_all();
+      }
+      if(m_thread_launched){
+         ipcdetail::thread_join(m_thread);
+      }
+   }
+
+   //!Copies the segment and writes the copy to "path" in the calling thread,
+   //!after previously requested asynchronous snapshots are completed.
+   //!Returns true when the snapshot is durable and has replaced any previous
+   //!file named "path". Throws interprocess_exception if the temporary file
+   //!can't be created or mapped.
+   bool snapshot(const char *path)
+   {
+      job j;
+      this->priv_prepare(j, path);
+      ticket_type previous;
+      {
+         //Previous asynchronous snapshots must not overwrite this one
+         lock_t lck(m_mut);
+         previous = m_last_ticket;
+         while(m_done_ticket < previous){
+            m_cond.wait(lck);
+         }
+      }
+      return priv_commit(j);
+   }
+
+   //!Copies the segment in the calling thread and hands the copy to the
+   //!background thread, which writes it to "path". Returns a ticket that can
+   //!be passed to wait() or is_complete(). Throws interprocess_exception if
+   //!the temporary file can't be created or mapped or the background thread
+   //!can't be launched.
+   ticket_type async_snapshot(const char *path)
+   {
+      {
+         lock_t lck(m_mut);
+         if(!m_thread_launched){
+            if(0 != ipcdetail::thread_launch(m_thread, worker(*this))){
+               throw interprocess_exception(other_error);
+            }
+            m_thread_launched = true;
+         }
+      }
+      job j;
+      this->priv_prepare(j, path);
+      lock_t lck(m_mut);
+      j.ticket = ++m_last_ticket;
+      m_jobs.push_back(j);
+      m_cond.notify_all();
+      return j.ticket;
+   }
+
+   //!Returns true if the asynchronous snapshot identified by t
+   //!(and all previous ones) has been completed. Never throws.
+   bool is_complete(ticket_type t)
+   {
+      lock_t lck(m_mut);
+      return m_done_ticket >= t;
+   }
+
+   //!Waits until the asynchronous snapshot identified by t (and all previous ones)
+   //!has been completed. Returns false if any asynchronous snapshot completed since
+   //!the last call to wait() failed. A failed snapshot leaves the previous file untouched.
+   bool wait(ticket_type t)
+   {
+      lock_t lck(m_mut);
+      while(m_done_ticket < t){
+         m_cond.wait(lck);
+      }
+      const bool ok = !m_error;
+      m_error = false;
+      return ok;
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+
+   //Creates a temporary file with a name no other writer uses
+   void priv_create_tmp_file(job &j, const char *path)
+   {
+      ipcdetail::pid_str_t pid_str;
+      ipcdetail::get_pid_str(pid_str);
+      for(;;){
+         std::size_t n;
+         {
+            lock_t lck(m_mut);
+            n = ++m_num_files;
+         }
+         j.tmp_name = path;
+         j.tmp_name += '.';
+         j.tmp_name += pid_str;
+         j.tmp_name += '.';
+         const std::size_t first_digit = j.tmp_name.size();
+         do{
+            j.tmp_name.insert(first_digit, 1u, char('0' + n % 10u));
+            n /= 10u;
+         } while(n);
+         j.tmp_name += ".tmp";
+         j.hnd = ipcdetail::create_new_file(j.tmp_name.c_str(), read_write, m_perm);
+         if(j.hnd != ipcdetail::invalid_file()){
+            return;
+         }
+         //Another writer of this process uses the name
+         error_info err = system_error_code();
+         if(err.get_error_code() != already_exists_error){
+            throw interprocess_exception(err);
+         }
+      }
+   }
+
+   //Copies the segment to a new temporary file
+   void priv_prepare(job &j, const char *path)
+   {
+      j.name = path;
+      this->priv_create_tmp_file(j, path);
+      const std::size_t size = m_segment.get_size();
+      BOOST_INTERPROCESS_TRY{
+         if(!ipcdetail::truncate_file(j.hnd, size)){
+            error_info err = system_error_code();
+            throw interprocess_exception(err);
+         }
+         mapped_region region(tmp_file(j.hnd), read_write, 0, size);
+         std::memcpy(region.get_address(), m_segment.get_address(), size);
+         //Start writing back, the background thread waits for completion
+         region.flush(0, 0, true);
+      }
+      BOOST_INTERPROCESS_CATCH(...){
+         ipcdetail::close_file(j.hnd);
+         ipcdetail::delete_file(j.tmp_name.c_str());
+         BOOST_INTERPROCESS_RETHROW
+      } BOOST_INTERPROCESS_CATCH_END
+   }
+
+   //Makes the temporary file durable and atomically replaces the snapshot
+   static bool priv_commit(const job &j)
+   {
+      bool ok = ipcdetail::flush_file(j.hnd);
+      ok = ipcdetail::close_file(j.hnd) && ok;
+      ok = ok && ipcdetail::rename_file(j.tmp_name.c_str(), j.name.c_str());
+      if(!ok){
+         ipcdetail::delete_file(j.tmp_name.c_str());
+         return false;
+      }
+      return ipcdetail::flush_parent_directory(j.name.c_str());
+   }
+
+   void priv_run()
+   {
+      lock_t lck(m_mut);
+      for(;;){
+         while(m_jobs.empty() && !m_stop){
+            m_cond.wait(lck);
+         }
+         if(m_jobs.empty()){
+            break;
+         }
+         const job j(m_jobs.front());
+         lck.unlock();
+         const bool ok = priv_commit(j);
+         lck.lock();
+         m_jobs.pop_front();
+         m_error = m_error || !ok;
+         if(m_done_ticket < j.ticket){
+            m_done_ticket = j.ticket;
+         }
+         m_cond.notify_all();
+      }
+   }
+
+   ManagedSegment         &m_segment;
+   permissions             m_perm;
+   interprocess_mutex      m_mut;
+   interprocess_condition  m_cond;
+   std::deque<job>         m_jobs;
+   std::size_t             m_num_files;
+   ticket_type             m_last_ticket;
+   ticket_type             m_done_ticket;
+   bool                    m_error;
+   bool                    m_stop;
+   bool                    m_thread_launched;
+   ipcdetail::OS_thread_t  m_thread;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+//!Atomically replaces the file "target" with the snapshot "snapshot", which is
+//!consumed. The restored file is ready to be opened as a managed mapped file:
+//!no replay is needed, so recovery time is bounded by the mapping of the file.
+//!"target" must not be mapped by any process. Returns false on error. Never throws.
+inline bool restore_snapshot(const char *snapshot, const char *target)
+{
+   return ipcdetail::rename_file(snapshot, target) &&
+          ipcdetail::flush_parent_directory(target);
+}
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_SEGMENT_SNAPSHOT_HPP
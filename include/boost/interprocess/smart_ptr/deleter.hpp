@@ -60,6 +60,22 @@ class deleter
    {  mp_mngr->destroy_ptr(ipcdetail::to_raw_pointer(p));   }
 };
 
+//!The deleter of shared pointers created with make_managed_shared.
+//!The object is placed in the same allocation as the reference counts,
+//!so the deleter only runs its destructor: the memory is deallocated
+//!with the reference counts when the last weak pointer is destroyed.
+template<class T, class SegmentManager>
+class inplace_deleter
+{
+   public:
+   typedef typename boost::intrusive::
+      pointer_traits<typename SegmentManager::void_pointer>::template
+         rebind_pointer<T>::type                pointer;
+
+   void operator()(const pointer &p)
+   {  ipcdetail::to_raw_pointer(p)->~T();   }
+};
+
 }  //namespace interprocess {
 }  //namespace boost {
 
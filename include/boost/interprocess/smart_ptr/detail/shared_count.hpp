@@ -33,6 +33,8 @@
 #include <boost/move/adl_move_swap.hpp>
 #include <boost/intrusive/detail/minimal_less_equal_header.hpp>   //std::less
 #include <boost/container/detail/placement_new.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
 
 namespace boost {
 namespace interprocess {
@@ -41,6 +43,9 @@ namespace ipcdetail{
 template<class T, class VoidAllocator, class Deleter>
 class weak_count;
 
+//Tag to construct the object in the same allocation as the control block
+struct sp_inplace_t {};
+
 template<class T, class VoidAllocator, class Deleter>
 class shared_count
 {
@@ -120,6 +125,34 @@ class shared_count
       BOOST_INTERPROCESS_CATCH_END
    }
 
+   //Allocates the control block and the object in a single allocation, the object
+   //is placed after the control block and constructed with "proxy".
+   //The deleter (an inplace_deleter) only destroys the object, as the memory
+   //is deallocated with the control block.
+   template <class CtorProxy, class SegmentManager>
+   shared_count(sp_inplace_t, CtorProxy &proxy, SegmentManager *mngr, const VoidAllocator &a, const Deleter &d)
+      :  m_px(0), m_pi(0)
+   {
+      typedef typename boost::intrusive::pointer_traits<pointer>::element_type element_type;
+      typedef sp_counted_impl_units<counted_impl, Deleter> units_t;
+      //The segment only guarantees its own alignment to the allocated block
+      BOOST_INTERPROCESS_STATIC_ASSERT((units_t::obj_align <= SegmentManager::MemAlignment));
+
+      counted_impl_allocator alloc(a);
+      counted_impl_ptr pi = alloc.allocate(units_t::value);
+      //Anti-exception deallocator
+      scoped_ptr<counted_impl,
+               scoped_ptr_dealloc_functor<counted_impl_allocator> >
+                  deallocator(pi, scoped_ptr_dealloc_functor<counted_impl_allocator>(alloc, units_t::value));
+      void *const obj = reinterpret_cast<char*>(ipcdetail::to_raw_pointer(pi)) + units_t::obj_offset;
+      BOOST_ASSERT((reinterpret_cast<std::size_t>(obj) % units_t::obj_align) == 0u);
+      proxy.construct_n(obj, mngr, 1u);
+      m_px = pointer(static_cast<element_type*>(obj));
+      ::new(ipcdetail::to_raw_pointer(pi), boost_container_new_t())counted_impl(m_px, a, d);
+      deallocator.release();
+      m_pi = pi;
+   }
+
    ~shared_count() // nothrow
    {
       if(m_pi)
@@ -28,9 +28,12 @@
 #include <boost/interprocess/containers/version_type.hpp>
 #include <boost/interprocess/smart_ptr/detail/sp_counted_base.hpp>
 #include <boost/interprocess/smart_ptr/scoped_ptr.hpp>
+#include <boost/interprocess/smart_ptr/deleter.hpp>
 #include <boost/interprocess/detail/utilities.hpp>
 #include <boost/container/allocator_traits.hpp>
 #include <boost/intrusive/pointer_traits.hpp>
+#include <boost/container/detail/type_traits.hpp>  //alignment_of
+#include <cstddef>
 
 namespace boost {
 
@@ -39,12 +42,14 @@ namespace interprocess {
 namespace ipcdetail {
 
 //!A deleter for scoped_ptr that deallocates the memory
-//!allocated for an object using a STL allocator.
+//!allocated for an object (or "n" contiguous objects) using a STL allocator.
 template <class Allocator>
 struct scoped_ptr_dealloc_functor
 {
    typedef typename boost::container::
       allocator_traits<Allocator>::pointer pointer;
+   typedef typename boost::container::
+      allocator_traits<Allocator>::size_type size_type;
 
    typedef ipcdetail::integral_constant<unsigned,
       boost::interprocess::version<Allocator>::value>                   alloc_version;
@@ -53,16 +58,22 @@ struct scoped_ptr_dealloc_functor
 
    private:
    void priv_deallocate(const pointer &p, allocator_v1)
-   {  m_alloc.deallocate(p, 1); }
+   {  m_alloc.deallocate(p, m_n); }
 
    void priv_deallocate(const pointer &p, allocator_v2)
-   {  m_alloc.deallocate_one(p); }
+   {
+      if(m_n == 1u)
+         m_alloc.deallocate_one(p);
+      else
+         m_alloc.deallocate(p, m_n);
+   }
 
    public:
    Allocator& m_alloc;
+   size_type m_n;
 
-   scoped_ptr_dealloc_functor(Allocator& a)
-      : m_alloc(a) {}
+   scoped_ptr_dealloc_functor(Allocator& a, size_type n = 1u)
+      : m_alloc(a), m_n(n) {}
 
    void operator()(pointer ptr)
    {  if (ptr) priv_deallocate(ptr, alloc_version());  }
@@ -70,6 +81,22 @@ struct scoped_ptr_dealloc_functor
 
 
 
+//!Number of control blocks "Impl" allocated in a row to hold the counts
+//!and, for make_managed_shared, the object placed after them.
+template<class Impl, class D>
+struct sp_counted_impl_units
+{
+   static const std::size_t value = 1u;
+};
+
+template<class Impl, class T, class SegmentManager>
+struct sp_counted_impl_units<Impl, inplace_deleter<T, SegmentManager> >
+{
+   static const std::size_t obj_align  = ::boost::container::dtl::alignment_of<T>::value;
+   static const std::size_t obj_offset = ((sizeof(Impl) - 1u)/obj_align + 1u)*obj_align;
+   static const std::size_t value      = (obj_offset + sizeof(T) - 1u)/sizeof(Impl) + 1u;
+};
+
 template<class A, class D>
 class sp_counted_impl_pd
    :  public sp_counted_base
@@ -132,7 +159,8 @@ class sp_counted_impl_pd
       this_pointer this_ptr(this_pointer_traits::pointer_to(*this));
       //Do it now!
       scoped_ptr< this_type, scoped_ptr_dealloc_functor<this_allocator> >
-         deleter_ptr(this_ptr, a_copy);
+         deleter_ptr(this_ptr, scoped_ptr_dealloc_functor<this_allocator>
+            (a_copy, sp_counted_impl_units<this_type, D>::value));
       ipcdetail::to_raw_pointer(this_ptr)->~this_type();
    }
 
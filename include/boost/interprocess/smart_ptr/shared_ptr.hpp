@@ -37,6 +37,8 @@
 #include <boost/interprocess/detail/type_traits.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
 #include <boost/interprocess/smart_ptr/deleter.hpp>
+#include <boost/interprocess/detail/named_proxy.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
 #include <boost/intrusive/pointer_traits.hpp>
 
 #include <iosfwd> // for std::basic_ostream
@@ -144,6 +146,17 @@ class shared_ptr
       ipcdetail::sp_enable_shared_from_this<T, VoidAllocator, Deleter>( m_pn, ipcdetail::to_raw_pointer(p), ipcdetail::to_raw_pointer(p) );
    }
 
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Used by make_managed_shared
+   template<class CtorProxy, class SegmentManager>
+   shared_ptr(ipcdetail::sp_inplace_t t, CtorProxy &proxy, SegmentManager *mngr, const VoidAllocator &a, const Deleter &d)
+      :  m_pn(t, proxy, mngr, a, d)
+   {
+      ipcdetail::sp_enable_shared_from_this<T, VoidAllocator, Deleter>
+         ( m_pn, ipcdetail::to_raw_pointer(m_pn.to_raw_pointer()), ipcdetail::to_raw_pointer(m_pn.to_raw_pointer()) );
+   }
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
    //!Copy constructs a shared_ptr. If r is empty, constructs an empty shared_ptr. Otherwise, constructs
    //!a shared_ptr that shares ownership with r. Never throws.
    shared_ptr(const shared_ptr &r)
@@ -374,6 +387,17 @@ struct managed_shared_ptr
    typedef shared_ptr< T, void_allocator, deleter>                type;
 };
 
+//!Returns the type of a shared pointer created with make_managed_shared:
+//!the object is placed in the same allocation as the reference counts,
+//!so it's destroyed with an inplace_deleter.
+template<class T, class ManagedMemory>
+struct managed_inplace_shared_ptr
+{
+   typedef typename ManagedMemory::template allocator<void>::type void_allocator;
+   typedef inplace_deleter<T, typename ManagedMemory::segment_manager> deleter;
+   typedef shared_ptr< T, void_allocator, deleter>                   type;
+};
+
 //!Returns an instance of a shared pointer constructed
 //!with the default allocator and deleter from a pointer
 //!of type T that has been allocated in the passed managed segment
@@ -408,6 +432,85 @@ inline typename managed_shared_ptr<T, ManagedMemory>::type
    } BOOST_INTERPROCESS_CATCH_END
 }
 
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+namespace ipcdetail {
+
+template<class T, class ManagedMemory, class CtorProxy>
+inline typename managed_inplace_shared_ptr<T, ManagedMemory>::type
+   make_managed_shared_impl(ManagedMemory &managed_memory, CtorProxy &proxy)
+{
+   typedef typename managed_inplace_shared_ptr<T, ManagedMemory>::type       shared_ptr_t;
+   typedef typename managed_inplace_shared_ptr<T, ManagedMemory>::deleter    deleter_t;
+   return shared_ptr_t( sp_inplace_t(), proxy, managed_memory.get_segment_manager()
+                      , managed_memory.template get_allocator<void>(), deleter_t());
+}
+
+template<class T, class ManagedMemory, class CtorProxy>
+inline typename managed_inplace_shared_ptr<T, ManagedMemory>::type
+   make_managed_shared_impl(ManagedMemory &managed_memory, CtorProxy &proxy, const std::nothrow_t &)
+{
+   BOOST_INTERPROCESS_TRY{
+      return make_managed_shared_impl<T>(managed_memory, proxy);
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      return typename managed_inplace_shared_ptr<T, ManagedMemory>::type();
+   } BOOST_INTERPROCESS_CATCH_END
+}
+
+}  //namespace ipcdetail {
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+#if defined(BOOST_INTERPROCESS_PERFECT_FORWARDING) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+//!Constructs an object of type T with "args" in the passed managed segment and returns
+//!a shared pointer that owns it, like std::allocate_shared: the object and the
+//!reference counts are placed in a single allocation, so the segment is only
+//!locked once and the counts share cache lines with the object. The memory is
+//!deallocated when the last shared or weak pointer is destroyed.
+//!T's alignment can't be bigger than the alignment of the segment (checked at compile time).
+//!Throws if the memory can't be allocated or if T's constructor throws.
+template<class T, class ManagedMemory, class ...Args>
+inline typename managed_inplace_shared_ptr<T, ManagedMemory>::type
+   make_managed_shared(ManagedMemory &managed_memory, BOOST_FWD_REF(Args) ...args)
+{
+   ipcdetail::CtorArgN<T, false, Args...> proxy(::boost::forward<Args>(args)...);
+   return ipcdetail::make_managed_shared_impl<T>(managed_memory, proxy);
+}
+
+//!Same as make_managed_shared(managed_memory, args...) but returns a null shared pointer on error.
+template<class T, class ManagedMemory, class ...Args>
+inline typename managed_inplace_shared_ptr<T, ManagedMemory>::type
+   make_managed_shared(ManagedMemory &managed_memory, const std::nothrow_t &, BOOST_FWD_REF(Args) ...args)
+{
+   ipcdetail::CtorArgN<T, false, Args...> proxy(::boost::forward<Args>(args)...);
+   return ipcdetail::make_managed_shared_impl<T>(managed_memory, proxy, std::nothrow);
+}
+
+#else
+
+#define BOOST_INTERPROCESS_MAKE_MANAGED_SHARED_CODE(N) \
+template<class T, class ManagedMemory BOOST_MOVE_I##N BOOST_MOVE_CLASS##N>\
+inline typename managed_inplace_shared_ptr<T, ManagedMemory>::type\
+   make_managed_shared(ManagedMemory &managed_memory BOOST_MOVE_I##N BOOST_MOVE_UREF##N)\
+{\
+   ipcdetail::CtorArg##N<T BOOST_MOVE_I##N BOOST_MOVE_TARG##N> proxy(BOOST_MOVE_FWD##N);\
+   return ipcdetail::make_managed_shared_impl<T>(managed_memory, proxy);\
+}\
+\
+template<class T, class ManagedMemory BOOST_MOVE_I##N BOOST_MOVE_CLASS##N>\
+inline typename managed_inplace_shared_ptr<T, ManagedMemory>::type\
+   make_managed_shared(ManagedMemory &managed_memory, const std::nothrow_t & BOOST_MOVE_I##N BOOST_MOVE_UREF##N)\
+{\
+   ipcdetail::CtorArg##N<T BOOST_MOVE_I##N BOOST_MOVE_TARG##N> proxy(BOOST_MOVE_FWD##N);\
+   return ipcdetail::make_managed_shared_impl<T>(managed_memory, proxy, std::nothrow);\
+}\
+//
+BOOST_MOVE_ITERATE_0TO9(BOOST_INTERPROCESS_MAKE_MANAGED_SHARED_CODE)
+#undef BOOST_INTERPROCESS_MAKE_MANAGED_SHARED_CODE
+
+#endif
 
 } // namespace interprocess
 
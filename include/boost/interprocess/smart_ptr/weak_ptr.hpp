@@ -248,6 +248,18 @@ struct managed_weak_ptr
    > type;
 };
 
+//!Returns the type of a weak pointer that observes
+//!a shared pointer created with make_managed_shared
+template<class T, class ManagedMemory>
+struct managed_inplace_weak_ptr
+{
+   typedef weak_ptr
+   < T
+   , typename ManagedMemory::template allocator<void>::type
+   , inplace_deleter<T, typename ManagedMemory::segment_manager>
+   > type;
+};
+
 //!Returns an instance of a weak pointer constructed
 //!with the default allocator and deleter from a pointer
 //!of type T that has been allocated in the passed managed segment
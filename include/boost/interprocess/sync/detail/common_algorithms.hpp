@@ -24,6 +24,8 @@
 
 #include <boost/interprocess/sync/spin/wait.hpp>
 #include <boost/interprocess/timed_utils.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/cstdint.hpp>
 
 namespace boost {
 namespace interprocess {
@@ -89,6 +91,126 @@ void timeout_when_locking_aware_lock(MutexType &m)
    #endif
 }
 
+//The following functions emulate the acquisition of "n" units on semaphores that only
+//support acquiring one unit at a time (POSIX and Windows semaphores). The first unit is
+//waited for and the rest are tried without blocking. If they are not available, all the
+//units are returned, so that waiters never block holding part of a request, which could
+//deadlock several waiters of partial requests. The waiter then sleeps before trying again
+//(doubling the sleep up to BOOST_INTERPROCESS_SEMAPHORE_WAIT_N_MAX_SLEEP_MS) instead of
+//immediately retaking the units it returned.
+//
+//This is not fair: a waiter of "n" units can starve while waiters of fewer units keep
+//taking them, and it might wake up late (up to the maximum sleep) after the units are posted.
+
+#ifndef BOOST_INTERPROCESS_SEMAPHORE_WAIT_N_MAX_SLEEP_MS
+#define BOOST_INTERPROCESS_SEMAPHORE_WAIT_N_MAX_SLEEP_MS 16u
+#endif
+
+class semaphore_wait_n_backoff
+{
+   public:
+   semaphore_wait_n_backoff()
+      : m_ms(1u)
+   {}
+
+   void sleep()
+   {  this->priv_sleep(m_ms);  }
+
+   //Returns false if abs_time was already reached
+   template<class TimePoint>
+   bool sleep(const TimePoint &abs_time)
+   {
+      if(ipcdetail::is_pos_infinity(abs_time)){
+         this->sleep();
+         return true;
+      }
+      typedef typename microsec_clock<TimePoint>::time_point time_point;
+      const time_point cur_time = microsec_clock<TimePoint>::universal_time();
+      if(!(cur_time < abs_time)){
+         return false;
+      }
+      const boost::uint64_t left_ms = duration_to_milliseconds(abs_time - cur_time);
+      this->priv_sleep(left_ms < m_ms ? unsigned(left_ms) + 1u : m_ms);
+      return true;
+   }
+
+   private:
+   void priv_sleep(unsigned int ms)
+   {
+      ipcdetail::thread_sleep_ms(ms);
+      if(m_ms < BOOST_INTERPROCESS_SEMAPHORE_WAIT_N_MAX_SLEEP_MS){
+         m_ms *= 2u;
+      }
+   }
+
+   unsigned int m_ms;
+};
+
+template<class Semaphore>
+void semaphore_post_n(Semaphore &sem, unsigned int n)
+{
+   for(; n; --n){
+      sem.post();
+   }
+}
+
+template<class Semaphore>
+bool semaphore_try_wait_rest_n(Semaphore &sem, unsigned int n)
+{
+   unsigned int acquired = 1u;
+   for(; acquired != n; ++acquired){
+      if(!sem.try_wait()){
+         semaphore_post_n(sem, acquired);
+         return false;
+      }
+   }
+   return true;
+}
+
+template<class Semaphore>
+bool semaphore_try_wait_n(Semaphore &sem, unsigned int n)
+{
+   if(!n){
+      return true;
+   }
+   return sem.try_wait() && semaphore_try_wait_rest_n(sem, n);
+}
+
+template<class Semaphore>
+void semaphore_wait_n(Semaphore &sem, unsigned int n)
+{
+   if(n){
+      semaphore_wait_n_backoff backoff;
+      while(1){
+         sem.wait();
+         if(semaphore_try_wait_rest_n(sem, n)){
+            break;
+         }
+         backoff.sleep();
+      }
+   }
+}
+
+template<class Semaphore, class TimePoint>
+bool semaphore_timed_wait_n(Semaphore &sem, unsigned int n, const TimePoint &abs_time)
+{
+   if(!n){
+      return true;
+   }
+   semaphore_wait_n_backoff backoff;
+   while(1){
+      if(!sem.timed_wait(abs_time)){
+         return false;
+      }
+      else if(semaphore_try_wait_rest_n(sem, n)){
+         return true;
+      }
+      else if(!backoff.sleep(abs_time)){
+         return false;
+      }
+   }
+}
+
 }  //namespace ipcdetail
 }  //namespace interprocess
 }  //namespace boost
@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
+#define BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/cstdint.hpp>
+#include <climits>
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <time.h>
+#  include <pthread.h>
+#  include <cerrno>
+#endif
+
+//Wrappers of the Linux futex system call for 32 bit words placed in memory shared between
+//processes. Waiters block while the word holds the expected value. Waiting functions can
+//return spuriously, callers must recheck their condition. These functions are only
+//available if BOOST_INTERPROCESS_HAS_FUTEX is defined.
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+inline long futex_call(volatile boost::uint32_t *addr, int op, boost::uint32_t val, const void *timeout_or_val2, volatile boost::uint32_t *addr2, boost::uint32_t val3)
+{
+   //Shared futexes (no FUTEX_PRIVATE_FLAG) as words can be mapped by several processes
+   return ::syscall(SYS_futex, addr, op, val, timeout_or_val2, addr2, val3);
+}
+
+//Blocks while *addr == expected until woken. Can return spuriously.
+inline void futex_wait(volatile boost::uint32_t *addr, boost::uint32_t expected)
+{  futex_call(addr, FUTEX_WAIT, expected, 0, 0, 0);  }
+
+//Blocks while *addr == expected until woken or "timeout" elapses.
+//Returns false if the timeout elapsed. Can return spuriously.
+inline bool futex_timed_wait(volatile boost::uint32_t *addr, boost::uint32_t expected, const usduration &timeout)
+{
+   const boost::uint64_t us = timeout.get_microsecs();
+   struct ::timespec ts;
+   ts.tv_sec  = static_cast< ::time_t>(us/1000000u);
+   ts.tv_nsec = static_cast<long>((us%1000000u)*1000u);
+   return !(futex_call(addr, FUTEX_WAIT, expected, &ts, 0, 0) == -1 && errno == ETIMEDOUT);
+}
+
+//Wakes up to "count" threads blocked in "addr". Returns the number of woken threads.
+inline int futex_wake(volatile boost::uint32_t *addr, int count = 1)
+{
+   const long r = futex_call(addr, FUTEX_WAKE, static_cast<boost::uint32_t>(count), 0, 0, 0);
+   return r > 0 ? static_cast<int>(r) : 0;
+}
+
+//Wakes all threads blocked in "addr".
+inline void futex_wake_all(volatile boost::uint32_t *addr)
+{  futex_call(addr, FUTEX_WAKE, static_cast<boost::uint32_t>(INT_MAX), 0, 0, 0);  }
+
+//If *addr == expected, wakes up to "wake_count" threads blocked in "addr" and moves
+//up to "requeue_count" of the remaining ones to "addr2" without waking them.
+//Returns false if *addr != expected, nothing is done in that case.
+inline bool futex_cmp_requeue(volatile boost::uint32_t *addr, boost::uint32_t expected, int wake_count, int requeue_count, volatile boost::uint32_t *addr2)
+{
+   //The kernel takes the requeue limit in the timeout argument
+   const void *const requeue_arg = reinterpret_cast<const void*>(static_cast<long>(requeue_count));
+   return !(futex_call(addr, FUTEX_CMP_REQUEUE, static_cast<boost::uint32_t>(wake_count), requeue_arg, addr2, expected) == -1 && errno == EAGAIN);
+}
+
+//Priority inheritance futexes store the thread id (TID) of the owner in the word,
+//so the kernel can boost it while higher priority threads are blocked.
+
+inline boost::uint32_t &futex_cached_tid()
+{
+   static __thread boost::uint32_t tid = 0u;
+   return tid;
+}
+
+inline void futex_reset_cached_tid()
+{  futex_cached_tid() = 0u;  }
+
+inline void futex_register_tid_reset()
+{  ::pthread_atfork(0, 0, &futex_reset_cached_tid);  }
+
+//Returns the TID of the calling thread. The id is cached per thread, and
+//the cache of the forking thread is reset in the child process.
+inline boost::uint32_t futex_tid()
+{
+   boost::uint32_t &tid = futex_cached_tid();
+   if(!tid){
+      static ::pthread_once_t once = PTHREAD_ONCE_INIT;
+      ::pthread_once(&once, &futex_register_tid_reset);
+      tid = static_cast<boost::uint32_t>(::syscall(SYS_gettid));
+   }
+   return tid;
+}
+
+//Locks a priority inheritance futex whose word is not zero (FUTEX_LOCK_PI), blocking
+//until "abs_timeout" (an absolute CLOCK_REALTIME time) or forever if it's null.
+//Returns zero on success or the error code (ETIMEDOUT, EDEADLK...).
+inline int futex_lock_pi(volatile boost::uint32_t *addr, const struct ::timespec *abs_timeout)
+{
+   while(futex_call(addr, FUTEX_LOCK_PI, 0u, abs_timeout, 0, 0) == -1){
+      if(errno != EINTR){
+         return errno;
+      }
+   }
+   return 0;
+}
+
+//Unlocks a priority inheritance futex with waiters (FUTEX_UNLOCK_PI),
+//handing it to the highest priority waiter.
+inline void futex_unlock_pi(volatile boost::uint32_t *addr)
+{  futex_call(addr, FUTEX_UNLOCK_PI, 0u, 0, 0, 0);  }
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#endif   //#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
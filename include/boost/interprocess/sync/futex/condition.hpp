@@ -0,0 +1,241 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_FUTEX_CONDITION_HPP
+#define BOOST_INTERPROCESS_DETAIL_FUTEX_CONDITION_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+
+#include <boost/interprocess/sync/cv_status.hpp>
+#include <boost/interprocess/sync/futex/mutex.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/mpl.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/cstdint.hpp>
+#include <climits>
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//A condition variable for futex_mutex. Waiters sleep on a sequence word that
+//is incremented by every notification.
+//
+//notify_all does not wake all the waiters, as they would just contend for
+//the external mutex: it wakes a single waiter, which moves the rest from the
+//sequence word to the word of its mutex (FUTEX_CMP_REQUEUE). Then each unlock
+//of the mutex wakes the next waiter, so a broadcast costs a single wakeup
+//plus one per mutex handoff. The requeue is done by the woken waiter because
+//it's the only one that knows the address of the mutex in its own process,
+//the notifier might not even hold it.
+//
+//Waiters can also use other mutexes (e.g. futex_pi_mutex). The kernel can't
+//requeue waiters to those mutexes, so the woken waiter wakes the rest instead.
+class futex_condition
+{
+   futex_condition(const futex_condition &);
+   futex_condition &operator=(const futex_condition &);
+
+   public:
+   futex_condition()
+      : m_seq(0u), m_waiters(0u), m_requeue(0u)
+   {
+      //Note that this class is initialized to zero.
+      //So zeroed memory can be interpreted as an initialized
+      //condition variable
+   }
+
+   ~futex_condition()
+   {}
+
+   void notify_one()
+   {
+      atomic_inc32(&m_seq);
+      if(atomic_read32(&m_waiters)){
+         futex_wake(&m_seq, 1);
+      }
+   }
+
+   void notify_all()
+   {
+      if(atomic_read32(&m_waiters)){
+         //The first waiter that returns will requeue the rest
+         atomic_write32(&m_requeue, 1u);
+         atomic_inc32(&m_seq);
+         futex_wake(&m_seq, 1);
+      }
+      else{
+         atomic_inc32(&m_seq);
+      }
+   }
+
+   template <typename L>
+   void wait(L& lock)
+   {
+      if (!lock)
+         throw lock_exception();
+      this->do_timed_wait_impl<false>(ustime(0u), *lock.mutex());
+   }
+
+   template <typename L, typename Pr>
+   void wait(L& lock, Pr pred)
+   {
+      if (!lock)
+         throw lock_exception();
+
+      while (!pred())
+         this->do_timed_wait_impl<false>(ustime(0u), *lock.mutex());
+   }
+
+   template <typename L, typename TimePoint>
+   bool timed_wait(L& lock, const TimePoint &abs_time)
+   {
+      if (!lock)
+         throw lock_exception();
+      //Handle infinity absolute time here to avoid complications in do_timed_wait
+      if(is_pos_infinity(abs_time)){
+         this->wait(lock);
+         return true;
+      }
+      return this->do_timed_wait_impl<true>(abs_time, *lock.mutex());
+   }
+
+   template <typename L, typename TimePoint, typename Pr>
+   bool timed_wait(L& lock, const TimePoint &abs_time, Pr pred)
+   {
+      if (!lock)
+         throw lock_exception();
+      //Handle infinity absolute time here to avoid complications in do_timed_wait
+      if(is_pos_infinity(abs_time)){
+         this->wait(lock, pred);
+         return true;
+      }
+      while (!pred()){
+         if (!this->do_timed_wait_impl<true>(abs_time, *lock.mutex()))
+            return pred();
+      }
+      return true;
+   }
+
+   template <typename L, class TimePoint>
+   cv_status wait_until(L& lock, const TimePoint &abs_time)
+   {  return this->timed_wait(lock, abs_time) ? cv_status::no_timeout : cv_status::timeout; }
+
+   template <typename L, class TimePoint, typename Pr>
+   bool wait_until(L& lock, const TimePoint &abs_time, Pr pred)
+   {  return this->timed_wait(lock, abs_time, pred); }
+
+   template <typename L, class Duration>
+   cv_status wait_for(L& lock, const Duration &dur)
+   {  return this->wait_until(lock, duration_to_ustime(dur)); }
+
+   template <typename L, class Duration, typename Pr>
+   bool wait_for(L& lock, const Duration &dur, Pr pred)
+   {  return this->wait_until(lock, duration_to_ustime(dur), pred); }
+
+   private:
+
+   template<bool TimeoutEnabled, class TimePoint, class Mutex>
+   bool do_timed_wait_impl(const TimePoint &abs_time, Mutex &mut)
+   {
+      //The waiter is registered and the sequence is read while holding the mutex,
+      //so any notification issued after the mutex is released changes the sequence
+      //and the futex wait returns immediately.
+      atomic_inc32(&m_waiters);
+      const boost::uint32_t seq = atomic_read32(&m_seq);
+      mut.unlock();
+
+      const bool woken = this->priv_sleep(bool_<TimeoutEnabled>(), seq, abs_time);
+
+      //A notify_all only wakes one waiter: move the rest to the mutex
+      if(atomic_read32(&m_requeue) && atomic_cas32(&m_requeue, 0u, 1u) == 1u){
+         this->priv_requeue(mut);
+      }
+      atomic_dec32(&m_waiters);
+
+      this->priv_relock(mut);
+      //Any change of the sequence is a notification, even if the wait timed out afterwards.
+      //Other wakeups before the deadline (signals, requeues) are spurious wakeups, not timeouts.
+      return woken || atomic_read32(&m_seq) != seq;
+   }
+
+   void priv_requeue(futex_mutex &mut)
+   {
+      boost::uint32_t cur = atomic_read32(&m_seq);
+      while(!futex_cmp_requeue(&m_seq, cur, 0, INT_MAX, mut.futex_word())){
+         cur = atomic_read32(&m_seq);
+      }
+   }
+
+   template <class Mutex>
+   void priv_requeue(Mutex &)
+   {  futex_wake_all(&m_seq);  }
+
+   //Other waiters might have been moved to the mutex, which must stay marked as
+   //contended so that each unlock wakes the next one.
+   static void priv_relock(futex_mutex &mut)
+   {  mut.lock_contended();  }
+
+   template <class Mutex>
+   static void priv_relock(Mutex &mut)
+   {  mut.lock();  }
+
+   //Returns false only if abs_time was reached before a wakeup
+   template <class TimePoint>
+   bool priv_sleep(bool_<true>, boost::uint32_t seq, const TimePoint &abs_time)
+   {
+      typedef typename microsec_clock<TimePoint>::time_point time_point;
+      //Requeued waiters return when woken from the mutex, or when the timeout elapses
+      while(atomic_read32(&m_seq) == seq){
+         const time_point now = microsec_clock<TimePoint>::universal_time();
+         if(now >= abs_time){
+            return false;
+         }
+         if(futex_timed_wait(&m_seq, seq, duration_to_usduration(abs_time - now))){
+            break;
+         }
+      }
+      return true;
+   }
+
+   template <class TimePoint>
+   bool priv_sleep(bool_<false>, boost::uint32_t seq, const TimePoint &)
+   {
+      futex_wait(&m_seq, seq);
+      return true;
+   }
+
+   volatile boost::uint32_t    m_seq;
+   volatile boost::uint32_t    m_waiters;
+   volatile boost::uint32_t    m_requeue;
+};
+
+}  //namespace ipcdetail
+}  //namespace interprocess
+}  //namespace boost
+
+#endif   //#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_FUTEX_CONDITION_HPP
@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_FUTEX_MUTEX_HPP
+#define BOOST_INTERPROCESS_DETAIL_FUTEX_MUTEX_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/cstdint.hpp>
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//A mutex built on a single futex word: 0 is unlocked, 1 locked and
+//2 locked with (possibly) blocked waiters, so that unlock only enters
+//the kernel when there is someone to wake.
+class futex_mutex
+{
+   futex_mutex(const futex_mutex &);
+   futex_mutex &operator=(const futex_mutex &);
+   public:
+
+   futex_mutex();
+   ~futex_mutex();
+
+   void lock();
+   bool try_lock();
+   template<class TimePoint>
+   bool timed_lock(const TimePoint &abs_time);
+
+   template<class TimePoint> bool try_lock_until(const TimePoint &abs_time)
+   {  return this->timed_lock(abs_time);  }
+
+   template<class Duration>  bool try_lock_for(const Duration &dur)
+   {  return this->timed_lock(duration_to_ustime(dur)); }
+
+   void unlock();
+   void take_ownership(){}
+
+   //Locks the mutex leaving it marked as contended, so that the unlock wakes
+   //a waiter. Used by threads that might have been moved to the futex word
+   //of the mutex by futex_condition::notify_all
+   void lock_contended();
+
+   volatile boost::uint32_t *futex_word()
+   {  return &m_s;  }
+
+   private:
+   enum { Unlocked, Locked, LockedWaiters };
+
+   boost::uint32_t exchange(boost::uint32_t val)
+   {
+      boost::uint32_t old = atomic_read32(&m_s);
+      boost::uint32_t prev;
+      while((prev = atomic_cas32(&m_s, val, old)) != old){
+         old = prev;
+      }
+      return old;
+   }
+
+   volatile boost::uint32_t m_s;
+};
+
+inline futex_mutex::futex_mutex()
+   : m_s(Unlocked)
+{
+   //Note that this class is initialized to zero.
+   //So zeroed memory can be interpreted as an
+   //initialized mutex
+}
+
+inline futex_mutex::~futex_mutex()
+{
+   //Trivial destructor
+}
+
+inline void futex_mutex::lock()
+{
+   if(!this->try_lock()){
+      this->lock_contended();
+   }
+}
+
+inline bool futex_mutex::try_lock()
+{  return atomic_cas32(&m_s, Locked, Unlocked) == Unlocked;   }
+
+inline void futex_mutex::lock_contended()
+{
+   while(this->exchange(LockedWaiters) != Unlocked){
+      futex_wait(&m_s, LockedWaiters);
+   }
+}
+
+template<class TimePoint>
+inline bool futex_mutex::timed_lock(const TimePoint &abs_time)
+{
+   if(this->try_lock()){
+      return true;
+   }
+   else if(is_pos_infinity(abs_time)){
+      this->lock_contended();
+      return true;
+   }
+   while(this->exchange(LockedWaiters) != Unlocked){
+      const typename microsec_clock<TimePoint>::time_point now = microsec_clock<TimePoint>::universal_time();
+      if(now >= abs_time){
+         return false;
+      }
+      futex_timed_wait(&m_s, LockedWaiters, duration_to_usduration(abs_time - now));
+   }
+   return true;
+}
+
+inline void futex_mutex::unlock()
+{
+   //Only enter the kernel if there might be waiters
+   if(atomic_dec32(&m_s) != Locked){
+      atomic_write32(&m_s, Unlocked);
+      futex_wake(&m_s, 1);
+   }
+}
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#endif   //#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_FUTEX_MUTEX_HPP
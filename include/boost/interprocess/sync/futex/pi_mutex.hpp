@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_FUTEX_PI_MUTEX_HPP
+#define BOOST_INTERPROCESS_DETAIL_FUTEX_PI_MUTEX_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+#include <boost/interprocess/sync/posix/timepoint_to_timespec.hpp>
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//A priority inheritance mutex built on a PI futex: the word is zero when unlocked
+//and holds the TID of the owner otherwise. Uncontended locks and unlocks are
+//a single compare and swap, contended ones are handled by the kernel, which
+//boosts the owner to the priority of the highest priority waiter.
+class futex_pi_mutex
+{
+   futex_pi_mutex(const futex_pi_mutex &);
+   futex_pi_mutex &operator=(const futex_pi_mutex &);
+   public:
+
+   futex_pi_mutex();
+   ~futex_pi_mutex();
+
+   void lock();
+   bool try_lock();
+   template<class TimePoint>
+   bool timed_lock(const TimePoint &abs_time);
+
+   template<class TimePoint> bool try_lock_until(const TimePoint &abs_time)
+   {  return this->timed_lock(abs_time);  }
+
+   template<class Duration>  bool try_lock_for(const Duration &dur)
+   {  return this->timed_lock(duration_to_ustime(dur)); }
+
+   void unlock();
+   void take_ownership(){}
+
+   private:
+   volatile boost::uint32_t m_s;
+};
+
+inline futex_pi_mutex::futex_pi_mutex()
+   : m_s(0u)
+{
+   //Note that this class is initialized to zero.
+   //So zeroed memory can be interpreted as an
+   //initialized mutex
+}
+
+inline futex_pi_mutex::~futex_pi_mutex()
+{
+   //Trivial destructor
+}
+
+inline void futex_pi_mutex::lock()
+{
+   if(!this->try_lock() && futex_lock_pi(&m_s, 0) != 0){
+      throw lock_exception();
+   }
+}
+
+inline bool futex_pi_mutex::try_lock()
+{  return atomic_cas32(&m_s, futex_tid(), 0u) == 0u;   }
+
+template<class TimePoint>
+inline bool futex_pi_mutex::timed_lock(const TimePoint &abs_time)
+{
+   if(this->try_lock()){
+      return true;
+   }
+   else if(is_pos_infinity(abs_time)){
+      this->lock();
+      return true;
+   }
+   //FUTEX_LOCK_PI takes an absolute CLOCK_REALTIME timeout
+   const ::timespec ts = timepoint_to_timespec(abs_time);
+   const int res = futex_lock_pi(&m_s, &ts);
+   if(res != 0 && res != ETIMEDOUT){
+      throw lock_exception();
+   }
+   return res == 0;
+}
+
+inline void futex_pi_mutex::unlock()
+{
+   //If there are waiters the kernel has set FUTEX_WAITERS in the word
+   //and it must hand the mutex to the highest priority waiter
+   const boost::uint32_t tid = futex_tid();
+   if(atomic_cas32(&m_s, 0u, tid) != tid){
+      BOOST_ASSERT((atomic_read32(&m_s) & FUTEX_TID_MASK) == tid);
+      futex_unlock_pi(&m_s);
+   }
+}
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#endif   //#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_FUTEX_PI_MUTEX_HPP
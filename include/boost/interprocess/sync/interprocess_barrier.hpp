@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_BARRIER_HPP
+#define BOOST_INTERPROCESS_BARRIER_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/sync/spin/interprocess_barrier.hpp>
+
+//!\file
+//!Describes interprocess_barrier, a barrier that can be placed in shared memory.
+
+namespace boost {
+namespace interprocess {
+
+//!A barrier that can be placed in shared memory, to synchronize a fixed number
+//!of processes/threads that repeatedly wait for each other (e.g. workers of a
+//!lock-step simulation).
+//!
+//!Arrivals are atomic operations. The last participant of a phase releases the rest,
+//!which spin for a short time before blocking (in a futex on Linux), so short phases
+//!don't pay the wakeup latency of a mutex and a condition variable.
+//!
+//!With tree_threshold or more participants, participants that pass their
+//!index to wait(participant) are grouped in leaves of the combining tree, so that
+//!arrivals are spread among several cache lines instead of a single shared counter.
+class interprocess_barrier
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   interprocess_barrier(const interprocess_barrier &);
+   interprocess_barrier &operator=(const interprocess_barrier &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Participant count from which wait(participant) uses the combining tree
+   static const unsigned int tree_threshold = ipcdetail::spin_barrier::tree_threshold;
+
+   //!Constructs a barrier for "count" participants.
+   //!Throws std::invalid_argument if count is zero.
+   explicit interprocess_barrier(unsigned int count)
+      : m_barrier(count)
+   {}
+
+   //!Destroys the barrier. No participant must be waiting on it.
+   //!Does not throw.
+   ~interprocess_barrier()
+   {}
+
+   //!Blocks until "count" participants have arrived in the current phase.
+   //!Returns true for exactly one participant of each phase (the last one
+   //!to arrive) and false for the rest. Never throws.
+   bool wait()
+   {  return m_barrier.wait();  }
+
+   //!Same as wait(), for the participant identified by "participant", which
+   //!must be unique among the participants of a phase and less than "count".
+   //!With tree_threshold or more participants, arrivals go through the combining tree.
+   //!All the participants of a barrier must consistently use either wait()
+   //!or wait(participant). Never throws.
+   bool wait(unsigned int participant)
+   {  return m_barrier.wait(participant);  }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   ipcdetail::spin_barrier m_barrier;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_BARRIER_HPP
@@ -32,7 +32,10 @@
 #include <boost/limits.hpp>
 #include <boost/assert.hpp>
 
-#if   !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined(BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
+#if   !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined(BOOST_INTERPROCESS_USE_FUTEX_SYNC) && defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   #include <boost/interprocess/sync/futex/condition.hpp>
+   #define BOOST_INTERPROCESS_CONDITION_USE_FUTEX
+#elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined(BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
    #include <boost/interprocess/sync/posix/condition.hpp>
    #define BOOST_INTERPROCESS_CONDITION_USE_POSIX
 //Experimental...
@@ -97,7 +100,14 @@ class interprocess_condition
    void wait(L& lock)
    {
       ipcdetail::internal_mutex_lock<L> internal_lock(lock);
+      #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+      ipcdetail::lock_stats_probe probe(m_stats);
+      probe.contended();
       m_condition.wait(internal_lock);
+      probe.acquired();
+      #else
+      m_condition.wait(internal_lock);
+      #endif
    }
 
    //!The same as:
@@ -106,7 +116,14 @@ class interprocess_condition
    void wait(L& lock, Pr pred)
    {
       ipcdetail::internal_mutex_lock<L> internal_lock(lock);
+      #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+      ipcdetail::lock_stats_probe probe(m_stats);
+      probe.contended();
+      m_condition.wait(internal_lock, pred);
+      probe.acquired();
+      #else
       m_condition.wait(internal_lock, pred);
+      #endif
    }
 
    //!Releases the lock on the interprocess_mutex object associated with lock, blocks
@@ -118,7 +135,13 @@ class interprocess_condition
    bool timed_wait(L& lock, const TimePoint &abs_time)
    {
       ipcdetail::internal_mutex_lock<L> internal_lock(lock);
+      #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+      ipcdetail::lock_stats_probe probe(m_stats);
+      probe.contended();
+      return probe.result(m_condition.timed_wait(internal_lock, abs_time));
+      #else
       return m_condition.timed_wait(internal_lock, abs_time);
+      #endif
    }
 
    //!The same as:   while (!pred()) {
@@ -128,7 +151,13 @@ class interprocess_condition
    bool timed_wait(L& lock, const TimePoint &abs_time, Pr pred)
    {
       ipcdetail::internal_mutex_lock<L> internal_lock(lock);
+      #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+      ipcdetail::lock_stats_probe probe(m_stats);
+      probe.contended();
+      return probe.result(m_condition.timed_wait(internal_lock, abs_time, pred));
+      #else
       return m_condition.timed_wait(internal_lock, abs_time, pred);
+      #endif
    }
 
    //!Same as `timed_wait`, but this function is modeled after the
@@ -155,15 +184,36 @@ class interprocess_condition
    bool wait_for(L& lock, const Duration &dur, Pr pred)
    {  return this->wait_until(lock, ipcdetail::duration_to_ustime(dur), pred); }
 
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the counters of this condition: every wait is accounted as
+   //!a contended acquisition and timed out waits are accounted as timeouts.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   lock_stats &stats()
+   {  return m_stats;   }
+
+   //!Returns the counters of this condition.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   const lock_stats &stats() const
+   {  return m_stats;   }
+   #endif
+
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
-   private:
-   #if defined(BOOST_INTERPROCESS_CONDITION_USE_POSIX)
-      ipcdetail::posix_condition m_condition;
+   public:
+   #if defined(BOOST_INTERPROCESS_CONDITION_USE_FUTEX)
+      typedef ipcdetail::futex_condition internal_condition_type;
+   #elif defined(BOOST_INTERPROCESS_CONDITION_USE_POSIX)
+      typedef ipcdetail::posix_condition internal_condition_type;
    #elif defined(BOOST_INTERPROCESS_CONDITION_USE_WINAPI)
-      ipcdetail::winapi_condition m_condition;
+      typedef ipcdetail::winapi_condition internal_condition_type;
    #else
-      ipcdetail::spin_condition m_condition;
+      typedef ipcdetail::spin_condition internal_condition_type;
+   #endif
+
+   private:
+   internal_condition_type m_condition;
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   lock_stats m_stats;
    #endif
 
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
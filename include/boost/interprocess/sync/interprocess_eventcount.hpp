@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_EVENTCOUNT_HPP
+#define BOOST_INTERPROCESS_EVENTCOUNT_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/ipc_atomic_wait.hpp>
+#include <boost/cstdint.hpp>
+
+//!\file
+//!Describes interprocess_eventcount, an object to block until a condition on
+//!shared state, modified without locks, becomes true.
+
+namespace boost {
+namespace interprocess {
+
+//!An eventcount that can be placed in shared memory: a condition variable for state that is
+//!modified with atomic operations instead of under a mutex (lock-free queues, flags, counters...).
+//!
+//!A waiter gets a key with prepare_wait(), checks its condition again and, if it's still false,
+//!blocks with wait(key) (or gives up with cancel_wait()). A notifier changes the state and then
+//!calls notify_one() or notify_all(), which only increment the epoch and enter the kernel if
+//!there are waiters, so notifying without waiters costs an atomic operation:
+//!
+//!\code
+//!while(!queue.try_pop(v)){
+//!   const interprocess_eventcount::key_type key = ec.prepare_wait();
+//!   if(queue.try_pop(v)){
+//!      ec.cancel_wait();
+//!      break;
+//!   }
+//!   ec.wait(key);
+//!}
+//!\endcode
+//!
+//!A notification between prepare_wait() and wait(key) is not lost, as it changes
+//!the epoch and wait(key) returns immediately. Waiters can return without a
+//!notification for the state they wait for, so they must check it again.
+class interprocess_eventcount
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   interprocess_eventcount(const interprocess_eventcount &);
+   interprocess_eventcount &operator=(const interprocess_eventcount &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   typedef boost::uint32_t key_type;
+
+   //!Constructs an eventcount without waiters. Never throws.
+   interprocess_eventcount()
+      : m_epoch(0u), m_waiters(0u)
+   {}
+
+   //!Registers the calling thread as a waiter and returns the current epoch.
+   //!Must be followed by wait(key), timed_wait(key, abs_time) or cancel_wait(). Never throws.
+   key_type prepare_wait()
+   {
+      //The waiter is registered before the caller checks the state again
+      //and notifiers check waiters after changing the state,
+      //so either the notifier sees the waiter or the waiter sees the state
+      ipcdetail::atomic_inc32(&m_waiters);
+      return ipcdetail::atomic_read32(&m_epoch);
+   }
+
+   //!Unregisters the calling thread as a waiter, when the condition
+   //!became true after prepare_wait(). Never throws.
+   void cancel_wait()
+   {  ipcdetail::atomic_dec32(&m_waiters);  }
+
+   //!Blocks until the epoch is not "key" (a notification after prepare_wait()
+   //!returned "key") and unregisters the calling thread as a waiter. Never throws.
+   void wait(key_type key)
+   {
+      ipc_atomic_wait(&m_epoch, key);
+      ipcdetail::atomic_dec32(&m_waiters);
+   }
+
+   //!Same as wait(key), but returns false if abs_time is reached
+   //!before a notification. Never throws.
+   template<class TimePoint>
+   bool timed_wait(key_type key, const TimePoint &abs_time)
+   {
+      const bool r = ipc_atomic_wait(&m_epoch, key, abs_time);
+      ipcdetail::atomic_dec32(&m_waiters);
+      return r;
+   }
+
+   //!Wakes one waiter, if any. Never throws.
+   void notify_one()
+   {
+      if(this->priv_advance()){
+         ipc_atomic_notify_one(&m_epoch);
+      }
+   }
+
+   //!Wakes all the waiters, if any. Never throws.
+   void notify_all()
+   {
+      if(this->priv_advance()){
+         ipc_atomic_notify_all(&m_epoch);
+      }
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   //Increments the epoch if there are waiters
+   bool priv_advance()
+   {
+      //A read-modify-write, to order the state changes of the
+      //caller (maybe plain stores) before reading the waiters
+      if(!ipcdetail::atomic_add32(&m_waiters, 0u)){
+         return false;
+      }
+      ipcdetail::atomic_inc32(&m_epoch);
+      return true;
+   }
+
+   volatile boost::uint32_t m_epoch;
+   volatile boost::uint32_t m_waiters;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_EVENTCOUNT_HPP
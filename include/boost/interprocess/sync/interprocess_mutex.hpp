@@ -32,7 +32,14 @@
 #include <boost/assert.hpp>
 #include <boost/interprocess/sync/detail/common_algorithms.hpp>
 
-#if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
+#if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   #include <boost/interprocess/sync/lock_stats.hpp>
+#endif
+
+#if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_USE_FUTEX_SYNC) && defined (BOOST_INTERPROCESS_HAS_FUTEX)
+   #include <boost/interprocess/sync/futex/mutex.hpp>
+   #define BOOST_INTERPROCESS_MUTEX_USE_FUTEX
+#elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
    #include <boost/interprocess/sync/posix/mutex.hpp>
    #define BOOST_INTERPROCESS_MUTEX_USE_POSIX
 #elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_WINDOWS)
@@ -75,7 +82,9 @@ class interprocess_mutex
    friend class interprocess_condition;
 
    public:
-   #if defined(BOOST_INTERPROCESS_MUTEX_USE_POSIX)
+   #if defined(BOOST_INTERPROCESS_MUTEX_USE_FUTEX)
+      typedef ipcdetail::futex_mutex internal_mutex_type;
+   #elif defined(BOOST_INTERPROCESS_MUTEX_USE_POSIX)
       typedef ipcdetail::posix_mutex internal_mutex_type;
    #elif defined(BOOST_INTERPROCESS_MUTEX_USE_WINAPI)
       typedef ipcdetail::winapi_mutex internal_mutex_type;
@@ -154,6 +163,18 @@ class interprocess_mutex
    //!Throws: interprocess_exception on error.
    void unlock();
 
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   lock_stats &stats()
+   {  return m_stats;   }
+
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   const lock_stats &stats() const
+   {  return m_stats;   }
+   #endif
+
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
    internal_mutex_type &internal_mutex()
    {  return m_mutex;   }
@@ -163,6 +184,9 @@ class interprocess_mutex
 
    private:
    internal_mutex_type m_mutex;
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   lock_stats m_stats;
+   #endif
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
 };
 
@@ -177,6 +201,8 @@ inline interprocess_mutex::interprocess_mutex(){}
 
 inline interprocess_mutex::~interprocess_mutex(){}
 
+#if !defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+
 inline void interprocess_mutex::lock()
 {  ipcdetail::timeout_when_locking_aware_lock(m_mutex);  }
 
@@ -190,6 +216,47 @@ inline bool interprocess_mutex::timed_lock(const TimePoint &abs_time)
 inline void interprocess_mutex::unlock()
 { m_mutex.unlock(); }
 
+#else //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+inline void interprocess_mutex::lock()
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(!m_mutex.try_lock()){
+      probe.contended();
+      ipcdetail::timeout_when_locking_aware_lock(m_mutex);
+   }
+   probe.acquired_exclusive();
+}
+
+inline bool interprocess_mutex::try_lock()
+{
+   if(!m_mutex.try_lock()){
+      return false;
+   }
+   ipcdetail::lock_stats_probe(m_stats).acquired_exclusive();
+   return true;
+}
+
+template <class TimePoint>
+inline bool interprocess_mutex::timed_lock(const TimePoint &abs_time)
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(m_mutex.try_lock()){
+      probe.acquired_exclusive();
+      return true;
+   }
+   probe.contended();
+   return probe.result_exclusive(m_mutex.timed_lock(abs_time));
+}
+
+inline void interprocess_mutex::unlock()
+{
+   ipcdetail::lock_stats_probe::released_exclusive(m_stats);
+   m_mutex.unlock();
+}
+
+#endif   //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
 }  //namespace interprocess {
 }  //namespace boost {
 
@@ -0,0 +1,241 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_PI_MUTEX_HPP
+#define BOOST_INTERPROCESS_PI_MUTEX_HPP
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/assert.hpp>
+#include <boost/interprocess/sync/detail/common_algorithms.hpp>
+
+#if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   #include <boost/interprocess/sync/lock_stats.hpp>
+#endif
+
+#if !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_USE_FUTEX_SYNC) && defined (BOOST_INTERPROCESS_HAS_FUTEX)
+   #include <boost/interprocess/sync/futex/pi_mutex.hpp>
+   #define BOOST_INTERPROCESS_PI_MUTEX_USE_FUTEX
+#elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)
+   #include <boost/interprocess/sync/posix/mutex.hpp>
+   #define BOOST_INTERPROCESS_PI_MUTEX_USE_POSIX
+#elif defined (BOOST_INTERPROCESS_HAS_FUTEX)
+   //Pthreads are not used, but the kernel still supports priority inheritance
+   #include <boost/interprocess/sync/futex/pi_mutex.hpp>
+   #define BOOST_INTERPROCESS_PI_MUTEX_USE_FUTEX
+#elif !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && defined (BOOST_INTERPROCESS_WINDOWS)
+   //No priority inheritance available
+   #include <boost/interprocess/sync/windows/mutex.hpp>
+   #define BOOST_INTERPROCESS_PI_MUTEX_USE_WINAPI
+#else
+   //No priority inheritance available, spin_mutex is used
+   #include <boost/interprocess/sync/spin/mutex.hpp>
+#endif
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!\file
+//!Describes a priority inheritance mutex class that can be placed in memory shared by
+//!several processes.
+
+namespace boost {
+namespace interprocess {
+
+//!A mutex that can be placed in shared memory and can be shared between processes, with
+//!the same interface as interprocess_mutex, that uses priority inheritance: while a
+//!higher priority thread is blocked on the mutex, the owner runs with that priority, so
+//!a critical section held by a background process can't be delayed indefinitely by
+//!medium priority threads (priority inversion).
+//!
+//!It can be used with interprocess_condition. Priority inheritance uses pthread mutexes with
+//!the PTHREAD_PRIO_INHERIT protocol and, if pthread mutexes are not used (e.g. with
+//!BOOST_INTERPROCESS_USE_FUTEX_SYNC), Linux priority inheritance futexes. On systems that
+//!support neither, the mutex behaves like interprocess_mutex.
+class interprocess_pi_mutex
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   interprocess_pi_mutex(const interprocess_pi_mutex &);
+   interprocess_pi_mutex &operator=(const interprocess_pi_mutex &);
+
+   public:
+   #if defined(BOOST_INTERPROCESS_PI_MUTEX_USE_FUTEX)
+      typedef ipcdetail::futex_pi_mutex internal_mutex_type;
+   #elif defined(BOOST_INTERPROCESS_PI_MUTEX_USE_POSIX)
+      typedef ipcdetail::posix_mutex internal_mutex_type;
+   #elif defined(BOOST_INTERPROCESS_PI_MUTEX_USE_WINAPI)
+      typedef ipcdetail::winapi_mutex internal_mutex_type;
+   #else
+      typedef ipcdetail::spin_mutex internal_mutex_type;
+   #endif
+
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   public:
+
+   //!Constructor.
+   //!Throws interprocess_exception on error.
+   interprocess_pi_mutex();
+
+   //!Destructor. If any process uses the mutex after the destructor is called
+   //!the result is undefined. Does not throw.
+   ~interprocess_pi_mutex();
+
+   //!Effects: The calling thread tries to obtain ownership of the mutex, and
+   //!   if another thread has ownership of the mutex, it waits until it can
+   //!   obtain the ownership, boosting the priority of the owner if needed.
+   //!Throws: interprocess_exception on error.
+   void lock();
+
+   //!Effects: The calling thread tries to obtain ownership of the mutex, and
+   //!   if another thread has ownership of the mutex returns immediately.
+   //!Returns: If the thread acquires ownership of the mutex, returns true, if
+   //!   the another thread has ownership of the mutex, returns false.
+   //!Throws: interprocess_exception on error.
+   bool try_lock();
+
+   //!Effects: The calling thread will try to obtain exclusive ownership of the
+   //!   mutex if it can do so in until the specified time is reached.
+   //!Returns: If the thread acquires ownership of the mutex, returns true, if
+   //!   the timeout expires returns false.
+   //!Throws: interprocess_exception on error.
+   template<class TimePoint>
+   bool timed_lock(const TimePoint &abs_time);
+
+   //!Same as `timed_lock`, but this function is modeled after the
+   //!standard library interface.
+   template<class TimePoint> bool try_lock_until(const TimePoint &abs_time)
+   {  return this->timed_lock(abs_time);  }
+
+   //!Same as `timed_lock`, but this function is modeled after the
+   //!standard library interface.
+   template<class Duration>  bool try_lock_for(const Duration &dur)
+   {  return this->timed_lock(ipcdetail::duration_to_ustime(dur)); }
+
+   //!Effects: The calling thread releases the exclusive ownership of the mutex.
+   //!   The mutex must be unlocked by the thread that locked it.
+   //!Throws: interprocess_exception on error.
+   void unlock();
+
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   lock_stats &stats()
+   {  return m_stats;   }
+
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   const lock_stats &stats() const
+   {  return m_stats;   }
+   #endif
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   internal_mutex_type &internal_mutex()
+   {  return m_mutex;   }
+
+   const internal_mutex_type &internal_mutex() const
+   {  return m_mutex;   }
+
+   private:
+   internal_mutex_type m_mutex;
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   lock_stats m_stats;
+   #endif
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+
+namespace boost {
+namespace interprocess {
+
+#if defined(BOOST_INTERPROCESS_PI_MUTEX_USE_POSIX)
+inline interprocess_pi_mutex::interprocess_pi_mutex() : m_mutex(true) {}
+#else
+inline interprocess_pi_mutex::interprocess_pi_mutex(){}
+#endif
+
+inline interprocess_pi_mutex::~interprocess_pi_mutex(){}
+
+#if !defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+
+inline void interprocess_pi_mutex::lock()
+{  ipcdetail::timeout_when_locking_aware_lock(m_mutex);  }
+
+inline bool interprocess_pi_mutex::try_lock()
+{ return m_mutex.try_lock(); }
+
+template <class TimePoint>
+inline bool interprocess_pi_mutex::timed_lock(const TimePoint &abs_time)
+{ return m_mutex.timed_lock(abs_time); }
+
+inline void interprocess_pi_mutex::unlock()
+{ m_mutex.unlock(); }
+
+#else //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+inline void interprocess_pi_mutex::lock()
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(!m_mutex.try_lock()){
+      probe.contended();
+      ipcdetail::timeout_when_locking_aware_lock(m_mutex);
+   }
+   probe.acquired_exclusive();
+}
+
+inline bool interprocess_pi_mutex::try_lock()
+{
+   if(!m_mutex.try_lock()){
+      return false;
+   }
+   ipcdetail::lock_stats_probe(m_stats).acquired_exclusive();
+   return true;
+}
+
+template <class TimePoint>
+inline bool interprocess_pi_mutex::timed_lock(const TimePoint &abs_time)
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(m_mutex.try_lock()){
+      probe.acquired_exclusive();
+      return true;
+   }
+   probe.contended();
+   return probe.result_exclusive(m_mutex.timed_lock(abs_time));
+}
+
+inline void interprocess_pi_mutex::unlock()
+{
+   ipcdetail::lock_stats_probe::released_exclusive(m_stats);
+   m_mutex.unlock();
+}
+
+#endif   //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_PI_MUTEX_HPP
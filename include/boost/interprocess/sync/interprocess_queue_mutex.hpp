@@ -0,0 +1,222 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_QUEUE_MUTEX_HPP
+#define BOOST_INTERPROCESS_QUEUE_MUTEX_HPP
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/assert.hpp>
+#include <boost/interprocess/sync/detail/common_algorithms.hpp>
+
+#if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   #include <boost/interprocess/sync/lock_stats.hpp>
+#endif
+
+#include <boost/interprocess/sync/spin/queue_mutex.hpp>
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!\file
+//!Describes a fair queue mutex class that can be placed in memory shared by
+//!several processes.
+
+namespace boost {
+namespace interprocess {
+
+//!A mutex that can be placed in shared memory and can be shared between processes, with
+//!the same interface as interprocess_mutex, that grants the ownership in FIFO order.
+//!
+//!Each waiter spins on its own cache line and blocks after a short spin (on a futex on Linux),
+//!so heavily contended mutexes don't suffer the cache line traffic and the starvation of locks
+//!where all the waiters compete for a single word. Up to 32 threads can be queued: when the queue
+//!is full, the rest wait for a place in it (not in FIFO order). It holds no pointers,
+//!and a zeroed object is an unlocked mutex. The object occupies 33 cache lines.
+//!
+//!timed_lock, try_lock_until and try_lock_for join the queue too, and leave it if the timeout
+//!expires. try_lock only succeeds if the mutex is unlocked and nobody is waiting for it.
+//!If BOOST_INTERPROCESS_ENABLE_TIMEOUT_WHEN_LOCKING is defined, lock() behaves like timed_lock.
+//!
+//!Each place in the queue records the process that took it, and waiters periodically check
+//!that the process at the head of the queue is alive, so a process that dies while waiting
+//!only delays the next waiters. Like interprocess_mutex, if the owner dies the mutex is never unlocked.
+//!
+//!queue_mutex_family can be used to protect memory algorithms of managed segments
+//!with this mutex.
+class interprocess_queue_mutex
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   interprocess_queue_mutex(const interprocess_queue_mutex &);
+   interprocess_queue_mutex &operator=(const interprocess_queue_mutex &);
+
+   public:
+   typedef ipcdetail::spin_queue_mutex internal_mutex_type;
+
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+   public:
+
+   //!Constructor.
+   //!Throws interprocess_exception on error.
+   interprocess_queue_mutex();
+
+   //!Destructor. If any process uses the mutex after the destructor is called
+   //!the result is undefined. Does not throw.
+   ~interprocess_queue_mutex();
+
+   //!Effects: The calling thread tries to obtain ownership of the mutex, and
+   //!   if another thread has ownership of the mutex, it waits until it can
+   //!   obtain the ownership after the threads that were already waiting.
+   //!Throws: interprocess_exception on error.
+   void lock();
+
+   //!Effects: The calling thread tries to obtain ownership of the mutex, and
+   //!   if another thread has ownership of the mutex returns immediately.
+   //!Returns: If the thread acquires ownership of the mutex, returns true, if
+   //!   the another thread has ownership of the mutex, returns false.
+   //!Throws: interprocess_exception on error.
+   bool try_lock();
+
+   //!Effects: The calling thread will try to obtain exclusive ownership of the
+   //!   mutex if it can do so in until the specified time is reached. The calling
+   //!   thread joins the queue of waiters and leaves it if the time is reached.
+   //!Returns: If the thread acquires ownership of the mutex, returns true, if
+   //!   the timeout expires returns false.
+   //!Throws: interprocess_exception on error.
+   template<class TimePoint>
+   bool timed_lock(const TimePoint &abs_time);
+
+   //!Same as `timed_lock`, but this function is modeled after the
+   //!standard library interface.
+   template<class TimePoint> bool try_lock_until(const TimePoint &abs_time)
+   {  return this->timed_lock(abs_time);  }
+
+   //!Same as `timed_lock`, but this function is modeled after the
+   //!standard library interface.
+   template<class Duration>  bool try_lock_for(const Duration &dur)
+   {  return this->timed_lock(ipcdetail::duration_to_ustime(dur)); }
+
+   //!Effects: The calling thread releases the exclusive ownership of the mutex.
+   //!   The mutex must be unlocked by the thread that locked it.
+   //!Throws: interprocess_exception on error.
+   void unlock();
+
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   lock_stats &stats()
+   {  return m_stats;   }
+
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   const lock_stats &stats() const
+   {  return m_stats;   }
+   #endif
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   internal_mutex_type &internal_mutex()
+   {  return m_mutex;   }
+
+   const internal_mutex_type &internal_mutex() const
+   {  return m_mutex;   }
+
+   private:
+   internal_mutex_type m_mutex;
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   lock_stats m_stats;
+   #endif
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+
+namespace boost {
+namespace interprocess {
+
+inline interprocess_queue_mutex::interprocess_queue_mutex(){}
+
+inline interprocess_queue_mutex::~interprocess_queue_mutex(){}
+
+#if !defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+
+inline void interprocess_queue_mutex::lock()
+{  ipcdetail::timeout_when_locking_aware_lock(m_mutex);  }
+
+inline bool interprocess_queue_mutex::try_lock()
+{ return m_mutex.try_lock(); }
+
+template <class TimePoint>
+inline bool interprocess_queue_mutex::timed_lock(const TimePoint &abs_time)
+{ return m_mutex.timed_lock(abs_time); }
+
+inline void interprocess_queue_mutex::unlock()
+{ m_mutex.unlock(); }
+
+#else //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+inline void interprocess_queue_mutex::lock()
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(!m_mutex.try_lock()){
+      probe.contended();
+      ipcdetail::timeout_when_locking_aware_lock(m_mutex);
+   }
+   probe.acquired_exclusive();
+}
+
+inline bool interprocess_queue_mutex::try_lock()
+{
+   if(!m_mutex.try_lock()){
+      return false;
+   }
+   ipcdetail::lock_stats_probe(m_stats).acquired_exclusive();
+   return true;
+}
+
+template <class TimePoint>
+inline bool interprocess_queue_mutex::timed_lock(const TimePoint &abs_time)
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(m_mutex.try_lock()){
+      probe.acquired_exclusive();
+      return true;
+   }
+   probe.contended();
+   return probe.result_exclusive(m_mutex.timed_lock(abs_time));
+}
+
+inline void interprocess_queue_mutex::unlock()
+{
+   ipcdetail::lock_stats_probe::released_exclusive(m_stats);
+   m_mutex.unlock();
+}
+
+#endif   //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_QUEUE_MUTEX_HPP
@@ -29,6 +29,10 @@
 #include <boost/interprocess/sync/detail/locks.hpp>
 #include <boost/interprocess/sync/detail/common_algorithms.hpp>
 
+#if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   #include <boost/interprocess/sync/lock_stats.hpp>
+#endif
+
 #if   !defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION) && \
        defined(BOOST_INTERPROCESS_POSIX_PROCESS_SHARED)    && \
        defined(BOOST_INTERPROCESS_POSIX_UNNAMED_SEMAPHORES)
@@ -92,8 +96,48 @@ class interprocess_semaphore
    template<class TimePoint>
    bool timed_wait(const TimePoint &abs_time);
 
+   //!Increments the interprocess_semaphore count by n, as n calls to post().
+   //!If there is an error an interprocess_exception exception is thrown.
+   void post(unsigned int n);
+
+   //!Decrements the interprocess_semaphore count by n. If the count is less than n, the calling
+   //!process/thread blocks until it can decrement it by n. Units are never held
+   //!while waiting, so a waiter of n units only acquires them when all are available.
+   //!Note: POSIX and Windows semaphores can only acquire one unit at a time, so
+   //!the wait is emulated: when fewer than n units are available the waiter returns
+   //!the units it took and sleeps before trying again. Waiters of fewer units can starve
+   //!it and it might acquire the units late (see BOOST_INTERPROCESS_SEMAPHORE_WAIT_N_MAX_SLEEP_MS).
+   //!If there is an error an interprocess_exception exception is thrown.
+   void wait(unsigned int n);
+
+   //!Decrements the interprocess_semaphore count by n and returns true if the count is
+   //!not less than n. Otherwise returns false and the count is not modified.
+   //!If there is an error an interprocess_exception exception is thrown.
+   bool try_wait(unsigned int n);
+
+   //!Decrements the interprocess_semaphore count by n, waiting if necessary until
+   //!the count is not less than n or abs_time is reached. On timeout returns false
+   //!and no unit is acquired. The same note as in wait(n) applies.
+   //!If there is an error throws sem_exception
+   template<class TimePoint>
+   bool timed_wait(unsigned int n, const TimePoint &abs_time);
+
    //!Returns the interprocess_semaphore count
 //   int get_count() const;
+
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the counters of this semaphore, where each successful wait
+   //!is accounted as an acquisition.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   lock_stats &stats()
+   {  return m_stats;   }
+
+   //!Returns the counters of this semaphore.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   const lock_stats &stats() const
+   {  return m_stats;   }
+   #endif
+
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
    private:
    #if defined(BOOST_INTERPROCESS_SEMAPHORE_USE_POSIX)
@@ -104,6 +148,9 @@ class interprocess_semaphore
       typedef ipcdetail::spin_semaphore internal_sem_t;
    #endif   //#if defined(BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION)
    internal_sem_t m_sem;
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   lock_stats m_stats;
+   #endif
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
 };
 
@@ -119,6 +166,8 @@ inline interprocess_semaphore::interprocess_semaphore(unsigned int initialCount)
 
 inline interprocess_semaphore::~interprocess_semaphore(){}
 
+#if !defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+
 inline void interprocess_semaphore::wait()
 {
    ipcdetail::lock_to_wait<internal_sem_t> ltw(m_sem);
@@ -132,9 +181,99 @@ template<class TimePoint>
 inline bool interprocess_semaphore::timed_wait(const TimePoint &abs_time)
 { return m_sem.timed_wait(abs_time); }
 
+#else //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+inline void interprocess_semaphore::wait()
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(!m_sem.try_wait()){
+      probe.contended();
+      ipcdetail::lock_to_wait<internal_sem_t> ltw(m_sem);
+      timeout_when_locking_aware_lock(ltw);
+   }
+   probe.acquired();
+}
+
+inline bool interprocess_semaphore::try_wait()
+{
+   if(!m_sem.try_wait()){
+      return false;
+   }
+   ipcdetail::lock_stats_probe(m_stats).acquired();
+   return true;
+}
+
+template<class TimePoint>
+inline bool interprocess_semaphore::timed_wait(const TimePoint &abs_time)
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(m_sem.try_wait()){
+      probe.acquired();
+      return true;
+   }
+   probe.contended();
+   return probe.result(m_sem.timed_wait(abs_time));
+}
+
+#endif   //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
 inline void interprocess_semaphore::post()
 { m_sem.post(); }
 
+inline void interprocess_semaphore::post(unsigned int n)
+{
+   if(n){
+      m_sem.post(n);
+   }
+}
+
+#if !defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+
+inline void interprocess_semaphore::wait(unsigned int n)
+{ m_sem.wait(n); }
+
+inline bool interprocess_semaphore::try_wait(unsigned int n)
+{ return m_sem.try_wait(n); }
+
+template<class TimePoint>
+inline bool interprocess_semaphore::timed_wait(unsigned int n, const TimePoint &abs_time)
+{ return m_sem.timed_wait(n, abs_time); }
+
+#else //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+inline void interprocess_semaphore::wait(unsigned int n)
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(!m_sem.try_wait(n)){
+      probe.contended();
+      m_sem.wait(n);
+   }
+   probe.acquired();
+}
+
+inline bool interprocess_semaphore::try_wait(unsigned int n)
+{
+   if(!m_sem.try_wait(n)){
+      return false;
+   }
+   ipcdetail::lock_stats_probe(m_stats).acquired();
+   return true;
+}
+
+template<class TimePoint>
+inline bool interprocess_semaphore::timed_wait(unsigned int n, const TimePoint &abs_time)
+{
+   ipcdetail::lock_stats_probe probe(m_stats);
+   if(m_sem.try_wait(n)){
+      probe.acquired();
+      return true;
+   }
+   probe.contended();
+   return probe.result(m_sem.timed_wait(n, abs_time));
+}
+
+#endif   //BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
 }  //namespace interprocess {
 }  //namespace boost {
 
@@ -31,6 +31,10 @@
 #include <boost/interprocess/sync/interprocess_condition.hpp>
 #include <climits>
 
+#if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   #include <boost/interprocess/sync/lock_stats.hpp>
+#endif
+
 
 //!\file
 //!Describes interprocess_sharable_mutex class
@@ -186,9 +190,76 @@ class interprocess_sharable_mutex
    void unlock_shared()
    {  this->unlock_sharable();  }
 
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the contention counters of this mutex. Both exclusive and sharable
+   //!acquisitions are accounted, but only exclusive ownership is accounted in hold_ns().
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   lock_stats &stats()
+   {  return m_stats;   }
+
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   const lock_stats &stats() const
+   {  return m_stats;   }
+   #endif
+
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
    private:
-   typedef scoped_lock<interprocess_mutex> scoped_lock_t;
+   //The internal primitives are not instrumented: each acquisition of
+   //this mutex is accounted once, in m_stats, including the time
+   //spent waiting for m_mut.
+   typedef interprocess_mutex::internal_mutex_type          internal_mutex_t;
+   typedef interprocess_condition::internal_condition_type  internal_condition_t;
+   typedef scoped_lock<internal_mutex_t>                    scoped_lock_t;
+
+   //Accounts an acquisition in m_stats.
+   //Does nothing if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is not defined.
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   struct probe_t
+      : ipcdetail::lock_stats_probe
+   {
+      explicit probe_t(interprocess_sharable_mutex &m)
+         : ipcdetail::lock_stats_probe(m.m_stats)
+      {}
+
+      static void released_exclusive(interprocess_sharable_mutex &m)
+      {  ipcdetail::lock_stats_probe::released_exclusive(m.m_stats);  }
+   };
+   #else
+   struct probe_t
+   {
+      explicit probe_t(interprocess_sharable_mutex &)
+      {}
+
+      void contended()           {}
+      void acquired()            {}
+      void acquired_exclusive()  {}
+      bool timed_out()           {  return false;  }
+
+      static void released_exclusive(interprocess_sharable_mutex &)
+      {}
+   };
+   #endif
+
+   //Acquires m_mut, marking the acquisition as contended if m_mut is owned
+   void priv_lock_mut(probe_t &probe)
+   {
+      if(!m_mut.try_lock()){
+         probe.contended();
+         ipcdetail::timeout_when_locking_aware_lock(m_mut);
+      }
+   }
+
+   template<class TimePoint>
+   bool priv_timed_lock_mut(probe_t &probe, const TimePoint &abs_time)
+   {
+      if(!m_mut.try_lock()){
+         probe.contended();
+         //Mutexes handle just fine infinite abs_times
+         return m_mut.timed_lock(abs_time);
+      }
+      return true;
+   }
 
    //Pack all the control data in a word to be able
    //to use atomic instructions in the future
@@ -198,16 +269,19 @@ class interprocess_sharable_mutex
       unsigned num_shared     : sizeof(unsigned)*CHAR_BIT-1;
    }                       m_ctrl;
 
-   interprocess_mutex      m_mut;
-   interprocess_condition  m_first_gate;
-   interprocess_condition  m_second_gate;
+   internal_mutex_t        m_mut;
+   internal_condition_t    m_first_gate;
+   internal_condition_t    m_second_gate;
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   lock_stats              m_stats;
+   #endif
 
    private:
    //Rollback structures for exceptions or failure return values
    struct exclusive_rollback
    {
       exclusive_rollback(control_word_t         &ctrl
-                        ,interprocess_condition &first_gate)
+                        ,internal_condition_t   &first_gate)
          :  mp_ctrl(&ctrl), m_first_gate(first_gate)
       {}
 
@@ -222,7 +296,7 @@ class interprocess_sharable_mutex
          }
       }
       control_word_t          *mp_ctrl;
-      interprocess_condition  &m_first_gate;
+      internal_condition_t    &m_first_gate;
    };
 
    template<int Dummy>
@@ -251,11 +325,14 @@ inline interprocess_sharable_mutex::~interprocess_sharable_mutex()
 
 inline void interprocess_sharable_mutex::lock()
 {
-   scoped_lock_t lck(m_mut);
+   probe_t probe(*this);
+   this->priv_lock_mut(probe);
+   scoped_lock_t lck(m_mut, accept_ownership);
 
    //The exclusive lock must block in the first gate
    //if an exclusive lock has been acquired
    while (this->m_ctrl.exclusive_in){
+      probe.contended();
       this->m_first_gate.wait(lck);
    }
 
@@ -267,9 +344,11 @@ inline void interprocess_sharable_mutex::lock()
 
    //Now wait until all readers are gone
    while (this->m_ctrl.num_shared){
+      probe.contended();
       this->m_second_gate.wait(lck);
    }
    rollback.release();
+   probe.acquired_exclusive();
 }
 
 inline bool interprocess_sharable_mutex::try_lock()
@@ -284,6 +363,7 @@ inline bool interprocess_sharable_mutex::try_lock()
       return false;
    }
    this->m_ctrl.exclusive_in = 1;
+   probe_t(*this).acquired_exclusive();
    return true;
 }
 
@@ -291,17 +371,20 @@ template<class TimePoint>
 inline bool interprocess_sharable_mutex::timed_lock
    (const TimePoint &abs_time)
 {
-   scoped_lock_t lck(m_mut, abs_time);
-   if(!lck.owns())   return false;
+   probe_t probe(*this);
+   if(!this->priv_timed_lock_mut(probe, abs_time))
+      return probe.timed_out();
+   scoped_lock_t lck(m_mut, accept_ownership);
 
    //The exclusive lock must block in the first gate
    //if an exclusive lock has been acquired
    while (this->m_ctrl.exclusive_in){
       //Mutexes and condvars handle just fine infinite abs_times
       //so avoid checking it here
+      probe.contended();
       if(!this->m_first_gate.timed_wait(lck, abs_time)){
          if(this->m_ctrl.exclusive_in){
-            return false;
+            return probe.timed_out();
          }
          break;
       }
@@ -317,20 +400,24 @@ inline bool interprocess_sharable_mutex::timed_lock
    while (this->m_ctrl.num_shared){
       //Mutexes and condvars handle just fine infinite abs_times
       //so avoid checking it here
+      probe.contended();
       if(!this->m_second_gate.timed_wait(lck, abs_time)){
          if(this->m_ctrl.num_shared){
-            return false;
+            return probe.timed_out();
          }
          break;
       }
    }
    rollback.release();
+   probe.acquired_exclusive();
    return true;
 }
 
 inline void interprocess_sharable_mutex::unlock()
 {
-   scoped_lock_t lck(m_mut);
+   ipcdetail::timeout_when_locking_aware_lock(m_mut);
+   scoped_lock_t lck(m_mut, accept_ownership);
+   probe_t::released_exclusive(*this);
    this->m_ctrl.exclusive_in = 0;
    this->m_first_gate.notify_all();
 }
@@ -339,18 +426,22 @@ inline void interprocess_sharable_mutex::unlock()
 
 inline void interprocess_sharable_mutex::lock_sharable()
 {
-   scoped_lock_t lck(m_mut);
+   probe_t probe(*this);
+   this->priv_lock_mut(probe);
+   scoped_lock_t lck(m_mut, accept_ownership);
 
    //The sharable lock must block in the first gate
    //if an exclusive lock has been acquired
    //or there are too many sharable locks
    while(this->m_ctrl.exclusive_in
         || this->m_ctrl.num_shared == constants::max_readers){
+      probe.contended();
       this->m_first_gate.wait(lck);
    }
 
    //Increment sharable count
    ++this->m_ctrl.num_shared;
+   probe.acquired();
 }
 
 inline bool interprocess_sharable_mutex::try_lock_sharable()
@@ -368,6 +459,7 @@ inline bool interprocess_sharable_mutex::try_lock_sharable()
 
    //Increment sharable count
    ++this->m_ctrl.num_shared;
+   probe_t(*this).acquired();
    return true;
 }
 
@@ -375,8 +467,10 @@ template<class TimePoint>
 inline bool interprocess_sharable_mutex::timed_lock_sharable
    (const TimePoint &abs_time)
 {
-   scoped_lock_t lck(m_mut, abs_time);
-   if(!lck.owns())   return false;
+   probe_t probe(*this);
+   if(!this->priv_timed_lock_mut(probe, abs_time))
+      return probe.timed_out();
+   scoped_lock_t lck(m_mut, accept_ownership);
 
    //The sharable lock must block in the first gate
    //if an exclusive lock has been acquired
@@ -385,10 +479,11 @@ inline bool interprocess_sharable_mutex::timed_lock_sharable
          || this->m_ctrl.num_shared == constants::max_readers){
       //Mutexes and condvars handle just fine infinite abs_times
       //so avoid checking it here
+      probe.contended();
       if(!this->m_first_gate.timed_wait(lck, abs_time)){
          if(this->m_ctrl.exclusive_in
                || this->m_ctrl.num_shared == constants::max_readers){
-            return false;
+            return probe.timed_out();
          }
          break;
       }
@@ -396,12 +491,14 @@ inline bool interprocess_sharable_mutex::timed_lock_sharable
 
    //Increment sharable count
    ++this->m_ctrl.num_shared;
+   probe.acquired();
    return true;
 }
 
 inline void interprocess_sharable_mutex::unlock_sharable()
 {
-   scoped_lock_t lck(m_mut);
+   ipcdetail::timeout_when_locking_aware_lock(m_mut);
+   scoped_lock_t lck(m_mut, accept_ownership);
    //Decrement sharable count
    --this->m_ctrl.num_shared;
    if (this->m_ctrl.num_shared == 0){
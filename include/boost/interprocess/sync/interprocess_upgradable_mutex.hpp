@@ -27,7 +27,12 @@
 #include <boost/interprocess/timed_utils.hpp>
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
-#include <climits>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   #include <boost/interprocess/sync/lock_stats.hpp>
+#endif
 
 
 //!\file
@@ -295,333 +300,478 @@ class interprocess_upgradable_mutex
    //!Throws: An exception derived from interprocess_exception on error.
    bool try_unlock_sharable_and_lock_upgradable();
 
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the contention counters of this mutex. Exclusive, upgradable and sharable
+   //!acquisitions are accounted, but only exclusive ownership is accounted in hold_ns().
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   lock_stats &stats()
+   {  return m_stats;   }
+
+   //!Returns the contention counters of this mutex.
+   //!Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined.
+   const lock_stats &stats() const
+   {  return m_stats;   }
+   #endif
+
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
    private:
-   typedef scoped_lock<interprocess_mutex> scoped_lock_t;
+   //The internal primitives are not instrumented: each acquisition of
+   //this mutex is accounted once, in m_stats.
+   typedef interprocess_mutex::internal_mutex_type          internal_mutex_t;
+   typedef interprocess_condition::internal_condition_type  internal_condition_t;
+   typedef scoped_lock<internal_mutex_t>                    scoped_lock_t;
+   typedef bool (interprocess_upgradable_mutex::*try_function_t)();
+
+   //Accounts an acquisition in m_stats.
+   //Does nothing if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is not defined.
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   struct probe_t
+      : ipcdetail::lock_stats_probe
+   {
+      explicit probe_t(interprocess_upgradable_mutex &m)
+         : ipcdetail::lock_stats_probe(m.m_stats)
+      {}
 
-   //Pack all the control data in a word to be able
-   //to use atomic instructions in the future
-   struct control_word_t
+      static void released_exclusive(interprocess_upgradable_mutex &m)
+      {  ipcdetail::lock_stats_probe::released_exclusive(m.m_stats);  }
+   };
+   #else
+   struct probe_t
    {
-      unsigned exclusive_in         : 1;
-      unsigned upgradable_in        : 1;
-      unsigned num_upr_shar         : sizeof(unsigned)*CHAR_BIT-2;
-   }                       m_ctrl;
+      explicit probe_t(interprocess_upgradable_mutex &)
+      {}
+
+      void contended()           {}
+      void acquired()            {}
+      void acquired_exclusive()  {}
+      bool timed_out()           {  return false;  }
 
-   interprocess_mutex      m_mut;
-   interprocess_condition  m_first_gate;
-   interprocess_condition  m_second_gate;
+      static void released_exclusive(interprocess_upgradable_mutex &)
+      {}
+   };
+   #endif
+
+   //All the control data is packed in a word that is updated with atomic
+   //operations, so acquisitions, releases and transitions that don't need to
+   //wait never touch the internal mutex. Threads that must wait register
+   //themselves in the waiter count of a gate before sleeping, and releases only
+   //lock the internal mutex to notify a gate whose waiter count is not zero.
+   volatile boost::uint32_t   m_state;
+   volatile boost::uint32_t   m_first_waiters;
+   volatile boost::uint32_t   m_second_waiters;
+
+   internal_mutex_t           m_mut;
+   internal_condition_t       m_first_gate;
+   internal_condition_t       m_second_gate;
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   lock_stats                 m_stats;
+   #endif
 
    private:
-   //Rollback structures for exceptions or failure return values
+   template<int Dummy>
+   struct base_constants_t
+   {
+      static const boost::uint32_t exclusive_in  = boost::uint32_t(1u) << 31u;
+      static const boost::uint32_t upgradable_in = boost::uint32_t(1u) << 30u;
+      //Also the mask of the count of sharable and upgradable owners
+      static const boost::uint32_t max_readers   = upgradable_in - 1u;
+   };
+   typedef base_constants_t<0> constants;
+
+   //Registers a thread waiting on a gate during its lifetime
+   struct gate_waiter
+   {
+      explicit gate_waiter(volatile boost::uint32_t &count)
+         :  m_count(count)
+      {  ipcdetail::atomic_inc32(&m_count);  }
+
+      ~gate_waiter()
+      {  ipcdetail::atomic_dec32(&m_count);  }
+
+      volatile boost::uint32_t &m_count;
+   };
+
+   //Rollback structures for exceptions or failure return values.
+   //They are executed with the internal mutex locked.
    struct exclusive_rollback
    {
-      exclusive_rollback(control_word_t         &ctrl
-                        ,interprocess_condition &first_gate)
-         :  mp_ctrl(&ctrl), m_first_gate(first_gate)
+      exclusive_rollback(interprocess_upgradable_mutex &mut)
+         :  mp_mut(&mut)
       {}
 
       void release()
-      {  mp_ctrl = 0;   }
+      {  mp_mut = 0;   }
 
       ~exclusive_rollback()
       {
-         if(mp_ctrl){
-            mp_ctrl->exclusive_in = 0;
-            m_first_gate.notify_all();
+         if(mp_mut){
+            ipcdetail::atomic_add32(&mp_mut->m_state, 0u - constants::exclusive_in);
+            mp_mut->m_first_gate.notify_all();
          }
       }
-      control_word_t          *mp_ctrl;
-      interprocess_condition  &m_first_gate;
+      interprocess_upgradable_mutex *mp_mut;
    };
 
    struct upgradable_to_exclusive_rollback
    {
-      upgradable_to_exclusive_rollback(control_word_t         &ctrl)
-         :  mp_ctrl(&ctrl)
+      upgradable_to_exclusive_rollback(interprocess_upgradable_mutex &mut)
+         :  mp_mut(&mut)
       {}
 
       void release()
-      {  mp_ctrl = 0;   }
+      {  mp_mut = 0;   }
 
       ~upgradable_to_exclusive_rollback()
       {
-         if(mp_ctrl){
-            //Recover upgradable lock
-            mp_ctrl->upgradable_in = 1;
-            ++mp_ctrl->num_upr_shar;
-            //Execute the second half of exclusive locking
-            mp_ctrl->exclusive_in = 0;
+         if(mp_mut){
+            //Recover upgradable lock and execute the second half of exclusive unlocking
+            ipcdetail::atomic_add32
+               (&mp_mut->m_state, constants::upgradable_in + 1u - constants::exclusive_in);
+            mp_mut->m_first_gate.notify_all();
          }
       }
-      control_word_t          *mp_ctrl;
+      interprocess_upgradable_mutex *mp_mut;
    };
 
-   template<int Dummy>
-   struct base_constants_t
+   //First half of exclusive locking: fails if an exclusive
+   //or upgradable lock has been acquired
+   bool priv_try_exclusive()
    {
-      static const unsigned max_readers
-         = ~(unsigned(3) << (sizeof(unsigned)*CHAR_BIT-2));
-   };
-   typedef base_constants_t<0> constants;
+      boost::uint32_t s = ipcdetail::atomic_read32(&m_state);
+      while(!(s & (constants::exclusive_in | constants::upgradable_in))){
+         const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_state, s | constants::exclusive_in, s);
+         if(prev == s)
+            return true;
+         s = prev;
+      }
+      return false;
+   }
+
+   //Fails if an exclusive or upgradable lock has been
+   //acquired or there are too many sharable locks
+   bool priv_try_upgradable()
+   {
+      boost::uint32_t s = ipcdetail::atomic_read32(&m_state);
+      while(!(s & (constants::exclusive_in | constants::upgradable_in)) &&
+            (s & constants::max_readers) != constants::max_readers){
+         const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_state, (s | constants::upgradable_in) + 1u, s);
+         if(prev == s)
+            return true;
+         s = prev;
+      }
+      return false;
+   }
+
+   //Fails if an exclusive lock has been acquired
+   //or there are too many sharable locks
+   bool priv_try_sharable()
+   {
+      boost::uint32_t s = ipcdetail::atomic_read32(&m_state);
+      while(!(s & constants::exclusive_in) &&
+            (s & constants::max_readers) != constants::max_readers){
+         const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_state, s + 1u, s);
+         if(prev == s)
+            return true;
+         s = prev;
+      }
+      return false;
+   }
+
+   boost::uint32_t priv_readers()
+   {  return ipcdetail::atomic_read32(&m_state) & constants::max_readers;  }
+
+   //Waits in the first gate until try_acquire succeeds. Requires lck to be locked.
+   void priv_wait_first_gate(scoped_lock_t &lck, try_function_t try_acquire)
+   {
+      gate_waiter waiter(m_first_waiters);
+      while(!(this->*try_acquire)()){
+         m_first_gate.wait(lck);
+      }
+   }
+
+   template<class TimePoint>
+   bool priv_timed_wait_first_gate(scoped_lock_t &lck, try_function_t try_acquire, const TimePoint &abs_time)
+   {
+      gate_waiter waiter(m_first_waiters);
+      while(!(this->*try_acquire)()){
+         if(!m_first_gate.timed_wait(lck, abs_time)){
+            return (this->*try_acquire)();
+         }
+      }
+      return true;
+   }
+
+   //Waits in the second gate until all readers are gone. Requires lck to be locked.
+   void priv_wait_second_gate(scoped_lock_t &lck)
+   {
+      gate_waiter waiter(m_second_waiters);
+      while(this->priv_readers()){
+         m_second_gate.wait(lck);
+      }
+   }
+
+   template<class TimePoint>
+   bool priv_timed_wait_second_gate(scoped_lock_t &lck, const TimePoint &abs_time)
+   {
+      gate_waiter waiter(m_second_waiters);
+      while(this->priv_readers()){
+         if(!m_second_gate.timed_wait(lck, abs_time)){
+            return !this->priv_readers();
+         }
+      }
+      return true;
+   }
+
+   //The state is changed before reading the waiter count and waiters register
+   //before checking the state, so either the waiter sees the new state or
+   //the notifier sees the waiter, which sleeps holding the internal mutex.
+   void priv_notify_first_gate()
+   {
+      if(ipcdetail::atomic_read32(&m_first_waiters)){
+         ipcdetail::timeout_when_locking_aware_lock(m_mut);
+         scoped_lock_t lck(m_mut, accept_ownership);
+         m_first_gate.notify_all();
+      }
+   }
+
+   void priv_notify_second_gate()
+   {
+      if(ipcdetail::atomic_read32(&m_second_waiters)){
+         ipcdetail::timeout_when_locking_aware_lock(m_mut);
+         scoped_lock_t lck(m_mut, accept_ownership);
+         m_second_gate.notify_one();
+      }
+   }
+
+   void priv_release_exclusive()
+   {
+      ipcdetail::atomic_add32(&m_state, 0u - constants::exclusive_in);
+      this->priv_notify_first_gate();
+   }
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
 };
 
 #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
 template <int Dummy>
-const unsigned interprocess_upgradable_mutex::base_constants_t<Dummy>::max_readers;
+const boost::uint32_t interprocess_upgradable_mutex::base_constants_t<Dummy>::exclusive_in;
+
+template <int Dummy>
+const boost::uint32_t interprocess_upgradable_mutex::base_constants_t<Dummy>::upgradable_in;
+
+template <int Dummy>
+const boost::uint32_t interprocess_upgradable_mutex::base_constants_t<Dummy>::max_readers;
 
 inline interprocess_upgradable_mutex::interprocess_upgradable_mutex()
-{
-   this->m_ctrl.exclusive_in  = 0;
-   this->m_ctrl.upgradable_in = 0;
-   this->m_ctrl.num_upr_shar   = 0;
-}
+   : m_state(0u), m_first_waiters(0u), m_second_waiters(0u)
+{}
 
 inline interprocess_upgradable_mutex::~interprocess_upgradable_mutex()
 {}
 
 inline void interprocess_upgradable_mutex::lock()
 {
-   scoped_lock_t lck(m_mut);
-
-   //The exclusive lock must block in the first gate
-   //if an exclusive or upgradable lock has been acquired
-   while (this->m_ctrl.exclusive_in || this->m_ctrl.upgradable_in){
-      this->m_first_gate.wait(lck);
-   }
-
-   //Mark that exclusive lock has been acquired
-   this->m_ctrl.exclusive_in = 1;
+   probe_t probe(*this);
+
+   //Fast path: close the first gate and check that there are no readers
+   const bool gate_closed = this->priv_try_exclusive();
+   if(!gate_closed || this->priv_readers()){
+      probe.contended();
+      ipcdetail::timeout_when_locking_aware_lock(m_mut);
+      scoped_lock_t lck(m_mut, accept_ownership);
+      //The exclusive lock must block in the first gate
+      //if an exclusive or upgradable lock has been acquired
+      if(!gate_closed){
+         this->priv_wait_first_gate(lck, &interprocess_upgradable_mutex::priv_try_exclusive);
+      }
 
-   //Prepare rollback
-   exclusive_rollback rollback(this->m_ctrl, this->m_first_gate);
+      //Prepare rollback
+      exclusive_rollback rollback(*this);
 
-   //Now wait until all readers are gone
-   while (this->m_ctrl.num_upr_shar){
-      this->m_second_gate.wait(lck);
+      //Now wait until all readers are gone
+      this->priv_wait_second_gate(lck);
+      rollback.release();
    }
-   rollback.release();
+   probe.acquired_exclusive();
 }
 
 inline bool interprocess_upgradable_mutex::try_lock()
 {
-   scoped_lock_t lck(m_mut, try_to_lock);
-
-   //If we can't lock or any has there is any exclusive, upgradable
-   //or sharable mark return false;
-   if(!lck.owns()
-      || this->m_ctrl.exclusive_in
-      || this->m_ctrl.num_upr_shar){
+   //If there is any exclusive, upgradable or sharable mark return false
+   if(ipcdetail::atomic_cas32(&m_state, constants::exclusive_in, 0u) != 0u){
       return false;
    }
-   this->m_ctrl.exclusive_in = 1;
+   probe_t(*this).acquired_exclusive();
    return true;
 }
 
 template<class TimePoint>
 bool interprocess_upgradable_mutex::timed_lock(const TimePoint &abs_time)
 {
-   //Mutexes and condvars handle just fine infinite abs_times
-   //so avoid checking it here
-   scoped_lock_t lck(m_mut, abs_time);
-   if(!lck.owns())   return false;
-
-   //The exclusive lock must block in the first gate
-   //if an exclusive or upgradable lock has been acquired
-   while (this->m_ctrl.exclusive_in || this->m_ctrl.upgradable_in){
-      if(!this->m_first_gate.timed_wait(lck, abs_time)){
-         if(this->m_ctrl.exclusive_in || this->m_ctrl.upgradable_in){
-            return false;
+   probe_t probe(*this);
+
+   const bool gate_closed = this->priv_try_exclusive();
+   if(!gate_closed || this->priv_readers()){
+      probe.contended();
+      //Mutexes and condvars handle just fine infinite abs_times
+      //so avoid checking it here
+      scoped_lock_t lck(m_mut, abs_time);
+      if(!lck.owns()){
+         if(gate_closed){
+            this->priv_release_exclusive();
          }
-         break;
+         return probe.timed_out();
       }
-   }
 
-   //Mark that exclusive lock has been acquired
-   this->m_ctrl.exclusive_in = 1;
+      //The exclusive lock must block in the first gate
+      //if an exclusive or upgradable lock has been acquired
+      if(!gate_closed &&
+         !this->priv_timed_wait_first_gate(lck, &interprocess_upgradable_mutex::priv_try_exclusive, abs_time)){
+         return probe.timed_out();
+      }
 
-   //Prepare rollback
-   exclusive_rollback rollback(this->m_ctrl, this->m_first_gate);
+      //Prepare rollback
+      exclusive_rollback rollback(*this);
 
-   //Now wait until all readers are gone
-   while (this->m_ctrl.num_upr_shar){
-      if(!this->m_second_gate.timed_wait(lck, abs_time)){
-         if(this->m_ctrl.num_upr_shar){
-            return false;
-         }
-         break;
+      //Now wait until all readers are gone
+      if(!this->priv_timed_wait_second_gate(lck, abs_time)){
+         return probe.timed_out();
       }
+      rollback.release();
    }
-   rollback.release();
+   probe.acquired_exclusive();
    return true;
 }
 
 inline void interprocess_upgradable_mutex::unlock()
 {
-   scoped_lock_t lck(m_mut);
-   this->m_ctrl.exclusive_in = 0;
-   this->m_first_gate.notify_all();
+   probe_t::released_exclusive(*this);
+   this->priv_release_exclusive();
 }
 
 //Upgradable locking
 
 inline void interprocess_upgradable_mutex::lock_upgradable()
 {
-   scoped_lock_t lck(m_mut);
+   probe_t probe(*this);
 
    //The upgradable lock must block in the first gate
    //if an exclusive or upgradable lock has been acquired
    //or there are too many sharable locks
-   while(this->m_ctrl.exclusive_in || this->m_ctrl.upgradable_in
-         || this->m_ctrl.num_upr_shar == constants::max_readers){
-      this->m_first_gate.wait(lck);
+   if(!this->priv_try_upgradable()){
+      probe.contended();
+      ipcdetail::timeout_when_locking_aware_lock(m_mut);
+      scoped_lock_t lck(m_mut, accept_ownership);
+      this->priv_wait_first_gate(lck, &interprocess_upgradable_mutex::priv_try_upgradable);
    }
-
-   //Mark that upgradable lock has been acquired
-   //And add upgradable to the sharable count
-   this->m_ctrl.upgradable_in = 1;
-   ++this->m_ctrl.num_upr_shar;
+   probe.acquired();
 }
 
 inline bool interprocess_upgradable_mutex::try_lock_upgradable()
 {
-   scoped_lock_t lck(m_mut, try_to_lock);
-
    //The upgradable lock must fail
    //if an exclusive or upgradable lock has been acquired
    //or there are too many sharable locks
-   if(!lck.owns()
-      || this->m_ctrl.exclusive_in
-      || this->m_ctrl.upgradable_in
-      || this->m_ctrl.num_upr_shar == constants::max_readers){
+   if(!this->priv_try_upgradable()){
       return false;
    }
-
-   //Mark that upgradable lock has been acquired
-   //And add upgradable to the sharable count
-   this->m_ctrl.upgradable_in = 1;
-   ++this->m_ctrl.num_upr_shar;
+   probe_t(*this).acquired();
    return true;
 }
 
 template<class TimePoint>
 bool interprocess_upgradable_mutex::timed_lock_upgradable(const TimePoint &abs_time)
 {
-   //Mutexes and condvars handle just fine infinite abs_times
-   //so avoid checking it here
-   scoped_lock_t lck(m_mut, abs_time);
-   if(!lck.owns())   return false;
+   probe_t probe(*this);
 
    //The upgradable lock must block in the first gate
    //if an exclusive or upgradable lock has been acquired
    //or there are too many sharable locks
-   while(this->m_ctrl.exclusive_in
-         || this->m_ctrl.upgradable_in
-         || this->m_ctrl.num_upr_shar == constants::max_readers){
-      if(!this->m_first_gate.timed_wait(lck, abs_time)){
-         if((this->m_ctrl.exclusive_in
-             || this->m_ctrl.upgradable_in
-             || this->m_ctrl.num_upr_shar == constants::max_readers)){
-            return false;
-         }
-         break;
+   if(!this->priv_try_upgradable()){
+      probe.contended();
+      //Mutexes and condvars handle just fine infinite abs_times
+      //so avoid checking it here
+      scoped_lock_t lck(m_mut, abs_time);
+      if(!lck.owns() ||
+         !this->priv_timed_wait_first_gate(lck, &interprocess_upgradable_mutex::priv_try_upgradable, abs_time)){
+         return probe.timed_out();
       }
    }
-
-   //Mark that upgradable lock has been acquired
-   //And add upgradable to the sharable count
-   this->m_ctrl.upgradable_in = 1;
-   ++this->m_ctrl.num_upr_shar;
+   probe.acquired();
    return true;
 }
 
 inline void interprocess_upgradable_mutex::unlock_upgradable()
 {
-   scoped_lock_t lck(m_mut);
-   //Mark that upgradable lock has been acquired
-   //And add upgradable to the sharable count
-   this->m_ctrl.upgradable_in = 0;
-   --this->m_ctrl.num_upr_shar;
-   this->m_first_gate.notify_all();
+   //Unmark upgradable and remove it from the sharable count
+   ipcdetail::atomic_add32(&m_state, 0u - (constants::upgradable_in + 1u));
+   this->priv_notify_first_gate();
 }
 
 //Sharable locking
 
 inline void interprocess_upgradable_mutex::lock_sharable()
 {
-   scoped_lock_t lck(m_mut);
+   probe_t probe(*this);
 
    //The sharable lock must block in the first gate
    //if an exclusive lock has been acquired
    //or there are too many sharable locks
-   while(this->m_ctrl.exclusive_in
-        || this->m_ctrl.num_upr_shar == constants::max_readers){
-      this->m_first_gate.wait(lck);
+   if(!this->priv_try_sharable()){
+      probe.contended();
+      ipcdetail::timeout_when_locking_aware_lock(m_mut);
+      scoped_lock_t lck(m_mut, accept_ownership);
+      this->priv_wait_first_gate(lck, &interprocess_upgradable_mutex::priv_try_sharable);
    }
-
-   //Increment sharable count
-   ++this->m_ctrl.num_upr_shar;
+   probe.acquired();
 }
 
 inline bool interprocess_upgradable_mutex::try_lock_sharable()
 {
-   scoped_lock_t lck(m_mut, try_to_lock);
-
    //The sharable lock must fail
    //if an exclusive lock has been acquired
    //or there are too many sharable locks
-   if(!lck.owns()
-      || this->m_ctrl.exclusive_in
-      || this->m_ctrl.num_upr_shar == constants::max_readers){
+   if(!this->priv_try_sharable()){
       return false;
    }
-
-   //Increment sharable count
-   ++this->m_ctrl.num_upr_shar;
+   probe_t(*this).acquired();
    return true;
 }
 
 template<class TimePoint>
 inline bool interprocess_upgradable_mutex::timed_lock_sharable(const TimePoint &abs_time)
 {
-   //Mutexes and condvars handle just fine infinite abs_times
-   //so avoid checking it here
-   scoped_lock_t lck(m_mut, abs_time);
-   if(!lck.owns())   return false;
+   probe_t probe(*this);
 
    //The sharable lock must block in the first gate
    //if an exclusive lock has been acquired
    //or there are too many sharable locks
-   while (this->m_ctrl.exclusive_in
-         || this->m_ctrl.num_upr_shar == constants::max_readers){
-      if(!this->m_first_gate.timed_wait(lck, abs_time)){
-         if(this->m_ctrl.exclusive_in
-            || this->m_ctrl.num_upr_shar == constants::max_readers){
-            return false;
-         }
-         break;
+   if(!this->priv_try_sharable()){
+      probe.contended();
+      //Mutexes and condvars handle just fine infinite abs_times
+      //so avoid checking it here
+      scoped_lock_t lck(m_mut, abs_time);
+      if(!lck.owns() ||
+         !this->priv_timed_wait_first_gate(lck, &interprocess_upgradable_mutex::priv_try_sharable, abs_time)){
+         return probe.timed_out();
       }
    }
-
-   //Increment sharable count
-   ++this->m_ctrl.num_upr_shar;
+   probe.acquired();
    return true;
 }
 
 inline void interprocess_upgradable_mutex::unlock_sharable()
 {
-   scoped_lock_t lck(m_mut);
    //Decrement sharable count
-   --this->m_ctrl.num_upr_shar;
-   if (this->m_ctrl.num_upr_shar == 0){
-      this->m_second_gate.notify_one();
+   const boost::uint32_t prev = ipcdetail::atomic_dec32(&m_state);
+   //Wake the exclusive lock waiting for the last reader
+   if((prev & constants::max_readers) == 1u && (prev & constants::exclusive_in)){
+      this->priv_notify_second_gate();
    }
    //Check if there are blocked sharables because of
    //there were too many sharables
-   else if(this->m_ctrl.num_upr_shar == (constants::max_readers-1)){
-      this->m_first_gate.notify_all();
+   else if((prev & constants::max_readers) == constants::max_readers){
+      this->priv_notify_first_gate();
    }
 }
 
@@ -629,135 +779,124 @@ inline void interprocess_upgradable_mutex::unlock_sharable()
 
 inline void interprocess_upgradable_mutex::unlock_and_lock_upgradable()
 {
-   scoped_lock_t lck(m_mut);
-   //Unmark it as exclusive
-   this->m_ctrl.exclusive_in     = 0;
-   //Mark it as upgradable
-   this->m_ctrl.upgradable_in    = 1;
-   //The sharable count should be 0 so increment it
-   this->m_ctrl.num_upr_shar   = 1;
+   probe_t::released_exclusive(*this);
+   //Unmark it as exclusive, mark it as upgradable and, as
+   //the sharable count should be 0, increment it
+   ipcdetail::atomic_add32(&m_state, constants::upgradable_in + 1u - constants::exclusive_in);
    //Notify readers that they can enter
-   m_first_gate.notify_all();
+   this->priv_notify_first_gate();
 }
 
 inline void interprocess_upgradable_mutex::unlock_and_lock_sharable()
 {
-   scoped_lock_t lck(m_mut);
-   //Unmark it as exclusive
-   this->m_ctrl.exclusive_in   = 0;
-   //The sharable count should be 0 so increment it
-   this->m_ctrl.num_upr_shar   = 1;
+   probe_t::released_exclusive(*this);
+   //Unmark it as exclusive and, as the sharable
+   //count should be 0, increment it
+   ipcdetail::atomic_add32(&m_state, 1u - constants::exclusive_in);
    //Notify readers that they can enter
-   m_first_gate.notify_all();
+   this->priv_notify_first_gate();
 }
 
 inline void interprocess_upgradable_mutex::unlock_upgradable_and_lock_sharable()
 {
-   scoped_lock_t lck(m_mut);
    //Unmark it as upgradable (we don't have to decrement count)
-   this->m_ctrl.upgradable_in    = 0;
+   ipcdetail::atomic_add32(&m_state, 0u - constants::upgradable_in);
    //Notify readers/upgradable that they can enter
-   m_first_gate.notify_all();
+   this->priv_notify_first_gate();
 }
 
 //Upgrading
 
 inline void interprocess_upgradable_mutex::unlock_upgradable_and_lock()
 {
-   scoped_lock_t lck(m_mut);
-   //Simulate unlock_upgradable() without
-   //notifying sharables.
-   this->m_ctrl.upgradable_in = 0;
-   --this->m_ctrl.num_upr_shar;
-   //Execute the second half of exclusive locking
-   this->m_ctrl.exclusive_in = 1;
-
-   //Prepare rollback
-   upgradable_to_exclusive_rollback rollback(m_ctrl);
-
-   while (this->m_ctrl.num_upr_shar){
-      this->m_second_gate.wait(lck);
+   probe_t probe(*this);
+   //Simulate unlock_upgradable() without notifying sharables
+   //and execute the first half of exclusive locking in a single step
+   const boost::uint32_t prev = ipcdetail::atomic_add32
+      (&m_state, constants::exclusive_in - constants::upgradable_in - 1u);
+
+   if((prev & constants::max_readers) != 1u){
+      probe.contended();
+      ipcdetail::timeout_when_locking_aware_lock(m_mut);
+      scoped_lock_t lck(m_mut, accept_ownership);
+
+      //Prepare rollback
+      upgradable_to_exclusive_rollback rollback(*this);
+
+      this->priv_wait_second_gate(lck);
+      rollback.release();
    }
-   rollback.release();
+   probe.acquired_exclusive();
 }
 
 inline bool interprocess_upgradable_mutex::try_unlock_upgradable_and_lock()
 {
-   scoped_lock_t lck(m_mut, try_to_lock);
-   //Check if there are no readers
-   if(!lck.owns()
-      || this->m_ctrl.num_upr_shar != 1){
+   //Check if there are no readers, then unlock upgradable and mark exclusive
+   if(ipcdetail::atomic_cas32(&m_state, constants::exclusive_in, constants::upgradable_in + 1u)
+         != constants::upgradable_in + 1u){
       return false;
    }
-   //Now unlock upgradable and mark exclusive
-   this->m_ctrl.upgradable_in = 0;
-   --this->m_ctrl.num_upr_shar;
-   this->m_ctrl.exclusive_in = 1;
+   probe_t(*this).acquired_exclusive();
    return true;
 }
 
 template<class TimePoint>
 bool interprocess_upgradable_mutex::timed_unlock_upgradable_and_lock(const TimePoint &abs_time)
 {
-   //Mutexes and condvars handle just fine infinite abs_times
-   //so avoid checking it here
-   scoped_lock_t lck(m_mut, abs_time);
-   if(!lck.owns())   return false;
-
-   //Simulate unlock_upgradable() without
-   //notifying sharables.
-   this->m_ctrl.upgradable_in = 0;
-   --this->m_ctrl.num_upr_shar;
-   //Execute the second half of exclusive locking
-   this->m_ctrl.exclusive_in = 1;
-
-   //Prepare rollback
-   upgradable_to_exclusive_rollback rollback(m_ctrl);
-
-   while (this->m_ctrl.num_upr_shar){
-      if(!this->m_second_gate.timed_wait(lck, abs_time)){
-         if(this->m_ctrl.num_upr_shar){
-            return false;
-         }
-         break;
+   probe_t probe(*this);
+   //Simulate unlock_upgradable() without notifying sharables
+   //and execute the first half of exclusive locking in a single step
+   const boost::uint32_t prev = ipcdetail::atomic_add32
+      (&m_state, constants::exclusive_in - constants::upgradable_in - 1u);
+
+   if((prev & constants::max_readers) != 1u){
+      probe.contended();
+      //Mutexes and condvars handle just fine infinite abs_times
+      //so avoid checking it here
+      scoped_lock_t lck(m_mut, abs_time);
+      if(!lck.owns()){
+         //Recover the upgradable lock
+         ipcdetail::atomic_add32(&m_state, constants::upgradable_in + 1u - constants::exclusive_in);
+         this->priv_notify_first_gate();
+         return probe.timed_out();
       }
+
+      //Prepare rollback
+      upgradable_to_exclusive_rollback rollback(*this);
+
+      if(!this->priv_timed_wait_second_gate(lck, abs_time)){
+         return probe.timed_out();
+      }
+      rollback.release();
    }
-   rollback.release();
+   probe.acquired_exclusive();
    return true;
 }
 
 inline bool interprocess_upgradable_mutex::try_unlock_sharable_and_lock()
 {
-   scoped_lock_t lck(m_mut, try_to_lock);
-
-   //If we can't lock or any has there is any exclusive, upgradable
-   //or sharable mark return false;
-   if(!lck.owns()
-      || this->m_ctrl.exclusive_in
-      || this->m_ctrl.upgradable_in
-      || this->m_ctrl.num_upr_shar != 1){
+   //If there is any exclusive or upgradable mark or
+   //another sharable lock return false
+   if(ipcdetail::atomic_cas32(&m_state, constants::exclusive_in, 1u) != 1u){
       return false;
    }
-   this->m_ctrl.exclusive_in = 1;
-   this->m_ctrl.num_upr_shar = 0;
+   probe_t(*this).acquired_exclusive();
    return true;
 }
 
 inline bool interprocess_upgradable_mutex::try_unlock_sharable_and_lock_upgradable()
 {
-   scoped_lock_t lck(m_mut, try_to_lock);
-
    //The upgradable lock must fail
    //if an exclusive or upgradable lock has been acquired
-   if(!lck.owns()
-      || this->m_ctrl.exclusive_in
-      || this->m_ctrl.upgradable_in){
-      return false;
+   boost::uint32_t s = ipcdetail::atomic_read32(&m_state);
+   while(!(s & (constants::exclusive_in | constants::upgradable_in))){
+      //Mark that upgradable lock has been acquired
+      const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_state, s | constants::upgradable_in, s);
+      if(prev == s)
+         return true;
+      s = prev;
    }
-
-   //Mark that upgradable lock has been acquired
-   this->m_ctrl.upgradable_in = 1;
-   return true;
+   return false;
 }
 
 #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
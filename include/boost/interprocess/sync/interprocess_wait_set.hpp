@@ -0,0 +1,177 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_WAIT_SET_HPP
+#define BOOST_INTERPROCESS_WAIT_SET_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+
+//!\file
+//!Describes interprocess_wait_set, an object to wait for several event sources at once.
+
+namespace boost {
+namespace interprocess {
+
+//!An object that can be placed in shared memory that allows a thread to block until any of
+//!up to 32 event sources is ready, so that a single thread can serve several message queues,
+//!semaphores or conditions without polling them or dedicating a thread to each one.
+//!
+//!Each source is identified by a number. Producers call notify(source) after changing the
+//!state of the source (e.g. after sending a message to the queue associated with the source)
+//!and the consumer calls wait(), which returns and clears the mask of ready sources. The
+//!consumer must then process all the pending work of each returned source (e.g. receive
+//!messages with try_receive until the queue is empty): a source notified again while it's
+//!being processed will be returned by the next wait, so no event is lost.
+//!
+//!Notifications are atomic operations on a shared word, the internal mutex and condition
+//!are only used when a consumer is blocked.
+class interprocess_wait_set
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   interprocess_wait_set(const interprocess_wait_set &);
+   interprocess_wait_set &operator=(const interprocess_wait_set &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Maximum number of sources
+   static const unsigned max_sources = 32u;
+
+   //!Constructs a wait set without ready sources.
+   //!Throws interprocess_exception on error.
+   interprocess_wait_set()
+      : m_ready(0u), m_waiters(0u), m_mut(), m_cond()
+   {}
+
+   //!Marks "source" as ready and wakes a blocked consumer.
+   //!"source" must be less than max_sources.
+   //!Throws interprocess_exception on error.
+   void notify(unsigned source)
+   {
+      BOOST_ASSERT(source < max_sources);
+      const boost::uint32_t bit = boost::uint32_t(1u) << source;
+      boost::uint32_t old = ipcdetail::atomic_read32(&m_ready);
+      while(!(old & bit)){
+         const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_ready, old | bit, old);
+         if(prev == old){
+            //The ready mask is set before checking for waiters and waiters are registered
+            //before checking the mask, so either we see the waiter or the waiter sees the bit
+            if(ipcdetail::atomic_read32(&m_waiters)){
+               scoped_lock<interprocess_mutex> lock(m_mut);
+               m_cond.notify_one();
+            }
+            return;
+         }
+         old = prev;
+      }
+      //Already ready, a consumer will process it
+   }
+
+   //!Returns the mask of ready sources, without clearing it. Never throws.
+   boost::uint32_t ready() const
+   {  return ipcdetail::atomic_read32(const_cast<volatile boost::uint32_t*>(&m_ready));  }
+
+   //!Returns and clears the mask of ready sources, which is zero
+   //!if no source is ready. Never throws.
+   boost::uint32_t try_wait()
+   {  return this->priv_take();  }
+
+   //!Blocks until at least one source is ready and returns and
+   //!clears the mask of ready sources.
+   //!Throws interprocess_exception on error.
+   boost::uint32_t wait()
+   {
+      boost::uint32_t r = this->priv_take();
+      if(!r){
+         scoped_lock<interprocess_mutex> lock(m_mut);
+         ipcdetail::atomic_inc32(&m_waiters);
+         BOOST_INTERPROCESS_TRY{
+            while(!(r = this->priv_take())){
+               m_cond.wait(lock);
+            }
+         }
+         BOOST_INTERPROCESS_CATCH(...){
+            ipcdetail::atomic_dec32(&m_waiters);
+            BOOST_INTERPROCESS_RETHROW
+         } BOOST_INTERPROCESS_CATCH_END
+         ipcdetail::atomic_dec32(&m_waiters);
+      }
+      return r;
+   }
+
+   //!Blocks until at least one source is ready or abs_time is reached
+   //!and returns and clears the mask of ready sources, which is zero on timeout.
+   //!Throws interprocess_exception on error.
+   template<class TimePoint>
+   boost::uint32_t timed_wait(const TimePoint &abs_time)
+   {
+      boost::uint32_t r = this->priv_take();
+      if(!r){
+         scoped_lock<interprocess_mutex> lock(m_mut);
+         ipcdetail::atomic_inc32(&m_waiters);
+         BOOST_INTERPROCESS_TRY{
+            while(!(r = this->priv_take())){
+               if(!m_cond.timed_wait(lock, abs_time)){
+                  r = this->priv_take();
+                  break;
+               }
+            }
+         }
+         BOOST_INTERPROCESS_CATCH(...){
+            ipcdetail::atomic_dec32(&m_waiters);
+            BOOST_INTERPROCESS_RETHROW
+         } BOOST_INTERPROCESS_CATCH_END
+         ipcdetail::atomic_dec32(&m_waiters);
+      }
+      return r;
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   boost::uint32_t priv_take()
+   {
+      boost::uint32_t old = ipcdetail::atomic_read32(&m_ready);
+      while(old){
+         const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_ready, 0u, old);
+         if(prev == old)
+            break;
+         old = prev;
+      }
+      return old;
+   }
+
+   volatile boost::uint32_t   m_ready;
+   volatile boost::uint32_t   m_waiters;
+   interprocess_mutex         m_mut;
+   interprocess_condition     m_cond;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_WAIT_SET_HPP
@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_IPC_ATOMIC_WAIT_HPP
+#define BOOST_INTERPROCESS_IPC_ATOMIC_WAIT_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/cstdint.hpp>
+
+//!\file
+//!Describes functions to wait until an integer placed in shared memory changes its value
+//!and to wake the waiters, that work between processes.
+
+namespace boost {
+namespace interprocess {
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+namespace ipcdetail {
+
+//Spin iterations (pause instructions and then yields) before blocking
+static const unsigned int ipc_atomic_wait_spin_limit = 2u*spin_wait::nop_pause_limit;
+
+//Spins and then blocks until *addr is not "old". This is the wait loop of ipc_atomic_wait
+//and of the primitives built on it (spin_barrier, spin_queue_mutex...). If "sleepers" is not
+//null, it's incremented while the waiter is blocked in the kernel, so that notifiers can skip
+//the system call if there are no sleepers: sleepers are registered before they check the
+//value again, so either the notifier sees them or they see the new value.
+inline void ipc_atomic_wait(volatile boost::uint32_t *addr, boost::uint32_t old, volatile boost::uint32_t *sleepers)
+{
+   spin_wait swait;
+   while(atomic_read32(addr) == old){
+      #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+      if(swait.count() < ipc_atomic_wait_spin_limit){
+         swait.yield();
+      }
+      else{
+         if(sleepers)   atomic_inc32(sleepers);
+         futex_wait(addr, old);
+         if(sleepers)   atomic_dec32(sleepers);
+      }
+      #else
+      (void)sleepers;
+      swait.yield();
+      #endif
+   }
+}
+
+template<class TimePoint>
+inline bool ipc_atomic_wait(volatile boost::uint32_t *addr, boost::uint32_t old, volatile boost::uint32_t *sleepers, const TimePoint &abs_time)
+{
+   typedef typename microsec_clock<TimePoint>::time_point time_point;
+   if(is_pos_infinity(abs_time)){
+      ipcdetail::ipc_atomic_wait(addr, old, sleepers);
+      return true;
+   }
+   spin_wait swait;
+   while(atomic_read32(addr) == old){
+      const time_point now = microsec_clock<TimePoint>::universal_time();
+      if(now >= abs_time){
+         return false;
+      }
+      #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+      if(swait.count() < ipc_atomic_wait_spin_limit){
+         swait.yield();
+      }
+      else{
+         if(sleepers)   atomic_inc32(sleepers);
+         futex_timed_wait(addr, old, duration_to_usduration(abs_time - now));
+         if(sleepers)   atomic_dec32(sleepers);
+      }
+      #else
+      (void)sleepers;
+      swait.yield();
+      #endif
+   }
+   return true;
+}
+
+//Wakes all the waiters of ipc_atomic_wait(addr, ..., sleepers) if some of them are blocked
+inline void ipc_atomic_notify_all(volatile boost::uint32_t *addr, volatile boost::uint32_t *sleepers)
+{
+   #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   //A full barrier (not just a load) so that the read is not
+   //reordered before the store to *addr done by the caller
+   if(atomic_add32(sleepers, 0u)){
+      futex_wake_all(addr);
+   }
+   #else
+   (void)addr;
+   (void)sleepers;
+   #endif
+}
+
+}  //namespace ipcdetail {
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!Blocks the calling thread until the value of *addr is not "old". The word can be placed in
+//!memory shared by several processes and must be modified with atomic operations.
+//!
+//!The waiter spins for a short time and then, on Linux, blocks on a shared futex until
+//!woken by ipc_atomic_notify_one or ipc_atomic_notify_all. On other systems, the waiter
+//!keeps spinning (yielding and sleeping as the wait gets longer), as there is no system
+//!primitive to block on an address between processes, and notifications are no-ops.
+//!
+//!Like std::atomic::wait, returns only when the value has changed, so a change of the value
+//!that is reverted before the waiter observes it (ABA) might not wake it. Never throws.
+inline void ipc_atomic_wait(volatile boost::uint32_t *addr, boost::uint32_t old)
+{  ipcdetail::ipc_atomic_wait(addr, old, 0);  }
+
+//!Same as ipc_atomic_wait(addr, old), but returns false if abs_time is
+//!reached while the value of *addr is still "old". Never throws.
+template<class TimePoint>
+inline bool ipc_atomic_wait(volatile boost::uint32_t *addr, boost::uint32_t old, const TimePoint &abs_time)
+{  return ipcdetail::ipc_atomic_wait(addr, old, 0, abs_time);  }
+
+//!Wakes one thread blocked in ipc_atomic_wait on addr, in any process.
+//!The value must be changed before calling it. Each call enters the kernel, so
+//!if waiters are rare, keep a count of them and only notify if there are waiters
+//!(see interprocess_eventcount). Never throws.
+inline void ipc_atomic_notify_one(volatile boost::uint32_t *addr)
+{
+   #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   ipcdetail::futex_wake(addr, 1);
+   #else
+   (void)addr;
+   #endif
+}
+
+//!Wakes all the threads blocked in ipc_atomic_wait on addr, in any process.
+//!The value must be changed before calling it. Never throws.
+inline void ipc_atomic_notify_all(volatile boost::uint32_t *addr)
+{
+   #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   ipcdetail::futex_wake_all(addr);
+   #else
+   (void)addr;
+   #endif
+}
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_IPC_ATOMIC_WAIT_HPP
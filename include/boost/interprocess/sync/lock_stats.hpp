@@ -0,0 +1,391 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_LOCK_STATS_HPP
+#define BOOST_INTERPROCESS_LOCK_STATS_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/offset_ptr.hpp>
+#include <boost/interprocess/sync/spin/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+
+//!\file
+//!Describes lock_stats, the contention counters that synchronization primitives
+//!embed when BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined, and lock_stats_registry,
+//!a table that can be placed in a managed segment so that a monitoring process can
+//!enumerate the instrumented objects stored in that segment.
+//!
+//!Instrumentation changes the size of the synchronization primitives, so all
+//!processes sharing those objects must be compiled with the same setting.
+
+// Maximum number of objects that a lock_stats_registry can hold
+#ifndef BOOST_INTERPROCESS_LOCK_STATS_REGISTRY_MAX_ENTRIES
+   #define BOOST_INTERPROCESS_LOCK_STATS_REGISTRY_MAX_ENTRIES 256u
+#endif
+
+// Maximum length (including the null character) of a name stored in a lock_stats_registry
+#ifndef BOOST_INTERPROCESS_LOCK_STATS_REGISTRY_MAX_NAME
+   #define BOOST_INTERPROCESS_LOCK_STATS_REGISTRY_MAX_NAME 64u
+#endif
+
+namespace boost {
+namespace interprocess {
+
+//!Per-object contention counters. They live inside the synchronization object
+//!(so they are placed in shared memory with it) and are updated with atomic operations,
+//!so any process mapping the object can read them while the object is being used.
+//!
+//!All times are measured in nanoseconds with the monotonic high resolution clock. The clock
+//!is read only by acquisitions that must wait and, if hold time tracking is enabled
+//!with track_hold_time(true), by exclusive acquisitions and releases. Uncontended
+//!acquisitions only update atomic counters when hold time tracking is disabled (the default).
+class lock_stats
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   lock_stats(const lock_stats &);
+   lock_stats &operator=(const lock_stats &);
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!Constructs zeroed counters. Does not throw.
+   lock_stats()
+      : m_acquisitions(0u), m_contentions(0u), m_timeouts(0u)
+      , m_wait_ns(0u), m_hold_ns(0u), m_hold_start(0u), m_track_hold(0u)
+   {}
+
+   //!Enables or disables the accounting of hold_ns(), that reads the clock
+   //!in every exclusive acquisition and release. Ownerships started while it
+   //!was disabled are not accounted. Does not throw.
+   void track_hold_time(bool enable)
+   {  ipcdetail::atomic_write32(&m_track_hold, enable ? 1u : 0u);  }
+
+   //!Returns true if hold_ns() is being accounted. Does not throw.
+   bool tracks_hold_time() const
+   {  return ipcdetail::atomic_read32(const_cast<boost::uint32_t*>(&m_track_hold)) != 0u;  }
+
+   //!Returns the number of successful acquisitions (locks, semaphore waits,
+   //!and condition wakeups). Does not throw.
+   boost::uint64_t acquisitions() const
+   {  return ipcdetail::atomic_read64(const_cast<boost::uint64_t*>(&m_acquisitions));  }
+
+   //!Returns the number of acquisitions that could not be satisfied
+   //!immediately and had to wait. Does not throw.
+   boost::uint64_t contentions() const
+   {  return ipcdetail::atomic_read64(const_cast<boost::uint64_t*>(&m_contentions));  }
+
+   //!Returns the number of timed acquisitions that failed because
+   //!the timeout expired. Does not throw.
+   boost::uint64_t timeouts() const
+   {  return ipcdetail::atomic_read64(const_cast<boost::uint64_t*>(&m_timeouts));  }
+
+   //!Returns the cumulative time spent waiting by contended (successful or timed out)
+   //!acquisitions. Does not throw.
+   boost::uint64_t wait_ns() const
+   {  return ipcdetail::atomic_read64(const_cast<boost::uint64_t*>(&m_wait_ns));  }
+
+   //!Returns the cumulative time the object was owned in exclusive mode, only accounted
+   //!while track_hold_time(true) is in effect. Sharable ownership is not accounted. For mutexes used with conditions, the time spent
+   //!waiting in the condition is included. Does not throw.
+   boost::uint64_t hold_ns() const
+   {  return ipcdetail::atomic_read64(const_cast<boost::uint64_t*>(&m_hold_ns));  }
+
+   //!Sets all counters to zero. Concurrent updates might be lost. Does not throw.
+   void reset()
+   {
+      this->reset_counter(m_acquisitions);
+      this->reset_counter(m_contentions);
+      this->reset_counter(m_timeouts);
+      this->reset_counter(m_wait_ns);
+      this->reset_counter(m_hold_ns);
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   void on_acquired(bool contended, boost::uint64_t wait)
+   {
+      ipcdetail::atomic_add64(&m_acquisitions, 1u);
+      if(contended){
+         ipcdetail::atomic_add64(&m_contentions, 1u);
+         ipcdetail::atomic_add64(&m_wait_ns, wait);
+      }
+   }
+
+   void on_timeout(boost::uint64_t wait)
+   {
+      ipcdetail::atomic_add64(&m_timeouts, 1u);
+      ipcdetail::atomic_add64(&m_wait_ns, wait);
+   }
+
+   //Only the exclusive owner calls these functions,
+   //so m_hold_start needs no atomic operation
+   void on_exclusive_begin(boost::uint64_t now)
+   {  m_hold_start = now;  }
+
+   void on_exclusive_end(boost::uint64_t now)
+   {
+      if(m_hold_start){
+         ipcdetail::atomic_add64(&m_hold_ns, now - m_hold_start);
+         m_hold_start = 0u;
+      }
+   }
+
+   //True if the current exclusive ownership is being timed
+   bool hold_started() const
+   {  return m_hold_start != 0u;  }
+
+   private:
+   static void reset_counter(volatile boost::uint64_t &counter)
+   {
+      boost::uint64_t old, c(ipcdetail::atomic_read64(&counter));
+      while((old = ipcdetail::atomic_cas64(&counter, 0u, c)) != c){
+         c = old;
+      }
+   }
+
+   volatile boost::uint64_t m_acquisitions;
+   volatile boost::uint64_t m_contentions;
+   volatile boost::uint64_t m_timeouts;
+   volatile boost::uint64_t m_wait_ns;
+   volatile boost::uint64_t m_hold_ns;
+   volatile boost::uint64_t m_hold_start;
+   volatile boost::uint32_t m_track_hold;
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+#if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+
+namespace ipcdetail {
+
+inline boost::uint64_t lock_stats_now_ns()
+{  return system_highres_count_to_ns(get_current_system_highres_count());  }
+
+//Helper used by instrumented primitives to measure a single acquisition.
+//The clock is only read if the acquisition must wait or if hold time is
+//tracked, so that uncontended acquisitions only pay the atomic updates.
+class lock_stats_probe
+{
+   public:
+   explicit lock_stats_probe(lock_stats &stats)
+      : m_stats(stats), m_start(0u), m_contended(false)
+   {}
+
+   //Marks the acquisition as contended. Only the first call starts the timer
+   void contended()
+   {
+      if(!m_contended){
+         m_contended = true;
+         m_start = lock_stats_now_ns();
+      }
+   }
+
+   void acquired()
+   {  m_stats.on_acquired(m_contended, this->elapsed());  }
+
+   void acquired_exclusive()
+   {
+      this->acquired();
+      if(m_stats.tracks_hold_time()){
+         m_stats.on_exclusive_begin(lock_stats_now_ns());
+      }
+   }
+
+   //Returns false so that it can be used in return statements
+   bool timed_out()
+   {
+      m_stats.on_timeout(this->elapsed());
+      return false;
+   }
+
+   //Returns "acquired" so that it can be used in return statements
+   bool result(bool acquired)
+   {
+      if(acquired){
+         this->acquired();
+      }
+      else{
+         this->timed_out();
+      }
+      return acquired;
+   }
+
+   bool result_exclusive(bool acquired)
+   {
+      if(acquired){
+         this->acquired_exclusive();
+      }
+      else{
+         this->timed_out();
+      }
+      return acquired;
+   }
+
+   static void released_exclusive(lock_stats &stats)
+   {
+      if(stats.hold_started()){
+         stats.on_exclusive_end(lock_stats_now_ns());
+      }
+   }
+
+   private:
+   boost::uint64_t elapsed() const
+   {  return m_contended ? lock_stats_now_ns() - m_start : 0u;  }
+
+   lock_stats &m_stats;
+   boost::uint64_t m_start;
+   bool m_contended;
+};
+
+}  //namespace ipcdetail {
+
+#endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+//!A fixed-capacity table, placed in a managed segment, that associates names with
+//!the lock_stats of instrumented synchronization objects placed in the same segment.
+//!A monitoring process can find the registry (e.g. with
+//!`segment.find<lock_stats_registry>(unique_instance)`) and enumerate the counters
+//!with for_each().
+//!
+//!The registry holds offset pointers, so registered objects must be placed in the same
+//!segment as the registry and must be removed from the registry before being destroyed.
+class lock_stats_registry
+{
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //Non-copyable
+   lock_stats_registry(const lock_stats_registry &);
+   lock_stats_registry &operator=(const lock_stats_registry &);
+
+   struct entry_t
+   {
+      offset_ptr<lock_stats> stats;
+      char name[BOOST_INTERPROCESS_LOCK_STATS_REGISTRY_MAX_NAME];
+   };
+
+   typedef ipcdetail::spin_mutex mutex_type;
+
+   struct scoped_lock_t
+   {
+      explicit scoped_lock_t(mutex_type &m) : m_m(m) {  m_m.lock();  }
+      ~scoped_lock_t() {  m_m.unlock();  }
+      mutex_type &m_m;
+   };
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+
+   public:
+   //!The maximum number of registered objects
+   static const std::size_t max_entries = BOOST_INTERPROCESS_LOCK_STATS_REGISTRY_MAX_ENTRIES;
+
+   //!Constructs an empty registry. Does not throw.
+   lock_stats_registry()
+      : m_mutex(), m_size(0u)
+   {}
+
+   //!Registers "stats" with the name "name". Names longer than
+   //!BOOST_INTERPROCESS_LOCK_STATS_REGISTRY_MAX_NAME - 1 are truncated.
+   //!Returns false if the registry is full. Does not throw.
+   bool add(const char *name, lock_stats &stats)
+   {
+      scoped_lock_t lck(m_mutex);
+      if(m_size == max_entries){
+         return false;
+      }
+      entry_t &e = m_entries[m_size];
+      e.stats = &stats;
+      std::strncpy(e.name, name, sizeof(e.name) - 1u);
+      e.name[sizeof(e.name) - 1u] = '\0';
+      ++m_size;
+      return true;
+   }
+
+   //!Registers the counters of an instrumented synchronization object
+   //!(one that offers a `stats()` member). Equivalent to `add(name, sync.stats())`.
+   template<class SyncObject>
+   bool add(const char *name, SyncObject &sync)
+   {  return this->add(name, sync.stats());  }
+
+   //!Unregisters "stats". Returns false if it was not registered. Does not throw.
+   bool remove(const lock_stats &stats)
+   {
+      scoped_lock_t lck(m_mutex);
+      for(std::size_t i = 0; i != m_size; ++i){
+         if(m_entries[i].stats.get() == &stats){
+            //Move the last entry to the freed position
+            --m_size;
+            if(i != m_size){
+               m_entries[i].stats = m_entries[m_size].stats;
+               std::memcpy(m_entries[i].name, m_entries[m_size].name, sizeof(m_entries[i].name));
+            }
+            m_entries[m_size].stats = 0;
+            return true;
+         }
+      }
+      return false;
+   }
+
+   //!Unregisters the counters of an instrumented synchronization object.
+   template<class SyncObject>
+   bool remove(const SyncObject &sync)
+   {  return this->remove(const_cast<SyncObject&>(sync).stats());  }
+
+   //!Returns the number of registered objects. Does not throw.
+   std::size_t size() const
+   {
+      scoped_lock_t lck(m_mutex);
+      return m_size;
+   }
+
+   //!Calls `f(name, stats)` for every registered object, where "name" is a
+   //!`const char *` and "stats" a `const lock_stats &`. The registry is locked
+   //!during the traversal, so "f" shall not call other registry functions.
+   template<class Func>
+   void for_each(Func f) const
+   {
+      scoped_lock_t lck(m_mutex);
+      for(std::size_t i = 0; i != m_size; ++i){
+         const entry_t &e = m_entries[i];
+         f(static_cast<const char *>(e.name), static_cast<const lock_stats &>(*e.stats));
+      }
+   }
+
+   //!Resets the counters of all registered objects. Does not throw.
+   void reset_all()
+   {
+      scoped_lock_t lck(m_mutex);
+      for(std::size_t i = 0; i != m_size; ++i){
+         m_entries[i].stats->reset();
+      }
+   }
+
+   #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   private:
+   mutable mutex_type m_mutex;
+   std::size_t m_size;
+   entry_t m_entries[max_entries];
+   #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
+};
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_LOCK_STATS_HPP
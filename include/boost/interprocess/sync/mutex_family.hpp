@@ -24,6 +24,7 @@
 
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/interprocess_recursive_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_queue_mutex.hpp>
 #include <boost/interprocess/sync/null_mutex.hpp>
 
 //!\file
@@ -41,6 +42,15 @@ struct mutex_family
    typedef boost::interprocess::interprocess_recursive_mutex       recursive_mutex_type;
 };
 
+//!Describes a mutex family to use with Interprocess framework based on
+//!interprocess_queue_mutex (fair, FIFO) for segments with many concurrent users.
+//!Recursive mutexes are interprocess_recursive_mutex.
+struct queue_mutex_family
+{
+   typedef boost::interprocess::interprocess_queue_mutex           mutex_type;
+   typedef boost::interprocess::interprocess_recursive_mutex       recursive_mutex_type;
+};
+
 //!Describes interprocess_mutex family to use with Interprocess frameworks
 //!based on null operation synchronization objects.
 struct null_mutex_family
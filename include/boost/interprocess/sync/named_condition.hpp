@@ -61,6 +61,9 @@ class named_condition
 
    //!Creates a global condition with a name.
    //!If the condition can't be created throws interprocess_exception
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition(create_only_t, const char *name, const permissions &perm = permissions());
 
    //!Opens or creates a global condition with a name.
@@ -69,6 +72,9 @@ class named_condition
    //!If the condition is already created, this call is equivalent
    //!named_condition(open_only_t, ... )
    //!Does not throw
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition(open_or_create_t, const char *name, const permissions &perm = permissions());
 
    //!Opens a global condition with a name if that condition is previously
@@ -86,6 +92,9 @@ class named_condition
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition(create_only_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens or creates a global condition with a name.
@@ -97,6 +106,9 @@ class named_condition
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition(open_or_create_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens a global condition with a name if that condition is previously
@@ -61,6 +61,9 @@ class named_condition_any
    public:
    //!Creates a global condition with a name.
    //!If the condition can't be created throws interprocess_exception
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition_any(create_only_t, const char *name, const permissions &perm = permissions())
       :  m_cond(create_only_t(), name, perm)
    {}
@@ -71,6 +74,9 @@ class named_condition_any
    //!If the condition is already created, this call is equivalent
    //!named_condition_any(open_only_t, ... )
    //!Does not throw
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition_any(open_or_create_t, const char *name, const permissions &perm = permissions())
       :  m_cond(open_or_create_t(), name, perm)
    {}
@@ -89,6 +95,9 @@ class named_condition_any
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition_any(create_only_t, const wchar_t *name, const permissions &perm = permissions())
       :  m_cond(create_only_t(), name, perm)
    {}
@@ -102,6 +111,9 @@ class named_condition_any
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_condition_any(open_or_create_t, const wchar_t *name, const permissions &perm = permissions())
       :  m_cond(open_or_create_t(), name, perm)
    {}
@@ -62,6 +62,9 @@ class named_mutex
    public:
    //!Creates a global mutex with a name.
    //!Throws interprocess_exception on error.
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_mutex(create_only_t, const char *name, const permissions &perm = permissions());
 
    //!Opens or creates a global mutex with a name.
@@ -70,6 +73,9 @@ class named_mutex
    //!If the mutex is already created, this call is equivalent
    //!named_mutex(open_only_t, ... )
    //!Does not throw
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_mutex(open_or_create_t, const char *name, const permissions &perm = permissions());
 
    //!Opens a global mutex with a name if that mutex is previously
@@ -84,6 +90,9 @@ class named_mutex
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_mutex(create_only_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens or creates a global mutex with a name.
@@ -95,6 +104,9 @@ class named_mutex
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_mutex(open_or_create_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens a global mutex with a name if that mutex is previously
@@ -177,6 +189,19 @@ class named_mutex
 
    #endif   //defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
+   #if (defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS) && !defined(BOOST_INTERPROCESS_NAMED_MUTEX_USE_POSIX) && \
+        !defined(BOOST_INTERPROCESS_NAMED_MUTEX_USE_WINAPI)) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
+   //!Returns the contention counters of the mutex, stored in shared memory so that
+   //!all processes opening the named mutex see the same values.
+   //!
+   //!Note: Only available if BOOST_INTERPROCESS_ENABLE_LOCK_STATS is defined and
+   //!      the named mutex is emulated with shared memory (e.g. when POSIX named
+   //!      semaphores are not available or BOOST_INTERPROCESS_FORCE_GENERIC_EMULATION
+   //!      is defined on Windows).
+   lock_stats &stats()
+   {  return m_mut.stats(); }
+   #endif
+
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
    private:
    friend class ipcdetail::interprocess_tester;
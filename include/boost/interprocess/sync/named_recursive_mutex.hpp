@@ -57,6 +57,9 @@ class named_recursive_mutex
 
    //!Creates a global recursive_mutex with a name.
    //!If the recursive_mutex can't be created throws interprocess_exception
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_recursive_mutex(create_only_t, const char *name, const permissions &perm = permissions());
 
    //!Opens or creates a global recursive_mutex with a name.
@@ -65,6 +68,9 @@ class named_recursive_mutex
    //!If the recursive_mutex is already created, this call is equivalent
    //!named_recursive_mutex(open_only_t, ... )
    //!Does not throw
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_recursive_mutex(open_or_create_t, const char *name, const permissions &perm = permissions());
 
    //!Opens a global recursive_mutex with a name if that recursive_mutex is previously
@@ -79,6 +85,9 @@ class named_recursive_mutex
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_recursive_mutex(create_only_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens or creates a global recursive_mutex with a name.
@@ -90,6 +99,9 @@ class named_recursive_mutex
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_recursive_mutex(open_or_create_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens a global recursive_mutex with a name if that recursive_mutex is previously
@@ -58,6 +58,9 @@ class named_semaphore
    public:
    //!Creates a global semaphore with a name, and an initial count.
    //!If the semaphore can't be created throws interprocess_exception
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_semaphore(create_only_t, const char *name, unsigned int initialCount, const permissions &perm = permissions());
 
    //!Opens or creates a global semaphore with a name, and an initial count.
@@ -66,6 +69,9 @@ class named_semaphore
    //!If the semaphore is already created, this call is equivalent to
    //!named_semaphore(open_only_t, ... )
    //!and initialCount is ignored.
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_semaphore(open_or_create_t, const char *name, unsigned int initialCount, const permissions &perm = permissions());
 
    //!Opens a global semaphore with a name if that semaphore is previously.
@@ -80,6 +86,9 @@ class named_semaphore
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_semaphore(create_only_t, const wchar_t *name, unsigned int initialCount, const permissions &perm = permissions());
 
    //!Opens or creates a global semaphore with a name, and an initial count.
@@ -91,6 +100,9 @@ class named_semaphore
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_semaphore(open_or_create_t, const wchar_t *name, unsigned int initialCount, const permissions &perm = permissions());
 
    //!Opens a global semaphore with a name if that semaphore is previously.
@@ -134,6 +146,32 @@ class named_semaphore
    template<class TimePoint>
    bool timed_wait(const TimePoint &abs_time);
 
+   //!Increments the semaphore count by n, as n calls to post().
+   //!If there is an error an interprocess_exception exception is thrown.
+   void post(unsigned int n);
+
+   //!Decrements the semaphore count by n. If the count is less than n, the calling
+   //!process/thread blocks until it can decrement it by n. Units are never held
+   //!while waiting, so a waiter of n units only acquires them when all are available.
+   //!Note: POSIX and Windows semaphores can only acquire one unit at a time, so
+   //!the wait is emulated: when fewer than n units are available the waiter returns
+   //!the units it took and sleeps before trying again. Waiters of fewer units can starve
+   //!it and it might acquire the units late (see BOOST_INTERPROCESS_SEMAPHORE_WAIT_N_MAX_SLEEP_MS).
+   //!If there is an error an interprocess_exception exception is thrown.
+   void wait(unsigned int n);
+
+   //!Decrements the semaphore count by n and returns true if the count is
+   //!not less than n. Otherwise returns false and the count is not modified.
+   //!If there is an error an interprocess_exception exception is thrown.
+   bool try_wait(unsigned int n);
+
+   //!Decrements the semaphore count by n, waiting if necessary until
+   //!the count is not less than n or abs_time is reached. On timeout returns false
+   //!and no unit is acquired. The same note as in wait(n) applies.
+   //!If there is an error throws sem_exception
+   template<class TimePoint>
+   bool timed_wait(unsigned int n, const TimePoint &abs_time);
+
    //!Erases a named semaphore from the system.
    //!Returns false on error. Never throws.
    static bool remove(const char *name);
@@ -218,6 +256,23 @@ template<class TimePoint>
 inline bool named_semaphore::timed_wait(const TimePoint &abs_time)
 {  return m_sem.timed_wait(abs_time);  }
 
+inline void named_semaphore::post(unsigned int n)
+{
+   if(n){
+      m_sem.post(n);
+   }
+}
+
+inline void named_semaphore::wait(unsigned int n)
+{  m_sem.wait(n);  }
+
+inline bool named_semaphore::try_wait(unsigned int n)
+{  return m_sem.try_wait(n);  }
+
+template<class TimePoint>
+inline bool named_semaphore::timed_wait(unsigned int n, const TimePoint &abs_time)
+{  return m_sem.timed_wait(n, abs_time);  }
+
 inline bool named_semaphore::remove(const char *name)
 {  return impl_t::remove(name);   }
 
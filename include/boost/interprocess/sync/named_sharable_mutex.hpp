@@ -25,7 +25,7 @@
 #include <boost/interprocess/exceptions.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/timed_utils.hpp>
-#include <boost/interprocess/detail/managed_open_or_create_impl.hpp>
+#include <boost/interprocess/sync/shm/named_sync_registry.hpp>
 #include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
 #include <boost/interprocess/sync/shm/named_creation_functor.hpp>
 #include <boost/interprocess/permissions.hpp>
@@ -57,6 +57,9 @@ class named_sharable_mutex
 
    //!Creates a global sharable mutex with a name.
    //!If the sharable mutex can't be created throws interprocess_exception
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_sharable_mutex(create_only_t, const char *name, const permissions &perm = permissions());
 
    //!Opens or creates a global sharable mutex with a name.
@@ -64,6 +67,9 @@ class named_sharable_mutex
    //!named_sharable_mutex(create_only_t, ...)
    //!If the sharable mutex is already created, this call is equivalent to
    //!named_sharable_mutex(open_only_t, ... ).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_sharable_mutex(open_or_create_t, const char *name, const permissions &perm = permissions());
 
    //!Opens a global sharable mutex with a name if that sharable mutex
@@ -79,6 +85,9 @@ class named_sharable_mutex
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_sharable_mutex(create_only_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens or creates a global sharable mutex with a name.
@@ -89,6 +98,9 @@ class named_sharable_mutex
    //! 
    //!Note: This function is only available on operating systems with
    //!      native wchar_t APIs (e.g. Windows).
+   //! 
+   //!Note: If BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY is defined and the object is emulated
+   //!      with shared memory, "perm" is only used if this call creates the registry segment.
    named_sharable_mutex(open_or_create_t, const wchar_t *name, const permissions &perm = permissions());
 
    //!Opens a global sharable mutex with a name if that sharable mutex
@@ -259,7 +271,7 @@ class named_sharable_mutex
    interprocess_sharable_mutex *mutex() const
    {  return static_cast<interprocess_sharable_mutex*>(m_shmem.get_user_address()); }
 
-   typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> open_create_impl_t;
+   typedef ipcdetail::named_sync_storage_t open_create_impl_t;
    open_create_impl_t m_shmem;
    typedef ipcdetail::named_creation_functor<interprocess_sharable_mutex> construct_func_t;
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
@@ -372,12 +384,12 @@ inline bool named_sharable_mutex::timed_lock_sharable
 {  return this->mutex()->timed_lock_sharable(abs_time);  }
 
 inline bool named_sharable_mutex::remove(const char *name)
-{  return shared_memory_object::remove(name); }
+{  return ipcdetail::remove_named_sync_storage(name); }
 
 #if defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
 inline bool named_sharable_mutex::remove(const wchar_t *name)
-{  return shared_memory_object::remove(name); }
+{  return ipcdetail::remove_named_sync_storage(name); }
 
 #endif //defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
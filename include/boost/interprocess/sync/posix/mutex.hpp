@@ -66,6 +66,9 @@ class posix_mutex
    public:
 
    posix_mutex();
+   //Constructs a priority inheritance mutex if prio_inherit is true and the
+   //platform supports it, a normal mutex otherwise
+   explicit posix_mutex(bool prio_inherit);
    ~posix_mutex();
 
    void lock();
@@ -93,6 +96,13 @@ inline posix_mutex::posix_mutex()
    mut.release();
 }
 
+inline posix_mutex::posix_mutex(bool prio_inherit)
+{
+   mutexattr_wrapper mut_attr(false, prio_inherit);
+   mutex_initializer mut(m_mut, mut_attr);
+   mut.release();
+}
+
 inline posix_mutex::~posix_mutex()
 {
    int res = pthread_mutex_destroy(&m_mut);
@@ -35,8 +35,9 @@ namespace ipcdetail{
    //!Makes pthread_mutexattr_t cleanup easy when using exceptions
    struct mutexattr_wrapper
    {
-      //!Constructor
-      mutexattr_wrapper(bool recursive = false)
+      //!Constructor. Priority inheritance is only requested if
+      //!the platform supports it (BOOST_INTERPROCESS_POSIX_PRIO_INHERIT)
+      mutexattr_wrapper(bool recursive = false, bool prio_inherit = false)
       {
          if(pthread_mutexattr_init(&m_attr)!=0 ||
             pthread_mutexattr_setpshared(&m_attr, PTHREAD_PROCESS_SHARED)!= 0 ||
@@ -45,8 +46,13 @@ namespace ipcdetail{
               #ifdef BOOST_INTERPROCESS_POSIX_ROBUST_MUTEXES
               || pthread_mutexattr_setrobust(&m_attr, PTHREAD_MUTEX_ROBUST) != 0
               #endif
+              #ifdef BOOST_INTERPROCESS_POSIX_PRIO_INHERIT
+              || (prio_inherit &&
+                  pthread_mutexattr_setprotocol(&m_attr, PTHREAD_PRIO_INHERIT) != 0)
+              #endif
               )
           throw interprocess_exception("pthread_mutexattr_xxxx failed");
+         (void)prio_inherit;
       }
 
       //!Destructor
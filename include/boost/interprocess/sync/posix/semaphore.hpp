@@ -23,6 +23,7 @@
 #include <boost/interprocess/detail/workaround.hpp>
 
 #include <boost/interprocess/sync/posix/semaphore_wrapper.hpp>
+#include <boost/interprocess/sync/detail/common_algorithms.hpp>
 
 namespace boost {
 namespace interprocess {
@@ -54,6 +55,21 @@ class posix_semaphore
    bool timed_wait(const TimePoint &abs_time)
    {  return semaphore_timed_wait(&m_sem, abs_time); }
 
+   //sem_t only handles single units, so multiple
+   //units are emulated (see common_algorithms.hpp)
+   void post(unsigned int n)
+   {  semaphore_post_n(*this, n); }
+
+   void wait(unsigned int n)
+   {  semaphore_wait_n(*this, n); }
+
+   bool try_wait(unsigned int n)
+   {  return semaphore_try_wait_n(*this, n); }
+
+   template<class TimePoint>
+   bool timed_wait(unsigned int n, const TimePoint &abs_time)
+   {  return semaphore_timed_wait_n(*this, n, abs_time); }
+
    private:
    sem_t       m_sem;
 };
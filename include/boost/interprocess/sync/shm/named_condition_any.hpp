@@ -28,7 +28,7 @@
 #include <boost/interprocess/exceptions.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
-#include <boost/interprocess/detail/managed_open_or_create_impl.hpp>
+#include <boost/interprocess/sync/shm/named_sync_registry.hpp>
 #include <boost/interprocess/sync/shm/named_creation_functor.hpp>
 #include <boost/interprocess/sync/named_mutex.hpp>
 #include <boost/interprocess/permissions.hpp>
@@ -180,7 +180,7 @@ class shm_named_condition_any
    //!Returns false on error. Never throws.
    template <class CharT>
    static bool remove(const CharT *name)
-   {  return shared_memory_object::remove(name); }
+   {  return ipcdetail::remove_named_sync_storage(name); }
 
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
    private:
@@ -208,7 +208,7 @@ class shm_named_condition_any
    void dont_close_on_destruction()
    {  interprocess_tester::dont_close_on_destruction(m_shmem);  }
 
-   typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> open_create_impl_t;
+   typedef ipcdetail::named_sync_storage_t open_create_impl_t;
    open_create_impl_t m_shmem;
 
    template <class T, class Arg> friend class boost::interprocess::ipcdetail::named_creation_functor;
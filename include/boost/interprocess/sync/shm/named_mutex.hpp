@@ -28,7 +28,7 @@
 
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
-#include <boost/interprocess/detail/managed_open_or_create_impl.hpp>
+#include <boost/interprocess/sync/shm/named_sync_registry.hpp>
 #include <boost/interprocess/sync/shm/named_creation_functor.hpp>
 #include <boost/interprocess/timed_utils.hpp>
 
@@ -139,6 +139,12 @@ class shm_named_mutex
 
    #endif
 
+   #if defined(BOOST_INTERPROCESS_ENABLE_LOCK_STATS)
+   //!Returns the contention counters of the mutex, stored in shared memory.
+   lock_stats &stats()
+   {  return this->internal_mutex().stats();  }
+   #endif
+
    #if !defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
    typedef interprocess_mutex internal_mutex_type;
    interprocess_mutex &internal_mutex()
@@ -147,7 +153,7 @@ class shm_named_mutex
    private:
    friend class ipcdetail::interprocess_tester;
    void dont_close_on_destruction();
-   typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> open_create_impl_t;
+   typedef ipcdetail::named_sync_storage_t open_create_impl_t;
    open_create_impl_t m_shmem;
    typedef ipcdetail::named_creation_functor<interprocess_mutex> construct_func_t;
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
@@ -239,12 +245,12 @@ inline bool shm_named_mutex::timed_lock(const TimePoint &abs_time)
 {  return this->internal_mutex().timed_lock(abs_time);   }
 
 inline bool shm_named_mutex::remove(const char *name)
-{  return shared_memory_object::remove(name); }
+{  return ipcdetail::remove_named_sync_storage(name); }
 
 #if defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
 inline bool shm_named_mutex::remove(const wchar_t *name)
-{  return shared_memory_object::remove(name); }
+{  return ipcdetail::remove_named_sync_storage(name); }
 
 #endif   //defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
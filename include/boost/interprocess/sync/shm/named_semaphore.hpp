@@ -26,7 +26,7 @@
 #include <boost/interprocess/permissions.hpp>
 #include <boost/interprocess/detail/interprocess_tester.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
-#include <boost/interprocess/detail/managed_open_or_create_impl.hpp>
+#include <boost/interprocess/sync/shm/named_sync_registry.hpp>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
 #include <boost/interprocess/sync/shm/named_creation_functor.hpp>
 
@@ -68,6 +68,11 @@ class shm_named_semaphore
    bool try_wait();
    template<class TimePoint> bool timed_wait(const TimePoint &abs_time);
 
+   void post(unsigned int n);
+   void wait(unsigned int n);
+   bool try_wait(unsigned int n);
+   template<class TimePoint> bool timed_wait(unsigned int n, const TimePoint &abs_time);
+
    static bool remove(const char *name);
 
    #if defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
@@ -84,7 +89,7 @@ class shm_named_semaphore
    interprocess_semaphore *semaphore() const
    {  return static_cast<interprocess_semaphore*>(m_shmem.get_user_address()); }
 
-   typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> open_create_impl_t;
+   typedef ipcdetail::named_sync_storage_t open_create_impl_t;
    open_create_impl_t m_shmem;
    typedef named_creation_functor<interprocess_semaphore, unsigned> construct_func_t;
    #endif   //#ifndef BOOST_INTERPROCESS_DOXYGEN_INVOKED
@@ -179,13 +184,26 @@ template<class TimePoint>
 inline bool shm_named_semaphore::timed_wait(const TimePoint &abs_time)
 {  return semaphore()->timed_wait(abs_time); }
 
+inline void shm_named_semaphore::post(unsigned int n)
+{  semaphore()->post(n);   }
+
+inline void shm_named_semaphore::wait(unsigned int n)
+{  semaphore()->wait(n);   }
+
+inline bool shm_named_semaphore::try_wait(unsigned int n)
+{  return semaphore()->try_wait(n);   }
+
+template<class TimePoint>
+inline bool shm_named_semaphore::timed_wait(unsigned int n, const TimePoint &abs_time)
+{  return semaphore()->timed_wait(n, abs_time); }
+
 inline bool shm_named_semaphore::remove(const char *name)
-{  return shared_memory_object::remove(name); }
+{  return ipcdetail::remove_named_sync_storage(name); }
 
 #if defined(BOOST_INTERPROCESS_WCHAR_NAMED_RESOURCES) || defined(BOOST_INTERPROCESS_DOXYGEN_INVOKED)
 
 inline bool shm_named_semaphore::remove(const wchar_t *name)
-{  return shared_memory_object::remove(name); }
+{  return ipcdetail::remove_named_sync_storage(name); }
 
 #endif
 
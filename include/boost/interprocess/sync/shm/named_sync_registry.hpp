@@ -0,0 +1,461 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_SHM_NAMED_SYNC_REGISTRY_HPP
+#define BOOST_INTERPROCESS_SHM_NAMED_SYNC_REGISTRY_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/permissions.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/detail/managed_open_or_create_impl.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/interprocess_tester.hpp>
+#include <boost/interprocess/detail/intermodule_singleton.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/spin/wait.hpp>
+#include <boost/container/detail/type_traits.hpp>  //max_align_t
+#include <boost/container/detail/placement_new.hpp>
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <string>
+
+//Defining BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY, named synchronization objects
+//emulated with shared memory (named mutexes, semaphores, conditions, etc. when the
+//system offers no native alternative) are stored in a single shared memory segment
+//(the registry) instead of a segment per object. Objects are found by the hash of their
+//name, so opening an object does not need a file descriptor or a new mapping.
+//
+//The registry counts the handles of each object, so that the slot of a removed object
+//is freed when its last handle is closed. Handles of a process that dies are never
+//closed, so the slots of the objects they refer to are not freed after being removed
+//(and their names can't be reused) until the registry segment is removed
+//(shared_memory_object::remove(BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME)) when no process uses it.
+//
+//The registry segment is created with the permissions passed to the first object
+//that is created or opened (the default permissions if it's opened with open_only),
+//and the permissions passed to other objects are ignored.
+
+//Name of the registry segment. Applications can use different registries.
+#if !defined(BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME)
+#  define BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME "boost_interprocess_named_sync_registry"
+#endif
+
+//Maximum number of objects in the registry
+#if !defined(BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_SLOTS)
+#  define BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_SLOTS 4096
+#endif
+
+//Maximum size of the name of an object, in bytes
+#if !defined(BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME_SIZE)
+#  define BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME_SIZE 128
+#endif
+
+//Maximum size of an object
+#if !defined(BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_OBJECT_SIZE)
+#  define BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_OBJECT_SIZE 256
+#endif
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//The registry segment: a mutex and an open addressing hash table of objects.
+//The mutex protects the table, that is only accessed when opening, closing and
+//removing objects, and objects are never moved, so they are used without locking it.
+class named_sync_registry
+{
+   named_sync_registry(const named_sync_registry &);
+   named_sync_registry &operator=(const named_sync_registry &);
+
+   public:
+   static const boost::uint32_t num_slots = BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_SLOTS;
+   static const std::size_t max_name_size = BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME_SIZE;
+   static const std::size_t max_object_size = BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_OBJECT_SIZE;
+
+   //Key of an object: the bytes of its name, wide names being different from narrow ones
+   struct key
+   {
+      template<class CharT>
+      explicit key(const CharT *name)
+         : m_data(name)
+         , m_size(static_cast<boost::uint32_t>(std::char_traits<CharT>::length(name)*sizeof(CharT)))
+         , m_wide(sizeof(CharT) != 1u)
+         , m_hash(2166136261u)
+      {
+         if(m_size > max_name_size){
+            throw interprocess_exception(error_info(invalid_argument), "Name too long for the named sync registry");
+         }
+         //FNV-1a
+         const unsigned char *p = static_cast<const unsigned char*>(m_data);
+         for(boost::uint32_t i = 0; i != m_size; ++i){
+            m_hash = (m_hash ^ p[i])*16777619u;
+         }
+         m_hash ^= m_wide;
+      }
+
+      const void *m_data;
+      boost::uint32_t m_size;
+      boost::uint32_t m_wide;
+      boost::uint32_t m_hash;
+   };
+
+   struct slot
+   {
+      //free_slot, used_slot, removed_slot (used but not found by name) or tombstone_slot
+      boost::uint32_t m_state;
+      //Number of handles to the object
+      boost::uint32_t m_refcount;
+      boost::uint32_t m_hash;
+      boost::uint32_t m_wide;
+      boost::uint32_t m_name_size;
+      unsigned char m_name[max_name_size];
+      union object_storage
+      {
+         unsigned char m_data[max_object_size];
+         ::boost::container::dtl::max_align_t m_aligner;
+      } m_object;
+
+      bool matches(const key &k) const
+      {
+         return m_state == used_slot && m_hash == k.m_hash && m_wide == k.m_wide &&
+                m_name_size == k.m_size && !std::memcmp(m_name, k.m_data, k.m_size);
+      }
+   };
+
+   enum slot_state
+   {  free_slot = 0u, used_slot, removed_slot, tombstone_slot };
+
+   named_sync_registry()
+      : m_num_slots(num_slots), m_slot_size(sizeof(slot))
+   {}
+
+   static std::size_t segment_size()
+   {  return sizeof(named_sync_registry) + std::size_t(num_slots)*sizeof(slot);  }
+
+   //Returns the slot of the object, creating it if needed, and increments its references
+   template<class ConstructFunc>
+   slot &open(create_enum_t type, const key &k, std::size_t size, const ConstructFunc &construct_func)
+   {
+      if(m_num_slots != num_slots || m_slot_size != sizeof(slot)){
+         throw interprocess_exception(error_info(corrupted_error), "Incompatible named sync registry");
+      }
+      if(size > max_object_size){
+         throw interprocess_exception(error_info(size_error), "Object too big for the named sync registry");
+      }
+      scoped_lock<interprocess_mutex> lock(m_mutex);
+      slot *s = this->priv_find(k);
+      bool created = false;
+      if(s){
+         if(type == DoCreate){
+            throw interprocess_exception(error_info(already_exists_error));
+         }
+      }
+      else if(type == DoOpen){
+         throw interprocess_exception(error_info(not_found_error));
+      }
+      else{
+         s = this->priv_insert(k);
+         created = true;
+      }
+      //Objects are constructed while holding the lock, so that
+      //no one opens them before they are initialized
+      BOOST_INTERPROCESS_TRY{
+         if(!construct_func(&s->m_object, size, created)){
+            throw interprocess_exception(error_info(corrupted_error));
+         }
+      }
+      BOOST_INTERPROCESS_CATCH(...){
+         if(created){
+            this->priv_free(*s);
+         }
+         BOOST_INTERPROCESS_RETHROW
+      } BOOST_INTERPROCESS_CATCH_END
+      ++s->m_refcount;
+      return *s;
+   }
+
+   //Decrements the references of an object, freeing its slot
+   //if it was removed and this was the last reference.
+   void close(slot &s)
+   {
+      scoped_lock<interprocess_mutex> lock(m_mutex);
+      if(!--s.m_refcount && s.m_state == removed_slot){
+         this->priv_free(s);
+      }
+   }
+
+   //Removes the name of an object. The slot is freed when it's closed by all the handles.
+   bool remove(const key &k)
+   {
+      scoped_lock<interprocess_mutex> lock(m_mutex);
+      slot *const s = this->priv_find(k);
+      if(!s){
+         return false;
+      }
+      if(s->m_refcount){
+         s->m_state = removed_slot;
+      }
+      else{
+         this->priv_free(*s);
+      }
+      return true;
+   }
+
+   //Returns the number of free slots, that end lookups
+   boost::uint32_t num_free_slots()
+   {
+      scoped_lock<interprocess_mutex> lock(m_mutex);
+      slot *const slots = this->priv_slots();
+      boost::uint32_t n = 0u;
+      for(boost::uint32_t i = 0; i != num_slots; ++i){
+         n += slots[i].m_state == free_slot;
+      }
+      return n;
+   }
+
+   private:
+   slot *priv_slots()
+   {  return reinterpret_cast<slot*>(this + 1);  }
+
+   //Linear probing until a free slot is found
+   slot *priv_find(const key &k)
+   {
+      slot *const slots = this->priv_slots();
+      for(boost::uint32_t i = 0, pos = k.m_hash % num_slots; i != num_slots; ++i, pos = (pos + 1u) % num_slots){
+         slot &s = slots[pos];
+         if(s.m_state == free_slot){
+            break;
+         }
+         else if(s.matches(k)){
+            return &s;
+         }
+      }
+      return 0;
+   }
+
+   //Marks the slot as a tombstone, so that lookups continue after it. If the next slot
+   //is free, no lookup needs it and the tombstones that precede it are freed too,
+   //so that lookups don't scan slots freed long ago.
+   void priv_free(slot &s)
+   {
+      slot *const slots = this->priv_slots();
+      boost::uint32_t pos = static_cast<boost::uint32_t>(&s - slots);
+      s.m_state = tombstone_slot;
+      if(slots[(pos + 1u) % num_slots].m_state != free_slot){
+         return;
+      }
+      for(boost::uint32_t i = 0; i != num_slots && slots[pos].m_state == tombstone_slot; ++i){
+         slots[pos].m_state = free_slot;
+         pos = (pos + num_slots - 1u) % num_slots;
+      }
+   }
+
+   slot *priv_insert(const key &k)
+   {
+      slot *const slots = this->priv_slots();
+      for(boost::uint32_t i = 0, pos = k.m_hash % num_slots; i != num_slots; ++i, pos = (pos + 1u) % num_slots){
+         slot &s = slots[pos];
+         if(s.m_state == free_slot || s.m_state == tombstone_slot){
+            s.m_state = used_slot;
+            s.m_refcount = 0u;
+            s.m_hash = k.m_hash;
+            s.m_wide = k.m_wide;
+            s.m_name_size = k.m_size;
+            std::memcpy(s.m_name, k.m_data, k.m_size);
+            return &s;
+         }
+      }
+      throw interprocess_exception(error_info(out_of_resource_error), "Named sync registry is full");
+   }
+
+   interprocess_mutex m_mutex;
+   boost::uint32_t m_num_slots;
+   boost::uint32_t m_slot_size;
+   //Slots are placed after the header
+   union
+   {
+      unsigned char m_pad[1];
+      ::boost::container::dtl::max_align_t m_aligner;
+   } m_end;
+};
+
+//Constructs the registry header when the segment is created
+struct named_sync_registry_ctor
+{
+   bool operator()(void *address, std::size_t, bool created) const
+   {
+      if(created){
+         ::new(address, boost_container_new_t()) named_sync_registry;
+      }
+      return true;
+   }
+
+   static std::size_t get_min_size()
+   {  return named_sync_registry::segment_size();  }
+};
+
+typedef managed_open_or_create_impl<shared_memory_object, 0, true, false> named_sync_registry_segment_t;
+
+//Mapping of the registry, shared by all the modules of the process. The registry is
+//mapped the first time is used and kept mapped until the singleton is destroyed.
+class named_sync_registry_mapping
+{
+   named_sync_registry_mapping(const named_sync_registry_mapping &);
+   named_sync_registry_mapping &operator=(const named_sync_registry_mapping &);
+
+   public:
+   named_sync_registry_mapping()
+      : m_state(0u), mp_segment(0)
+   {}
+
+   ~named_sync_registry_mapping()
+   {  delete mp_segment;  }
+
+   named_sync_registry &get(const permissions &perm)
+   {
+      spin_wait swait;
+      while(atomic_read32(&m_state) != mapped){
+         if(atomic_cas32(&m_state, mapping, unmapped) == unmapped){
+            BOOST_INTERPROCESS_TRY{
+               const char *const name = BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME;
+               mp_segment = new named_sync_registry_segment_t
+                  ( open_or_create
+                  , name
+                  , named_sync_registry::segment_size() + named_sync_registry_segment_t::ManagedOpenOrCreateUserOffset
+                  , read_write
+                  , 0
+                  , named_sync_registry_ctor()
+                  , perm);
+            }
+            BOOST_INTERPROCESS_CATCH(...){
+               atomic_write32(&m_state, unmapped);
+               BOOST_INTERPROCESS_RETHROW
+            } BOOST_INTERPROCESS_CATCH_END
+            atomic_write32(&m_state, mapped);
+         }
+         else{
+            swait.yield();
+         }
+      }
+      return *static_cast<named_sync_registry*>(mp_segment->get_user_address());
+   }
+
+   private:
+   enum { unmapped = 0u, mapping, mapped };
+   volatile boost::uint32_t m_state;
+   named_sync_registry_segment_t *mp_segment;
+};
+
+inline named_sync_registry &get_named_sync_registry(const permissions &perm = permissions())
+{  return intermodule_singleton<named_sync_registry_mapping>::get().get(perm);  }
+
+//A handle to an object of the registry, with the same interface as the
+//managed_open_or_create_impl segment used by the named synchronization objects
+class named_sync_registry_handle
+{
+   named_sync_registry_handle(const named_sync_registry_handle &);
+   named_sync_registry_handle &operator=(const named_sync_registry_handle &);
+
+   public:
+   static const std::size_t ManagedOpenOrCreateUserOffset = 0u;
+
+   template <class CharT, class ConstructFunc>
+   named_sync_registry_handle(create_only_t, const CharT *name, std::size_t size, mode_t, const void *,
+                              const ConstructFunc &construct_func, const permissions &perm)
+      : m_registry(get_named_sync_registry(perm))
+      , m_slot(m_registry.open(DoCreate, named_sync_registry::key(name), size, construct_func))
+      , m_close(true)
+   {}
+
+   template <class CharT, class ConstructFunc>
+   named_sync_registry_handle(open_or_create_t, const CharT *name, std::size_t size, mode_t, const void *,
+                              const ConstructFunc &construct_func, const permissions &perm)
+      : m_registry(get_named_sync_registry(perm))
+      , m_slot(m_registry.open(DoOpenOrCreate, named_sync_registry::key(name), size, construct_func))
+      , m_close(true)
+   {}
+
+   template <class CharT, class ConstructFunc>
+   named_sync_registry_handle(open_only_t, const CharT *name, mode_t, const void *,
+                              const ConstructFunc &construct_func)
+      : m_registry(get_named_sync_registry())
+      , m_slot(m_registry.open(DoOpen, named_sync_registry::key(name), 0u, construct_func))
+      , m_close(true)
+   {}
+
+   ~named_sync_registry_handle()
+   {
+      if(m_close){
+         m_registry.close(m_slot);
+      }
+   }
+
+   void *get_user_address() const
+   {  return &m_slot.m_object;  }
+
+   template <class CharT>
+   static bool remove(const CharT *name)
+   {
+      BOOST_INTERPROCESS_TRY{
+         return get_named_sync_registry().remove(named_sync_registry::key(name));
+      }
+      BOOST_INTERPROCESS_CATCH(...){
+         return false;
+      } BOOST_INTERPROCESS_CATCH_END
+   }
+
+   private:
+   friend class interprocess_tester;
+   void dont_close_on_destruction()
+   {  m_close = false;  }
+
+   named_sync_registry &m_registry;
+   named_sync_registry::slot &m_slot;
+   bool m_close;
+};
+
+//Storage of the named synchronization objects emulated with shared memory
+#if defined(BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY)
+
+typedef named_sync_registry_handle named_sync_storage_t;
+
+template <class CharT>
+inline bool remove_named_sync_storage(const CharT *name)
+{  return named_sync_registry_handle::remove(name);  }
+
+#else
+
+typedef managed_open_or_create_impl<shared_memory_object, 0, true, false> named_sync_storage_t;
+
+template <class CharT>
+inline bool remove_named_sync_storage(const CharT *name)
+{  return shared_memory_object::remove(name);  }
+
+#endif
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_SHM_NAMED_SYNC_REGISTRY_HPP
@@ -1,6 +1,6 @@
 //////////////////////////////////////////////////////////////////////////////
 //
-// (C) Copyright Ion Gaztanaga 2006. Distributed under the Boost
+// (C) Copyright Ion Gaztanaga 2006-2026. Distributed under the Boost
 // Software License, Version 1.0. (See accompanying file
 // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
@@ -8,8 +8,8 @@
 //
 //////////////////////////////////////////////////////////////////////////////
 
-#include<boost/interprocess/exceptions.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
+#ifndef BOOST_INTERPROCESS_DETAIL_SPIN_BARRIER_HPP
+#define BOOST_INTERPROCESS_DETAIL_SPIN_BARRIER_HPP
 
 #ifndef BOOST_CONFIG_HPP
 #  include <boost/config.hpp>
@@ -19,35 +19,130 @@
 #  pragma once
 #endif
 
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/ipc_atomic_wait.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <stdexcept>
+
 namespace boost {
 namespace interprocess {
+namespace ipcdetail {
+
+//A barrier built on atomic counters. Arrivals are counted with atomic
+//increments and the last participant releases the rest incrementing
+//a generation word. Waiters wait for the generation word to change with
+//ipc_atomic_wait, so the kernel is only entered when the wait is long.
+//
+//With many participants the shared arrival counter becomes a hot cache line,
+//so participants that identify themselves arrive at a leaf counter
+//(combining tree): only the last participant of each leaf arrives at the root.
+class spin_barrier
+{
+   spin_barrier(const spin_barrier &);
+   spin_barrier &operator=(const spin_barrier &);
+
+   public:
+   //Participant count from which wait(participant) uses the combining tree
+   static const unsigned int tree_threshold = 64u;
+   //Maximum number of leaves of the combining tree
+   static const unsigned int max_leaves = 16u;
+   //Minimum number of participants per leaf
+   static const unsigned int min_leaf_size = 8u;
+
+   explicit spin_barrier(unsigned int count);
+   ~spin_barrier();
+
+   bool wait();
+   bool wait(unsigned int participant);
+
+   private:
+   //Each counter in its own cache line
+   struct counter
+   {
+      volatile boost::uint32_t m_value;
+      char m_pad[BOOST_INTERPROCESS_CACHE_LINE_SIZE - sizeof(boost::uint32_t)];
+   };
+
+   bool priv_arrive(boost::uint32_t units);
+   void priv_wait_generation(boost::uint32_t gen);
+
+   boost::uint32_t m_count;
+   boost::uint32_t m_leaf_size;
+   counter m_arrived;
+   volatile boost::uint32_t m_generation;
+   volatile boost::uint32_t m_sleepers;
+   char m_pad[BOOST_INTERPROCESS_CACHE_LINE_SIZE - 2*sizeof(boost::uint32_t)];
+   counter m_leaves[max_leaves];
+};
 
-inline barrier::barrier(unsigned int count)
-   : m_threshold(count), m_count(count), m_generation(0)
+inline spin_barrier::spin_barrier(unsigned int count)
+   : m_count(count), m_leaf_size(0u), m_generation(0u), m_sleepers(0u)
 {
    if (count == 0)
       throw std::invalid_argument("count cannot be zero.");
+   m_arrived.m_value = 0u;
+   for(unsigned int i = 0; i != max_leaves; ++i){
+      m_leaves[i].m_value = 0u;
+   }
+   if(count >= tree_threshold){
+      const boost::uint32_t leaf_size = (count - 1u)/max_leaves + 1u;
+      m_leaf_size = leaf_size < min_leaf_size ? min_leaf_size : leaf_size;
+   }
 }
 
-inline barrier::~barrier(){}
+inline spin_barrier::~spin_barrier()
+{}
+
+inline bool spin_barrier::wait()
+{  return this->priv_arrive(1u);  }
 
-inline bool barrier::wait()
+inline bool spin_barrier::wait(unsigned int participant)
 {
-   scoped_lock<interprocess_mutex> lock(m_mutex);
-   unsigned int gen = m_generation;
-
-   if (--m_count == 0){
-      m_generation++;
-      m_count = m_threshold;
-      m_cond.notify_all();
-      return true;
+   BOOST_ASSERT(participant < m_count);
+   if(!m_leaf_size){
+      return this->priv_arrive(1u);
    }
+   //The last leaf might be smaller than the rest
+   const boost::uint32_t leaf = participant/m_leaf_size;
+   const boost::uint32_t first = leaf*m_leaf_size;
+   const boost::uint32_t leaf_count = m_count - first < m_leaf_size ? m_count - first : m_leaf_size;
+   //Read the generation before arriving, as it can't change until we do
+   const boost::uint32_t gen = atomic_read32(&m_generation);
+   volatile boost::uint32_t *const leaf_arrived = &m_leaves[leaf].m_value;
+   if(atomic_inc32(leaf_arrived) + 1u != leaf_count){
+      this->priv_wait_generation(gen);
+      return false;
+   }
+   //Last participant of the leaf: no one else can arrive at it
+   //until the generation changes, so reset it and arrive at the root
+   atomic_write32(leaf_arrived, 0u);
+   return this->priv_arrive(leaf_count);
+}
 
-   while (gen == m_generation){
-      m_cond.wait(lock);
+inline bool spin_barrier::priv_arrive(boost::uint32_t units)
+{
+   const boost::uint32_t gen = atomic_read32(&m_generation);
+   if(atomic_add32(&m_arrived.m_value, units) + units != m_count){
+      this->priv_wait_generation(gen);
+      return false;
    }
-   return false;
+   //Last participant: reset the counter before releasing the rest
+   atomic_write32(&m_arrived.m_value, 0u);
+   atomic_inc32(&m_generation);
+   ipc_atomic_notify_all(&m_generation, &m_sleepers);
+   return true;
 }
 
+inline void spin_barrier::priv_wait_generation(boost::uint32_t gen)
+{  ipc_atomic_wait(&m_generation, gen, &m_sleepers);  }
+
+}  //namespace ipcdetail {
 }  //namespace interprocess {
 }  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_SPIN_BARRIER_HPP
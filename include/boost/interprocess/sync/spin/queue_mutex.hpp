@@ -0,0 +1,304 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_DETAIL_SPIN_QUEUE_MUTEX_HPP
+#define BOOST_INTERPROCESS_DETAIL_SPIN_QUEUE_MUTEX_HPP
+
+#ifndef BOOST_CONFIG_HPP
+#  include <boost/config.hpp>
+#endif
+#
+#if defined(BOOST_HAS_PRAGMA_ONCE)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/sync/ipc_atomic_wait.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//A fair (FIFO) queue lock with local spinning that can be placed in shared memory.
+//
+//Each locker takes a ticket incrementing the tail of the queue and waits in the
+//slot "ticket % num_slots", until the slot grants its ticket. Unlocking grants the
+//next ticket in the next slot, so each waiter spins on its own cache line and
+//the lock is handed to waiters in arrival order. The queue only holds integers,
+//so it works in any address and process, and a zeroed object is an unlocked mutex.
+//
+//At most num_slots tickets are taken at the same time, so each slot holds a single
+//ticket, its state and the process that took it: the slot is claimed (writing the
+//pid) before taking the ticket and released when the ticket is passed. Lockers that
+//find the queue full wait (not in FIFO order) until the head ticket is passed.
+//
+//Waiters wait for the grant with ipc_atomic_wait, so they spin for a while
+//and then block (on a futex, if available). Timed waiters take a ticket too, and when
+//the timeout expires they mark it as abandoned, so that unlock skips it. A waiter woken
+//by the check period verifies that the process of the head ticket is alive: if it died
+//after taking its ticket, and before taking the ownership, its ticket is skipped. Tickets
+//of processes that die while owning the mutex are not recovered.
+class spin_queue_mutex
+{
+   spin_queue_mutex(const spin_queue_mutex &);
+   spin_queue_mutex &operator=(const spin_queue_mutex &);
+   public:
+
+   //Number of waiters that can spin in different cache lines
+   static const unsigned int num_slots = 32u;
+   //Period of the checks of the process that holds the head ticket
+   static const unsigned int check_period_ms = 100u;
+
+   spin_queue_mutex();
+   ~spin_queue_mutex();
+
+   void lock();
+   bool try_lock();
+   template<class TimePoint>
+   bool timed_lock(const TimePoint &abs_time);
+
+   template<class TimePoint> bool try_lock_until(const TimePoint &abs_time)
+   {  return this->timed_lock(abs_time);  }
+
+   template<class Duration>  bool try_lock_for(const Duration &dur)
+   {  return this->timed_lock(duration_to_ustime(dur)); }
+
+   void unlock();
+   void take_ownership(){}
+
+   private:
+   //States of a ticket, stored with the ticket to avoid ABA problems
+   enum ticket_state { waiting, owned, abandoned, skipped };
+
+   static boost::uint32_t priv_state(boost::uint32_t ticket, ticket_state st)
+   {  return boost::uint32_t(ticket << 2u) | boost::uint32_t(st);  }
+
+   struct slot
+   {
+      //Last ticket granted in this slot
+      volatile boost::uint32_t m_grant;
+      //State of the ticket that holds the slot
+      volatile boost::uint32_t m_state;
+      //Process that holds the slot, zero if free
+      volatile boost::uint32_t m_pid;
+      volatile boost::uint32_t m_sleepers;
+      char m_pad[BOOST_INTERPROCESS_CACHE_LINE_SIZE - 4*sizeof(boost::uint32_t)];
+   };
+
+   slot &priv_slot(boost::uint32_t ticket)
+   {  return m_slots[ticket % num_slots];  }
+
+   bool priv_lock(const ustime *deadline);
+   bool priv_take_ticket(boost::uint32_t &ticket, const ustime *deadline);
+   bool priv_wait(volatile boost::uint32_t *addr, boost::uint32_t old, volatile boost::uint32_t *sleepers, const ustime *deadline);
+   void priv_pass(boost::uint32_t ticket);
+   void priv_recover_head();
+
+   //Next ticket to be taken
+   volatile boost::uint32_t m_tail;
+   //Ticket that owns (or is granted) the mutex
+   volatile boost::uint32_t m_head;
+   //Lockers waiting for a place in the queue
+   volatile boost::uint32_t m_head_sleepers;
+   char m_pad[BOOST_INTERPROCESS_CACHE_LINE_SIZE - 3*sizeof(boost::uint32_t)];
+   slot m_slots[num_slots];
+};
+
+inline spin_queue_mutex::spin_queue_mutex()
+   : m_tail(0u), m_head(0u), m_head_sleepers(0u)
+{
+   //Note that this class is initialized to zero.
+   //So zeroed memory can be interpreted as an
+   //initialized mutex: the first ticket (zero) is granted
+   for(unsigned int i = 0; i != num_slots; ++i){
+      m_slots[i].m_grant = 0u;
+      m_slots[i].m_state = 0u;
+      m_slots[i].m_pid = 0u;
+      m_slots[i].m_sleepers = 0u;
+   }
+}
+
+inline spin_queue_mutex::~spin_queue_mutex()
+{
+   //Trivial destructor
+}
+
+inline void spin_queue_mutex::lock()
+{  this->priv_lock(0);  }
+
+inline bool spin_queue_mutex::try_lock()
+{
+   //Only take a ticket if it's already granted (the queue is empty)
+   const boost::uint32_t ticket = atomic_read32(&m_tail);
+   if(atomic_read32(&m_head) != ticket){
+      return false;
+   }
+   slot &s = this->priv_slot(ticket);
+   const boost::uint32_t pid = boost::uint32_t(get_current_process_id());
+   if(atomic_cas32(&s.m_pid, pid, 0u) != 0u){
+      return false;
+   }
+   atomic_write32(&s.m_state, priv_state(ticket, owned));
+   if(atomic_cas32(&m_tail, ticket + 1u, ticket) != ticket){
+      atomic_write32(&s.m_pid, 0u);
+      return false;
+   }
+   return true;
+}
+
+template<class TimePoint>
+inline bool spin_queue_mutex::timed_lock(const TimePoint &abs_time)
+{
+   if(is_pos_infinity(abs_time)){
+      this->lock();
+      return true;
+   }
+   typedef typename microsec_clock<TimePoint>::time_point time_point;
+   const time_point now = microsec_clock<TimePoint>::universal_time();
+   ustime deadline = microsec_clock<ustime>::universal_time();
+   if(now < abs_time){
+      deadline += duration_to_usduration(abs_time - now);
+   }
+   return this->priv_lock(&deadline);
+}
+
+inline void spin_queue_mutex::unlock()
+{  this->priv_pass(atomic_read32(&m_head));  }
+
+inline bool spin_queue_mutex::priv_lock(const ustime *deadline)
+{
+   boost::uint32_t ticket;
+   if(!this->priv_take_ticket(ticket, deadline)){
+      return false;
+   }
+   slot &s = this->priv_slot(ticket);
+   boost::uint32_t grant;
+   while((grant = atomic_read32(&s.m_grant)) != ticket){
+      if(!this->priv_wait(&s.m_grant, grant, &s.m_sleepers, deadline)){
+         //Leave the queue, unless the ticket is granted meanwhile and
+         //we take the ownership before unlock() skips the ticket
+         atomic_cas32(&s.m_state, priv_state(ticket, abandoned), priv_state(ticket, waiting));
+         return atomic_read32(&s.m_grant) == ticket &&
+            atomic_cas32(&s.m_state, priv_state(ticket, owned), priv_state(ticket, abandoned))
+               == priv_state(ticket, abandoned);
+      }
+   }
+   //Only dead processes are skipped, so the ticket is still ours
+   const boost::uint32_t prev = atomic_cas32(&s.m_state, priv_state(ticket, owned), priv_state(ticket, waiting));
+   BOOST_ASSERT(prev == priv_state(ticket, waiting));
+   (void)prev;
+   return true;
+}
+
+inline bool spin_queue_mutex::priv_take_ticket(boost::uint32_t &ticket, const ustime *deadline)
+{
+   const boost::uint32_t pid = boost::uint32_t(get_current_process_id());
+   spin_wait swait;
+   while(1){
+      const boost::uint32_t tail = atomic_read32(&m_tail);
+      const boost::uint32_t head = atomic_read32(&m_head);
+      if(boost::uint32_t(tail - head) >= num_slots){
+         //The queue is full, wait until the head ticket is passed
+         if(!this->priv_wait(&m_head, head, &m_head_sleepers, deadline)){
+            return false;
+         }
+         continue;
+      }
+      //The slot of the next ticket is free: claim it and then take the ticket
+      slot &s = this->priv_slot(tail);
+      const boost::uint32_t other = atomic_cas32(&s.m_pid, pid, 0u);
+      if(other == 0u){
+         atomic_write32(&s.m_state, priv_state(tail, waiting));
+         if(atomic_cas32(&m_tail, tail + 1u, tail) == tail){
+            ticket = tail;
+            return true;
+         }
+         //The tail was stale, the slot belongs to a later ticket
+         atomic_write32(&s.m_pid, 0u);
+      }
+      else if(atomic_read32(&m_tail) == tail && !is_process_alive(OS_process_id_t(other))){
+         //The process died after claiming the slot and before taking the ticket
+         atomic_cas32(&s.m_pid, 0u, other);
+      }
+      swait.yield();
+   }
+}
+
+inline bool spin_queue_mutex::priv_wait
+   (volatile boost::uint32_t *addr, boost::uint32_t old, volatile boost::uint32_t *sleepers, const ustime *deadline)
+{
+   //Wake up when the check period expires to verify the head of the queue
+   ustime end = microsec_clock<ustime>::universal_time();
+   if(deadline && !(end < *deadline)){
+      return false;
+   }
+   end += usduration_from_milliseconds(check_period_ms);
+   if(deadline && *deadline < end){
+      end = *deadline;
+   }
+   if(!ipc_atomic_wait(addr, old, sleepers, end)){
+      this->priv_recover_head();
+   }
+   return true;
+}
+
+inline void spin_queue_mutex::priv_pass(boost::uint32_t ticket)
+{
+   while(1){
+      //Release the slot before the queue can grow over it
+      atomic_write32(&this->priv_slot(ticket).m_pid, 0u);
+      const boost::uint32_t next = ticket + 1u;
+      atomic_write32(&m_head, next);
+      ipc_atomic_notify_all(&m_head, &m_head_sleepers);
+      slot &s = this->priv_slot(next);
+      atomic_write32(&s.m_grant, next);
+      //Several waiters might share the slot
+      ipc_atomic_notify_all(&s.m_grant, &s.m_sleepers);
+      //Skip tickets whose waiters have timed out
+      if(atomic_cas32(&s.m_state, priv_state(next, skipped), priv_state(next, abandoned))
+            != priv_state(next, abandoned)){
+         break;
+      }
+      ticket = next;
+   }
+}
+
+inline void spin_queue_mutex::priv_recover_head()
+{
+   const boost::uint32_t head = atomic_read32(&m_head);
+   //The head ticket must be taken, so that its slot holds its process
+   if(atomic_read32(&m_tail) == head){
+      return;
+   }
+   slot &s = this->priv_slot(head);
+   const boost::uint32_t pid = atomic_read32(&s.m_pid);
+   if(pid && atomic_read32(&s.m_grant) == head &&
+      atomic_read32(&s.m_state) == priv_state(head, waiting) &&
+      !is_process_alive(OS_process_id_t(pid)) &&
+      atomic_cas32(&s.m_state, priv_state(head, skipped), priv_state(head, waiting)) == priv_state(head, waiting) &&
+      atomic_read32(&m_head) == head){
+      //The process died before taking the ownership
+      this->priv_pass(head);
+   }
+}
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_DETAIL_SPIN_QUEUE_MUTEX_HPP
@@ -45,8 +45,30 @@ class spin_semaphore
    bool try_wait();
    template<class TimePoint> bool timed_wait(const TimePoint &abs_time);
 
+   void post(unsigned int n);
+   void wait(unsigned int n);
+   bool try_wait(unsigned int n);
+   template<class TimePoint> bool timed_wait(unsigned int n, const TimePoint &abs_time);
+
 //   int get_count() const;
    private:
+   //Maps the lock interface to the acquisition of n units
+   struct wait_n_wrapper
+   {
+      wait_n_wrapper(spin_semaphore &sem, unsigned int n)
+         :  m_sem(sem), m_n(n)
+      {}
+
+      void lock()
+      {  m_sem.wait(m_n);  }
+
+      bool try_lock()
+      {  return m_sem.try_wait(m_n);  }
+
+      spin_semaphore &m_sem;
+      unsigned int m_n;
+   };
+
    volatile boost::uint32_t m_count;
 };
 
@@ -80,6 +102,38 @@ inline bool spin_semaphore::timed_wait(const TimePoint &abs_time)
    return ipcdetail::try_based_timed_lock(lw, abs_time);
 }
 
+inline void spin_semaphore::post(unsigned int n)
+{
+   ipcdetail::atomic_add32(&m_count, boost::uint32_t(n));
+}
+
+inline void spin_semaphore::wait(unsigned int n)
+{
+   wait_n_wrapper w(*this, n);
+   ipcdetail::try_based_lock(w);
+}
+
+inline bool spin_semaphore::try_wait(unsigned int n)
+{
+   //All or nothing: the count is only decremented if n units are available
+   boost::uint32_t c = ipcdetail::atomic_read32(&m_count);
+   while(c >= n){
+      const boost::uint32_t prev = ipcdetail::atomic_cas32(&m_count, c - boost::uint32_t(n), c);
+      if(prev == c){
+         return true;
+      }
+      c = prev;
+   }
+   return false;
+}
+
+template<class TimePoint>
+inline bool spin_semaphore::timed_wait(unsigned int n, const TimePoint &abs_time)
+{
+   wait_n_wrapper w(*this, n);
+   return ipcdetail::try_based_timed_lock(w, abs_time);
+}
+
 //inline int spin_semaphore::get_count() const
 //{
    //return (int)ipcdetail::atomic_read32(&m_count);
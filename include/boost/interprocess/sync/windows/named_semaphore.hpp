@@ -26,6 +26,7 @@
 #include <boost/interprocess/detail/interprocess_tester.hpp>
 #include <boost/interprocess/sync/windows/named_sync.hpp>
 #include <boost/interprocess/sync/windows/winapi_semaphore_wrapper.hpp>
+#include <boost/interprocess/sync/detail/common_algorithms.hpp>
 
 namespace boost {
 namespace interprocess {
@@ -63,6 +64,19 @@ class winapi_named_semaphore
    bool try_wait();
    template<class TimePoint> bool timed_wait(const TimePoint &abs_time);
 
+   void post(unsigned int n);
+
+   //Windows semaphores can only wait for a single unit,
+   //so multiple units are emulated (see common_algorithms.hpp)
+   void wait(unsigned int n)
+   {  semaphore_wait_n(*this, n);  }
+
+   bool try_wait(unsigned int n)
+   {  return semaphore_try_wait_n(*this, n);  }
+
+   template<class TimePoint> bool timed_wait(unsigned int n, const TimePoint &abs_time)
+   {  return semaphore_timed_wait_n(*this, n, abs_time);  }
+
    static bool remove(const char *name);
    static bool remove(const wchar_t *name);
 
@@ -190,6 +204,13 @@ inline winapi_named_semaphore::winapi_named_semaphore(open_only_t, const wchar_t
    m_named_sync.open_or_create(DoOpen, name, permissions(), callbacks);
 }
 
+inline void winapi_named_semaphore::post(unsigned int n)
+{
+   if(n){
+      m_sem_wrapper.post(static_cast<long>(n));
+   }
+}
+
 inline void winapi_named_semaphore::post()
 {
    m_sem_wrapper.post();
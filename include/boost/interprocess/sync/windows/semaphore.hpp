@@ -25,6 +25,7 @@
 #include <boost/interprocess/detail/windows_intermodule_singleton.hpp>
 #include <boost/interprocess/sync/windows/sync_utils.hpp>
 #include <boost/interprocess/sync/windows/winapi_semaphore_wrapper.hpp>
+#include <boost/interprocess/sync/detail/common_algorithms.hpp>
 #include <boost/interprocess/exceptions.hpp>
 #include <boost/assert.hpp>
 
@@ -47,6 +48,17 @@ class winapi_semaphore
    bool try_wait();
    template<class TimePoint> bool timed_wait(const TimePoint &abs_time);
 
+   //Windows semaphores can only wait for a single unit,
+   //so multiple units are emulated (see common_algorithms.hpp)
+   void wait(unsigned int n)
+   {  semaphore_wait_n(*this, n);  }
+
+   bool try_wait(unsigned int n)
+   {  return semaphore_try_wait_n(*this, n);  }
+
+   template<class TimePoint> bool timed_wait(unsigned int n, const TimePoint &abs_time)
+   {  return semaphore_timed_wait_n(*this, n, abs_time);  }
+
    private:
    const sync_id id_;
    const unsigned initial_count_;
@@ -0,0 +1,237 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/atomic_offset_ptr.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+//Explicit instantiation to detect compilation errors
+template class boost::interprocess::atomic_offset_ptr<int>;
+template class boost::interprocess::atomic_tagged_offset_ptr<int>;
+
+struct node
+{
+   offset_ptr<node> next;
+   unsigned value;
+};
+
+struct shared_data
+{
+   atomic_offset_ptr<int>  ptr;
+   int                     ints[2];
+};
+
+//Treiber stack whose head can be shared between processes
+class shared_stack
+{
+   typedef atomic_tagged_offset_ptr<node>::value_type head_t;
+
+   public:
+   void push(node *n)
+   {
+      head_t old = m_head.load(memory_order_relaxed);
+      do{
+         n->next = old.ptr;
+      } while(!m_head.compare_exchange_weak(old, head_t(n, old.tag + 1u), memory_order_release, memory_order_relaxed));
+   }
+
+   node *pop()
+   {
+      head_t old = m_head.load(memory_order_acquire);
+      while(old.ptr && !m_head.compare_exchange_weak(old, head_t(old.ptr->next.get(), old.tag + 1u), memory_order_acquire, memory_order_acquire)){}
+      return old.ptr;
+   }
+
+   atomic_tagged_offset_ptr<node> m_head;
+};
+
+static const unsigned NumThreads = 4u;
+static const unsigned NodesPerThread = 1000u;
+static const unsigned Iterations = 20000u;
+
+struct stack_worker
+{
+   explicit stack_worker(shared_stack &s)
+      : mp_stack(&s)
+   {}
+
+   void operator()()
+   {
+      //Pop and push back nodes, so that the same addresses are
+      //continuously reused and ABA situations are likely
+      for(unsigned i = 0; i != Iterations; ++i){
+         node *n = mp_stack->pop();
+         if(n){
+            mp_stack->push(n);
+         }
+      }
+   }
+
+   shared_stack *mp_stack;
+};
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+
+//Memory orders must not be ambiguous when both namespaces are used
+namespace both_namespaces {
+
+using namespace std;
+using namespace boost::interprocess;
+
+bool test_memory_order(atomic_offset_ptr<int> &p, int *v)
+{
+   memory_order order = memory_order_release;
+   p.store(v, order);
+   return p.load(std::memory_order_acquire) == v && p.load(memory_order_relaxed) == v;
+}
+
+}  //namespace both_namespaces {
+
+#endif   //#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+
+bool test_atomic_offset_ptr(managed_shared_memory &segment, managed_shared_memory &segment2)
+{
+   shared_data *d = segment.construct<shared_data>("data")();
+   atomic_offset_ptr<int> &p = d->ptr;
+   if(!p.is_lock_free() || p.load() != 0)
+      return false;
+
+   p.store(&d->ints[0]);
+   if(p.load() != &d->ints[0] || p != &d->ints[0])
+      return false;
+   if(p.exchange(&d->ints[1]) != &d->ints[0] || p.load() != &d->ints[1])
+      return false;
+
+   //Failed compare and exchange loads the current value
+   int *expected = &d->ints[0];
+   if(p.compare_exchange_strong(expected, 0) || expected != &d->ints[1])
+      return false;
+   if(!p.compare_exchange_strong(expected, 0) || p.load() != 0)
+      return false;
+   expected = 0;
+   if(!p.compare_exchange_weak(expected, &d->ints[0], memory_order_acq_rel, memory_order_acquire))
+      return false;
+   #if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+   if(!both_namespaces::test_memory_order(p, &d->ints[0]))
+      return false;
+   #endif
+
+   //The stored value is valid in a mapping placed at a different address
+   std::pair<shared_data*, std::size_t> other = segment2.find<shared_data>("data");
+   if(!other.first || (void*)other.first == (void*)d)
+      return false;
+   if(other.first->ptr.load() != &other.first->ints[0])
+      return false;
+   other.first->ptr = &other.first->ints[1];
+   if(p.load() != &d->ints[1])
+      return false;
+   p = 0;
+   if(other.first->ptr.load() != 0)
+      return false;
+
+   segment.destroy_ptr(d);
+   return true;
+}
+
+bool test_atomic_tagged_offset_ptr(managed_shared_memory &segment, managed_shared_memory &segment2)
+{
+   typedef atomic_tagged_offset_ptr<node>::value_type value_type;
+
+   shared_stack *s = segment.construct<shared_stack>("stack")();
+   if(!s->m_head.is_lock_free() || s->m_head.load() != value_type())
+      return false;
+
+   //The tag is part of the comparison
+   node *n = segment.construct<node>(anonymous_instance)();
+   value_type expected(0, 1u);
+   if(s->m_head.compare_exchange_strong(expected, value_type(n, 2u)) || expected != value_type(0, 0u))
+      return false;
+   if(!s->m_head.compare_exchange_strong(expected, value_type(n, 2u)) || s->m_head.load() != value_type(n, 2u))
+      return false;
+
+   //Tags wrap around
+   const value_type::tag_type max_tag = value_type::tag_type((1ul << atomic_tagged_offset_ptr<node>::tag_bits) - 1u);
+   if(s->m_head.exchange(value_type(n, max_tag)) != value_type(n, 2u))
+      return false;
+   expected = s->m_head.load();
+   if(expected.tag != max_tag || !s->m_head.compare_exchange_strong(expected, value_type(0, expected.tag + 1u)))
+      return false;
+   if(s->m_head.load() != value_type(0, 0u))
+      return false;
+   segment.destroy_ptr(n);
+
+   //Concurrent pushes and pops
+   node *nodes = segment.construct<node>(anonymous_instance)[NumThreads*NodesPerThread]();
+   for(unsigned i = 0; i != NumThreads*NodesPerThread; ++i){
+      nodes[i].value = i;
+      s->push(&nodes[i]);
+   }
+
+   ipcdetail::OS_thread_t threads[NumThreads];
+   for(unsigned i = 0; i != NumThreads; ++i){
+      //Half of the threads use the second mapping
+      shared_stack *ts = s;
+      if(i % 2u){
+         ts = segment2.find<shared_stack>("stack").first;
+      }
+      if(0 != ipcdetail::thread_launch(threads[i], stack_worker(*ts)))
+         return false;
+   }
+   for(unsigned i = 0; i != NumThreads; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+
+   //Every node must be in the stack exactly once
+   std::string seen(NumThreads*NodesPerThread, '\0');
+   while(node *p = s->pop()){
+      if(p < nodes || p >= nodes + NumThreads*NodesPerThread || seen[p->value])
+         return false;
+      seen[p->value] = 1;
+   }
+   if(seen.find('\0') != std::string::npos)
+      return false;
+
+   segment.destroy_ptr(nodes);
+   segment.destroy_ptr(s);
+   return true;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u*4u);
+      //A second mapping of the same segment, at a different address
+      managed_shared_memory segment2(open_only, shMemName);
+      if(!test_atomic_offset_ptr(segment, segment2) || !test_atomic_tagged_offset_ptr(segment, segment2)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      //All memory must have been returned
+      if(!segment.all_memory_deallocated()){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
@@ -0,0 +1,210 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/containers/bplus_tree_map.hpp>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef managed_shared_memory::segment_manager                    segment_manager_t;
+typedef bplus_tree_map<int, unsigned, segment_manager_t>          map_t;
+//Small pages to test deep trees
+typedef bplus_tree_map<int, int, segment_manager_t, std::greater<int>, 128u> small_map_t;
+
+//Explicit instantiation to detect compilation errors
+template class boost::interprocess::bplus_tree_map<int, unsigned, segment_manager_t>;
+template class boost::interprocess::bplus_tree_map<int, int, segment_manager_t, std::greater<int>, 128u>;
+
+template<class Map, class StdMap>
+bool check_equal(const Map &m, const StdMap &sm)
+{
+   if(m.size() != sm.size() || m.empty() != sm.empty())
+      return false;
+   typename Map::const_iterator it = m.begin();
+   for(typename StdMap::const_iterator sit = sm.begin(); sit != sm.end(); ++sit, ++it){
+      if(it == m.end() || it->first != sit->first || it->second != sit->second)
+         return false;
+   }
+   if(it != m.end())
+      return false;
+   //Backwards iteration
+   for(typename StdMap::const_reverse_iterator sit = sm.rbegin(); sit != sm.rend(); ++sit){
+      --it;
+      if(it->first != sit->first)
+         return false;
+   }
+   return it == m.begin();
+}
+
+bool test_basic(managed_shared_memory &segment)
+{
+   map_t *m = segment.find_or_construct<map_t>("map")(segment.get_segment_manager());
+   if(!m->empty() || m->begin() != m->end() || m->height() != 1u || m->page_count() != 1u)
+      return false;
+   if(m->find(1) != m->end() || m->erase(1) != 0u || m->lower_bound(1) != m->end())
+      return false;
+
+   //Random insertions and erasures compared with std::map
+   std::map<int, unsigned> sm;
+   std::srand(0);
+   for(unsigned i = 0; i != 50000u; ++i){
+      const int k = std::rand() % 20000;
+      const std::pair<map_t::iterator, bool> r = m->insert(k, i);
+      if(r.second != sm.insert(std::pair<const int, unsigned>(k, i)).second || r.first->first != k)
+         return false;
+      if(i % 3u == 0u){
+         const int e = std::rand() % 20000;
+         if(m->erase(e) != sm.erase(e))
+            return false;
+      }
+   }
+   if(!check_equal(*m, sm) || m->height() < 2u)
+      return false;
+   if(m->insert_or_assign(sm.begin()->first, 7u) || m->find(sm.begin()->first)->second != 7u)
+      return false;
+   sm.begin()->second = 7u;
+
+   //Lookups
+   for(int k = -1; k != 20001; ++k){
+      std::map<int, unsigned>::iterator sit = sm.lower_bound(k);
+      map_t::iterator it = m->lower_bound(k);
+      if((sit == sm.end()) != (it == m->end()) || (it != m->end() && it->first != sit->first))
+         return false;
+      sit = sm.upper_bound(k);
+      it = m->upper_bound(k);
+      if((sit == sm.end()) != (it == m->end()) || (it != m->end() && it->first != sit->first))
+         return false;
+      if(m->contains(k) != (sm.count(k) != 0u) || m->count(k) != sm.count(k))
+         return false;
+   }
+
+   //Erasing all elements releases all leaves but the root
+   for(int k = 0; k != 20000; ++k){
+      if(m->erase(k) != sm.erase(k))
+         return false;
+   }
+   if(!m->empty() || m->height() != 1u || m->page_count() != 1u || !check_equal(*m, sm))
+      return false;
+
+   //Reuse after clear
+   for(int k = 0; k != 1000; ++k){
+      m->insert(k, unsigned(k));
+   }
+   m->clear();
+   if(!m->empty() || m->page_count() != 1u || m->begin() != m->end() || !m->insert(5, 5u).second)
+      return false;
+   segment.destroy_ptr(m);
+   return true;
+}
+
+bool test_bulk_load(managed_shared_memory &segment)
+{
+   const std::size_t n = 100000u;
+   std::vector< std::pair<int, unsigned> > v;
+   for(std::size_t i = 0; i != n; ++i){
+      v.push_back(std::pair<int, unsigned>(int(i*2u), unsigned(i)));
+   }
+
+   map_t *m = segment.construct<map_t>(anonymous_instance)(segment.get_segment_manager());
+   m->bulk_load(v.begin(), v.end());
+   //Leaves are filled completely
+   const std::size_t leaves = (n - 1u)/map_t::leaf_capacity + 1u;
+   if(m->size() != n || m->page_count() > leaves + leaves/(map_t::inner_capacity/2u) + 2u)
+      return false;
+   std::map<int, unsigned> sm(v.begin(), v.end());
+   if(!check_equal(*m, sm))
+      return false;
+
+   //Range scan
+   map_t::const_iterator it = m->lower_bound(1001), itend = m->upper_bound(2000);
+   unsigned count = 0;
+   for(; it != itend; ++it, ++count){
+      if(it->first != int(1002u + count*2u))
+         return false;
+   }
+   if(count != 500u)
+      return false;
+
+   //Insertions between loaded keys split full leaves
+   for(std::size_t i = 0; i < n; i += 7u){
+      if(!m->insert(int(i*2u + 1u), 0u).second)
+         return false;
+      sm.insert(std::pair<const int, unsigned>(int(i*2u + 1u), 0u));
+   }
+   if(!check_equal(*m, sm))
+      return false;
+
+   //Append more sorted elements
+   std::vector< std::pair<int, unsigned> > v2;
+   for(std::size_t i = 0; i != 1000u; ++i){
+      v2.push_back(std::pair<int, unsigned>(int(n*2u + i), 1u));
+   }
+   m->bulk_load(v2.begin(), v2.end());
+   sm.insert(v2.begin(), v2.end());
+   if(!check_equal(*m, sm))
+      return false;
+   segment.destroy_ptr(m);
+   return true;
+}
+
+bool test_small_pages(managed_shared_memory &segment)
+{
+   small_map_t *m = segment.construct<small_map_t>(anonymous_instance)(segment.get_segment_manager());
+   std::map<int, int, std::greater<int> > sm;
+   for(int i = 0; i != 20000; ++i){
+      const int k = (i*7919) % 20011;
+      m->insert(k, -k);
+      sm.insert(std::pair<const int, int>(k, -k));
+   }
+   if(m->height() < 4u || !check_equal(*m, sm))
+      return false;
+   for(int i = 0; i < 20011; i += 2){
+      if(m->erase(i) != sm.erase(i))
+         return false;
+   }
+   if(!check_equal(*m, sm))
+      return false;
+   segment.destroy_ptr(m);
+   return true;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u*128u);
+      if(!test_basic(segment) || !test_bulk_load(segment) || !test_small_pages(segment)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      //All memory must have been returned
+      if(!segment.all_memory_deallocated()){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
@@ -0,0 +1,347 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/ipc/broadcast_ring.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef managed_shared_memory::segment_manager                    segment_manager_t;
+typedef broadcast_ring<segment_manager_t>                         ring_t;
+typedef broadcast_ring<segment_manager_t, 4u>                     small_ring_t;
+
+//Explicit instantiation to detect compilation errors
+template class boost::interprocess::broadcast_ring<segment_manager_t>;
+template class boost::interprocess::broadcast_ring<segment_manager_t, 4u>;
+
+static const unsigned NumReaders = 3u;
+static const unsigned NumMessages = 20000u;
+
+bool test_basic(managed_shared_memory &segment)
+{
+   ring_t *r = segment.find_or_construct<ring_t>("ring")(segment.get_segment_manager(), 8u, 100u);
+   if(r->num_slots() != 8u || r->max_msg_size() != 100u || r->sequence() != 0u || r->num_readers() != 0u)
+      return false;
+
+   //Without readers, messages are discarded
+   for(unsigned i = 0; i != 20u; ++i){
+      if(!r->try_send(&i, sizeof(i)))
+         return false;
+   }
+
+   ring_t::reader a(*r), b(*r);
+   if(r->num_readers() != 2u || a.available() != 0u)
+      return false;
+   char buf[100];
+   std::size_t recvd = 0;
+   if(a.try_receive(buf, sizeof(buf), recvd) || a.try_peek(recvd))
+      return false;
+
+   //Every reader receives every message
+   for(unsigned i = 0; i != 8u; ++i){
+      if(!r->try_send(&i, sizeof(i)))
+         return false;
+   }
+   //The ring is full until the slowest reader receives
+   if(r->try_send(buf, 1u) || a.available() != 8u)
+      return false;
+   for(unsigned i = 0; i != 8u; ++i){
+      unsigned v = 0;
+      if(!a.try_receive(&v, sizeof(v), recvd) || recvd != sizeof(v) || v != i)
+         return false;
+   }
+   if(r->try_send(buf, 1u))
+      return false;
+   //In place read
+   const void *p = b.try_peek(recvd);
+   if(!p || recvd != sizeof(unsigned) || *static_cast<const unsigned*>(p) != 0u || !b.release())
+      return false;
+   if(!r->try_send(buf, 0u) || r->try_send(buf, 0u))
+      return false;
+
+   //Oversized messages
+   bool thrown = false;
+   BOOST_INTERPROCESS_TRY{  r->try_send(buf, 101u);  }
+   BOOST_INTERPROCESS_CATCH(interprocess_exception &e){  thrown = e.get_error_code() == size_error;  } BOOST_INTERPROCESS_CATCH_END
+   if(!thrown)
+      return false;
+   thrown = false;
+   BOOST_INTERPROCESS_TRY{  b.try_receive(buf, 1u, recvd);  }
+   BOOST_INTERPROCESS_CATCH(interprocess_exception &e){  thrown = e.get_error_code() == size_error;  } BOOST_INTERPROCESS_CATCH_END
+   if(!thrown)
+      return false;
+
+   //Detached readers don't apply backpressure
+   {
+      ring_t::reader c(*r);
+      if(r->num_readers() != 3u)
+         return false;
+   }
+   if(r->num_readers() != 2u || a.lost() != 0u || b.lost() != 0u)
+      return false;
+   segment.destroy_ptr(r);
+
+   //Reader slots are limited
+   small_ring_t *sr = segment.construct<small_ring_t>(anonymous_instance)(segment.get_segment_manager(), 2u, 8u);
+   {
+      small_ring_t::reader r0(*sr), r1(*sr), r2(*sr), r3(*sr);
+      thrown = false;
+      BOOST_INTERPROCESS_TRY{  small_ring_t::reader r4(*sr);  }
+      BOOST_INTERPROCESS_CATCH(interprocess_exception &){  thrown = true;  } BOOST_INTERPROCESS_CATCH_END
+      if(!thrown)
+         return false;
+   }
+   small_ring_t::reader r5(*sr);
+   segment.destroy_ptr(sr);
+   return true;
+}
+
+bool test_overwrite(managed_shared_memory &segment)
+{
+   ring_t *r = segment.construct<ring_t>(anonymous_instance)
+      (segment.get_segment_manager(), 4u, sizeof(unsigned), ring_t::overwrite_oldest);
+   ring_t::reader a(*r);
+   //The writer never waits and lapped readers skip lost messages
+   for(unsigned i = 0; i != 10u; ++i){
+      if(!r->try_send(&i, sizeof(i)))
+         return false;
+   }
+   unsigned v = 0;
+   std::size_t recvd = 0;
+   if(!a.try_receive(&v, sizeof(v), recvd) || v != 6u || a.lost() != 6u)
+      return false;
+
+   //A message overwritten while being read in place is reported
+   const void *p = a.try_peek(recvd);
+   if(!p || *static_cast<const unsigned*>(p) != 7u)
+      return false;
+   for(unsigned i = 10u; i != 14u; ++i){
+      r->send(&i, sizeof(i));
+   }
+   if(a.release() || a.lost() != 7u)
+      return false;
+   if(!a.try_receive(&v, sizeof(v), recvd) || v != 10u || a.lost() != 9u)
+      return false;
+   segment.destroy_ptr(r);
+   return true;
+}
+
+struct receiver
+{
+   receiver(ring_t::reader &rd, bool &ok)
+      : mp_reader(&rd), mp_ok(&ok)
+   {}
+
+   void operator()()
+   {
+      unsigned msg[4];
+      std::size_t recvd = 0;
+      for(unsigned i = 0; i != NumMessages; ++i){
+         //Alternate copies and in place reads
+         if(i % 2u){
+            mp_reader->receive(msg, sizeof(msg), recvd);
+         }
+         else{
+            const void *p;
+            spin_wait swait;
+            while(!(p = mp_reader->try_peek(recvd))){
+               swait.yield();
+            }
+            std::memcpy(msg, p, recvd);
+            if(!mp_reader->release()){
+               *mp_ok = false;
+            }
+         }
+         if(recvd != (i % 4u + 1u)*sizeof(unsigned) || msg[0] != i ||
+            (i % 4u && msg[i % 4u] != ~i)){
+            *mp_ok = false;
+         }
+      }
+      if(mp_reader->lost() != 0u){
+         *mp_ok = false;
+      }
+   }
+
+   ring_t::reader *mp_reader;
+   bool *mp_ok;
+};
+
+bool test_threads(managed_shared_memory &segment, managed_shared_memory &segment2)
+{
+   ring_t *r = segment.construct<ring_t>("ring")(segment.get_segment_manager(), 16u, 4u*sizeof(unsigned));
+   ring_t *r2 = segment2.find<ring_t>("ring").first;
+   //Readers are attached before the first message is sent
+   ring_t::reader *readers[NumReaders];
+   ipcdetail::OS_thread_t threads[NumReaders];
+   bool results[NumReaders];
+   for(unsigned i = 0; i != NumReaders; ++i){
+      //Some readers use the second mapping
+      readers[i] = new ring_t::reader(i % 2u ? *r2 : *r);
+      results[i] = true;
+   }
+   for(unsigned i = 0; i != NumReaders; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], receiver(*readers[i], results[i])))
+         return false;
+   }
+   for(unsigned i = 0; i != NumMessages; ++i){
+      unsigned msg[4];
+      const unsigned n = i % 4u + 1u;
+      msg[0] = i;
+      for(unsigned j = 1u; j != n; ++j){
+         msg[j] = ~i;
+      }
+      r->send(msg, n*sizeof(unsigned));
+   }
+   bool ok = true;
+   for(unsigned i = 0; i != NumReaders; ++i){
+      ipcdetail::thread_join(threads[i]);
+      ok = ok && results[i];
+      delete readers[i];
+   }
+   ok = ok && r->sequence() == NumMessages;
+   segment.destroy_ptr(r);
+   return ok;
+}
+
+struct overwriting_sender
+{
+   overwriting_sender(ring_t &r, volatile boost::uint32_t &done)
+      : mp_ring(&r), mp_done(&done)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != NumMessages; ++i){
+         unsigned msg[8];
+         const unsigned n = i % 8u + 1u;
+         for(unsigned j = 0; j != n; ++j){
+            msg[j] = i;
+         }
+         mp_ring->send(msg, n*sizeof(unsigned));
+      }
+      ipcdetail::atomic_write32(mp_done, 1u);
+   }
+
+   ring_t *mp_ring;
+   volatile boost::uint32_t *mp_done;
+};
+
+//A reader lapped by a writer that never waits gets whole messages or loses them
+bool test_overwrite_threads(managed_shared_memory &segment)
+{
+   ring_t *r = segment.construct<ring_t>(anonymous_instance)
+      (segment.get_segment_manager(), 4u, 8u*sizeof(unsigned), ring_t::overwrite_oldest);
+   bool ok = true;
+   {
+      ring_t::reader rd(*r);
+      volatile boost::uint32_t done = 0u;
+      ipcdetail::OS_thread_t thread;
+      if(0 != ipcdetail::thread_launch(thread, overwriting_sender(*r, done)))
+         return false;
+      unsigned received = 0u, last = 0u;
+      for(;;){
+         const bool finished = ipcdetail::atomic_read32(&done) != 0u;
+         unsigned msg[8];
+         std::size_t recvd = 0;
+         while(rd.try_receive(msg, sizeof(msg), recvd)){
+            const unsigned n = msg[0] % 8u + 1u;
+            ok = ok && recvd == n*sizeof(unsigned) && (!received || msg[0] > last);
+            for(unsigned j = 1u; j < n && ok; ++j){
+               ok = msg[j] == msg[0];
+            }
+            last = msg[0];
+            ++received;
+         }
+         if(finished)
+            break;
+         ipcdetail::thread_yield();
+      }
+      ipcdetail::thread_join(thread);
+      ok = ok && received + rd.lost() == NumMessages;
+   }
+   segment.destroy_ptr(r);
+   return ok;
+}
+
+bool test_dead_process(managed_shared_memory &segment, const char *argv0, const char *shm_name)
+{
+   ring_t *r = segment.construct<ring_t>("ring")(segment.get_segment_manager(), 4u, sizeof(unsigned));
+   std::string s(argv0);
+   s += " child ";
+   s += shm_name;
+   if(0 != std::system(s.c_str()))
+      return false;
+
+   //The child died without detaching its reader, the writer releases it when the ring is full
+   if(r->num_readers() != 1u)
+      return false;
+   for(unsigned i = 0; i != 10u; ++i){
+      if(!r->try_send(&i, sizeof(i)))
+         return false;
+   }
+   if(r->num_readers() != 0u)
+      return false;
+   segment.destroy_ptr(r);
+   return true;
+}
+
+//Never destroyed, to simulate a crash
+ring_t::reader *child_reader;
+
+int child_main(const char *shm_name)
+{
+   managed_shared_memory segment(open_only, shm_name);
+   ring_t *r = segment.find<ring_t>("ring").first;
+   if(!r)
+      return 1;
+   child_reader = new ring_t::reader(*r);
+   return 0;
+}
+
+int main (int argc, char *argv[])
+{
+   if(argc > 2){
+      return child_main(argv[2]);
+   }
+
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u*16u);
+      //A second mapping of the same segment, at a different address
+      managed_shared_memory segment2(open_only, shMemName);
+      if(!test_basic(segment) || !test_overwrite(segment) || !test_threads(segment, segment2) ||
+         !test_overwrite_threads(segment) ||
+         !test_dead_process(segment, argv[0], shMemName)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      //All memory must have been returned
+      if(!segment.all_memory_deallocated()){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/cache_aligned.hpp>
+#include <boost/interprocess/allocators/cache_aligned_allocator.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/container/vector.hpp>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef managed_shared_memory::segment_manager segment_manager_t;
+
+//Explicit instantiation to detect compilation errors
+template class boost::interprocess::cache_aligned_allocator<int, segment_manager_t>;
+template class boost::interprocess::cache_aligned<int>;
+
+static const std::size_t CacheLine = BOOST_INTERPROCESS_CACHE_LINE_SIZE;
+
+inline bool is_cache_aligned(const void *p, std::size_t alignment = CacheLine)
+{  return 0u == (reinterpret_cast<std::size_t>(p) % alignment);  }
+
+struct counter_pair
+{
+   counter_pair(unsigned a, unsigned b)
+      : first(a), second(b)
+   {}
+
+   unsigned first;
+   unsigned second;
+};
+
+bool test_cache_aligned(managed_shared_memory &segment)
+{
+   typedef cache_aligned<interprocess_mutex> aligned_mutex_t;
+   typedef cache_aligned<unsigned>           aligned_counter_t;
+   typedef cache_aligned<counter_pair, 256u> aligned_pair_t;
+
+   if(sizeof(aligned_counter_t) != CacheLine || aligned_counter_t::padded_size != CacheLine)
+      return false;
+   if(aligned_pair_t::alignment != 256u || sizeof(aligned_pair_t) != 256u)
+      return false;
+
+   //Interleave small allocations to make sure alignment is not accidental
+   const std::size_t NumMutexes = 5u;
+   aligned_mutex_t *mutexes[NumMutexes];
+   char *fillers[NumMutexes];
+   for(std::size_t i = 0; i != NumMutexes; ++i){
+      fillers[i] = segment.construct<char>(anonymous_instance)[i+1]();
+      mutexes[i] = segment.construct<aligned_mutex_t>(anonymous_instance)();
+      if(!is_cache_aligned(mutexes[i]))
+         return false;
+      scoped_lock<interprocess_mutex> lck(mutexes[i]->get());
+   }
+
+   //Named array of per-process slots, each one in its own cache line
+   const std::size_t NumSlots = 7u;
+   aligned_counter_t *slots = segment.construct<aligned_counter_t>("slots")[NumSlots](3u);
+   for(std::size_t i = 0; i != NumSlots; ++i){
+      if(!is_cache_aligned(&slots[i]) || *slots[i] != 3u)
+         return false;
+      *slots[i] = unsigned(i);
+   }
+   if((std::size_t)((char*)&slots[1] - (char*)&slots[0]) != CacheLine)
+      return false;
+
+   std::pair<aligned_counter_t*, std::size_t> found = segment.find<aligned_counter_t>("slots");
+   if(found.first != slots || found.second != NumSlots || *found.first[NumSlots-1] != NumSlots-1)
+      return false;
+
+   //Several constructor arguments and custom alignment
+   aligned_pair_t *pair = segment.construct<aligned_pair_t>("pair")(1u, 2u);
+   if(!is_cache_aligned(pair, 256u) || (*pair)->first != 1u || (**pair).second != 2u)
+      return false;
+
+   for(std::size_t i = 0; i != NumMutexes; ++i){
+      segment.destroy_ptr(mutexes[i]);
+      segment.destroy_ptr(fillers[i]);
+   }
+   if(!segment.destroy<aligned_counter_t>("slots") || !segment.destroy<aligned_pair_t>("pair"))
+      return false;
+   return true;
+}
+
+bool test_cache_aligned_allocator(managed_shared_memory &segment)
+{
+   typedef cache_aligned_allocator<int, segment_manager_t> allocator_t;
+   typedef boost::container::vector<int, allocator_t> vector_t;
+
+   allocator_t a(segment.get_segment_manager());
+   //Allocation sizes are padded to the cache line
+   for(std::size_t n = 1u; n < 100u; n += 7u){
+      allocator_t::pointer p1 = a.allocate(n);
+      allocator_t::pointer p2 = a.allocate(1u);
+      if(!is_cache_aligned(ipcdetail::to_raw_pointer(p1)) || !is_cache_aligned(ipcdetail::to_raw_pointer(p2)))
+         return false;
+      //Blocks must not share a cache line
+      const char *b1 = (const char*)ipcdetail::to_raw_pointer(p1);
+      const char *b2 = (const char*)ipcdetail::to_raw_pointer(p2);
+      const std::size_t padded = ((n*sizeof(int) - 1u)/CacheLine + 1u)*CacheLine;
+      if(b2 > b1 && (std::size_t)(b2 - b1) < padded)
+         return false;
+      a.deallocate(p2, 1u);
+      a.deallocate(p1, n);
+   }
+
+   vector_t *v = segment.construct<vector_t>("vector")(segment.get_segment_manager());
+   for(int i = 0; i != 1000; ++i){
+      v->push_back(i);
+      if(!is_cache_aligned(v->data()))
+         return false;
+   }
+   for(int i = 0; i != 1000; ++i){
+      if((*v)[std::size_t(i)] != i)
+         return false;
+   }
+
+   //Rebound allocators keep the alignment
+   typedef allocator_t::rebind<char>::other char_allocator_t;
+   char_allocator_t ca(a);
+   char_allocator_t::pointer cp = ca.allocate(1u);
+   if(!is_cache_aligned(ipcdetail::to_raw_pointer(cp)) || ca != char_allocator_t(a))
+      return false;
+   ca.deallocate(cp, 1u);
+
+   segment.destroy_ptr(v);
+   return true;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u*4u);
+      if(!test_cache_aligned(segment) || !test_cache_aligned_allocator(segment)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      //All memory must have been returned
+      if(!segment.all_memory_deallocated()){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
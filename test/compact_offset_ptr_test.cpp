@@ -0,0 +1,243 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/compact_offset_ptr.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/indexes/iset_index.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/detail/type_traits.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/container/list.hpp>
+#include <boost/container/map.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/container/string.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <functional>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+struct self_node
+{
+   compact_offset_ptr<self_node> next;
+   int value;
+};
+
+class Base
+{
+   int padding;
+   public:
+   Base() : padding(0){}
+   virtual ~Base(){}
+};
+
+class Base2
+{
+   int padding;
+   public:
+   Base2() : padding(0){}
+   virtual ~Base2(){}
+};
+
+class Derived
+   : public Base, public Base2
+{};
+
+typedef rbtree_best_fit<mutex_family, compact_offset_ptr<void> >  compact_mem_algo_t;
+typedef basic_managed_shared_memory
+   <char, compact_mem_algo_t, iset_index>                         compact_managed_shm_t;
+typedef compact_managed_shm_t::segment_manager                    segment_manager_t;
+
+void test_types_and_conversions(compact_managed_shm_t &segment)
+{
+   typedef compact_offset_ptr<int>        pint_t;
+   typedef compact_offset_ptr<const int>  pcint_t;
+   typedef compact_offset_ptr<void>       pvoid_t;
+
+   BOOST_INTERPROCESS_STATIC_ASSERT(sizeof(pint_t) == 4u);
+   BOOST_INTERPROCESS_STATIC_ASSERT((ipcdetail::is_same<pint_t::element_type, int>::value));
+   BOOST_INTERPROCESS_STATIC_ASSERT((ipcdetail::is_same<pcint_t::value_type, int>::value));
+   BOOST_INTERPROCESS_STATIC_ASSERT((ipcdetail::is_same
+      <boost::intrusive::pointer_traits<pint_t>::rebind_pointer<char>::type, compact_offset_ptr<char> >::value));
+
+   //Pointees must be placed in the segment
+   int *dummy_int = segment.construct<int>(anonymous_instance)[4](0);
+   for(int i = 0; i != 4; ++i){
+      dummy_int[i] = i;
+   }
+   pint_t pint(&dummy_int[1]);
+   BOOST_TEST(pint.get() == &dummy_int[1]);
+   pcint_t pcint(pint);
+   BOOST_TEST(pcint.get() == &dummy_int[1]);
+   pcint = &dummy_int[2];
+   BOOST_TEST(*pcint == 2);
+   pvoid_t pvoid(pint);
+   BOOST_TEST(pvoid.get() == &dummy_int[1]);
+   BOOST_TEST(static_cast<pint_t>(pvoid) == pint);
+   BOOST_TEST(static_pointer_cast<int>(pvoid) == pint);
+   BOOST_TEST(const_pointer_cast<int>(pcint).get() == &dummy_int[2]);
+   //Unaligned void pointers
+   pvoid = reinterpret_cast<char*>(&dummy_int[1]) + 1;
+   BOOST_TEST(pvoid.get() == reinterpret_cast<char*>(&dummy_int[1]) + 1);
+
+   //Null and self references are different
+   pint_t pnull;
+   BOOST_TEST(!pnull && pnull.get() == 0 && pnull == pint_t(0));
+   self_node *n = segment.construct<self_node>(anonymous_instance)();
+   n->next = n;
+   n->value = 1;
+   BOOST_TEST(n->next && n->next.get() == n && n->next->value == 1);
+   n->next = 0;
+   BOOST_TEST(!n->next);
+
+   //Pointer adjustment with multiple inheritance
+   Derived *d = segment.construct<Derived>(anonymous_instance)();
+   compact_offset_ptr<Derived> pd(d);
+   compact_offset_ptr<Base2> pb2(pd);
+   BOOST_TEST(pb2.get() == static_cast<Base2*>(d));
+   BOOST_TEST(static_pointer_cast<Derived>(pb2) == pd);
+   BOOST_TEST(dynamic_pointer_cast<Derived>(pb2) == pd);
+   pb2 = compact_offset_ptr<Derived>();
+   BOOST_TEST(!pb2);
+
+   segment.destroy_ptr(d);
+   segment.destroy_ptr(n);
+   segment.destroy_ptr(dummy_int);
+}
+
+void test_arithmetic_and_comparison(compact_managed_shm_t &segment)
+{
+   typedef compact_offset_ptr<int> pint_t;
+   int *arr = segment.construct<int>(anonymous_instance)[10](0);
+   pint_t p(&arr[0]);
+   pint_t q(&arr[9]);
+   BOOST_TEST(q - p == 9);
+   BOOST_TEST(p < q && p <= q && q > p && q >= p && p != q);
+   ++p;
+   BOOST_TEST(p.get() == &arr[1]);
+   p++;
+   BOOST_TEST(p.get() == &arr[2]);
+   p += 5;
+   BOOST_TEST(p.get() == &arr[7]);
+   p -= 3;
+   BOOST_TEST(p.get() == &arr[4]);
+   --p;
+   p--;
+   BOOST_TEST(p.get() == &arr[2]);
+   BOOST_TEST((p + 2).get() == &arr[4] && (2 + p).get() == &arr[4] && (p - 2).get() == &arr[0]);
+   BOOST_TEST(&p[3] == &arr[5]);
+   BOOST_TEST(p == &arr[2] && &arr[2] == p);
+   swap(p, q);
+   BOOST_TEST(p.get() == &arr[9] && q.get() == &arr[2]);
+   BOOST_TEST(pint_t::pointer_to(arr[3]).get() == &arr[3]);
+   segment.destroy_ptr(arr);
+}
+
+bool test_managed_segment(compact_managed_shm_t &segment)
+{
+   typedef allocator<int, segment_manager_t>                                  int_alloc_t;
+   typedef boost::container::list<int, int_alloc_t>                           list_t;
+   typedef std::pair<const int, int>                                          pair_t;
+   typedef allocator<pair_t, segment_manager_t>                               pair_alloc_t;
+   typedef boost::container::map<int, int, std::less<int>, pair_alloc_t>      map_t;
+   typedef allocator<char, segment_manager_t>                                 char_alloc_t;
+   typedef boost::container::basic_string<char, std::char_traits<char>, char_alloc_t> string_t;
+   typedef boost::container::vector<string_t, allocator<string_t, segment_manager_t> > string_vector_t;
+
+   BOOST_INTERPROCESS_STATIC_ASSERT(sizeof(int_alloc_t::pointer) == 4u);
+
+   list_t *l = segment.construct<list_t>("list")(segment.get_segment_manager());
+   map_t *m = segment.construct<map_t>("map")(std::less<int>(), segment.get_segment_manager());
+   string_vector_t *v = segment.construct<string_vector_t>("vector")(segment.get_segment_manager());
+   const int NumElements = 1000;
+   for(int i = 0; i != NumElements; ++i){
+      l->push_back(i);
+      m->insert(pair_t((i*7919) % NumElements, i));
+      v->emplace_back("a long string to avoid the small string optimization", segment.get_segment_manager());
+   }
+   if(l->size() != std::size_t(NumElements) || m->size() != std::size_t(NumElements) || !segment.check_sanity())
+      return false;
+   int expected = 0;
+   for(list_t::iterator it = l->begin(); it != l->end(); ++it, ++expected){
+      if(*it != expected)
+         return false;
+   }
+   expected = 0;
+   for(map_t::iterator it = m->begin(); it != m->end(); ++it, ++expected){
+      if(it->first != expected || (it->second*7919) % NumElements != expected)
+         return false;
+   }
+   if(segment.find<map_t>("map").first != m)
+      return false;
+   for(int i = 0; i < NumElements; i += 2){
+      m->erase(i);
+   }
+   if(m->size() != std::size_t(NumElements/2) || !segment.check_sanity())
+      return false;
+   segment.destroy<list_t>("list");
+   segment.destroy<map_t>("map");
+   segment.destroy<string_vector_t>("vector");
+   return segment.all_memory_deallocated() && segment.check_sanity();
+}
+
+void test_segment_base_checks(const char *shMemName)
+{
+   typedef ipcdetail::segment_base_hook< compact_offset_ptr<void> > hook_t;
+   static char buf[64];
+   //Segments that can't be addressed with 31 bit offsets are rejected
+   bool thrown = false;
+   BOOST_INTERPROCESS_TRY{  hook_t::check_size(buf, std::size_t(0x7FFFFFFFu) + 1u);  }
+   BOOST_INTERPROCESS_CATCH(interprocess_exception &e){  thrown = e.get_error_code() == size_error;  } BOOST_INTERPROCESS_CATCH_END
+   BOOST_TEST(thrown);
+   hook_t::check_size(buf, sizeof(buf));
+
+   {
+      compact_managed_shm_t segment(create_only, shMemName, 65536u);
+      //A second mapping of a segment with the same tag would rebase live pointers
+      thrown = false;
+      BOOST_INTERPROCESS_TRY{  compact_managed_shm_t segment2(open_only, shMemName);  }
+      BOOST_INTERPROCESS_CATCH(interprocess_exception &e){  thrown = e.get_error_code() == already_exists_error;  } BOOST_INTERPROCESS_CATCH_END
+      BOOST_TEST(thrown);
+      //The first segment is still usable
+      self_node *n = segment.construct<self_node>("node")();
+      n->next = n;
+      BOOST_TEST(n->next.get() == n);
+   }
+   //Once closed, the tag can be attached again
+   {
+      compact_managed_shm_t segment(open_only, shMemName);
+      self_node *n = segment.find<self_node>("node").first;
+      BOOST_TEST(n && n->next.get() == n);
+   }
+   shared_memory_object::remove(shMemName);
+}
+
+int main()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      test_segment_base_checks(shMemName);
+      compact_managed_shm_t segment(create_only, shMemName, 65536u*16u);
+      test_types_and_conversions(segment);
+      test_arithmetic_and_comparison(segment);
+      BOOST_TEST(test_managed_segment(segment));
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return ::boost::report_errors();
+}
@@ -0,0 +1,236 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/concurrent_hash_map.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef managed_shared_memory::segment_manager                    segment_manager_t;
+typedef allocator<char, segment_manager_t>                        char_allocator_t;
+typedef concurrent_hash_map<unsigned, unsigned, char_allocator_t> map_t;
+
+struct point
+{
+   int x, y;
+};
+
+struct point_hash
+{
+   std::size_t operator()(const point &p) const
+   {  return std::size_t(p.x)*31u + std::size_t(p.y);  }
+};
+
+struct point_equal
+{
+   bool operator()(const point &a, const point &b) const
+   {  return a.x == b.x && a.y == b.y;  }
+};
+
+typedef concurrent_hash_map<point, point, char_allocator_t, point_hash, point_equal, 4u> point_map_t;
+
+//Explicit instantiation to detect compilation errors
+template class boost::interprocess::concurrent_hash_map<unsigned, unsigned, char_allocator_t>;
+template class boost::interprocess::concurrent_hash_map<point, point, char_allocator_t, point_hash, point_equal, 4u>;
+
+static const unsigned NumThreads = 4u;
+static const unsigned KeysPerThread = 4000u;
+
+struct add
+{
+   explicit add(unsigned n) : m_n(n) {}
+   void operator()(unsigned &v) const {  v += m_n;  }
+   unsigned m_n;
+};
+
+struct check_value
+{
+   check_value(unsigned expected, bool &ok) : m_expected(expected), mp_ok(&ok) {}
+   void operator()(const unsigned &v) const {  *mp_ok = v == m_expected;  }
+   unsigned m_expected;
+   bool *mp_ok;
+};
+
+bool test_basic(managed_shared_memory &segment)
+{
+   map_t *m = segment.find_or_construct<map_t>("map")(segment.get_segment_manager());
+   if(!m->empty() || m->capacity() < map_t::num_stripes)
+      return false;
+
+   unsigned v = 0;
+   if(m->find(1u, v) || m->contains(1u) || m->erase(1u))
+      return false;
+   if(!m->insert(1u, 10u) || m->insert(1u, 11u) || !m->find(1u, v) || v != 10u)
+      return false;
+   if(m->insert_or_assign(1u, 12u) || !m->find(1u, v) || v != 12u)
+      return false;
+   if(!m->insert_or_assign(2u, 20u) || m->size() != 2u)
+      return false;
+
+   //In place modification
+   if(!m->visit(1u, add(3u)) || m->visit(3u, add(3u)))
+      return false;
+   bool ok = false;
+   if(!m->cvisit(1u, check_value(15u, ok)) || !ok)
+      return false;
+
+   if(!m->erase(1u) || m->erase(1u) || m->contains(1u) || !m->contains(2u) || m->size() != 1u)
+      return false;
+
+   //Growing several times keeps all elements
+   const std::size_t old_capacity = m->capacity();
+   for(unsigned i = 0; i != 10000u; ++i){
+      if(!m->insert(i + 100u, i))
+         return false;
+   }
+   if(m->capacity() <= old_capacity || m->size() != 10001u)
+      return false;
+   for(unsigned i = 0; i != 10000u; ++i){
+      if(!m->find(i + 100u, v) || v != i)
+         return false;
+   }
+
+   //Tombstones are purged when the table is rehashed
+   for(unsigned i = 0; i != 100000u; ++i){
+      if(!m->insert(i + 100000u, i) || !m->erase(i + 100000u))
+         return false;
+   }
+   if(m->size() != 10001u || !m->contains(2u))
+      return false;
+
+   m->clear();
+   if(!m->empty() || m->contains(2u) || m->contains(100u) || !m->insert(2u, 2u))
+      return false;
+   segment.destroy_ptr(m);
+
+   //User provided hash and comparison functions, initial capacity
+   point_map_t *pm = segment.construct<point_map_t>("point_map")(segment.get_segment_manager(), 1000u);
+   if(pm->capacity() < 1000u)
+      return false;
+   for(int i = 0; i != 1000; ++i){
+      const point k = { i, -i };
+      const point val = { -i, i };
+      if(!pm->insert(k, val))
+         return false;
+   }
+   for(int i = 0; i != 1000; ++i){
+      const point k = { i, -i };
+      point val;
+      if(!pm->find(k, val) || val.x != -i || val.y != i)
+         return false;
+   }
+   segment.destroy_ptr(pm);
+   return true;
+}
+
+struct worker
+{
+   worker(map_t &m, unsigned id, bool &ok)
+      : mp_map(&m), m_id(id), mp_ok(&ok)
+   {}
+
+   void operator()()
+   {
+      const unsigned base = m_id*KeysPerThread;
+      unsigned v = 0;
+      for(unsigned i = 0; i != KeysPerThread; ++i){
+         //Shared counter modified by all threads
+         mp_map->visit(0u, add(1u));
+         if(!mp_map->insert(base + i + 1u, i) || !mp_map->find(base + i + 1u, v) || v != i){
+            *mp_ok = false;
+         }
+         //Elements inserted before, possibly migrated since then
+         if(i && (!mp_map->find(base + i/2u + 1u, v) || v != i/2u)){
+            *mp_ok = false;
+         }
+      }
+      //Erase odd keys
+      for(unsigned i = 1u; i < KeysPerThread; i += 2u){
+         if(!mp_map->erase(base + i + 1u)){
+            *mp_ok = false;
+         }
+      }
+   }
+
+   map_t *mp_map;
+   unsigned m_id;
+   bool *mp_ok;
+};
+
+bool test_threads(managed_shared_memory &segment, managed_shared_memory &segment2)
+{
+   map_t *m = segment.construct<map_t>("map")(segment.get_segment_manager());
+   if(!m->insert(0u, 0u))
+      return false;
+   ipcdetail::OS_thread_t threads[NumThreads];
+   bool results[NumThreads];
+   for(unsigned i = 0; i != NumThreads; ++i){
+      //Half of the threads use the second mapping
+      map_t *tm = m;
+      if(i % 2u){
+         tm = segment2.find<map_t>("map").first;
+      }
+      results[i] = true;
+      if(0 != ipcdetail::thread_launch(threads[i], worker(*tm, i, results[i])))
+         return false;
+   }
+   for(unsigned i = 0; i != NumThreads; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+
+   bool ok = true;
+   unsigned v = 0;
+   for(unsigned t = 0; t != NumThreads; ++t){
+      ok = ok && results[t];
+      for(unsigned i = 0; i != KeysPerThread; ++i){
+         const bool found = m->find(t*KeysPerThread + i + 1u, v);
+         if(found != !(i % 2u) || (found && v != i)){
+            ok = false;
+         }
+      }
+   }
+   ok = ok && m->find(0u, v) && v == NumThreads*KeysPerThread;
+   ok = ok && m->size() == NumThreads*KeysPerThread/2u + 1u;
+   segment.destroy_ptr(m);
+   return ok;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u*64u);
+      //A second mapping of the same segment, at a different address
+      managed_shared_memory segment2(open_only, shMemName);
+      if(!test_basic(segment) || !test_threads(segment, segment2)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      //All memory must have been returned
+      if(!segment.all_memory_deallocated()){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
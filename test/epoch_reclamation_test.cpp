@@ -0,0 +1,245 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/epoch_reclamation.hpp>
+#include <boost/interprocess/atomic_offset_ptr.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <cstdlib>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef managed_shared_memory::segment_manager segment_manager_t;
+typedef epoch_reclamation_domain<segment_manager_t, 8u> domain_t;
+
+//Explicit instantiation to detect compilation errors
+template class boost::interprocess::epoch_reclamation_domain<segment_manager_t>;
+
+struct node
+{
+   offset_ptr<node> next;
+   unsigned value;
+};
+
+//Treiber stack: popped nodes are retired, so they are
+//not reused while other threads might be reading them
+struct shared_stack
+{
+   void push(node *n)
+   {
+      node *old = m_head.load();
+      do{
+         n->next = old;
+      } while(!m_head.compare_exchange_weak(old, n));
+   }
+
+   node *pop(domain_t::participant &p)
+   {
+      domain_t::guard g(p);
+      node *old = m_head.load();
+      while(old && !m_head.compare_exchange_weak(old, old->next.get())){}
+      return old;
+   }
+
+   atomic_offset_ptr<node> m_head;
+};
+
+static const unsigned NumThreads = 4u;
+static const unsigned Iterations = 5000u;
+
+struct stack_worker
+{
+   stack_worker(managed_shared_memory &segment, domain_t &domain, shared_stack &s)
+      : mp_segment(&segment), mp_domain(&domain), mp_stack(&s)
+   {}
+
+   void operator()()
+   {
+      domain_t::participant p(*mp_domain);
+      for(unsigned i = 0; i != Iterations; ++i){
+         node *n = static_cast<node*>(mp_segment->allocate(sizeof(node)));
+         n->value = i;
+         mp_stack->push(n);
+         if(node *popped = mp_stack->pop(p)){
+            p.retire(popped);
+         }
+      }
+   }
+
+   managed_shared_memory *mp_segment;
+   domain_t *mp_domain;
+   shared_stack *mp_stack;
+};
+
+bool test_basic(managed_shared_memory &segment, domain_t &domain)
+{
+   domain_t::participant p(domain);
+   domain_t::participant reader(domain);
+
+   //Retired blocks need two epoch advances
+   p.retire(segment.allocate(16u));
+   if(p.num_retired() != 1u || domain.num_retired() != 1u)
+      return false;
+   p.reclaim();
+   if(p.num_retired() != 1u)
+      return false;
+   if(p.reclaim() != 1u || p.num_retired() != 0u)
+      return false;
+
+   //An active reader blocks the reclamation
+   reader.enter();
+   reader.enter();
+   p.retire(segment.allocate(16u));
+   for(int i = 0; i != 4; ++i){
+      p.reclaim();
+   }
+   if(p.num_retired() != 1u)
+      return false;
+   reader.leave();
+   p.reclaim();
+   if(p.num_retired() != 1u)
+      return false;
+   reader.leave();
+   p.reclaim();
+   p.reclaim();
+   if(p.num_retired() != 0u)
+      return false;
+
+   //All slots in use
+   {
+      domain_t::participant *ps[domain_t::max_participants - 2u];
+      for(std::size_t i = 0; i != domain_t::max_participants - 2u; ++i){
+         ps[i] = new domain_t::participant(domain);
+      }
+      bool thrown = false;
+      BOOST_INTERPROCESS_TRY{  domain_t::participant extra(domain);  }
+      BOOST_INTERPROCESS_CATCH(interprocess_exception &){  thrown = true;  } BOOST_INTERPROCESS_CATCH_END
+      for(std::size_t i = 0; i != domain_t::max_participants - 2u; ++i){
+         delete ps[i];
+      }
+      if(!thrown)
+         return false;
+   }
+
+   //Pending blocks of released participants are adopted
+   reader.enter();
+   {
+      domain_t::participant tmp(domain);
+      tmp.retire(segment.allocate(16u));
+   }
+   reader.leave();
+   if(domain.num_retired() != 1u)
+      return false;
+   p.reclaim();
+   p.reclaim();
+   p.reclaim();
+   return domain.num_retired() == 0u && p.num_retired() == 0u;
+}
+
+bool test_threads(managed_shared_memory &segment, domain_t &domain)
+{
+   shared_stack *s = segment.construct<shared_stack>("stack")();
+   ipcdetail::OS_thread_t threads[NumThreads];
+   for(unsigned i = 0; i != NumThreads; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], stack_worker(segment, domain, *s)))
+         return false;
+   }
+   for(unsigned i = 0; i != NumThreads; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   //Every thread pushed and popped the same number of nodes
+   if(s->m_head.load() != 0)
+      return false;
+   domain_t::participant p(domain);
+   for(int i = 0; i != 3; ++i){
+      p.reclaim();
+   }
+   segment.destroy_ptr(s);
+   return domain.num_retired() == 0u;
+}
+
+bool test_dead_process(managed_shared_memory &segment, domain_t &domain, const char *argv0, const char *shm_name)
+{
+   std::string s(argv0);
+   s += " child ";
+   s += shm_name;
+   if(0 != std::system(s.c_str()))
+      return false;
+
+   //The child died inside a critical section with a retired block
+   if(domain.num_retired() != 1u)
+      return false;
+   domain_t::participant p(domain);
+   for(int i = 0; i != 4; ++i){
+      p.reclaim();
+   }
+   if(domain.num_retired() != 0u)
+      return false;
+   //The slot of the dead process can be used
+   domain_t::participant *ps[domain_t::max_participants - 1u];
+   for(std::size_t i = 0; i != domain_t::max_participants - 1u; ++i){
+      ps[i] = new domain_t::participant(domain);
+   }
+   for(std::size_t i = 0; i != domain_t::max_participants - 1u; ++i){
+      delete ps[i];
+   }
+   return segment.find<domain_t>("domain").first == &domain;
+}
+
+int child_main(const char *shm_name)
+{
+   managed_shared_memory segment(open_only, shm_name);
+   domain_t *domain = segment.find<domain_t>("domain").first;
+   if(!domain)
+      return 1;
+   //Never destroyed, to simulate a crash
+   static domain_t::participant *p = new domain_t::participant(*domain);
+   p->enter();
+   p->retire(segment.allocate(16u));
+   return 0;
+}
+
+int main (int argc, char *argv[])
+{
+   if(argc > 2){
+      return child_main(argv[2]);
+   }
+
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      {
+         managed_shared_memory segment(create_only, shMemName, 65536u*128u);
+         domain_t *domain = segment.construct<domain_t>("domain")(segment.get_segment_manager());
+         if(!test_basic(segment, *domain) || !test_threads(segment, *domain) ||
+            !test_dead_process(segment, *domain, argv[0], shMemName)){
+            shared_memory_object::remove(shMemName);
+            return 1;
+         }
+         segment.destroy_ptr(domain);
+         //All memory must have been returned
+         if(!segment.all_memory_deallocated()){
+            shared_memory_object::remove(shMemName);
+            return 1;
+         }
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
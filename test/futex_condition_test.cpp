@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/workaround.hpp>
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+#include "condition_test_template.hpp"
+#include <boost/interprocess/sync/futex/condition.hpp>
+#include <boost/interprocess/sync/futex/mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <signal.h>
+#include <pthread.h>
+
+using namespace boost::interprocess;
+
+typedef ipcdetail::futex_mutex      mutex_t;
+typedef ipcdetail::futex_condition  condition_t;
+
+static const unsigned NumWaiters = 64u;
+static const unsigned NumRounds = 20u;
+
+struct broadcast_data
+{
+   broadcast_data()
+      : generation(0u), awake(0u)
+   {}
+
+   mutex_t mut;
+   condition_t cond;
+   condition_t done;
+   unsigned generation;
+   unsigned awake;
+};
+
+struct broadcast_waiter
+{
+   explicit broadcast_waiter(broadcast_data &d)
+      : mp_data(&d)
+   {}
+
+   void operator()()
+   {
+      scoped_lock<mutex_t> lock(mp_data->mut);
+      for(unsigned r = 0; r != NumRounds; ++r){
+         const unsigned gen = r + 1u;
+         //Half of the waiters use timed waits, that must not time out
+         if(r % 2u){
+            mp_data->cond.wait(lock, generation_reached(*mp_data, gen));
+         }
+         else{
+            while(mp_data->generation < gen){
+               mp_data->cond.timed_wait(lock, test::ptime_delay_ms(60000u));
+            }
+         }
+         if(++mp_data->awake == NumWaiters){
+            mp_data->done.notify_one();
+         }
+      }
+   }
+
+   struct generation_reached
+   {
+      generation_reached(broadcast_data &d, unsigned gen)
+         : mp_data(&d), m_gen(gen)
+      {}
+
+      bool operator()() const
+      {  return mp_data->generation >= m_gen;  }
+
+      broadcast_data *mp_data;
+      unsigned m_gen;
+   };
+
+   broadcast_data *mp_data;
+};
+
+//Every notify_all must release every waiter, even though
+//most of them are moved to the mutex instead of being woken
+bool test_broadcast_many_waiters()
+{
+   broadcast_data data;
+   ipcdetail::OS_thread_t threads[NumWaiters];
+   for(unsigned i = 0; i != NumWaiters; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], broadcast_waiter(data)))
+         return false;
+   }
+   bool ok = true;
+   for(unsigned r = 0; r != NumRounds; ++r){
+      scoped_lock<mutex_t> lock(data.mut);
+      data.awake = 0u;
+      ++data.generation;
+      data.cond.notify_all();
+      while(data.awake != NumWaiters){
+         if(!data.done.timed_wait(lock, test::ptime_delay_ms(60000u))){
+            ok = false;
+            break;
+         }
+      }
+      if(!ok)
+         break;
+   }
+   for(unsigned i = 0; i != NumWaiters; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   return ok;
+}
+
+extern "C" void ignore_signal(int)
+{}
+
+struct interrupted_waiter
+{
+   interrupted_waiter(mutex_t &mut, condition_t &cond, volatile boost::uint32_t &done, volatile boost::uint32_t &early)
+      : mp_mut(&mut), mp_cond(&cond), mp_done(&done), mp_early(&early)
+   {}
+
+   void operator()()
+   {
+      const ustime deadline = ustime_delay_milliseconds(500u);
+      scoped_lock<mutex_t> lock(*mp_mut);
+      //Interrupted waits are spurious wakeups, the timeout is only reported after the deadline
+      while(mp_cond->timed_wait(lock, deadline)){}
+      if(ustime(ipcdetail::universal_time_u64_us()) < deadline){
+         ipcdetail::atomic_write32(mp_early, 1u);
+      }
+      ipcdetail::atomic_write32(mp_done, 1u);
+   }
+
+   mutex_t *mp_mut;
+   condition_t *mp_cond;
+   volatile boost::uint32_t *mp_done;
+   volatile boost::uint32_t *mp_early;
+};
+
+//A timed wait interrupted by a signal must not time out before its deadline
+bool test_signal_interrupts_timed_wait()
+{
+   struct sigaction sa, old_sa;
+   sa.sa_handler = ignore_signal;
+   sigemptyset(&sa.sa_mask);
+   sa.sa_flags = 0;
+   if(0 != ::sigaction(SIGUSR1, &sa, &old_sa))
+      return false;
+
+   mutex_t mut;
+   condition_t cond;
+   volatile boost::uint32_t done = 0u, early = 0u;
+   ipcdetail::OS_thread_t thread;
+   if(0 != ipcdetail::thread_launch(thread, interrupted_waiter(mut, cond, done, early)))
+      return false;
+   while(!ipcdetail::atomic_read32(&done)){
+      ipcdetail::thread_sleep_ms(20u);
+      ::pthread_kill(thread, SIGUSR1);
+   }
+   ipcdetail::thread_join(thread);
+   ::sigaction(SIGUSR1, &old_sa, 0);
+   return !ipcdetail::atomic_read32(&early);
+}
+
+int main ()
+{
+   if(!test::do_test_condition<condition_t, mutex_t>())
+      return 1;
+   if(!test_broadcast_many_waiters())
+      return 1;
+   if(!test_signal_interrupts_timed_wait())
+      return 1;
+   return 0;
+}
+
+#else
+int main()
+{
+   return 0;
+}
+#endif
@@ -0,0 +1,31 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/workaround.hpp>
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+#include "mutex_test_template.hpp"
+#include <boost/interprocess/sync/futex/mutex.hpp>
+
+int main ()
+{
+   using namespace boost::interprocess;
+
+   test::test_all_lock<ipcdetail::futex_mutex>();
+   test::test_all_mutex<ipcdetail::futex_mutex>();
+   return 0;
+}
+
+#else
+int main()
+{
+   return 0;
+}
+#endif
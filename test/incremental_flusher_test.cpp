@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/workaround.hpp>
+
+#if defined(BOOST_INTERPROCESS_MAPPED_FILES)
+
+#include <boost/interprocess/managed_mapped_file.hpp>
+#include <boost/interprocess/incremental_flusher.hpp>
+#include <cstring>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef incremental_flusher<managed_mapped_file> flusher_t;
+
+bool test_ranged_flush(managed_mapped_file &mfile)
+{
+   const std::size_t size = mfile.get_size();
+   //Unaligned offsets and sizes are accepted
+   if(!mfile.flush(0u, 1u) || !mfile.flush(3u, 4097u) || !mfile.flush(size - 1u, 1u, true))
+      return false;
+   //Zero means until the end of the segment
+   if(!mfile.flush(12345u, 0u))
+      return false;
+   //Out of range
+   if(mfile.flush(size, 1u))
+      return false;
+   return true;
+}
+
+bool test_sync_flush(managed_mapped_file &mfile)
+{
+   flusher_t flusher(mfile, 1u);
+   const std::size_t granule = flusher.granule_size();
+   if(granule != mapped_region::get_page_size())
+      return false;
+   if(flusher.dirty_bytes() != 0u || !flusher.flush())
+      return false;
+
+   char *buf = mfile.construct<char>("buffer")[granule*8u](0);
+   std::memset(buf, 1, granule*8u);
+   flusher.mark_dirty(buf, granule*8u);
+   //The buffer is not granule aligned, so it might span one more granule
+   if(flusher.dirty_bytes() < granule*8u || flusher.dirty_bytes() > granule*9u)
+      return false;
+   //Marking again does not change the dirty size
+   const std::size_t dirty = flusher.dirty_bytes();
+   flusher.mark_dirty(buf + granule, 1u);
+   if(flusher.dirty_bytes() != dirty)
+      return false;
+   if(!flusher.flush() || flusher.dirty_bytes() != 0u)
+      return false;
+
+   //Last byte of the segment (partial granule)
+   const char *const last = static_cast<char*>(mfile.get_address()) + mfile.get_size() - 1u;
+   flusher.mark_dirty(last, 1u);
+   if(flusher.dirty_bytes() != granule || !flusher.flush())
+      return false;
+
+   mfile.destroy<char>("buffer");
+   return true;
+}
+
+bool test_async_flush(managed_mapped_file &mfile)
+{
+   flusher_t flusher(mfile);
+   if(flusher.granule_size() != mapped_region::get_page_size()*BOOST_INTERPROCESS_INCREMENTAL_FLUSHER_GRANULE_PAGES)
+      return false;
+
+   const std::size_t NumObjects = 16u;
+   int *objects[NumObjects];
+   flusher_t::ticket_type tickets[NumObjects];
+   for(std::size_t i = 0; i != NumObjects; ++i){
+      objects[i] = mfile.construct<int>(anonymous_instance)[1000u]((int)i);
+      flusher.mark_dirty(objects[i], sizeof(int)*1000u);
+      tickets[i] = flusher.async_flush();
+      if(flusher.dirty_bytes() != 0u)
+         return false;
+      if(i && tickets[i] <= tickets[i-1])
+         return false;
+   }
+   //Waiting for the last ticket waits for all previous ones
+   if(!flusher.wait(tickets[NumObjects-1u]))
+      return false;
+   for(std::size_t i = 0; i != NumObjects; ++i){
+      if(!flusher.is_complete(tickets[i]))
+         return false;
+   }
+   //Barrier without dirty ranges
+   if(!flusher.barrier())
+      return false;
+
+   //Synchronous flush also waits for pending asynchronous flushes
+   for(std::size_t i = 0; i != NumObjects; ++i){
+      objects[i][0] = -1;
+      flusher.mark_dirty(objects[i], sizeof(int));
+      if(i % 2u)
+         flusher.async_flush();
+   }
+   if(!flusher.flush())
+      return false;
+   for(std::size_t i = 0; i != NumObjects; ++i){
+      mfile.destroy_ptr(objects[i]);
+   }
+   return true;
+}
+
+int main ()
+{
+   const std::size_t FileSize = 65536u*16u;
+   std::string filename(get_filename());
+   const char *FileName = filename.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      file_mapping::remove(FileName);
+      {
+         managed_mapped_file mfile(create_only, FileName, FileSize);
+         if(!test_ranged_flush(mfile) || !test_sync_flush(mfile) || !test_async_flush(mfile)){
+            file_mapping::remove(FileName);
+            return 1;
+         }
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      file_mapping::remove(FileName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   file_mapping::remove(FileName);
+   return 0;
+}
+
+#else //#if defined(BOOST_INTERPROCESS_MAPPED_FILES)
+
+int main()
+{
+   return 0;
+}
+
+#endif//#if defined(BOOST_INTERPROCESS_MAPPED_FILES)
@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/interprocess_barrier.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+static const unsigned NumPhases = 2000u;
+static const unsigned NumTreePhases = 200u;
+
+struct shared_state
+{
+   volatile boost::uint32_t arrived[NumPhases];
+   volatile boost::uint32_t serial[NumPhases];
+};
+
+struct participant
+{
+   participant(interprocess_barrier &b, shared_state &st, unsigned id, unsigned count, unsigned phases, bool indexed, bool &ok)
+      : mp_b(&b), mp_st(&st), m_id(id), m_count(count), m_phases(phases), m_indexed(indexed), mp_ok(&ok)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != m_phases; ++i){
+         ipcdetail::atomic_inc32(&mp_st->arrived[i]);
+         //Some participants arrive late, so that others block
+         if((i + m_id) % 97u == 0u){
+            ipcdetail::thread_sleep_ms(1u);
+         }
+         const bool last = m_indexed ? mp_b->wait(m_id) : mp_b->wait();
+         if(last){
+            ipcdetail::atomic_inc32(&mp_st->serial[i]);
+         }
+         //Nobody leaves a phase before everybody has arrived
+         if(ipcdetail::atomic_read32(&mp_st->arrived[i]) != m_count){
+            *mp_ok = false;
+         }
+      }
+   }
+
+   interprocess_barrier *mp_b;
+   shared_state *mp_st;
+   unsigned m_id;
+   unsigned m_count;
+   unsigned m_phases;
+   bool m_indexed;
+   bool *mp_ok;
+};
+
+bool test_barrier(managed_shared_memory &segment, unsigned count, unsigned phases, bool indexed)
+{
+   interprocess_barrier *b = segment.construct<interprocess_barrier>(anonymous_instance)(count);
+   shared_state *st = segment.construct<shared_state>(anonymous_instance)();
+   for(unsigned i = 0; i != NumPhases; ++i){
+      st->arrived[i] = 0u;
+      st->serial[i] = 0u;
+   }
+
+   ipcdetail::OS_thread_t *threads = new ipcdetail::OS_thread_t[count];
+   bool *ok = new bool[count];
+   bool ret = true;
+   for(unsigned i = 0; i != count; ++i){
+      ok[i] = true;
+      if(0 != ipcdetail::thread_launch(threads[i], participant(*b, *st, i, count, phases, indexed, ok[i])))
+         return false;
+   }
+   for(unsigned i = 0; i != count; ++i){
+      ipcdetail::thread_join(threads[i]);
+      ret = ret && ok[i];
+   }
+   //Exactly one serial participant per phase
+   for(unsigned i = 0; i != phases; ++i){
+      ret = ret && st->serial[i] == 1u;
+   }
+   delete [] ok;
+   delete [] threads;
+   segment.destroy_ptr(st);
+   segment.destroy_ptr(b);
+   return ret;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u);
+      {
+         interprocess_barrier b(1u);
+         if(!b.wait() || !b.wait(0u)){
+            shared_memory_object::remove(shMemName);
+            return 1;
+         }
+      }
+      //Flat counter, a combining tree with a smaller last leaf
+      //and a tree used through wait()
+      if(!test_barrier(segment, 4u, NumPhases, false) ||
+         !test_barrier(segment, 4u, NumPhases, true) ||
+         !test_barrier(segment, interprocess_barrier::tree_threshold + 3u, NumTreePhases, true) ||
+         !test_barrier(segment, interprocess_barrier::tree_threshold, NumTreePhases, false)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
@@ -0,0 +1,195 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/ipc_atomic_wait.hpp>
+#include <boost/interprocess/sync/interprocess_eventcount.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+static const unsigned NumRounds = 10000u;
+static const unsigned NumItems = 20000u;
+static const unsigned NumConsumers = 4u;
+
+bool test_basic(volatile boost::uint32_t &word)
+{
+   ipcdetail::atomic_write32(&word, 1u);
+   //Returns immediately if the value is not the old one
+   ipc_atomic_wait(&word, 0u);
+   if(!ipc_atomic_wait(&word, 0u, ustime_delay_milliseconds(10u)))
+      return false;
+   //Times out if the value does not change
+   if(ipc_atomic_wait(&word, 1u, ustime_delay_milliseconds(10u)))
+      return false;
+   //Notifying without waiters does nothing
+   ipc_atomic_notify_one(&word);
+   ipc_atomic_notify_all(&word);
+   return ipcdetail::atomic_read32(&word) == 1u;
+}
+
+//Two threads take turns: each one waits for its parity and increments the word
+struct ping_pong
+{
+   ping_pong(volatile boost::uint32_t &word, boost::uint32_t parity)
+      : mp_word(&word), m_parity(parity)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != NumRounds; ++i){
+         boost::uint32_t v;
+         while(((v = ipcdetail::atomic_read32(mp_word)) & 1u) != m_parity){
+            ipc_atomic_wait(mp_word, v);
+         }
+         ipcdetail::atomic_inc32(mp_word);
+         ipc_atomic_notify_one(mp_word);
+      }
+   }
+
+   volatile boost::uint32_t *mp_word;
+   boost::uint32_t m_parity;
+};
+
+bool test_ping_pong(volatile boost::uint32_t &word)
+{
+   ipcdetail::atomic_write32(&word, 0u);
+   ipcdetail::OS_thread_t threads[2];
+   for(boost::uint32_t i = 0; i != 2u; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], ping_pong(word, i)))
+         return false;
+   }
+   for(unsigned i = 0; i != 2u; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   return ipcdetail::atomic_read32(&word) == 2u*NumRounds;
+}
+
+//Shared state for the eventcount test, modified without locks
+struct shared_items
+{
+   shared_items()
+      : m_available(0u), m_done(0u), m_consumed(0u), m_ec()
+   {}
+
+   volatile boost::uint32_t m_available;
+   volatile boost::uint32_t m_done;
+   volatile boost::uint32_t m_consumed;
+   interprocess_eventcount m_ec;
+};
+
+static bool try_take(shared_items &items)
+{
+   boost::uint32_t old = ipcdetail::atomic_read32(&items.m_available);
+   while(old){
+      const boost::uint32_t prev = ipcdetail::atomic_cas32(&items.m_available, old - 1u, old);
+      if(prev == old){
+         return true;
+      }
+      old = prev;
+   }
+   return false;
+}
+
+struct consumer
+{
+   explicit consumer(shared_items &items)
+      : mp_items(&items)
+   {}
+
+   void operator()()
+   {
+      for(;;){
+         if(try_take(*mp_items)){
+            ipcdetail::atomic_inc32(&mp_items->m_consumed);
+            continue;
+         }
+         if(ipcdetail::atomic_read32(&mp_items->m_done)){
+            return;
+         }
+         const interprocess_eventcount::key_type key = mp_items->m_ec.prepare_wait();
+         if(ipcdetail::atomic_read32(&mp_items->m_available) || ipcdetail::atomic_read32(&mp_items->m_done)){
+            mp_items->m_ec.cancel_wait();
+         }
+         else{
+            mp_items->m_ec.wait(key);
+         }
+      }
+   }
+
+   shared_items *mp_items;
+};
+
+bool test_eventcount(shared_items &items)
+{
+   //Nothing to wait for
+   {
+      const interprocess_eventcount::key_type key = items.m_ec.prepare_wait();
+      if(items.m_ec.timed_wait(key, ustime_delay_milliseconds(10u)))
+         return false;
+   }
+   //A notification between prepare_wait and wait is not lost
+   {
+      const interprocess_eventcount::key_type key = items.m_ec.prepare_wait();
+      items.m_ec.notify_one();
+      if(!items.m_ec.timed_wait(key, ustime_delay_milliseconds(1000u)))
+         return false;
+   }
+
+   ipcdetail::OS_thread_t threads[NumConsumers];
+   for(unsigned i = 0; i != NumConsumers; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], consumer(items)))
+         return false;
+   }
+   for(unsigned i = 0; i != NumItems; ++i){
+      ipcdetail::atomic_inc32(&items.m_available);
+      items.m_ec.notify_one();
+      if(i % 64u == 0u){
+         ipcdetail::thread_yield();
+      }
+   }
+   //Wait until all the items are consumed
+   while(ipcdetail::atomic_read32(&items.m_consumed) != NumItems){
+      ipcdetail::thread_yield();
+   }
+   ipcdetail::atomic_write32(&items.m_done, 1u);
+   items.m_ec.notify_all();
+   for(unsigned i = 0; i != NumConsumers; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   return ipcdetail::atomic_read32(&items.m_available) == 0u;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u);
+      volatile boost::uint32_t *word = segment.construct<boost::uint32_t>("word")(0u);
+      shared_items *items = segment.construct<shared_items>("items")();
+      if(!test_basic(*word) || !test_ping_pong(*word) || !test_eventcount(*items)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
@@ -0,0 +1,216 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_INTERPROCESS_ENABLE_LOCK_STATS
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/lock_stats.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_upgradable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <cstring>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+struct lock_and_sleep
+{
+   lock_and_sleep(interprocess_mutex &m, interprocess_semaphore &locked)
+      : m_(m), locked_(locked)
+   {}
+
+   void operator()()
+   {
+      m_.lock();
+      locked_.post();
+      ipcdetail::thread_sleep_ms(200);
+      m_.unlock();
+   }
+
+   interprocess_mutex &m_;
+   interprocess_semaphore &locked_;
+};
+
+struct count_visitor
+{
+   count_visitor(unsigned &n, bool &found_mutex)
+      : n_(n), found_mutex_(found_mutex)
+   {}
+
+   void operator()(const char *name, const lock_stats &s)
+   {
+      ++n_;
+      if(0 == std::strcmp(name, "mutex") && s.acquisitions() != 0){
+         found_mutex_ = true;
+      }
+   }
+
+   unsigned &n_;
+   bool &found_mutex_;
+};
+
+bool test_mutex_stats()
+{
+   interprocess_mutex m;
+   if(m.stats().acquisitions() || m.stats().contentions())
+      return false;
+
+   {  scoped_lock<interprocess_mutex> lck(m);  }
+   if(m.stats().acquisitions() != 1u || m.stats().contentions() != 0u)
+      return false;
+   //Hold time is not tracked by default
+   if(m.stats().tracks_hold_time() || m.stats().hold_ns() != 0u)
+      return false;
+   m.stats().track_hold_time(true);
+
+   //Contended acquisition: another thread holds the mutex for a while
+   interprocess_semaphore locked(0u);
+   ipcdetail::OS_thread_t th;
+   ipcdetail::thread_launch(th, lock_and_sleep(m, locked));
+   locked.wait();
+   m.lock();
+   m.unlock();
+   ipcdetail::thread_join(th);
+   if(m.stats().contentions() != 1u || m.stats().wait_ns() == 0u)
+      return false;
+   if(m.stats().acquisitions() != 3u)
+      return false;
+   if(m.stats().hold_ns() == 0u)
+      return false;
+
+   //Failed try_lock is not an acquisition
+   m.lock();
+   if(m.try_lock())
+      return false;
+   m.unlock();
+   if(m.stats().acquisitions() != 4u)
+      return false;
+
+   m.stats().reset();
+   if(m.stats().acquisitions() || m.stats().hold_ns() || m.stats().wait_ns())
+      return false;
+   return true;
+}
+
+bool test_semaphore_stats()
+{
+   interprocess_semaphore sem(1u);
+   sem.wait();
+   if(sem.try_wait())
+      return false;
+   //Timed wait must time out and be accounted
+   if(sem.timed_wait(ustime_delay_milliseconds(10u)))
+      return false;
+   sem.post();
+   if(sem.stats().acquisitions() != 1u)
+      return false;
+   if(sem.stats().timeouts() != 1u || sem.stats().contentions() != 0u)
+      return false;
+   if(sem.stats().wait_ns() == 0u)
+      return false;
+   return true;
+}
+
+template<class SharableMutex>
+bool test_sharable_stats()
+{
+   SharableMutex m;
+   m.lock_sharable();
+   m.lock_sharable();
+   //Exclusive lock must fail while there are readers
+   if(m.try_lock())
+      return false;
+   m.unlock_sharable();
+   m.unlock_sharable();
+   m.lock();
+   m.unlock();
+   if(m.stats().acquisitions() != 3u)
+      return false;
+   return true;
+}
+
+bool test_registry(managed_shared_memory &segment)
+{
+   lock_stats_registry *reg = segment.find_or_construct<lock_stats_registry>(unique_instance)();
+   interprocess_mutex *m = segment.construct<interprocess_mutex>("mutex")();
+   interprocess_semaphore *s = segment.construct<interprocess_semaphore>("semaphore")(0u);
+   interprocess_condition *c = segment.construct<interprocess_condition>("condition")();
+
+   if(!reg->add("mutex", *m) || !reg->add("semaphore", *s) || !reg->add("condition", *c))
+      return false;
+   if(reg->size() != 3u)
+      return false;
+
+   m->lock();
+   m->unlock();
+
+   //Another "process" finds the registry and enumerates it
+   lock_stats_registry *reg2 = segment.find<lock_stats_registry>(unique_instance).first;
+   if(reg2 != reg)
+      return false;
+   unsigned n = 0;
+   bool found_mutex = false;
+   reg2->for_each(count_visitor(n, found_mutex));
+   if(n != 3u || !found_mutex)
+      return false;
+
+   if(!reg->remove(*s) || reg->remove(*s))
+      return false;
+   if(reg->size() != 2u)
+      return false;
+   reg->reset_all();
+   if(m->stats().acquisitions() != 0u)
+      return false;
+
+   //Fill the registry
+   while(reg->size() != lock_stats_registry::max_entries){
+      if(!reg->add("mutex", *m))
+         return false;
+   }
+   if(reg->add("mutex", *m))
+      return false;
+   return true;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   if(!test_mutex_stats())
+      return 1;
+   if(!test_semaphore_stats())
+      return 1;
+   if(!test_sharable_stats<interprocess_sharable_mutex>())
+      return 1;
+   if(!test_sharable_stats<interprocess_upgradable_mutex>())
+      return 1;
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u);
+      if(!test_registry(segment)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
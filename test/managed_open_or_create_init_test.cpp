@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/detail/managed_open_or_create_impl.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <cstring>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef ipcdetail::managed_open_or_create_impl<shared_memory_object, 0, true, false> shared_memory;
+
+static const std::size_t ShmSize = 1000u;
+static const unsigned NumOpeners = 8u;
+static const boost::uint32_t Magic = 0x1F2E3D4Cu;
+
+//Set when the creator starts initializing the segment
+volatile boost::uint32_t initializing;
+
+struct slow_construct
+{
+   explicit slow_construct(bool fail) : m_fail(fail) {}
+
+   bool operator()(void *addr, std::size_t, bool created) const
+   {
+      if(created){
+         ipcdetail::atomic_write32(&initializing, 1u);
+         //Keep openers waiting for the final state
+         ipcdetail::thread_sleep_ms(300u);
+         if(m_fail){
+            throw interprocess_exception(other_error);
+         }
+         *static_cast<boost::uint32_t*>(addr) = Magic;
+      }
+      return true;
+   }
+
+   std::size_t get_min_size() const
+   {  return sizeof(boost::uint32_t);  }
+
+   bool m_fail;
+};
+
+struct opener
+{
+   opener(const char *name, int &result)
+      : mp_name(name), mp_result(&result)
+   {}
+
+   void operator()()
+   {
+      //Start opening once the segment is being initialized
+      while(!ipcdetail::atomic_read32(&initializing)){
+         ipcdetail::thread_yield();
+      }
+      BOOST_INTERPROCESS_TRY{
+         shared_memory shm(open_only, mp_name, read_write, 0);
+         *mp_result = *static_cast<boost::uint32_t*>(shm.get_user_address()) == Magic ? 1 : -1;
+      }
+      BOOST_INTERPROCESS_CATCH(interprocess_exception &e){
+         *mp_result = e.get_error_code() == corrupted_error ? 2 : -1;
+      } BOOST_INTERPROCESS_CATCH_END
+   }
+
+   const char *mp_name;
+   int *mp_result;
+};
+
+struct creator
+{
+   creator(const char *name, bool fail, shared_memory *&shm)
+      : mp_name(name), m_fail(fail), mp_shm(&shm)
+   {}
+
+   void operator()()
+   {
+      BOOST_INTERPROCESS_TRY{
+         *mp_shm = new shared_memory(create_only, mp_name, ShmSize, read_write, 0, slow_construct(m_fail), permissions());
+      }
+      BOOST_INTERPROCESS_CATCH(...){
+         *mp_shm = 0;
+      } BOOST_INTERPROCESS_CATCH_END
+   }
+
+   const char *mp_name;
+   bool m_fail;
+   shared_memory **mp_shm;
+};
+
+//Openers blocked while the segment is being initialized must be woken
+//with the final state, both when initialization succeeds and when it fails
+bool test_concurrent_open(const char *name, bool fail)
+{
+   shared_memory_object::remove(name);
+   ipcdetail::atomic_write32(&initializing, 0u);
+
+   shared_memory *shm = 0;
+   int results[NumOpeners];
+   ipcdetail::OS_thread_t threads[NumOpeners + 1u];
+   if(0 != ipcdetail::thread_launch(threads[NumOpeners], creator(name, fail, shm)))
+      return false;
+   for(unsigned i = 0; i != NumOpeners; ++i){
+      results[i] = 0;
+      if(0 != ipcdetail::thread_launch(threads[i], opener(name, results[i])))
+         return false;
+   }
+   for(unsigned i = 0; i != NumOpeners + 1u; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+
+   bool ok = fail ? shm == 0 : shm != 0;
+   for(unsigned i = 0; i != NumOpeners; ++i){
+      ok = ok && results[i] == (fail ? 2 : 1);
+   }
+   delete shm;
+   shared_memory_object::remove(name);
+   return ok;
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const name = process_name.c_str();
+
+   if(!test_concurrent_open(name, false) || !test_concurrent_open(name, true)){
+      return 1;
+   }
+   return 0;
+}
@@ -22,12 +22,18 @@
 #include <boost/move/unique_ptr.hpp>
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <iostream>
 #include <vector>
 #include <exception>
 #include <limits>
 
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+#  include <poll.h>
+#  include <unistd.h>
+#endif
+
 #include "get_process_id_name.hpp"
 #include "named_creation_template.hpp"
 
@@ -351,6 +357,258 @@ bool test_multi_sender_receiver()
    return ret;
 }
 
+//Messages of packed queues carry their id and a size derived from it
+static message_queue::size_type packed_msg_size(std::size_t id)
+{  return sizeof(std::size_t) + (id*7919u) % 300u;  }
+
+static void packed_msg_fill(char *buf, std::size_t id)
+{
+   std::memcpy(buf, &id, sizeof(id));
+   std::memset(buf + sizeof(id), char(id), packed_msg_size(id) - sizeof(id));
+}
+
+static bool packed_msg_check(const char *buf, message_queue::size_type size, std::size_t &id)
+{
+   std::memcpy(&id, buf, sizeof(id));
+   if(size != packed_msg_size(id))
+      return false;
+   for(std::size_t i = sizeof(id); i != size; ++i){
+      if(buf[i] != char(id))
+         return false;
+   }
+   return true;
+}
+
+static const std::size_t PACKED_NUM_MSG = 20000;
+static message_queue *packed_queue = 0;
+
+static void packed_send()
+{
+   char buf[sizeof(std::size_t) + 300];
+   for(std::size_t id = 0; id != PACKED_NUM_MSG; ++id){
+      packed_msg_fill(buf, id);
+      packed_queue->send(buf, packed_msg_size(id), 0);
+   }
+}
+
+//This test checks queues that store messages packed in a buffer
+//instead of in preallocated slots of the maximum message size
+bool test_packed_storage()
+{
+   message_queue::remove(test::get_process_id_name());
+   {
+      const message_queue::size_type max_msg_size = 1000u;
+      message_queue mq
+         (create_only, test::get_process_id_name(), 1000, max_msg_size, packed_message_storage(4096u));
+      if(!mq.is_packed() || mq.get_max_msg() != 1000u || mq.get_max_msg_size() != max_msg_size)
+         return false;
+
+      //Small messages use only the space they need
+      char buf[1000];
+      message_queue::size_type recvd = 0;
+      unsigned int priority = 0;
+      std::size_t n = 0;
+      packed_msg_fill(buf, n);
+      while(mq.try_send(buf, packed_msg_size(n), 0)){
+         packed_msg_fill(buf, ++n);
+      }
+      if(n < 4096u/(max_msg_size*2u) + 10u || mq.get_num_msg() != n)
+         return false;
+      for(std::size_t i = 0; i != n; ++i){
+         std::size_t id;
+         if(!mq.try_receive(buf, sizeof(buf), recvd, priority) || !packed_msg_check(buf, recvd, id) || id != i)
+            return false;
+      }
+      if(mq.try_receive(buf, sizeof(buf), recvd, priority))
+         return false;
+
+      //Messages of the maximum size always fit in an empty queue
+      std::memset(buf, 1, sizeof(buf));
+      if(!mq.try_send(buf, max_msg_size, 0) || !mq.try_receive(buf, sizeof(buf), recvd, priority) || recvd != max_msg_size)
+         return false;
+
+      //Out of order receptions due to priorities and wrap around the buffer
+      std::size_t next = 0;
+      std::size_t last_id[3];
+      for(int round = 0; round != 200; ++round){
+         //Fill the queue
+         packed_msg_fill(buf, next);
+         while(mq.try_send(buf, packed_msg_size(next), unsigned(next % 3u))){
+            packed_msg_fill(buf, ++next);
+         }
+         //Receive half of the messages, higher priorities first and FIFO for the same priority
+         const message_queue::size_type num = mq.get_num_msg();
+         unsigned int prev_priority = 3u;
+         last_id[0] = last_id[1] = last_id[2] = 0u;
+         for(std::size_t i = 0; i != (num + 1u)/2u; ++i){
+            std::size_t id;
+            if(!mq.try_receive(buf, sizeof(buf), recvd, priority) || !packed_msg_check(buf, recvd, id))
+               return false;
+            if(priority > prev_priority || priority != id % 3u || (last_id[priority] && id <= last_id[priority]))
+               return false;
+            prev_priority = priority;
+            last_id[priority] = id;
+         }
+      }
+      while(mq.try_receive(buf, sizeof(buf), recvd, priority)){}
+      if(mq.get_num_msg() != 0u)
+         return false;
+   }
+   message_queue::remove(test::get_process_id_name());
+
+   //A buffer smaller than a message is enlarged and anonymous queues can be packed
+   {
+      message_queue mq(10u, 100u, packed_message_storage(1u));
+      char buf[100] = {};
+      message_queue::size_type recvd = 0;
+      unsigned int priority = 0;
+      if(!mq.is_packed() || !mq.try_send(buf, 100u, 0) || mq.try_send(buf, 1u, 0))
+         return false;
+      if(!mq.try_receive(buf, sizeof(buf), recvd, priority) || recvd != 100u)
+         return false;
+   }
+
+   //Blocking senders and receivers
+   {
+      message_queue mq
+         (create_only, test::get_process_id_name(), 100, sizeof(std::size_t) + 300, packed_message_storage(2048u));
+      packed_queue = &mq;
+      boost::interprocess::ipcdetail::OS_thread_t thread;
+      boost::interprocess::ipcdetail::thread_launch(thread, &packed_send);
+      char buf[sizeof(std::size_t) + 300];
+      message_queue::size_type recvd = 0;
+      unsigned int priority = 0;
+      bool ok = true;
+      for(std::size_t i = 0; i != PACKED_NUM_MSG; ++i){
+         std::size_t id;
+         mq.receive(buf, sizeof(buf), recvd, priority);
+         ok = ok && packed_msg_check(buf, recvd, id) && id == i;
+      }
+      boost::interprocess::ipcdetail::thread_join(thread);
+      if(!ok)
+         return false;
+   }
+   message_queue::remove(test::get_process_id_name());
+   return true;
+}
+
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
+static bool is_readable(int fd)
+{
+   pollfd pfd;
+   pfd.fd = fd;
+   pfd.events = POLLIN;
+   pfd.revents = 0;
+   return ::poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+
+//This test checks the pollable descriptor signaled when the queue becomes non-empty
+bool test_notification_handle()
+{
+   message_queue::remove(test::get_process_id_name());
+   {
+      message_queue receiver_mq(create_only, test::get_process_id_name(), 10, sizeof(int));
+      //Another handle, as if the sender was another process
+      message_queue sender_mq(open_only, test::get_process_id_name());
+      int msg = 0;
+      message_queue::size_type recvd = 0;
+      unsigned int priority = 0;
+
+      //Messages sent before the handle is created are notified by
+      //get_notification_handle, as senders won't notify a non-empty queue
+      sender_mq.send(&msg, sizeof(msg), 0);
+      const int fd = receiver_mq.get_notification_handle();
+      if(fd < 0 || !is_readable(fd))
+         return false;
+      receiver_mq.clear_notification();
+      if(!receiver_mq.try_receive(&msg, sizeof(msg), recvd, priority))
+         return false;
+      //An empty queue is not notified
+      if(receiver_mq.get_notification_handle() != fd || is_readable(fd))
+         return false;
+
+      for(int round = 0; round != 3; ++round){
+         //Only the transition to non-empty is notified
+         for(int i = 0; i != 5; ++i){
+            sender_mq.send(&i, sizeof(i), 0);
+         }
+         if(!is_readable(fd))
+            return false;
+         char buf[16];
+         if(::read(fd, buf, sizeof(buf)) != 1)
+            return false;
+         if(is_readable(fd))
+            return false;
+
+         //Wait as an event loop: clear the notification and receive until empty
+         receiver_mq.clear_notification();
+         int n = 0;
+         while(receiver_mq.try_receive(&msg, sizeof(msg), recvd, priority)){
+            if(msg != n++)
+               return false;
+         }
+         if(n != 5 || is_readable(fd))
+            return false;
+      }
+
+      //Pending notifications are discarded
+      sender_mq.send(&msg, sizeof(msg), 0);
+      receiver_mq.clear_notification();
+      if(is_readable(fd))
+         return false;
+   }
+   message_queue::remove(test::get_process_id_name());
+
+   //Anonymous queues can't be notified
+   message_queue mq(10u, sizeof(int));
+   bool thrown = false;
+   BOOST_INTERPROCESS_TRY{  mq.get_notification_handle();  }
+   BOOST_INTERPROCESS_CATCH(interprocess_exception &){  thrown = true;  } BOOST_INTERPROCESS_CATCH_END
+   return thrown;
+}
+
+bool test_notification_fifo()
+{
+   message_queue::remove(test::get_process_id_name());
+   bool ok = true;
+   {
+      message_queue receiver_mq(create_only, test::get_process_id_name(), 10, sizeof(int), permissions(0600));
+      message_queue sender_mq(open_only, test::get_process_id_name());
+      int msg = 0;
+      message_queue::size_type recvd = 0;
+      unsigned int priority = 0;
+
+      //The fifo has the permissions of the queue, even if
+      //the notification handle is obtained from an opened queue
+      message_queue opened_mq(open_only, test::get_process_id_name());
+      const int fd = opened_mq.get_notification_handle();
+      std::string fifo_name(test::get_process_id_name());
+      fifo_name += ".mq_notify";
+      std::string path;
+      ipcdetail::shared_filepath(fifo_name.c_str(), path);
+      struct ::stat st;
+      ok = ok && ::stat(path.c_str(), &st) == 0 && (st.st_mode & 0777) == 0600;
+
+      //The sender caches the write end of the fifo
+      sender_mq.send(&msg, sizeof(msg), 0);
+      ok = ok && is_readable(fd);
+      opened_mq.clear_notification();
+      ok = ok && opened_mq.try_receive(&msg, sizeof(msg), recvd, priority);
+
+      //The fifo is removed and a new one is created by another handle:
+      //the sender must notify the new fifo
+      ipcdetail::msg_queue_notifier::remove(test::get_process_id_name());
+      const int fd2 = receiver_mq.get_notification_handle();
+      sender_mq.send(&msg, sizeof(msg), 0);
+      ok = ok && is_readable(fd2) && !is_readable(fd);
+   }
+   message_queue::remove(test::get_process_id_name());
+   return ok;
+}
+
+#endif   //#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
 class msg_queue_named_test_wrapper
    : public test::named_sync_deleter<message_queue>, public message_queue
 {
@@ -424,6 +682,20 @@ int main ()
       if(!test_multi_sender_receiver()){
          return 1;
       }
+
+      if(!test_packed_storage()){
+         return 1;
+      }
+
+      #if !defined(BOOST_INTERPROCESS_WINDOWS)
+      if(!test_notification_handle()){
+         return 1;
+      }
+
+      if(!test_notification_fifo()){
+         return 1;
+      }
+      #endif
    }
    BOOST_INTERPROCESS_CATCH(std::exception &ex) {
       std::cout << ex.what() << std::endl;
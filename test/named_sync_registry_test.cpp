@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "get_process_id_name.hpp"
+
+//Each test process uses its own registry
+#define BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY
+#define BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME ::boost::interprocess::test::get_process_id_name()
+
+#include "named_mutex_test_helpers.hpp"
+#include "named_semaphore_test_helpers.hpp"
+#include <boost/interprocess/sync/shm/named_mutex.hpp>
+#include <boost/interprocess/sync/shm/named_semaphore.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include "boost_interprocess_check.hpp"
+#include <string>
+#include <sstream>
+#include <vector>
+
+using namespace boost::interprocess;
+
+static std::string object_name(unsigned int i)
+{
+   std::stringstream sstr;
+   sstr << "named_sync_registry_test_" << i;
+   return sstr.str();
+}
+
+bool test_many_objects()
+{
+   const unsigned int num_objects = 1000u;
+   std::vector<ipcdetail::shm_named_mutex*> mutexes;
+   for(unsigned int i = 0; i != num_objects; ++i){
+      mutexes.push_back(new ipcdetail::shm_named_mutex(create_only, object_name(i).c_str()));
+   }
+   bool ok = true;
+   for(unsigned int i = 0; i != num_objects; ++i){
+      //A second handle refers to the same object
+      ipcdetail::shm_named_mutex other(open_only, object_name(i).c_str());
+      mutexes[i]->lock();
+      ok = ok && &other.internal_mutex() == &mutexes[i]->internal_mutex() && !other.try_lock();
+      mutexes[i]->unlock();
+   }
+   for(unsigned int i = 0; i != num_objects; ++i){
+      delete mutexes[i];
+      ok = ok && ipcdetail::shm_named_mutex::remove(object_name(i).c_str());
+   }
+   return ok;
+}
+
+bool test_remove()
+{
+   const std::string name = object_name(0);
+   ipcdetail::shm_named_mutex mtx(create_only, name.c_str());
+   BOOST_INTERPROCESS_TRY{
+      ipcdetail::shm_named_mutex dup(create_only, name.c_str());
+      return false;
+   }
+   BOOST_INTERPROCESS_CATCH(interprocess_exception &e){
+      if(e.get_error_code() != already_exists_error)
+         return false;
+   } BOOST_INTERPROCESS_CATCH_END
+
+   //Removing the name does not destroy the object while it's open
+   if(!ipcdetail::shm_named_mutex::remove(name.c_str()) ||
+       ipcdetail::shm_named_mutex::remove(name.c_str())){
+      return false;
+   }
+   mtx.lock();
+   BOOST_INTERPROCESS_TRY{
+      ipcdetail::shm_named_mutex removed(open_only, name.c_str());
+      return false;
+   }
+   BOOST_INTERPROCESS_CATCH(interprocess_exception &e){
+      if(e.get_error_code() != not_found_error)
+         return false;
+   } BOOST_INTERPROCESS_CATCH_END
+
+   //The name can be used by a new object
+   {
+      ipcdetail::shm_named_mutex recreated(create_only, name.c_str());
+      if(&recreated.internal_mutex() == &mtx.internal_mutex() || !recreated.try_lock()){
+         return false;
+      }
+      recreated.unlock();
+   }
+   mtx.unlock();
+   return ipcdetail::shm_named_mutex::remove(name.c_str());
+}
+
+//Removed objects don't leave slots that lookups must scan
+bool test_slot_reuse()
+{
+   ipcdetail::named_sync_registry &registry = ipcdetail::get_named_sync_registry();
+   const boost::uint32_t free_slots = registry.num_free_slots();
+   for(unsigned int i = 0; i != 2u*ipcdetail::named_sync_registry::num_slots; ++i){
+      const std::string name = object_name(i);
+      {
+         ipcdetail::shm_named_mutex mtx(create_only, name.c_str());
+         ipcdetail::shm_named_mutex other(open_only, name.c_str());
+      }
+      if(!ipcdetail::shm_named_mutex::remove(name.c_str()))
+         return false;
+      //Removed while open
+      ipcdetail::shm_named_mutex mtx(create_only, name.c_str());
+      if(!ipcdetail::shm_named_mutex::remove(name.c_str()))
+         return false;
+   }
+   return registry.num_free_slots() == free_slots;
+}
+
+bool test_name_too_long()
+{
+   const std::string name(BOOST_INTERPROCESS_NAMED_SYNC_REGISTRY_NAME_SIZE + 1u, 'a');
+   BOOST_INTERPROCESS_TRY{
+      ipcdetail::shm_named_mutex mtx(open_or_create, name.c_str());
+   }
+   BOOST_INTERPROCESS_CATCH(interprocess_exception &){
+      return true;
+   } BOOST_INTERPROCESS_CATCH_END
+   return false;
+}
+
+int main()
+{
+   int ret = 0;
+   if(test::test_named_mutex<ipcdetail::shm_named_mutex>() ||
+      test::test_named_semaphore<ipcdetail::shm_named_semaphore>()){
+      ret = 1;
+   }
+   else if(!test_many_objects() || !test_remove() || !test_slot_reuse() || !test_name_too_long()){
+      ret = 1;
+   }
+   shared_memory_object::remove(test::get_process_id_name());
+   return ret;
+}
@@ -0,0 +1,40 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/sync/interprocess_pi_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include "mutex_test_template.hpp"
+#include "condition_test_template.hpp"
+
+#if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+#include <boost/interprocess/sync/futex/pi_mutex.hpp>
+#include <boost/interprocess/sync/futex/condition.hpp>
+#endif
+
+int main ()
+{
+   using namespace boost::interprocess;
+
+   test::test_all_lock<interprocess_pi_mutex>();
+   test::test_all_mutex<interprocess_pi_mutex>();
+   //Conditions work with priority inheritance mutexes
+   if(!test::do_test_condition<interprocess_condition, interprocess_pi_mutex>())
+      return 1;
+
+   #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   //The futex implementation, used when pthreads are not
+   test::test_all_lock<ipcdetail::futex_pi_mutex>();
+   test::test_all_mutex<ipcdetail::futex_pi_mutex>();
+   if(!test::do_test_condition<ipcdetail::futex_condition, ipcdetail::futex_pi_mutex>())
+      return 1;
+   #endif
+   return 0;
+}
@@ -0,0 +1,104 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/robust_emulation.hpp>
+#include <boost/interprocess/sync/spin/mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include "boost_interprocess_check.hpp"
+
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+#include <boost/interprocess/anonymous_shared_memory.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <new>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace boost::interprocess;
+
+typedef ipcdetail::robust_spin_mutex<ipcdetail::spin_mutex> robust_mutex_t;
+
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
+//Locks the mutex in a child process that dies without unlocking it
+static bool die_holding(robust_mutex_t &mtx, bool recovers)
+{
+   const pid_t pid = ::fork();
+   if(pid == 0){
+      //The child must take the ownership from the dead previous owner
+      const bool ok = mtx.try_lock() && mtx.previous_owner_dead() == recovers;
+      ::_exit(ok ? 0 : 1);
+   }
+   int status = 0;
+   return pid > 0 && ::waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+//A mutex owned by a dead process is recovered, also when the dead
+//owner had taken the ownership from another dead process
+static void test_dead_owner()
+{
+   mapped_region region(anonymous_shared_memory(sizeof(robust_mutex_t)));
+   robust_mutex_t *mtx = ::new(region.get_address()) robust_mutex_t;
+   BOOST_INTERPROCESS_CHECK(die_holding(*mtx, false));
+   BOOST_INTERPROCESS_CHECK(die_holding(*mtx, true));
+   BOOST_INTERPROCESS_CHECK(mtx->try_lock());
+   BOOST_INTERPROCESS_CHECK(mtx->previous_owner_dead());
+   mtx->consistent();
+   mtx->unlock();
+   BOOST_INTERPROCESS_CHECK(mtx->try_lock());
+   BOOST_INTERPROCESS_CHECK(!mtx->previous_owner_dead());
+   mtx->unlock();
+   mtx->~robust_mutex_t();
+}
+
+#endif   //#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
+int main()
+{
+   const ipcdetail::OS_process_id_t pid = ipcdetail::get_current_process_id();
+   const unsigned long long start = ipcdetail::get_process_start_time(pid);
+   #if defined(BOOST_INTERPROCESS_WINDOWS) || defined(__linux__)
+   //The start time of a living process is known
+   BOOST_INTERPROCESS_CHECK(start != 0u);
+   #endif
+   //and it does not change
+   BOOST_INTERPROCESS_CHECK(start == ipcdetail::get_process_start_time(pid));
+
+   #if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
+   //Verified owners are cached, and a different start time is a different owner
+   {
+      typedef ipcdetail::robust_emulation_helpers::verified_owner_cache cache_t;
+      const boost::uint64_t own = boost::uint64_t(pid) | (boost::uint64_t(0x1234u) << 32u);
+      BOOST_INTERPROCESS_CHECK(!cache_t::is_verified(own));
+      cache_t::set_verified(own);
+      BOOST_INTERPROCESS_CHECK(cache_t::is_verified(own));
+      BOOST_INTERPROCESS_CHECK(!cache_t::is_verified(own + (boost::uint64_t(1u) << 32u)));
+   }
+   #endif
+
+   //Lock files don't tell if the owner is the current process
+   #if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
+   //A mutex owned by a living process is not taken
+   robust_mutex_t mtx;
+   {
+      scoped_lock<robust_mutex_t> lock(mtx);
+      BOOST_INTERPROCESS_CHECK(!mtx.try_lock());
+      BOOST_INTERPROCESS_CHECK(!mtx.previous_owner_dead());
+   }
+   BOOST_INTERPROCESS_CHECK(mtx.try_lock());
+   mtx.unlock();
+   #endif   //#if !defined(BOOST_INTERPROCESS_ROBUST_EMULATION_USE_LOCK_FILES)
+   #if !defined(BOOST_INTERPROCESS_WINDOWS)
+   test_dead_owner();
+   #endif
+   return 0;
+}
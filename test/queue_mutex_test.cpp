@@ -0,0 +1,281 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/sync/interprocess_queue_mutex.hpp>
+#include <boost/interprocess/sync/mutex_family.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/timed_utils.hpp>
+#include <string>
+#include "mutex_test_template.hpp"
+#include "get_process_id_name.hpp"
+
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+#include <boost/interprocess/anonymous_shared_memory.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <new>
+#include <csignal>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace boost::interprocess;
+
+//More contenders than slots, so that some of them share a slot
+static const unsigned NumThreads = ipcdetail::spin_queue_mutex::num_slots + 8u;
+static const unsigned NumIterations = 2000u;
+static const unsigned NumFifoWaiters = 8u;
+
+struct counter_data
+{
+   interprocess_queue_mutex mut;
+   unsigned value;
+};
+
+struct incrementer
+{
+   explicit incrementer(counter_data &d)
+      : mp_data(&d)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != NumIterations; ++i){
+         scoped_lock<interprocess_queue_mutex> lock(mp_data->mut);
+         ++mp_data->value;
+      }
+   }
+
+   counter_data *mp_data;
+};
+
+bool test_mutual_exclusion()
+{
+   counter_data d;
+   d.value = 0u;
+   ipcdetail::OS_thread_t threads[NumThreads];
+   for(unsigned i = 0; i != NumThreads; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], incrementer(d)))
+         return false;
+   }
+   for(unsigned i = 0; i != NumThreads; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   return d.value == NumThreads*NumIterations;
+}
+
+struct fifo_data
+{
+   interprocess_queue_mutex mut;
+   volatile boost::uint32_t started;
+   unsigned order[NumFifoWaiters];
+   unsigned num_acquired;
+};
+
+struct fifo_waiter
+{
+   fifo_waiter(fifo_data &d, unsigned id)
+      : mp_data(&d), m_id(id)
+   {}
+
+   void operator()()
+   {
+      ipcdetail::atomic_inc32(&mp_data->started);
+      scoped_lock<interprocess_queue_mutex> lock(mp_data->mut);
+      mp_data->order[mp_data->num_acquired++] = m_id;
+   }
+
+   fifo_data *mp_data;
+   unsigned m_id;
+};
+
+//Waiters acquire the mutex in the order they started waiting
+bool test_fifo()
+{
+   fifo_data d;
+   d.started = 0u;
+   d.num_acquired = 0u;
+   ipcdetail::OS_thread_t threads[NumFifoWaiters];
+   d.mut.lock();
+   for(unsigned i = 0; i != NumFifoWaiters; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], fifo_waiter(d, i)))
+         return false;
+      //Give the waiter time to join the queue before launching the next one
+      while(ipcdetail::atomic_read32(&d.started) != i + 1u){
+         ipcdetail::thread_yield();
+      }
+      ipcdetail::thread_sleep_ms(20u);
+   }
+   //Nobody can get the mutex while others are queued
+   if(d.mut.try_lock())
+      return false;
+   d.mut.unlock();
+   for(unsigned i = 0; i != NumFifoWaiters; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   bool ok = d.num_acquired == NumFifoWaiters;
+   for(unsigned i = 0; i != NumFifoWaiters; ++i){
+      ok = ok && d.order[i] == i;
+   }
+   return ok;
+}
+
+struct timed_waiter
+{
+   timed_waiter(fifo_data &d, unsigned id, unsigned timeout_ms, bool &acquired)
+      : mp_data(&d), m_id(id), m_timeout_ms(timeout_ms), mp_acquired(&acquired)
+   {}
+
+   void operator()()
+   {
+      ipcdetail::atomic_inc32(&mp_data->started);
+      *mp_acquired = mp_data->mut.timed_lock(ustime_delay_milliseconds(m_timeout_ms));
+      if(*mp_acquired){
+         mp_data->order[mp_data->num_acquired++] = m_id;
+         mp_data->mut.unlock();
+      }
+   }
+
+   fifo_data *mp_data;
+   unsigned m_id;
+   unsigned m_timeout_ms;
+   bool *mp_acquired;
+};
+
+//Timed waiters join the queue and the tickets of the ones that time out are skipped
+bool test_timed_fifo()
+{
+   fifo_data d;
+   d.started = 0u;
+   d.num_acquired = 0u;
+   ipcdetail::OS_thread_t threads[3];
+   bool acquired[3] = { false, false, false };
+   const unsigned timeouts[3] = { 10000u, 50u, 10000u };
+   d.mut.lock();
+   for(unsigned i = 0; i != 3u; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], timed_waiter(d, i, timeouts[i], acquired[i])))
+         return false;
+      while(ipcdetail::atomic_read32(&d.started) != i + 1u){
+         ipcdetail::thread_yield();
+      }
+      ipcdetail::thread_sleep_ms(20u);
+   }
+   //Wait for the second waiter to time out
+   ipcdetail::thread_join(threads[1]);
+   d.mut.unlock();
+   ipcdetail::thread_join(threads[0]);
+   ipcdetail::thread_join(threads[2]);
+   if(!acquired[0] || acquired[1] || !acquired[2] || d.num_acquired != 2u)
+      return false;
+   if(d.order[0] != 0u || d.order[1] != 2u)
+      return false;
+   //The mutex is usable after skipping the abandoned ticket
+   if(!d.mut.try_lock())
+      return false;
+   d.mut.unlock();
+   return true;
+}
+
+#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
+//A process killed while waiting only delays the next waiters
+bool test_dead_waiter()
+{
+   mapped_region region(anonymous_shared_memory(sizeof(fifo_data)));
+   fifo_data *d = ::new(region.get_address()) fifo_data;
+   d->started = 0u;
+   d->mut.lock();
+   const pid_t pid = ::fork();
+   if(pid == 0){
+      ipcdetail::atomic_inc32(&d->started);
+      d->mut.lock();
+      ::_exit(0);
+   }
+   while(ipcdetail::atomic_read32(&d->started) != 1u){
+      ipcdetail::thread_yield();
+   }
+   ipcdetail::thread_sleep_ms(50u);
+   int status = 0;
+   if(pid < 0 || ::kill(pid, SIGKILL) != 0 || ::waitpid(pid, &status, 0) != pid)
+      return false;
+   //The mutex is granted to the dead waiter and then recovered
+   d->mut.unlock();
+   const bool ok = d->mut.timed_lock(ustime_delay_milliseconds(5000u));
+   if(ok){
+      d->mut.unlock();
+   }
+   d->~fifo_data();
+   return ok;
+}
+
+#endif   //#if !defined(BOOST_INTERPROCESS_WINDOWS)
+
+typedef basic_managed_shared_memory
+   <char, rbtree_best_fit<queue_mutex_family>, iset_index> queue_managed_shared_memory;
+
+struct allocator_user
+{
+   explicit allocator_user(queue_managed_shared_memory &segment)
+      : mp_segment(&segment)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != NumIterations; ++i){
+         void *p = mp_segment->allocate(16u + i % 64u);
+         mp_segment->deallocate(p);
+      }
+   }
+
+   queue_managed_shared_memory *mp_segment;
+};
+
+//queue_mutex_family protects the memory algorithm of a managed segment
+bool test_mutex_family(const char *name)
+{
+   shared_memory_object::remove(name);
+   bool ok;
+   {
+      queue_managed_shared_memory segment(create_only, name, 65536u);
+      ipcdetail::OS_thread_t threads[4];
+      for(unsigned i = 0; i != 4u; ++i){
+         if(0 != ipcdetail::thread_launch(threads[i], allocator_user(segment)))
+            return false;
+      }
+      for(unsigned i = 0; i != 4u; ++i){
+         ipcdetail::thread_join(threads[i]);
+      }
+      ok = segment.all_memory_deallocated() && segment.check_sanity();
+   }
+   shared_memory_object::remove(name);
+   return ok;
+}
+
+int main ()
+{
+   test::test_all_lock<interprocess_queue_mutex>();
+   test::test_all_mutex<interprocess_queue_mutex>();
+
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   if(!test_mutual_exclusion() || !test_fifo() || !test_timed_fifo() || !test_mutex_family(process_name.c_str())){
+      return 1;
+   }
+   #if !defined(BOOST_INTERPROCESS_WINDOWS)
+   if(!test_dead_waiter()){
+      return 1;
+   }
+   #endif
+   return 0;
+}
@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/workaround.hpp>
+
+#if defined(BOOST_INTERPROCESS_MAPPED_FILES)
+
+#include <boost/interprocess/managed_mapped_file.hpp>
+#include <boost/interprocess/segment_snapshot.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <fstream>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef segment_snapshot_writer<managed_mapped_file> writer_t;
+
+const std::size_t ArraySize = 1000u;
+
+bool check_value(const char *filename, int value)
+{
+   managed_mapped_file mfile(open_copy_on_write, filename);
+   std::pair<int*, std::size_t> res = mfile.find<int>("array");
+   if(!res.first || res.second != ArraySize)
+      return false;
+   for(std::size_t i = 0; i != ArraySize; ++i){
+      if(res.first[i] != value + int(i))
+         return false;
+   }
+   return mfile.check_sanity();
+}
+
+void set_value(int *array, int value)
+{
+   for(std::size_t i = 0; i != ArraySize; ++i){
+      array[i] = value + int(i);
+   }
+}
+
+bool test_snapshot(const char *filename, const char *snapname)
+{
+   {
+      managed_mapped_file mfile(open_only, filename);
+      int *array = mfile.find<int>("array").first;
+      writer_t writer(mfile);
+
+      //Synchronous snapshot
+      set_value(array, 1);
+      if(!writer.snapshot(snapname))
+         return false;
+      set_value(array, 2);
+      if(!check_value(snapname, 1))
+         return false;
+
+      //Asynchronous snapshots are renamed in order
+      writer_t::ticket_type t1 = writer.async_snapshot(snapname);
+      set_value(array, 3);
+      writer_t::ticket_type t2 = writer.async_snapshot(snapname);
+      set_value(array, 4);
+      if(t2 <= t1 || !writer.wait(t2) || !writer.is_complete(t1))
+         return false;
+      if(!check_value(snapname, 3))
+         return false;
+
+      //Synchronous snapshots wait for pending asynchronous ones
+      writer.async_snapshot(snapname);
+      set_value(array, 5);
+      if(!writer.snapshot(snapname) || !check_value(snapname, 5))
+         return false;
+
+      //Several writers can write to the same path
+      {
+         writer_t writer2(mfile);
+         set_value(array, 9);
+         writer_t::ticket_type t3 = writer.async_snapshot(snapname);
+         writer_t::ticket_type t4 = writer2.async_snapshot(snapname);
+         if(!writer.wait(t3) || !writer2.wait(t4) || !check_value(snapname, 9))
+            return false;
+      }
+      //The temporary file of another writer is not used nor removed
+      {
+         ipcdetail::pid_str_t pid_str;
+         ipcdetail::get_pid_str(pid_str);
+         std::string other(snapname);
+         other += '.'; other += pid_str; other += ".1.tmp";
+         {
+            std::ofstream f(other.c_str());
+            f << "other";
+         }
+         writer_t writer3(mfile);
+         set_value(array, 10);
+         const bool ok = writer3.snapshot(snapname) && check_value(snapname, 10);
+         std::string contents;
+         {
+            std::ifstream f(other.c_str());
+            f >> contents;
+         }
+         file_mapping::remove(other.c_str());
+         if(!ok || contents != "other")
+            return false;
+      }
+
+      //Pending snapshots are completed on destruction
+      set_value(array, 6);
+      writer.async_snapshot(snapname);
+      set_value(array, 7);
+   }
+   if(!check_value(snapname, 6) || !check_value(filename, 7))
+      return false;
+
+   //Recovery: the snapshot replaces the file and can be used directly
+   if(!restore_snapshot(snapname, filename))
+      return false;
+   if(!check_value(filename, 6))
+      return false;
+   {
+      managed_mapped_file mfile(open_only, filename);
+      int *array = mfile.find<int>("array").first;
+      set_value(array, 8);
+      if(!mfile.construct<int>("new")(0) || !mfile.destroy<int>("new"))
+         return false;
+   }
+   return check_value(filename, 8);
+}
+
+int main ()
+{
+   const std::size_t FileSize = 65536u*4u;
+   std::string filename(get_filename());
+   const char *FileName = filename.c_str();
+   std::string snapname(filename);
+   snapname += "_snapshot";
+   const char *SnapName = snapname.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      file_mapping::remove(FileName);
+      file_mapping::remove(SnapName);
+      {
+         managed_mapped_file mfile(create_only, FileName, FileSize);
+         mfile.construct<int>("array")[ArraySize](0);
+      }
+      if(!test_snapshot(FileName, SnapName)){
+         file_mapping::remove(FileName);
+         file_mapping::remove(SnapName);
+         return 1;
+      }
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      file_mapping::remove(FileName);
+      file_mapping::remove(SnapName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   file_mapping::remove(FileName);
+   file_mapping::remove(SnapName);
+   return 0;
+}
+
+#else //#if defined(BOOST_INTERPROCESS_MAPPED_FILES)
+
+int main()
+{
+   return 0;
+}
+
+#endif//#if defined(BOOST_INTERPROCESS_MAPPED_FILES)
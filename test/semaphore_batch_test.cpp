@@ -0,0 +1,136 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/interprocess/sync/named_semaphore.hpp>
+#include <boost/interprocess/sync/spin/semaphore.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <string>
+#include "util.hpp"
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+static const unsigned NumThreads = 4u;
+static const unsigned NumIterations = 5000u;
+static const unsigned MaxBatch = 4u;
+
+//Requests that can't be satisfied must not acquire any unit
+template<class Semaphore>
+bool test_all_or_nothing(Semaphore &sem)
+{
+   //Initial count is 2
+   if(sem.try_wait(3u) || !sem.try_wait(0u))
+      return false;
+   if(sem.timed_wait(3u, test::ptime_delay_ms(50)))
+      return false;
+   if(!sem.try_wait(2u) || sem.try_wait())
+      return false;
+   sem.post(0u);
+   if(sem.try_wait())
+      return false;
+   sem.post(5u);
+   if(!sem.timed_wait(3u, test::ptime_delay_ms(50)) || !sem.try_wait(2u) || sem.try_wait())
+      return false;
+   sem.post(3u);
+   sem.wait(3u);
+   return !sem.try_wait();
+}
+
+template<class Semaphore>
+struct batch_user
+{
+   batch_user(Semaphore &sem, unsigned id, volatile boost::uint32_t &in_use, bool &ok)
+      : mp_sem(&sem), m_id(id), mp_in_use(&in_use), mp_ok(&ok)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != NumIterations; ++i){
+         const unsigned n = 1u + (i + m_id) % MaxBatch;
+         if(i % 3u == 2u){
+            while(!mp_sem->timed_wait(n, test::ptime_delay_ms(10))){}
+         }
+         else{
+            mp_sem->wait(n);
+         }
+         //Units in use can never exceed the initial count
+         if(ipcdetail::atomic_add32(mp_in_use, n) + n > MaxBatch){
+            *mp_ok = false;
+         }
+         ipcdetail::atomic_add32(mp_in_use, boost::uint32_t(0u - n));
+         mp_sem->post(n);
+      }
+   }
+
+   Semaphore *mp_sem;
+   unsigned m_id;
+   volatile boost::uint32_t *mp_in_use;
+   bool *mp_ok;
+};
+
+//Threads requesting different amounts of units must not deadlock
+//holding partial requests
+template<class Semaphore>
+bool test_concurrent_batches(Semaphore &sem)
+{
+   volatile boost::uint32_t in_use = 0u;
+   bool ok[NumThreads];
+   ipcdetail::OS_thread_t threads[NumThreads];
+   for(unsigned i = 0; i != NumThreads; ++i){
+      ok[i] = true;
+      if(0 != ipcdetail::thread_launch(threads[i], batch_user<Semaphore>(sem, i, in_use, ok[i])))
+         return false;
+   }
+   bool ret = true;
+   for(unsigned i = 0; i != NumThreads; ++i){
+      ipcdetail::thread_join(threads[i]);
+      ret = ret && ok[i];
+   }
+   return ret && sem.try_wait(MaxBatch) && !sem.try_wait();
+}
+
+template<class Semaphore>
+bool test_semaphore(Semaphore &sem)
+{
+   if(!test_all_or_nothing(sem))
+      return false;
+   sem.post(MaxBatch);
+   return test_concurrent_batches(sem);
+}
+
+int main ()
+{
+   {
+      interprocess_semaphore sem(2u);
+      if(!test_semaphore(sem))
+         return 1;
+   }
+   {
+      ipcdetail::spin_semaphore sem(2u);
+      if(!test_semaphore(sem))
+         return 1;
+   }
+   {
+      std::string process_name;
+      test::get_process_id_name(process_name);
+      named_semaphore::remove(process_name.c_str());
+      bool ok;
+      {
+         named_semaphore sem(create_only, process_name.c_str(), 2u);
+         ok = test_semaphore(sem);
+      }
+      named_semaphore::remove(process_name.c_str());
+      if(!ok)
+         return 1;
+   }
+   return 0;
+}
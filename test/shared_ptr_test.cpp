@@ -597,6 +597,92 @@ void test_alias()
 }
 
 
+struct make_shared_tester
+   : enable_shared_from_this< make_shared_tester
+                            , managed_shared_memory::allocator<void>::type
+                            , inplace_deleter<make_shared_tester, managed_shared_memory::segment_manager> >
+{
+   static int count;
+
+   make_shared_tester(int a, int b)
+      : value(a + b)
+   {
+      if(value < 0)
+         throw std::exception();
+      ++count;
+   }
+
+   ~make_shared_tester()
+   {  --count;  }
+
+   int value;
+};
+
+int make_shared_tester::count = 0;
+
+void test_make_managed_shared()
+{
+   typedef managed_inplace_shared_ptr<make_shared_tester, managed_shared_memory>::type tester_ptr_t;
+   typedef managed_inplace_weak_ptr<make_shared_tester, managed_shared_memory>::type   tester_weak_ptr_t;
+   typedef managed_shared_ptr<make_shared_tester, managed_shared_memory>::type         tester_owner_ptr_t;
+   typedef allocator<char, managed_shared_memory::segment_manager>               char_allocator_t;
+   typedef boost::container::basic_string<char, std::char_traits<char>, char_allocator_t> string_t;
+
+   std::string process_name;
+   test::get_process_id_name(process_name);
+
+   shared_memory_object::remove(process_name.c_str());
+   {
+      managed_shared_memory shmem(create_only, process_name.c_str(), 65536);
+      const managed_shared_memory::size_type free_memory = shmem.get_free_memory();
+      {
+         tester_ptr_t p = make_managed_shared<make_shared_tester>(shmem, 1, 2);
+         BOOST_TEST( p->value == 3 );
+         BOOST_TEST( make_shared_tester::count == 1 );
+         BOOST_TEST( p.use_count() == 1 );
+         BOOST_TEST( p->shared_from_this() == p );
+
+         //The object and the counts need a single allocation, so less
+         //memory than an object and a separately allocated control block
+         const managed_shared_memory::size_type free_memory1 = shmem.get_free_memory();
+         tester_owner_ptr_t p2(make_managed_shared_ptr
+            (shmem.construct<make_shared_tester>(anonymous_instance)(3, 4), shmem));
+         BOOST_TEST( (free_memory - free_memory1) < (free_memory1 - shmem.get_free_memory()) );
+         p2.reset();
+
+         //The memory is kept while there are weak pointers
+         tester_weak_ptr_t w(p);
+         tester_ptr_t p3(p);
+         p.reset();
+         BOOST_TEST( !w.expired() && make_shared_tester::count == 1 );
+         p3.reset();
+         BOOST_TEST( w.expired() && make_shared_tester::count == 0 );
+         BOOST_TEST( !w.lock() );
+         BOOST_TEST( shmem.get_free_memory() < free_memory );
+      }
+      BOOST_TEST( shmem.get_free_memory() == free_memory );
+
+      //Exceptions thrown by the constructor deallocate the memory
+      bool thrown = false;
+      BOOST_INTERPROCESS_TRY{  make_managed_shared<make_shared_tester>(shmem, -1, -2);  }
+      BOOST_INTERPROCESS_CATCH(std::exception &){  thrown = true;  } BOOST_INTERPROCESS_CATCH_END
+      BOOST_TEST( thrown );
+      BOOST_TEST( !make_managed_shared<make_shared_tester>(shmem, std::nothrow, -1, -2) );
+      BOOST_TEST( shmem.get_free_memory() == free_memory );
+
+      //Types using the segment allocator get it from the segment manager
+      {
+         managed_inplace_shared_ptr<string_t, managed_shared_memory>::type s =
+            make_managed_shared<string_t>(shmem, "a string longer than the small string buffer");
+         BOOST_TEST( *s == "a string longer than the small string buffer" );
+         BOOST_TEST( s->get_allocator().get_segment_manager() == shmem.get_segment_manager() );
+      }
+      BOOST_TEST( shmem.get_free_memory() == free_memory );
+      BOOST_TEST( make_shared_tester::count == 0 );
+   }
+   shared_memory_object::remove(process_name.c_str());
+}
+
 struct std_deleter
 {
    typedef const void* pointer;
@@ -635,5 +721,7 @@ int main()
 
    test_alias();
    test_const_shared_from_this();
+   test_make_managed_shared();
+   return boost::report_errors();
 }
 
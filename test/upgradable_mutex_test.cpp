@@ -15,15 +15,194 @@
 #include <boost/interprocess/sync/sharable_lock.hpp>
 #include <boost/interprocess/sync/upgradable_lock.hpp>
 #include "util.hpp"
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
 
-int main ()
+using namespace boost::interprocess;
+
+//Concurrent mix of acquisitions and transitions that checks
+//the ownership invariants with atomic counters
+struct transition_stress
 {
-   using namespace boost::interprocess;
+   typedef interprocess_upgradable_mutex Mutex;
+   static const unsigned NumThreads = 6u;
+   static const unsigned NumIterations = 20000u;
+
+   transition_stress()
+      : readers(0u), upgraders(0u), writers(0u), ok(true)
+   {}
+
+   void check(bool cond)
+   {
+      if(!cond)
+         ok = false;
+   }
+
+   void enter_sharable()
+   {
+      ipcdetail::atomic_inc32(&readers);
+      check(!ipcdetail::atomic_read32(&writers));
+   }
+
+   void leave_sharable()
+   {  ipcdetail::atomic_dec32(&readers);  }
 
+   void enter_upgradable()
+   {
+      check(!ipcdetail::atomic_inc32(&upgraders));
+      check(!ipcdetail::atomic_read32(&writers));
+   }
+
+   void leave_upgradable()
+   {  ipcdetail::atomic_dec32(&upgraders);  }
+
+   void enter_exclusive()
+   {
+      check(!ipcdetail::atomic_inc32(&writers));
+      check(!ipcdetail::atomic_read32(&readers) && !ipcdetail::atomic_read32(&upgraders));
+   }
+
+   void leave_exclusive()
+   {  ipcdetail::atomic_dec32(&writers);  }
+
+   void run(unsigned seed)
+   {
+      for(unsigned i = 0; i != NumIterations; ++i){
+         switch((i + seed) % 7u){
+            case 0u:
+               mut.lock_sharable();
+               enter_sharable();
+               leave_sharable();
+               mut.unlock_sharable();
+            break;
+            case 1u:
+               mut.lock();
+               enter_exclusive();
+               leave_exclusive();
+               mut.unlock_and_lock_upgradable();
+               enter_upgradable();
+               leave_upgradable();
+               mut.unlock_upgradable_and_lock_sharable();
+               enter_sharable();
+               leave_sharable();
+               mut.unlock_sharable();
+            break;
+            case 2u:
+               mut.lock_upgradable();
+               enter_upgradable();
+               leave_upgradable();
+               mut.unlock_upgradable_and_lock();
+               enter_exclusive();
+               leave_exclusive();
+               mut.unlock_and_lock_sharable();
+               enter_sharable();
+               leave_sharable();
+               mut.unlock_sharable();
+            break;
+            case 3u:
+               if(mut.timed_lock(test::ptime_delay_ms(1))){
+                  enter_exclusive();
+                  leave_exclusive();
+                  mut.unlock();
+               }
+            break;
+            case 4u:
+               if(mut.timed_lock_upgradable(test::ptime_delay_ms(1))){
+                  enter_upgradable();
+                  leave_upgradable();
+                  if(mut.timed_unlock_upgradable_and_lock(test::ptime_delay_ms(1))){
+                     enter_exclusive();
+                     leave_exclusive();
+                     mut.unlock();
+                  }
+                  else{
+                     enter_upgradable();
+                     leave_upgradable();
+                     mut.unlock_upgradable();
+                  }
+               }
+            break;
+            case 5u:
+               if(mut.timed_lock_sharable(test::ptime_delay_ms(1))){
+                  enter_sharable();
+                  leave_sharable();
+                  if(mut.try_unlock_sharable_and_lock_upgradable()){
+                     enter_upgradable();
+                     leave_upgradable();
+                     mut.unlock_upgradable();
+                  }
+                  else{
+                     mut.unlock_sharable();
+                  }
+               }
+            break;
+            default:
+               if(mut.try_lock_sharable()){
+                  enter_sharable();
+                  leave_sharable();
+                  if(mut.try_unlock_sharable_and_lock()){
+                     enter_exclusive();
+                     leave_exclusive();
+                     mut.unlock();
+                  }
+                  else{
+                     mut.unlock_sharable();
+                  }
+               }
+            break;
+         }
+      }
+   }
+
+   struct thread_func
+   {
+      thread_func(transition_stress &s, unsigned seed)
+         : mp_s(&s), m_seed(seed)
+      {}
+
+      void operator()()
+      {  mp_s->run(m_seed);  }
+
+      transition_stress *mp_s;
+      unsigned m_seed;
+   };
+
+   bool test()
+   {
+      ipcdetail::OS_thread_t threads[NumThreads];
+      for(unsigned i = 0; i != NumThreads; ++i){
+         if(0 != ipcdetail::thread_launch(threads[i], thread_func(*this, i)))
+            return false;
+      }
+      for(unsigned i = 0; i != NumThreads; ++i){
+         ipcdetail::thread_join(threads[i]);
+      }
+      //The mutex must be free
+      if(!mut.try_lock())
+         return false;
+      mut.unlock();
+      return ok;
+   }
+
+   Mutex mut;
+   volatile boost::uint32_t readers;
+   volatile boost::uint32_t upgraders;
+   volatile boost::uint32_t writers;
+   bool ok;
+};
+
+int main ()
+{
    test::test_all_lock<interprocess_upgradable_mutex>();
    test::test_all_mutex<interprocess_upgradable_mutex>();
    test::test_all_sharable_mutex<interprocess_upgradable_mutex>();
 
+   {
+      transition_stress stress;
+      if(!stress.test())
+         return 1;
+   }
+
    //Test lock transition
    {
       typedef interprocess_upgradable_mutex Mutex;
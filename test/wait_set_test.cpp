@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2026. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/interprocess_wait_set.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/interprocess/ipc/message_queue.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <string>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+static const unsigned NumQueues = 4u;
+static const unsigned NumMessages = 5000u;
+//The semaphore is the last source
+static const unsigned SemSource = NumQueues;
+
+bool test_basic(interprocess_wait_set &ws)
+{
+   if(ws.try_wait() || ws.ready())
+      return false;
+   ws.notify(3u);
+   ws.notify(3u);
+   ws.notify(31u);
+   if(ws.ready() != ((1u << 3u) | (1u << 31u)) || ws.try_wait() != ((1u << 3u) | (1u << 31u)))
+      return false;
+   if(ws.try_wait() || ws.timed_wait(ustime_delay_milliseconds(10u)))
+      return false;
+   ws.notify(0u);
+   return ws.wait() == 1u && ws.timed_wait(ustime_delay_milliseconds(0u)) == 0u;
+}
+
+struct producer
+{
+   producer(interprocess_wait_set &ws, message_queue &mq, unsigned source)
+      : mp_ws(&ws), mp_mq(&mq), m_source(source)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != NumMessages; ++i){
+         mp_mq->send(&i, sizeof(i), 0);
+         mp_ws->notify(m_source);
+         if(i % 64u == 0u){
+            ipcdetail::thread_yield();
+         }
+      }
+   }
+
+   interprocess_wait_set *mp_ws;
+   message_queue *mp_mq;
+   unsigned m_source;
+};
+
+struct poster
+{
+   poster(interprocess_wait_set &ws, interprocess_semaphore &sem)
+      : mp_ws(&ws), mp_sem(&sem)
+   {}
+
+   void operator()()
+   {
+      for(unsigned i = 0; i != NumMessages; ++i){
+         mp_sem->post();
+         mp_ws->notify(SemSource);
+      }
+   }
+
+   interprocess_wait_set *mp_ws;
+   interprocess_semaphore *mp_sem;
+};
+
+bool test_multiple_sources(interprocess_wait_set &ws, interprocess_semaphore &sem)
+{
+   message_queue *queues[NumQueues];
+   ipcdetail::OS_thread_t threads[NumQueues + 1u];
+   for(unsigned i = 0; i != NumQueues; ++i){
+      //Small queues so that producers block
+      queues[i] = new message_queue(8u, sizeof(unsigned));
+   }
+   for(unsigned i = 0; i != NumQueues; ++i){
+      if(0 != ipcdetail::thread_launch(threads[i], producer(ws, *queues[i], i)))
+         return false;
+   }
+   if(0 != ipcdetail::thread_launch(threads[NumQueues], poster(ws, sem)))
+      return false;
+
+   //A single consumer serves all the sources
+   bool ok = true;
+   unsigned received[NumQueues] = {};
+   unsigned acquired = 0;
+   unsigned pending = NumQueues*NumMessages + NumMessages;
+   while(pending){
+      const boost::uint32_t mask = ws.wait();
+      if(!mask || (mask >> (SemSource + 1u))){
+         ok = false;
+      }
+      for(unsigned s = 0; s != NumQueues; ++s){
+         if(mask & (1u << s)){
+            unsigned v;
+            message_queue::size_type recvd;
+            unsigned int priority;
+            while(queues[s]->try_receive(&v, sizeof(v), recvd, priority)){
+               ok = ok && v == received[s];
+               ++received[s];
+               --pending;
+            }
+         }
+      }
+      if(mask & (1u << SemSource)){
+         while(sem.try_wait()){
+            ++acquired;
+            --pending;
+         }
+      }
+   }
+   for(unsigned i = 0; i != NumQueues + 1u; ++i){
+      ipcdetail::thread_join(threads[i]);
+   }
+   for(unsigned i = 0; i != NumQueues; ++i){
+      ok = ok && received[i] == NumMessages && queues[i]->get_num_msg() == 0u;
+      delete queues[i];
+   }
+   return ok && acquired == NumMessages && !sem.try_wait();
+}
+
+int main ()
+{
+   std::string process_name;
+   test::get_process_id_name(process_name);
+   const char *const shMemName = process_name.c_str();
+
+   BOOST_INTERPROCESS_TRY{
+      shared_memory_object::remove(shMemName);
+      managed_shared_memory segment(create_only, shMemName, 65536u);
+      interprocess_wait_set *ws = segment.construct<interprocess_wait_set>("wait_set")();
+      interprocess_semaphore *sem = segment.construct<interprocess_semaphore>("sem")(0u);
+      if(!test_basic(*ws) || !test_multiple_sources(*ws, *sem)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      segment.destroy_ptr(ws);
+      segment.destroy_ptr(sem);
+   }
+   BOOST_INTERPROCESS_CATCH(...){
+      shared_memory_object::remove(shMemName);
+      BOOST_INTERPROCESS_RETHROW
+   } BOOST_INTERPROCESS_CATCH_END
+   shared_memory_object::remove(shMemName);
+   return 0;
+}